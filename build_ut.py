@@ -32,11 +32,13 @@ import sys
 suiteInfo = {
     "servermain" : {"suite" : "RialtoServerMainUnitTests", "path" : "/tests/media/server/main/"},
     "servergstplayer" : {"suite" : "RialtoServerGstPlayerUnitTests", "path" : "/tests/media/server/gstplayer/"},
+    "servergstplayertaskpool" : {"suite" : "RialtoServerGstPlayerTaskPoolUnitTests", "path" : "/tests/media/server/gstplayer/"},
     "serveripc" : {"suite" : "RialtoServerIpcUnitTests", "path" : "/tests/media/server/ipc/"},
     "serverservice" : {"suite" : "RialtoServerServiceUnitTests", "path" : "/tests/media/server/service/"},
     "client" : {"suite" : "RialtoClientUnitTests", "path" : "/tests/media/client/main/"},
     "clientipc" : {"suite" : "RialtoClientIpcUnitTests", "path" : "/tests/media/client/ipc/"},
     "common" : {"suite" : "RialtoPlayerCommonUnitTests", "path" : "/tests/media/common/"},
+    "commonutils" : {"suite" : "RialtoCommonUnitTests", "path" : "/tests/common/"},
     "logging" : {"suite" : "RialtoLoggingUnitTests", "path" : "/tests/logging/"},
     "manager" : {"suite" : "RialtoServerManagerUnitTests", "path" : "/tests/serverManager/"},
     "ipc" : {"suite" : "RialtoIpcUnitTests", "path" : "/tests/ipc/"},
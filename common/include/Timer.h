@@ -21,12 +21,10 @@
 #define FIREBOLT_RIALTO_COMMON_TIMER_H_
 
 #include "ITimer.h"
+#include "TimerScheduler.h"
 
 #include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <thread>
 
 namespace firebolt::rialto::common
 {
@@ -45,10 +43,13 @@ public:
                                         TimerType timerType = TimerType::ONE_SHOT) const override;
 };
 
+/**
+ * @brief ITimer implementation; the callback is run by the shared TimerScheduler thread.
+ */
 class Timer : public ITimer
 {
 public:
-    Timer(const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
+    Timer(TimerScheduler &scheduler, const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
           TimerType timerType = TimerType::ONE_SHOT);
     ~Timer();
     Timer(const Timer &) = delete;
@@ -61,11 +62,8 @@ public:
 
 private:
     std::atomic<bool> m_active;
-    std::chrono::milliseconds m_timeout;
-    std::function<void()> m_callback;
-    mutable std::mutex m_mutex;
-    std::thread m_thread;
-    std::condition_variable m_cv;
+    TimerScheduler &m_scheduler;
+    TimerScheduler::Entry m_entry;
 };
 } // namespace firebolt::rialto::common
 
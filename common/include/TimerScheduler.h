@@ -0,0 +1,132 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FIREBOLT_RIALTO_COMMON_TIMER_SCHEDULER_H_
+#define FIREBOLT_RIALTO_COMMON_TIMER_SCHEDULER_H_
+
+#include "ITimer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace firebolt::rialto::common
+{
+/**
+ * @brief Runs the callbacks of all timers in the process on a single thread.
+ *
+ * Armed timers are kept ordered by their deadline on the monotonic clock, so the thread only
+ * ever waits for the earliest one.
+ */
+class TimerScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The scheduling state of a single timer. Owned by the timer, guarded by the scheduler.
+     */
+    struct Entry
+    {
+        std::chrono::milliseconds timeout;
+        std::function<void()> callback;
+        TimerType timerType;
+        std::multimap<Clock::time_point, Entry *>::iterator position;
+        bool isQueued{false};
+    };
+
+    /**
+     * @brief Gets the process wide scheduler, starting its thread on first use.
+     *
+     * The scheduler is never destroyed, so timers may be cancelled at any point of the process lifetime.
+     *
+     * @retval the scheduler.
+     */
+    static TimerScheduler &instance();
+
+    TimerScheduler(const TimerScheduler &) = delete;
+    TimerScheduler(TimerScheduler &&) = delete;
+    TimerScheduler &operator=(const TimerScheduler &) = delete;
+    TimerScheduler &operator=(TimerScheduler &&) = delete;
+
+    /**
+     * @brief Arms the entry to fire after its timeout.
+     *
+     * @param[in] entry : The entry to arm. Must stay valid until unschedule() returns.
+     */
+    void schedule(Entry &entry);
+
+    /**
+     * @brief Disarms the entry.
+     *
+     * Unless called from a timer callback, also waits for a running callback of this entry to finish.
+     *
+     * @param[in] entry : The entry to disarm.
+     */
+    void unschedule(Entry &entry);
+
+private:
+    TimerScheduler();
+    ~TimerScheduler() = default;
+
+    /**
+     * @brief The scheduler thread loop.
+     */
+    void run();
+
+    /**
+     * @brief Inserts the entry into the queue. Must be called with m_mutex held.
+     */
+    void enqueue(Entry &entry, const Clock::time_point &deadline);
+
+    /**
+     * @brief Mutex guarding the queue and all the entries.
+     */
+    std::mutex m_mutex;
+
+    /**
+     * @brief Wakes the scheduler thread when an earlier deadline is queued.
+     */
+    std::condition_variable m_wakeUp;
+
+    /**
+     * @brief Notified whenever a callback returns.
+     */
+    std::condition_variable m_callbackFinished;
+
+    /**
+     * @brief Armed entries ordered by deadline.
+     */
+    std::multimap<Clock::time_point, Entry *> m_queue;
+
+    /**
+     * @brief The entry whose callback is currently running, if any.
+     */
+    const Entry *m_runningEntry{nullptr};
+
+    /**
+     * @brief Id of the scheduler thread.
+     */
+    std::thread::id m_threadId;
+};
+} // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_TIMER_SCHEDULER_H_
@@ -48,28 +48,14 @@ std::shared_ptr<ITimerFactory> ITimerFactory::getFactory()
 std::unique_ptr<ITimer> TimerFactory::createTimer(const std::chrono::milliseconds &timeout,
                                                   const std::function<void()> &callback, TimerType timerType) const
 {
-    return std::make_unique<Timer>(timeout, callback, timerType);
+    return std::make_unique<Timer>(TimerScheduler::instance(), timeout, callback, timerType);
 }
 
-Timer::Timer(const std::chrono::milliseconds &timeout, const std::function<void()> &callback, TimerType timerType)
-    : m_active{true}, m_timeout{timeout}, m_callback{callback}
+Timer::Timer(TimerScheduler &scheduler, const std::chrono::milliseconds &timeout,
+             const std::function<void()> &callback, TimerType timerType)
+    : m_active{true}, m_scheduler{scheduler}, m_entry{timeout, callback, timerType, {}, false}
 {
-    m_thread = std::thread(
-        [this, timerType]()
-        {
-            do
-            {
-                std::unique_lock<std::mutex> lock{m_mutex};
-                if (!m_cv.wait_until(lock, std::chrono::system_clock::now() + m_timeout, [this]() { return !m_active; }))
-                {
-                    if (m_active && m_callback)
-                    {
-                        lock.unlock();
-                        m_callback();
-                    }
-                }
-            } while (timerType == TimerType::PERIODIC && m_active);
-        });
+    m_scheduler.schedule(m_entry);
 }
 
 Timer::~Timer()
@@ -80,12 +66,7 @@ Timer::~Timer()
 void Timer::cancel()
 {
     m_active = false;
-
-    if (std::this_thread::get_id() != m_thread.get_id() && m_thread.joinable())
-    {
-        m_cv.notify_one();
-        m_thread.join();
-    }
+    m_scheduler.unschedule(m_entry);
 }
 
 bool Timer::isActive() const
@@ -0,0 +1,111 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "TimerScheduler.h"
+
+#include <utility>
+
+namespace firebolt::rialto::common
+{
+TimerScheduler &TimerScheduler::instance()
+{
+    // Intentionally leaked: timers owned by other static objects may still be cancelled during process exit.
+    static TimerScheduler *scheduler = new TimerScheduler();
+    return *scheduler;
+}
+
+TimerScheduler::TimerScheduler()
+{
+    std::thread thread{&TimerScheduler::run, this};
+    m_threadId = thread.get_id();
+    thread.detach();
+}
+
+void TimerScheduler::schedule(Entry &entry)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    enqueue(entry, Clock::now() + entry.timeout);
+}
+
+void TimerScheduler::unschedule(Entry &entry)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (entry.isQueued)
+    {
+        m_queue.erase(entry.position);
+        entry.isQueued = false;
+    }
+    if (std::this_thread::get_id() != m_threadId)
+    {
+        m_callbackFinished.wait(lock, [this, &entry]() { return m_runningEntry != &entry; });
+    }
+}
+
+void TimerScheduler::enqueue(Entry &entry, const Clock::time_point &deadline)
+{
+    entry.position = m_queue.emplace(deadline, &entry);
+    entry.isQueued = true;
+    if (entry.position == m_queue.begin())
+    {
+        m_wakeUp.notify_one();
+    }
+}
+
+void TimerScheduler::run()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true)
+    {
+        if (m_queue.empty())
+        {
+            m_wakeUp.wait(lock);
+            continue;
+        }
+        auto next = m_queue.begin();
+        Clock::time_point deadline = next->first;
+        const Clock::time_point now = Clock::now();
+        if (now < deadline)
+        {
+            m_wakeUp.wait_until(lock, deadline);
+            continue;
+        }
+
+        Entry &entry = *next->second;
+        m_queue.erase(next);
+        entry.isQueued = false;
+        if (entry.timerType == TimerType::PERIODIC)
+        {
+            // Re-arm before running the callback, so that it can be cancelled from within the callback
+            deadline += entry.timeout;
+            enqueue(entry, deadline < now ? now + entry.timeout : deadline);
+        }
+
+        // The callback may destroy its own timer, so run a copy of it
+        std::function<void()> callback{entry.callback};
+        m_runningEntry = &entry;
+        lock.unlock();
+        if (callback)
+        {
+            callback();
+        }
+        lock.lock();
+        m_runningEntry = nullptr;
+        m_callbackFinished.notify_all();
+    }
+}
+} // namespace firebolt::rialto::common
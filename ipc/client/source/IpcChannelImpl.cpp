@@ -18,10 +18,13 @@
  */
 
 #include "IpcChannelImpl.h"
+#include "EmbeddedMessageWriter.h"
 #include "IpcLogging.h"
 
 #include "rialtoipc.pb.h"
 
+#include <google/protobuf/descriptor.h>
+
 #include <algorithm>
 #include <cinttypes>
 #include <cstdarg>
@@ -44,6 +47,7 @@
 namespace firebolt::rialto::ipc
 {
 const size_t ChannelImpl::m_kMaxMessageSize = 128 * 1024;
+const size_t ChannelImpl::m_kRecvBatchSize = 8;
 
 std::shared_ptr<IChannelFactory> IChannelFactory::createFactory()
 {
@@ -109,6 +113,10 @@ ChannelImpl::ChannelImpl(int sock)
         termChannel();
         throw std::runtime_error("Channel not connected");
     }
+    if (!sendCapabilities())
+    {
+        RIALTO_IPC_LOG_WARN("failed to send the client capabilities, calls will use names");
+    }
 }
 
 ChannelImpl::ChannelImpl(const std::string &socketPath)
@@ -129,6 +137,10 @@ ChannelImpl::ChannelImpl(const std::string &socketPath)
         termChannel();
         throw std::runtime_error("Channel not connected");
     }
+    if (!sendCapabilities())
+    {
+        RIALTO_IPC_LOG_WARN("failed to send the client capabilities, calls will use names");
+    }
 }
 
 ChannelImpl::~ChannelImpl()
@@ -256,11 +268,30 @@ bool ChannelImpl::initChannel()
     return true;
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Tells the server the client understands numeric service, method and event
+    ids. Servers that do not know the message ignore it.
+
+ */
+bool ChannelImpl::sendCapabilities()
+{
+    transport::MessageToServer message;
+    message.mutable_capabilities()->set_numeric_ids(true);
+
+    const std::string data = message.SerializeAsString();
+    return TEMP_FAILURE_RETRY(send(m_sock, data.data(), data.size(), MSG_NOSIGNAL)) ==
+           static_cast<ssize_t>(data.size());
+}
+
 void ChannelImpl::termChannel()
 {
     // close the socket and the epoll and timer fds
+    std::vector<MethodCall> outstandingCalls;
     if (m_sock >= 0)
-        disconnectNoLock();
+        outstandingCalls = disconnectNoLock();
     if ((m_epollFd >= 0) && (close(m_epollFd) != 0))
         RIALTO_IPC_LOG_SYS_ERROR(errno, "closing epoll fd failed");
     if ((m_timerFd >= 0) && (close(m_timerFd) != 0))
@@ -269,6 +300,10 @@ void ChannelImpl::termChannel()
         RIALTO_IPC_LOG_SYS_ERROR(errno, "closing event fd failed");
 
     // if any method calls are still outstanding then complete them with errors now
+    for (auto &call : outstandingCalls)
+    {
+        completeWithError(&call, "Channel destructed");
+    }
     for (auto &entry : m_methodCalls)
     {
         completeWithError(&entry.second, "Channel destructed");
@@ -280,13 +315,19 @@ void ChannelImpl::termChannel()
 void ChannelImpl::disconnect()
 {
     // disconnect from the socket
+    std::vector<MethodCall> outstandingCalls;
     {
         std::lock_guard<std::mutex> locker(m_lock);
 
         if (m_sock < 0)
             return;
 
-        disconnectNoLock();
+        outstandingCalls = disconnectNoLock();
+    }
+
+    for (auto &call : outstandingCalls)
+    {
+        completeWithError(&call, "Channel disconnected");
     }
 
     // wake the wait(...) call so client code is blocked there it is woken
@@ -304,14 +345,19 @@ void ChannelImpl::disconnect()
 /*!
     \internal
 
+    Closes the socket and takes the outstanding method calls, they can't be
+    replied to anymore.  The caller should complete the returned calls with
+    an error once it has dropped the lock.
+
+    \note Must be called while holding the m_lock mutex.
 
  */
-void ChannelImpl::disconnectNoLock()
+std::vector<ChannelImpl::MethodCall> ChannelImpl::disconnectNoLock()
 {
     if (m_sock < 0)
     {
         RIALTO_IPC_LOG_WARN("not connected\n");
-        return;
+        return {};
     }
 
     // remove the socket from epoll
@@ -331,6 +377,20 @@ void ChannelImpl::disconnectNoLock()
     }
 
     m_sock = -1;
+
+    std::vector<MethodCall> outstandingCalls;
+    outstandingCalls.reserve(m_methodCalls.size());
+    for (auto &entry : m_methodCalls)
+    {
+        outstandingCalls.emplace_back(entry.second);
+    }
+    m_methodCalls.clear();
+
+    // no more replies or timeouts are expected, so drop the pending deadlines and disarm the timer
+    m_callTimeouts = decltype(m_callTimeouts)();
+    updateTimeoutTimer();
+
+    return outstandingCalls;
 }
 
 bool ChannelImpl::isConnected() const
@@ -439,69 +499,89 @@ bool ChannelImpl::unsubscribe(int eventTag)
  */
 bool ChannelImpl::processSocketEvent()
 {
-    static std::mutex bufLock;
-    std::lock_guard<std::mutex> bufLocker(bufLock);
-
-    static std::vector<uint8_t> dataBuf(m_kMaxMessageSize);
-    static std::vector<uint8_t> ctrlBuf(CMSG_SPACE(SCM_MAX_FD * sizeof(int)));
-
-    // read all messages from the client socket, we break out if the socket is closed
-    // or EWOULDBLOCK is returned on a read (ie. no more messages to read)
-    while (true)
+    // the receive buffers belong to the channel, so channels serviced by different
+    // threads don't contend with each other
+    std::lock_guard<std::mutex> bufLocker(m_recvLock);
+    // most channels only ever get one message at a time, so start with a single
+    // slot and only allocate the full batch once a read fills it
+    if (!m_recvBatch)
     {
-        struct msghdr msg = {nullptr};
-        struct iovec io = {.iov_base = dataBuf.data(), .iov_len = dataBuf.size()};
-
-        bzero(&msg, sizeof(msg));
-        msg.msg_iov = &io;
-        msg.msg_iovlen = 1;
-        msg.msg_control = ctrlBuf.data();
-        msg.msg_controllen = ctrlBuf.size();
+        m_recvBatch = std::make_unique<RecvMessageBatch>(1, m_kMaxMessageSize, CMSG_SPACE(SCM_MAX_FD * sizeof(int)));
+    }
 
-        // read one message
-        ssize_t rd = TEMP_FAILURE_RETRY(recvmsg(m_sock, &msg, MSG_CMSG_CLOEXEC));
-        if (rd < 0)
+    // read all messages from the client socket in batches, we break out if the socket is closed, EWOULDBLOCK
+    // is returned on a read or a batch isn't full (ie. no more messages to read, and as the socket is level
+    // triggered we'll be woken again if more arrive)
+    bool moreToRead = true;
+    while (moreToRead)
+    {
+        const int numMessages = m_recvBatch->receive(m_sock, MSG_CMSG_CLOEXEC);
+        if (numMessages < 0)
         {
             if (errno != EWOULDBLOCK)
             {
                 RIALTO_IPC_LOG_SYS_ERROR(errno, "error reading client socket");
 
-                std::lock_guard<std::mutex> locker(m_lock);
-                disconnectNoLock();
+                std::unique_lock<std::mutex> locker(m_lock);
+                std::vector<MethodCall> outstandingCalls = disconnectNoLock();
+                locker.unlock();
+
+                for (auto &call : outstandingCalls)
+                    completeWithError(&call, "Channel disconnected");
                 return false;
             }
 
             break;
         }
-        else if (rd == 0)
-        {
-            // server closed connection, and we've read all data
-            RIALTO_IPC_LOG_INFO("socket remote end closed, disconnecting channel");
 
-            std::lock_guard<std::mutex> locker(m_lock);
-            disconnectNoLock();
-            return false;
-        }
-        else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
-        {
-            RIALTO_IPC_LOG_WARN("received truncated message from server, discarding");
+        moreToRead = (static_cast<size_t>(numMessages) == m_recvBatch->size());
 
-            // make sure to close all the fds, otherwise we'll leak them, this
-            // will read the fds and return in a vector, which will then be
-            // destroyed, closing all the fds
-            readMessageFds(&msg, 16);
-        }
-        else
+        for (int i = 0; i < numMessages; i++)
         {
-            // if there is control data then assume fd(s) have been passed
-            std::vector<FileDescriptor> fds;
-            if (msg.msg_controllen > 0)
+            const struct msghdr *msg = m_recvBatch->header(i);
+            const size_t rd = m_recvBatch->length(i);
+            if (rd == 0)
+            {
+                // server closed connection, and we've read all data
+                RIALTO_IPC_LOG_INFO("socket remote end closed, disconnecting channel");
+
+                std::unique_lock<std::mutex> locker(m_lock);
+                std::vector<MethodCall> outstandingCalls = disconnectNoLock();
+                locker.unlock();
+
+                for (auto &call : outstandingCalls)
+                    completeWithError(&call, "Channel disconnected");
+                return false;
+            }
+            else if (msg->msg_flags & (MSG_TRUNC | MSG_CTRUNC))
             {
-                fds = readMessageFds(&msg, 32);
+                RIALTO_IPC_LOG_WARN("received truncated message from server, discarding");
+
+                // make sure to close all the fds, otherwise we'll leak them, this
+                // will read the fds and return in a vector, which will then be
+                // destroyed, closing all the fds
+                readMessageFds(msg, 16);
             }
+            else
+            {
+                // if there is control data then assume fd(s) have been passed
+                std::vector<FileDescriptor> fds;
+                if (msg->msg_controllen > 0)
+                {
+                    fds = readMessageFds(msg, 32);
+                }
 
-            // process the message from the server
-            processServerMessage(dataBuf.data(), rd, &fds);
+                // process the message from the server, then recycle the arena it was parsed into
+                processServerMessage(m_recvBatch->data(i), rd, &fds);
+                m_recvArena.Reset();
+            }
+        }
+
+        // the messages read have been processed, so the buffers can be replaced
+        if (moreToRead && (m_recvBatch->size() < m_kRecvBatchSize))
+        {
+            m_recvBatch = std::make_unique<RecvMessageBatch>(m_kRecvBatchSize, m_kMaxMessageSize,
+                                                             CMSG_SPACE(SCM_MAX_FD * sizeof(int)));
         }
     }
 
@@ -536,26 +616,20 @@ void ChannelImpl::processTimeoutEvent()
 
     // remove the method calls that have expired
     const auto now = std::chrono::steady_clock::now();
-    auto it = m_methodCalls.begin();
-    while (it != m_methodCalls.end())
+    while (!m_callTimeouts.empty() && (now >= m_callTimeouts.top().first))
     {
-        if (now >= it->second.timeoutDeadline)
+        auto it = m_methodCalls.find(m_callTimeouts.top().second);
+        if (it != m_methodCalls.end())
         {
             timedOuts.emplace_back(it->second);
-            it = m_methodCalls.erase(it);
-        }
-        else
-        {
-            ++it;
+            m_methodCalls.erase(it);
         }
+        m_callTimeouts.pop();
     }
 
-    // if any method calls have been removed, then re-calculate the timer
-    // for the next timeout
-    if (!timedOuts.empty())
-    {
-        updateTimeoutTimer();
-    }
+    // the timer is one-shot so has now disarmed itself, re-arm it for the next timeout
+    m_armedTimeout = std::chrono::steady_clock::time_point::max();
+    updateTimeoutTimer();
 
     // drop the lock and now terminate the timed out method calls
     locker.unlock();
@@ -587,8 +661,9 @@ void ChannelImpl::processWakeEvent()
 /*!
     \internal
 
-    Updates the timerfd to the time of the next method call timeout.  If method
-    calls are pending then the timer is disabled.
+    Updates the timerfd to the time of the next method call timeout.  If no method
+    calls are pending then the timer is disabled.  The timerfd is only written
+    if the earliest deadline has changed since it was last armed.
 
     This should be called whenever a new method is called or a method has
     completed.
@@ -598,22 +673,25 @@ void ChannelImpl::processWakeEvent()
  */
 void ChannelImpl::updateTimeoutTimer()
 {
+    // drop the entries of calls that have already completed from the top of the heap
+    while (!m_callTimeouts.empty() && (m_methodCalls.count(m_callTimeouts.top().second) == 0))
+    {
+        m_callTimeouts.pop();
+    }
+
+    const std::chrono::steady_clock::time_point nextTimeout =
+        m_callTimeouts.empty() ? std::chrono::steady_clock::time_point::max() : m_callTimeouts.top().first;
+    if (nextTimeout == m_armedTimeout)
+    {
+        return;
+    }
+    m_armedTimeout = nextTimeout;
+
     struct itimerspec ts = {{0}};
 
     // if no method calls then just disarm the timer
-    if (!m_methodCalls.empty())
-    {
-        // otherwise, find the next soonest timeout
-        std::chrono::steady_clock::time_point nextTimeout = std::chrono::steady_clock::time_point::max();
-        auto nextTimeoutCall =
-            std::min_element(m_methodCalls.begin(), m_methodCalls.end(),
-                             [](const auto &elem, const auto &currentMin)
-                             { return elem.second.timeoutDeadline < currentMin.second.timeoutDeadline; });
-        if (nextTimeoutCall != m_methodCalls.end())
-        {
-            nextTimeout = nextTimeoutCall->second.timeoutDeadline;
-        }
-
+    if (!m_callTimeouts.empty())
+    {
         // set the timerfd to the next duration
         const std::chrono::microseconds duration =
             std::chrono::duration_cast<std::chrono::microseconds>(nextTimeout - std::chrono::steady_clock::now());
@@ -649,8 +727,8 @@ void ChannelImpl::updateTimeoutTimer()
  */
 void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std::vector<FileDescriptor> *fds)
 {
-    // parse the message
-    transport::MessageFromServer message;
+    // parse the message, the arena is owned by processSocketEvent() which holds m_recvLock
+    auto &message = *google::protobuf::Arena::CreateMessage<transport::MessageFromServer>(&m_recvArena);
     if (!message.ParseFromArray(data, static_cast<int>(dataLen)))
     {
         RIALTO_IPC_LOG_ERROR("invalid message from server");
@@ -670,6 +748,14 @@ void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std:
     {
         processEventFromServer(message.event(), fds);
     }
+    else if (message.has_service_ids())
+    {
+        processServiceIdsFromServer(message.service_ids());
+    }
+    else if (message.has_event_id())
+    {
+        processEventIdFromServer(message.event_id());
+    }
     else
     {
         RIALTO_IPC_LOG_ERROR("message from server is missing reply or event type");
@@ -774,10 +860,16 @@ void ChannelImpl::processEventFromServer(const transport::EventFromServer &event
 {
     RIALTO_IPC_LOG_DEBUG("processing event from server");
 
-    const std::string &eventName = event.event_name();
-
     std::lock_guard<std::mutex> locker(m_eventsLock);
 
+    if (event.has_event_id() && (event.event_id() >= m_eventNames.size()))
+    {
+        RIALTO_IPC_LOG_ERROR("received event with unknown id %u", event.event_id());
+        return;
+    }
+
+    const std::string &eventName = event.has_event_id() ? m_eventNames[event.event_id()] : event.event_name();
+
     auto range = m_eventHandlers.equal_range(eventName);
     if (range.first == range.second)
     {
@@ -822,6 +914,55 @@ void ChannelImpl::processEventFromServer(const transport::EventFromServer &event
     }
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Stores the ids of an exported service, subsequent calls to the service are
+    sent with the ids rather than the service and method names.
+
+ */
+void ChannelImpl::processServiceIdsFromServer(const transport::ServiceIds &serviceIds)
+{
+    const google::protobuf::ServiceDescriptor *descriptor =
+        google::protobuf::DescriptorPool::generated_pool()->FindServiceByName(serviceIds.service_name());
+    if (!descriptor)
+    {
+        RIALTO_IPC_LOG_DEBUG("ignoring ids of unknown service %s", serviceIds.service_name().c_str());
+        return;
+    }
+
+    // match the methods by name, in case the server was built from a different version of the service
+    ServiceIds ids{serviceIds.service_id(), std::vector<int64_t>(descriptor->method_count(), -1)};
+    for (int serverMethodId = 0; serverMethodId < serviceIds.method_names_size(); ++serverMethodId)
+    {
+        const google::protobuf::MethodDescriptor *method =
+            descriptor->FindMethodByName(serviceIds.method_names(serverMethodId));
+        if (method)
+            ids.methodIds[method->index()] = serverMethodId;
+    }
+
+    std::lock_guard<std::mutex> locker(m_idsLock);
+    m_serviceIds[descriptor] = std::move(ids);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Stores the name of an event id, always received before the first event
+    with that id.
+
+ */
+void ChannelImpl::processEventIdFromServer(const transport::EventId &eventId)
+{
+    std::lock_guard<std::mutex> locker(m_eventsLock);
+
+    if (eventId.event_id() >= m_eventNames.size())
+        m_eventNames.resize(eventId.event_id() + 1);
+    m_eventNames[eventId.event_id()] = eventId.event_name();
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
@@ -1058,17 +1199,29 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     const uint64_t serialId = m_serialCounter++;
 
     // create the transport request
-    transport::MessageToServer message;
-    transport::MethodCall *call = message.mutable_call();
-    call->set_serial_id(serialId);
-    call->set_service_name(method->service()->full_name());
-    call->set_method_name(method->name());
+    transport::MethodCall call;
+    call.set_serial_id(serialId);
+    {
+        // use the numeric ids once the server has sent them, otherwise fall back to the names
+        std::lock_guard<std::mutex> idsLocker(m_idsLock);
+        auto idsIt = m_serviceIds.find(method->service());
+        if ((idsIt != m_serviceIds.end()) && (idsIt->second.methodIds[method->index()] >= 0))
+        {
+            call.set_service_id(idsIt->second.serviceId);
+            call.set_method_id(static_cast<uint32_t>(idsIt->second.methodIds[method->index()]));
+        }
+        else
+        {
+            call.set_service_name(method->service()->full_name());
+            call.set_method_name(method->name());
+        }
+    }
 
-    // copy in the actual message data
-    std::string reqString = request->SerializeAsString();
-    call->set_request_message(std::move(reqString));
+    // the request is serialised straight into the send buffer as the request_message field of the call
+    const EmbeddedMessageWriter writer(transport::MessageToServer::kCallFieldNumber, call,
+                                       transport::MethodCall::kRequestMessageFieldNumber, *request);
 
-    const size_t requiredDataLen = message.ByteSizeLong();
+    const size_t requiredDataLen = writer.byteSize();
     if (requiredDataLen > m_kMaxMessageSize)
     {
         RIALTO_IPC_LOG_ERROR("method call to big to send (%zu, max %zu", requiredDataLen, m_kMaxMessageSize);
@@ -1100,7 +1253,7 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     iov->iov_len = requiredDataLen;
 
     // copy in the data
-    message.SerializeWithCachedSizesToArray(data);
+    writer.serializeToArray(data);
 
     // next check if the request is sending any fd's
     if (!fds.empty())
@@ -1139,8 +1292,8 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     }
     else
     {
-        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s.%s { %s }", serialId, call->service_name().c_str(),
-                             call->method_name().c_str(), request->ShortDebugString().c_str());
+        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s { %s }", serialId, method->full_name().c_str(),
+                             request->ShortDebugString().c_str());
 
         if (noReplyExpected)
         {
@@ -1154,6 +1307,7 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
         {
             // add the message to the queue so we pick-up the reply
             m_methodCalls.emplace(serialId, methodCall);
+            m_callTimeouts.emplace(methodCall.timeoutDeadline, serialId);
 
             // update the single timeout timer
             updateTimeoutTimer();
@@ -23,17 +23,21 @@
 #include "FileDescriptor.h"
 #include "IIpcChannel.h"
 #include "IpcClientControllerImpl.h"
-#include "SimpleBufferPool.h"
+#include "RecvMessageBatch.h"
+#include "SlabBufferPool.h"
 
 #include "rialtoipc-transport.pb.h"
+#include <google/protobuf/arena.h>
 #include <google/protobuf/service.h>
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <string>
 #include <vector>
 
@@ -76,7 +80,6 @@ public:
                       EventHandler &&handler) override;
 
 private:
-    void disconnectNoLock();
 
     bool processSocketEvent();
     void processTimeoutEvent();
@@ -88,10 +91,13 @@ private:
     void processErrorFromServer(const ::firebolt::rialto::ipc::transport::MethodCallError &error);
     void processEventFromServer(const ::firebolt::rialto::ipc::transport::EventFromServer &event,
                                 std::vector<FileDescriptor> *fds);
+    void processServiceIdsFromServer(const ::firebolt::rialto::ipc::transport::ServiceIds &serviceIds);
+    void processEventIdFromServer(const ::firebolt::rialto::ipc::transport::EventId &eventId);
 
     bool createConnectedSocket(const std::string &socketPath);
     bool attachSocket(int sockFd);
     bool initChannel();
+    bool sendCapabilities();
     void termChannel();
     bool isConnectedInternal() const; // to avoid calling virtual method in constructor
 
@@ -108,6 +114,8 @@ private:
         google::protobuf::Closure *closure = nullptr;
     };
 
+    std::vector<MethodCall> disconnectNoLock();
+
     void updateTimeoutTimer();
 
     static void complete(MethodCall *call);
@@ -115,13 +123,22 @@ private:
 
 private:
     static const size_t m_kMaxMessageSize;
+    static const size_t m_kRecvBatchSize;
 
     int m_sock;
     int m_epollFd;
     int m_timerFd;
     int m_eventFd;
 
-    SimpleBufferPool m_sendBufPool;
+    SlabBufferPool m_sendBufPool;
+
+    std::mutex m_recvLock;                          // serialises processSocketEvent() calls on this channel
+    std::unique_ptr<RecvMessageBatch> m_recvBatch;  // one slot until a read fills it, then m_kRecvBatchSize
+
+    // messages read from the socket are parsed onto this arena, it is reset after each message so its initial
+    // block is reused
+    alignas(std::max_align_t) char m_recvArenaBlock[4 * 1024];
+    google::protobuf::Arena m_recvArena{m_recvArenaBlock, sizeof(m_recvArenaBlock)};
 
     mutable std::mutex m_lock;
     std::atomic<uint64_t> m_serialCounter;
@@ -130,6 +147,21 @@ private:
 
     std::map<uint64_t, MethodCall> m_methodCalls;
 
+    // min-heap of (deadline, serial) for the outstanding calls, entries for calls that have already completed are
+    // dropped lazily when they reach the top of the heap
+    using CallTimeout = std::pair<std::chrono::steady_clock::time_point, uint64_t>;
+    std::priority_queue<CallTimeout, std::vector<CallTimeout>, std::greater<CallTimeout>> m_callTimeouts;
+    std::chrono::steady_clock::time_point m_armedTimeout = std::chrono::steady_clock::time_point::max();
+
+    struct ServiceIds
+    {
+        uint32_t serviceId;
+        std::vector<int64_t> methodIds; // server method id for each local method index, -1 if unknown
+    };
+
+    std::mutex m_idsLock;
+    std::map<const google::protobuf::ServiceDescriptor *, ServiceIds> m_serviceIds;
+
     std::mutex m_eventsLock;
 
     int m_eventTagCounter;
@@ -142,6 +174,7 @@ private:
     };
 
     std::multimap<std::string, Event> m_eventHandlers;
+    std::vector<std::string> m_eventNames; // event names indexed by the ids assigned by the server
 };
 
 } // namespace firebolt::rialto::ipc
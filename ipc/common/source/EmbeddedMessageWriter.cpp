@@ -0,0 +1,74 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EmbeddedMessageWriter.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedOutputStream;
+
+namespace firebolt::rialto::ipc
+{
+EmbeddedMessageWriter::EmbeddedMessageWriter(int wrapperFieldNumber, const google::protobuf::Message &wrapper,
+                                             int payloadFieldNumber, const google::protobuf::Message &payload)
+    : m_kWrapperFieldNumber(wrapperFieldNumber), m_kWrapper(wrapper), m_kPayloadFieldNumber(payloadFieldNumber),
+      m_kPayload(payload)
+{
+    // calculating the sizes also caches them in the messages for the serialisation
+    m_payloadSize = m_kPayload.ByteSizeLong();
+    m_wrapperSize = m_kWrapper.ByteSizeLong() +
+                    WireFormatLite::TagSize(m_kPayloadFieldNumber, WireFormatLite::TYPE_BYTES) +
+                    CodedOutputStream::VarintSize64(m_payloadSize) + m_payloadSize;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Returns the number of bytes serializeToArray() will write.
+
+*/
+size_t EmbeddedMessageWriter::byteSize() const
+{
+    return WireFormatLite::TagSize(m_kWrapperFieldNumber, WireFormatLite::TYPE_MESSAGE) +
+           CodedOutputStream::VarintSize64(m_wrapperSize) + m_wrapperSize;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Writes the message to \a data, which must have room for byteSize() bytes,
+    and returns a pointer to the byte after the last one written.
+
+*/
+uint8_t *EmbeddedMessageWriter::serializeToArray(uint8_t *data) const
+{
+    uint8_t *p = data;
+
+    p = WireFormatLite::WriteTagToArray(m_kWrapperFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, p);
+    p = CodedOutputStream::WriteVarint64ToArray(m_wrapperSize, p);
+    p = m_kWrapper.SerializeWithCachedSizesToArray(p);
+
+    p = WireFormatLite::WriteTagToArray(m_kPayloadFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, p);
+    p = CodedOutputStream::WriteVarint64ToArray(m_payloadSize, p);
+    p = m_kPayload.SerializeWithCachedSizesToArray(p);
+
+    return p;
+}
+
+} // namespace firebolt::rialto::ipc
@@ -0,0 +1,72 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_EMBEDDED_MESSAGE_WRITER_H_
+#define FIREBOLT_RIALTO_IPC_EMBEDDED_MESSAGE_WRITER_H_
+
+#include <google/protobuf/message.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// -----------------------------------------------------------------------------
+/*!
+    \class EmbeddedMessageWriter
+    \brief Serialises a transport message with its payload message embedded.
+
+    The transport messages carry the actual request, reply or event as a bytes
+    field.  Rather than serialising the payload into a temporary string and
+    copying that into the transport message, this writes the transport message
+    with the payload serialised straight into the output buffer.
+
+    The output is a single field of the outer transport message (e.g. the
+    \c call field of \c MessageToServer) holding the \a wrapper message with
+    the \a payload appended as its bytes field.  The \a wrapper must not have
+    the bytes field set itself.
+
+    Neither message may be modified between construction and the call to
+    serializeToArray(), as the cached sizes are used.
+*/
+
+namespace firebolt::rialto::ipc
+{
+class EmbeddedMessageWriter
+{
+public:
+    EmbeddedMessageWriter(int wrapperFieldNumber, const google::protobuf::Message &wrapper, int payloadFieldNumber,
+                          const google::protobuf::Message &payload);
+    ~EmbeddedMessageWriter() = default;
+
+public:
+    size_t byteSize() const;
+    uint8_t *serializeToArray(uint8_t *data) const;
+
+private:
+    const int m_kWrapperFieldNumber;
+    const google::protobuf::Message &m_kWrapper;
+    const int m_kPayloadFieldNumber;
+    const google::protobuf::Message &m_kPayload;
+
+    size_t m_payloadSize;
+    size_t m_wrapperSize;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_EMBEDDED_MESSAGE_WRITER_H_
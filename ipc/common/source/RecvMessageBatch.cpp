@@ -0,0 +1,69 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RecvMessageBatch.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace firebolt::rialto::ipc
+{
+RecvMessageBatch::RecvMessageBatch(size_t numSlots, size_t maxMessageSize, size_t maxControlSize)
+    : m_kNumSlots(numSlots), m_kMaxMessageSize(maxMessageSize), m_kMaxControlSize(CMSG_ALIGN(maxControlSize)),
+      m_dataBuf(new uint8_t[numSlots * maxMessageSize]), m_ctrlBuf(new uint8_t[numSlots * m_kMaxControlSize]),
+      m_iovs(numSlots), m_headers(numSlots)
+{
+    for (size_t i = 0; i < m_kNumSlots; i++)
+    {
+        m_iovs[i].iov_base = m_dataBuf.get() + (i * m_kMaxMessageSize);
+        m_iovs[i].iov_len = m_kMaxMessageSize;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Reads up to size() messages from \a sock, which should be non-blocking.
+
+    Returns the number of messages read, or -1 with errno set if none could be
+    read.  A message with a length of zero means the remote end has closed the
+    socket, any slots following it are also zero length.
+
+ */
+int RecvMessageBatch::receive(int sock, int flags)
+{
+    // the kernel updates the headers with the received lengths and flags, so reset them all
+    for (size_t i = 0; i < m_kNumSlots; i++)
+    {
+        struct msghdr &msg = m_headers[i].msg_hdr;
+        bzero(&msg, sizeof(msg));
+        msg.msg_iov = &m_iovs[i];
+        msg.msg_iovlen = 1;
+        msg.msg_control = m_ctrlBuf.get() + (i * m_kMaxControlSize);
+        msg.msg_controllen = m_kMaxControlSize;
+        m_headers[i].msg_len = 0;
+    }
+
+    return TEMP_FAILURE_RETRY(recvmmsg(sock, m_headers.data(), m_kNumSlots, flags, nullptr));
+}
+
+} // namespace firebolt::rialto::ipc
@@ -0,0 +1,74 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_RECV_MESSAGE_BATCH_H_
+#define FIREBOLT_RIALTO_IPC_RECV_MESSAGE_BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <sys/socket.h>
+
+// -----------------------------------------------------------------------------
+/*!
+    \class RecvMessageBatch
+    \brief Preallocated buffers for reading several messages from a socket with
+    a single recvmmsg() call.
+
+    Each slot holds one message of up to \a maxMessageSize bytes along with its
+    control data.  The data buffers are allocated once and not cleared, so only
+    the pages that messages are actually read into are ever touched.
+
+    The contents of a slot are valid until the next call to receive().
+*/
+
+namespace firebolt::rialto::ipc
+{
+class RecvMessageBatch
+{
+public:
+    RecvMessageBatch(size_t numSlots, size_t maxMessageSize, size_t maxControlSize);
+    ~RecvMessageBatch() = default;
+    RecvMessageBatch(const RecvMessageBatch &) = delete;
+    RecvMessageBatch &operator=(const RecvMessageBatch &) = delete;
+
+public:
+    int receive(int sock, int flags);
+
+    size_t size() const { return m_kNumSlots; }
+    const struct msghdr *header(size_t slot) const { return &m_headers[slot].msg_hdr; }
+    const uint8_t *data(size_t slot) const { return m_dataBuf.get() + (slot * m_kMaxMessageSize); }
+    size_t length(size_t slot) const { return m_headers[slot].msg_len; }
+
+private:
+    const size_t m_kNumSlots;
+    const size_t m_kMaxMessageSize;
+    const size_t m_kMaxControlSize;
+
+    std::unique_ptr<uint8_t[]> m_dataBuf;
+    std::unique_ptr<uint8_t[]> m_ctrlBuf;
+    std::vector<struct iovec> m_iovs;
+    std::vector<struct mmsghdr> m_headers;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_RECV_MESSAGE_BATCH_H_
@@ -0,0 +1,216 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SlabBufferPool.h"
+#include <cstdlib>
+#include <mutex>
+
+namespace
+{
+constexpr uint32_t kNumSizeClasses = 6;
+
+// the largest class fits a maximum size (128kb) IPC message plus its msghdr, iovec and control data
+constexpr size_t kSizeClasses[kNumSizeClasses] = {256, 1024, 4 * 1024, 16 * 1024, 64 * 1024, 136 * 1024};
+
+// number of buffers moved between a thread's free list and the depot in one go, a thread keeps at most twice this
+constexpr size_t kBatchSizes[kNumSizeClasses] = {32, 16, 8, 4, 2, 1};
+
+constexpr uint32_t kOversized = kNumSizeClasses;
+
+/**
+ * @brief Header stored in front of every buffer handed out by the pool.
+ */
+struct alignas(std::max_align_t) BlockHeader
+{
+    uint32_t sizeClass;
+    size_t bytes;
+    BlockHeader *next;
+};
+
+struct FreeList
+{
+    BlockHeader *head = nullptr;
+    size_t count = 0;
+
+    void push(BlockHeader *block)
+    {
+        block->next = head;
+        head = block;
+        ++count;
+    }
+
+    BlockHeader *pop()
+    {
+        BlockHeader *block = head;
+        head = block->next;
+        --count;
+        return block;
+    }
+
+    void moveTo(FreeList &other, size_t maxBlocks)
+    {
+        while (head && (maxBlocks-- > 0))
+        {
+            other.push(pop());
+        }
+    }
+};
+
+struct Depot
+{
+    std::mutex lock[kNumSizeClasses];
+    FreeList lists[kNumSizeClasses];
+};
+
+Depot &depot()
+{
+    // intentionally leaked, threads hand their cached buffers back to it when they exit
+    static Depot *instance = new Depot;
+    return *instance;
+}
+
+struct ThreadCache
+{
+    FreeList lists[kNumSizeClasses];
+
+    ~ThreadCache()
+    {
+        for (uint32_t sizeClass = 0; sizeClass < kNumSizeClasses; ++sizeClass)
+        {
+            std::lock_guard<std::mutex> locker(depot().lock[sizeClass]);
+            lists[sizeClass].moveTo(depot().lists[sizeClass], lists[sizeClass].count);
+        }
+    }
+};
+
+thread_local ThreadCache tThreadCache;
+
+uint32_t getSizeClass(size_t bytes)
+{
+    for (uint32_t sizeClass = 0; sizeClass < kNumSizeClasses; ++sizeClass)
+    {
+        if (bytes <= kSizeClasses[sizeClass])
+            return sizeClass;
+    }
+    return kOversized;
+}
+
+bool carveSlab(uint32_t sizeClass, FreeList &list)
+{
+    const size_t blockSize = sizeof(BlockHeader) + kSizeClasses[sizeClass];
+    auto *slab = reinterpret_cast<uint8_t *>(malloc(blockSize * kBatchSizes[sizeClass]));
+    if (!slab)
+        return false;
+
+    for (size_t i = 0; i < kBatchSizes[sizeClass]; ++i)
+    {
+        auto *block = reinterpret_cast<BlockHeader *>(slab + (i * blockSize));
+        block->sizeClass = sizeClass;
+        list.push(block);
+    }
+    return true;
+}
+} // namespace
+
+SlabBufferPool::SlabBufferPool() : m_hits(0), m_misses(0), m_bytesInUse(0), m_highWaterMark(0) {}
+
+SlabBufferPool::~SlabBufferPool() {}
+
+void *SlabBufferPool::allocateImpl(size_t bytes)
+{
+    BlockHeader *block = nullptr;
+
+    const uint32_t sizeClass = getSizeClass(bytes);
+    if (sizeClass == kOversized)
+    {
+        block = reinterpret_cast<BlockHeader *>(malloc(sizeof(BlockHeader) + bytes));
+        if (!block)
+            return nullptr;
+
+        block->sizeClass = kOversized;
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        FreeList &list = tThreadCache.lists[sizeClass];
+        if (!list.head)
+        {
+            std::lock_guard<std::mutex> locker(depot().lock[sizeClass]);
+            depot().lists[sizeClass].moveTo(list, kBatchSizes[sizeClass]);
+        }
+
+        if (list.head)
+        {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (carveSlab(sizeClass, list))
+        {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        block = list.pop();
+    }
+
+    block->bytes = bytes;
+
+    const size_t bytesInUse = m_bytesInUse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+    while ((bytesInUse > highWaterMark) &&
+           !m_highWaterMark.compare_exchange_weak(highWaterMark, bytesInUse, std::memory_order_relaxed))
+    {
+    }
+
+    return block + 1;
+}
+
+void SlabBufferPool::deallocate(void *p)
+{
+    if (!p)
+        return;
+
+    BlockHeader *block = reinterpret_cast<BlockHeader *>(p) - 1;
+    m_bytesInUse.fetch_sub(block->bytes, std::memory_order_relaxed);
+
+    const uint32_t sizeClass = block->sizeClass;
+    if (sizeClass == kOversized)
+    {
+        free(block);
+        return;
+    }
+
+    FreeList &list = tThreadCache.lists[sizeClass];
+    list.push(block);
+
+    // hand a batch back to the depot if this thread is holding more than it is likely to reuse
+    if (list.count > (2 * kBatchSizes[sizeClass]))
+    {
+        std::lock_guard<std::mutex> locker(depot().lock[sizeClass]);
+        list.moveTo(depot().lists[sizeClass], kBatchSizes[sizeClass]);
+    }
+}
+
+SlabBufferPool::Stats SlabBufferPool::getStats() const
+{
+    return Stats{m_hits.load(std::memory_order_relaxed), m_misses.load(std::memory_order_relaxed),
+                 m_bytesInUse.load(std::memory_order_relaxed), m_highWaterMark.load(std::memory_order_relaxed)};
+}
@@ -0,0 +1,83 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SLAB_BUFFER_POOL_H_
+#define SLAB_BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Buffer pool built from fixed size class slabs.
+ *
+ * Freed buffers are kept on a per-thread free list for each size class, so the common allocate / deallocate
+ * path takes no lock. Threads swap batches of buffers with a shared depot, guarded by a per size class mutex,
+ * when their own list runs empty or grows too long. Slab memory is shared by all pool instances and is never
+ * returned to the system, it is kept for reuse once the process has reached its high-water mark.
+ *
+ * Requests larger than the biggest size class, which covers a maximum size IPC message plus its headers, fall
+ * back to malloc.
+ *
+ * Each pool instance keeps its own statistics, and must outlive any buffers allocated from it.
+ */
+class SlabBufferPool
+{
+public:
+    struct Stats
+    {
+        uint64_t hits;        ///< allocations served from a free buffer
+        uint64_t misses;      ///< allocations that needed fresh memory from the system
+        size_t bytesInUse;    ///< bytes currently allocated from the pool
+        size_t highWaterMark; ///< the largest value bytesInUse has reached
+    };
+
+    SlabBufferPool();
+    ~SlabBufferPool();
+    SlabBufferPool(const SlabBufferPool &) = delete;
+    SlabBufferPool(SlabBufferPool &&) = delete;
+    SlabBufferPool &operator=(const SlabBufferPool &) = delete;
+    SlabBufferPool &operator=(SlabBufferPool &&) = delete;
+
+    template <class T = uint8_t> T *allocate(size_t count)
+    {
+        return reinterpret_cast<T *>(allocateImpl(count * sizeof(T)));
+    }
+
+    template <class T = uint8_t> std::shared_ptr<T> allocateShared(size_t count)
+    {
+        return std::shared_ptr<T>(allocate<T>(count), [this](T *p) { deallocate(p); });
+    }
+
+    void deallocate(void *p);
+
+    Stats getStats() const;
+
+private:
+    void *allocateImpl(size_t bytes);
+
+private:
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+    std::atomic<size_t> m_bytesInUse;
+    std::atomic<size_t> m_highWaterMark;
+};
+
+#endif // SLAB_BUFFER_POOL_H_
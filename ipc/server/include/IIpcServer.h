@@ -50,6 +50,18 @@ public:
     IClient &operator=(IClient &&) = delete;
 
 public:
+    /**
+     * @brief Statistics of the queue of messages waiting to be sent to the client.
+     */
+    struct SendQueueStats
+    {
+        size_t depth = 0;                /**< the number of messages currently queued */
+        size_t maxDepth = 0;             /**< the largest number of messages queued at once */
+        uint64_t numQueuedMessages = 0;  /**< messages that were queued rather than sent straight away */
+        uint64_t numCoalescedEvents = 0; /**< events replaced by a newer one while queued */
+        uint64_t numDroppedEvents = 0;   /**< coalescible events dropped because the queue was full */
+    };
+
     /**
      * @brief Gets the pid of the client that created the connection.
      *
@@ -113,6 +125,37 @@ public:
      */
     virtual bool sendEvent(const std::shared_ptr<google::protobuf::Message> &message) = 0;
 
+    /**
+     * @brief Sends a message that supersedes any earlier one of the same type and key.
+     *
+     * \threadsafe
+     *
+     * Like sendEvent(), but if an event of the same type and with the same
+     * \a coalesceKey is still waiting in the client's message queue it is
+     * replaced by this one instead of queuing both.  Use for events where only
+     * the latest value matters, such as position updates.
+     *
+     * @param[in] message      : message to send.
+     * @param[in] coalesceKey  : identifies the events that supersede each other, e.g. a session id.
+     *
+     * @retval true on success, false otherwise.
+     */
+    virtual bool sendCoalescedEvent(const std::shared_ptr<google::protobuf::Message> &message,
+                                    uint64_t coalesceKey) = 0;
+
+    /**
+     * @brief Gets the statistics of the client's send queue.
+     *
+     * \threadsafe
+     *
+     * Messages are queued while the client's socket is full.  Once the queue
+     * is full, coalescible events are dropped, any other message disconnects
+     * the client.
+     *
+     * @retval the statistics, all zero if the client has disconnected.
+     */
+    virtual SendQueueStats getSendQueueStats() const = 0;
+
     /**
      * @brief The server object.
      *
@@ -222,6 +265,12 @@ public:
      * @retval false if there was an error, true otherwise
      */
     virtual bool process() = 0;
+
+    /**
+     * @brief Wakes up a thread blocked in wait(), so that it can return to its event loop and re-check its
+     * run conditions.  Can be called from any thread.
+     */
+    virtual void wakeEventLoop() const = 0;
 };
 
 } // namespace firebolt::rialto::ipc
@@ -55,7 +55,15 @@ void ClientImpl::disconnect()
 void ClientImpl::exportService(const std::shared_ptr<google::protobuf::Service> &service)
 {
     auto descriptor = service->GetDescriptor();
-    m_services.emplace(descriptor->full_name(), service);
+    if (!m_services.emplace(descriptor->full_name(), service).second)
+        return;
+
+    const auto serviceId = static_cast<uint32_t>(m_servicesById.size());
+    m_servicesById.push_back(service);
+
+    auto server = m_kServer.lock();
+    if (server)
+        server->sendServiceIds(m_kClientId, serviceId, descriptor);
 }
 
 bool ClientImpl::sendEvent(const std::shared_ptr<google::protobuf::Message> &message)
@@ -67,6 +75,24 @@ bool ClientImpl::sendEvent(const std::shared_ptr<google::protobuf::Message> &mes
         return false;
 }
 
+bool ClientImpl::sendCoalescedEvent(const std::shared_ptr<google::protobuf::Message> &message, uint64_t coalesceKey)
+{
+    auto server = m_kServer.lock();
+    if (server)
+        return server->sendEvent(m_kClientId, message, true, coalesceKey);
+    else
+        return false;
+}
+
+IClient::SendQueueStats ClientImpl::getSendQueueStats() const
+{
+    auto server = m_kServer.lock();
+    if (server)
+        return server->getSendQueueStats(m_kClientId);
+    else
+        return SendQueueStats();
+}
+
 bool ClientImpl::isConnected() const
 {
     auto server = m_kServer.lock();
@@ -27,6 +27,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace firebolt::rialto::ipc
 {
@@ -48,6 +49,8 @@ public:
     void exportService(const std::shared_ptr<google::protobuf::Service> &service) override;
 
     bool sendEvent(const std::shared_ptr<google::protobuf::Message> &message) override;
+    bool sendCoalescedEvent(const std::shared_ptr<google::protobuf::Message> &message, uint64_t coalesceKey) override;
+    SendQueueStats getSendQueueStats() const override;
 
     bool isConnected() const override;
 
@@ -61,6 +64,9 @@ private:
     const struct ucred m_kCredentials;
 
     std::map<std::string, std::shared_ptr<google::protobuf::Service>> m_services;
+
+    // services indexed by their numeric id, which is the order they were exported in
+    std::vector<std::shared_ptr<google::protobuf::Service>> m_servicesById;
 };
 
 } // namespace firebolt::rialto::ipc
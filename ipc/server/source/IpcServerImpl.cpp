@@ -18,6 +18,7 @@
  */
 
 #include "IpcServerImpl.h"
+#include "EmbeddedMessageWriter.h"
 #include "IIpcServerFactory.h"
 #include "IpcClientImpl.h"
 #include "IpcLogging.h"
@@ -51,6 +52,8 @@
 namespace firebolt::rialto::ipc
 {
 const size_t ServerImpl::m_kMaxMessageLen = (128 * 1024);
+const size_t ServerImpl::m_kMaxSendQueueLen = 256;
+const size_t ServerImpl::m_kRecvBatchSize = 8;
 
 std::shared_ptr<IServerFactory> IServerFactory::createFactory()
 {
@@ -80,7 +83,8 @@ ServerImpl::ServerImpl(unsigned flags)
     : m_pollFd(-1), m_wakeEventFd(-1),
       m_kMonitor(flags & ServerFactory::ALLOW_MONITORING ? std::make_unique<ServerMonitor>() : nullptr),
       m_socketIdCounter(FIRST_LISTENING_SOCKET_ID),
-      m_clientIdCounter(FIRST_CLIENT_ID), m_recvDataBuf{0}, m_recvCtrlBuf{0}
+      m_clientIdCounter(FIRST_CLIENT_ID),
+      m_recvBatch(m_kRecvBatchSize, m_kMaxMessageLen, CMSG_SPACE(SCM_MAX_FD * sizeof(int)))
 {
     // create the eventfd use to wake the poll loop
     m_wakeEventFd = eventfd(0, EFD_CLOEXEC);
@@ -351,7 +355,7 @@ int ServerImpl::fd() const
 
 // -----------------------------------------------------------------------------
 /*!
-    \internal
+    \threadsafe
 
     Writes to the eventfd to wake the event loop.  Typically called when requesting
     it to shutdown or external code has requested that a client be disconnected.
@@ -446,16 +450,21 @@ bool ServerImpl::process()
     }
 
     // if we have client sockets that are condemned then we need to shut down
-    // and close them as well as remove from epoll
-    std::unique_lock<std::mutex> locker(m_clientsLock);
-    if (!m_condemnedClients.empty())
+    // and close them as well as remove from epoll, take a copy of the set so
+    // we can process without the lock held
+    std::set<uint64_t> theCondemned;
     {
-        // take a copy of the set so we can process without the lock held
-        std::set<uint64_t> theCondemned;
+        std::lock_guard<std::mutex> locker(m_condemnedClientsLock);
         m_condemnedClients.swap(theCondemned);
+    }
 
-        for (uint64_t clientId : theCondemned)
+    for (uint64_t clientId : theCondemned)
+    {
+        // remove from the list of clients
+        std::shared_ptr<ClientDetails> details;
         {
+            std::lock_guard<std::shared_timed_mutex> locker(m_clientsLock);
+
             auto it = m_clients.find(clientId);
             if (it == m_clients.end())
             {
@@ -463,45 +472,74 @@ bool ServerImpl::process()
                 continue;
             }
 
-            ClientDetails details = it->second;
-
-            // remove from the list of clients
+            details = std::move(it->second);
             m_clients.erase(it);
+        }
 
-            // drop the lock while closing the connection and removing from epoll
-            locker.unlock();
-
-            // remove the socket from epoll and close it
-            if (details.sock >= 0)
+        // remove the socket from epoll and close it, other threads may still hold
+        // the details so this is done with the send lock held
+        {
+            std::lock_guard<std::mutex> sendLocker(details->sendLock);
+            if (details->sock >= 0)
             {
-                if (epoll_ctl(m_pollFd, EPOLL_CTL_DEL, details.sock, nullptr) != 0)
+                if (epoll_ctl(m_pollFd, EPOLL_CTL_DEL, details->sock, nullptr) != 0)
                     RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to remove socket from epoll");
 
-                if (shutdown(details.sock, SHUT_RDWR) != 0)
+                if (shutdown(details->sock, SHUT_RDWR) != 0)
                     RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to shutdown socket");
-                if (close(details.sock) != 0)
+                if (close(details->sock) != 0)
                     RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close socket");
+
+                details->sock = -1;
             }
 
-            // let the installed handler know a client has disconnected
-            if (details.disconnectedCb)
-                details.disconnectedCb(details.client);
+            if (details->maxSendQueueDepth > 0)
+            {
+                RIALTO_IPC_LOG_INFO("client %" PRIu64 " send queue: max depth %zu, coalesced %" PRIu64
+                                    ", dropped %" PRIu64,
+                                    clientId, details->maxSendQueueDepth, details->numCoalescedMessages,
+                                    details->numDroppedMessages);
+            }
+            details->sendQueue.clear();
+        }
 
-            // tell any monitors that the client has disconnected
-            if (m_kMonitor)
-                m_kMonitor->clientDisconnected(clientId);
+        // let the installed handler know a client has disconnected
+        if (details->disconnectedCb)
+            details->disconnectedCb(details->client);
 
-            // ensure client object is destructed without the client lock held
-            details.client.reset();
+        // tell any monitors that the client has disconnected
+        if (m_kMonitor)
+            m_kMonitor->clientDisconnected(clientId);
 
-            // re-take the lock for the next client
-            locker.lock();
-        }
+        // drop our reference to the client object without any lock held
+        details->client.reset();
     }
 
     return true;
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \threadsafe
+
+    Returns the details of the client with \a clientId, or a nullptr if the client
+    is not (or no longer) connected.  The client lock is only held for the lookup,
+    the returned details stay valid after the client has been removed but their
+    socket is then closed.
+
+ */
+std::shared_ptr<ServerImpl::ClientDetails> ServerImpl::findClient(uint64_t clientId) const
+{
+    std::shared_lock<std::shared_timed_mutex> locker(m_clientsLock);
+
+    auto it = m_clients.find(clientId);
+    if (it == m_clients.end())
+        return nullptr;
+
+    return it->second;
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
@@ -542,20 +580,20 @@ std::shared_ptr<ClientImpl> ServerImpl::addClientSocket(int socketFd, const std:
     auto client = std::make_shared<ClientImpl>(shared_from_this(), clientId, clientCreds);
 
     // and the details for the internal list
-    ClientDetails clientDetails;
-    clientDetails.sock = socketFd;
-    clientDetails.disconnectedCb = std::move(disconnectedCb);
-    clientDetails.client = client;
+    auto clientDetails = std::make_shared<ClientDetails>();
+    clientDetails->sock = socketFd;
+    clientDetails->disconnectedCb = std::move(disconnectedCb);
+    clientDetails->client = client;
 
     // add to the set of clients
     {
-        std::lock_guard<std::mutex> locker(m_clientsLock);
-        m_clients.emplace(clientId, clientDetails);
+        std::lock_guard<std::shared_timed_mutex> locker(m_clientsLock);
+        m_clients.emplace(clientId, std::move(clientDetails));
     }
 
     if (m_kMonitor)
     {
-        m_kMonitor->clientConnected(listeningSocketPath, clientId, clientDetails.client);
+        m_kMonitor->clientConnected(listeningSocketPath, clientId, client);
     }
 
     RIALTO_IPC_LOG_INFO("new client connected - giving id %" PRIu64, clientId);
@@ -696,11 +734,8 @@ static std::vector<FileDescriptor> readMessageFds(const struct msghdr *msg, size
  */
 void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
 {
-    // take the lock while accessing the client list
-    std::unique_lock<std::mutex> locker(m_clientsLock);
-
-    auto it = m_clients.find(clientId);
-    if (it == m_clients.end())
+    const std::shared_ptr<ClientDetails> details = findClient(clientId);
+    if (!details)
     {
         // should never happen
         RIALTO_IPC_LOG_ERROR("received an event from a socket with no matching client");
@@ -708,19 +743,18 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
     }
 
     // check if the client is marked for closure, if so then just ignore the data
-    if (m_condemnedClients.count(clientId) != 0)
     {
-        return;
+        std::lock_guard<std::mutex> locker(m_condemnedClientsLock);
+        if (m_condemnedClients.count(clientId) != 0)
+            return;
     }
 
-    // get the socket that corresponds to the client connection
-    const int sockFd = it->second.sock;
+    // the socket is only closed by this thread, so it can be read without the
+    // send lock held
+    const int sockFd = details->sock;
 
     // get the client object
-    std::shared_ptr<ClientImpl> clientObj = it->second.client;
-
-    // can safely release the lock now we have the clientId and client object
-    locker.unlock();
+    std::shared_ptr<ClientImpl> clientObj = details->client;
 
     // if there was an error disconnect the socket
     if (events & EPOLLERR)
@@ -730,24 +764,21 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
         return;
     }
 
+    // flush any queued messages if the socket has room again
+    if (events & EPOLLOUT)
+    {
+        processClientWritable(*details, clientId);
+    }
+
     if (events & EPOLLIN)
     {
-        // read all messages from the client socket, we break out if the socket is closed
-        // or EWOULDBLOCK is returned on a read (ie. no more messages to read)
-        while (true)
+        // read all messages from the client socket in batches, we break out if the socket is closed,
+        // EWOULDBLOCK is returned on a read or a batch isn't full (ie. no more messages to read)
+        bool moreToRead = true;
+        while (moreToRead)
         {
-            struct msghdr msg = {nullptr};
-            struct iovec io = {.iov_base = m_recvDataBuf, .iov_len = sizeof(m_recvDataBuf)};
-
-            bzero(&msg, sizeof(msg));
-            msg.msg_iov = &io;
-            msg.msg_iovlen = 1;
-            msg.msg_control = m_recvCtrlBuf;
-            msg.msg_controllen = sizeof(m_recvCtrlBuf);
-
-            // read one message
-            ssize_t rd = TEMP_FAILURE_RETRY(recvmsg(sockFd, &msg, MSG_CMSG_CLOEXEC));
-            if (rd < 0)
+            const int numMessages = m_recvBatch.receive(sockFd, MSG_CMSG_CLOEXEC);
+            if (numMessages < 0)
             {
                 if (errno != EWOULDBLOCK)
                 {
@@ -757,33 +788,63 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
 
                 break;
             }
-            else if (rd == 0)
-            {
-                // client closed connection, and we've read all data, add to the condemned set
-                // so is cleaned up once all the events are processed
-                disconnectClient(clientId);
 
-                break;
-            }
-            else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
-            {
-                RIALTO_IPC_LOG_WARN("received message from client %" PRIu64 " truncated, discarding", clientId);
+            // the socket is level triggered, so if it wasn't drained we'll get another event
+            moreToRead = (static_cast<size_t>(numMessages) == m_recvBatch.size());
 
-                // make sure to close all the fds, otherwise we'll leak them
-                readMessageFds(&msg, 16);
+            // if more than one message was read hold back the replies and events
+            // until the batch has been processed, so they go out in one syscall,
+            // a single reply is sent straight away without going through the queue
+            const bool corked = (numMessages > 1);
+            if (corked)
+            {
+                std::lock_guard<std::mutex> locker(details->sendLock);
+                details->corked = true;
             }
-            else
+
+            for (int i = 0; i < numMessages; i++)
             {
-                // if there is control data then assume fd(s) have been passed
-                if (msg.msg_controllen > 0)
+                const struct msghdr *msg = m_recvBatch.header(i);
+                const size_t rd = m_recvBatch.length(i);
+                if (rd == 0)
+                {
+                    // client closed connection, and we've read all data, add to the condemned set
+                    // so is cleaned up once all the events are processed
+                    disconnectClient(clientId);
+
+                    moreToRead = false;
+                    break;
+                }
+                else if (msg->msg_flags & (MSG_TRUNC | MSG_CTRUNC))
                 {
-                    processClientMessage(clientObj, m_recvDataBuf, rd, readMessageFds(&msg, 16));
+                    RIALTO_IPC_LOG_WARN("received message from client %" PRIu64 " truncated, discarding", clientId);
+
+                    // make sure to close all the fds, otherwise we'll leak them
+                    readMessageFds(msg, 16);
                 }
                 else
                 {
-                    processClientMessage(clientObj, m_recvDataBuf, rd);
+                    // if there is control data then assume fd(s) have been passed
+                    if (msg->msg_controllen > 0)
+                    {
+                        processClientMessage(clientObj, m_recvBatch.data(i), rd, readMessageFds(msg, 16));
+                    }
+                    else
+                    {
+                        processClientMessage(clientObj, m_recvBatch.data(i), rd);
+                    }
+
+                    // everything parsed from the message has been released, recycle the arena memory
+                    m_recvArena.Reset();
                 }
             }
+
+            if (corked)
+            {
+                std::lock_guard<std::mutex> locker(details->sendLock);
+                details->corked = false;
+                flushSendQueue(*details, clientId);
+            }
         }
     }
 }
@@ -860,20 +921,24 @@ void ServerImpl::processClientMessage(const std::shared_ptr<ClientImpl> &client,
                          fds.size(), client->id());
 
     // parse the message
-    transport::MessageToServer message;
-    if (!message.ParseFromArray(data, static_cast<int>(dataLen)))
+    auto *message = google::protobuf::Arena::CreateMessage<transport::MessageToServer>(&m_recvArena);
+    if (!message->ParseFromArray(data, static_cast<int>(dataLen)))
     {
         RIALTO_IPC_LOG_ERROR("invalid request");
         return;
     }
 
-    if (message.has_call())
+    if (message->has_call())
     {
-        processMethodCall(client, message.call(), fds);
+        processMethodCall(client, message->call(), fds);
     }
-    else if (message.has_monitor())
+    else if (message->has_monitor())
     {
-        processMonitorRequest(client, message.monitor(), fds);
+        processMonitorRequest(client, message->monitor(), fds);
+    }
+    else if (message->has_capabilities())
+    {
+        processCapabilities(client, message->capabilities());
     }
     else
     {
@@ -891,35 +956,16 @@ void ServerImpl::processClientMessage(const std::shared_ptr<ClientImpl> &client,
 void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
                                    const std::vector<FileDescriptor> &fds)
 {
-    // try and find the service with the given name
-    const std::string &serviceName = call.service_name();
-    auto it = client->m_services.find(serviceName);
-    if (it == client->m_services.end())
-    {
-        RIALTO_IPC_LOG_ERROR("unknown service request '%s'", serviceName.c_str());
-
-        sendErrorReply(client, call.serial_id(), "Unknown service '%s'", serviceName.c_str());
-        return;
-    }
-
-    std::shared_ptr<google::protobuf::Service> service = it->second;
-
-    // try and find the method
-    const std::string &methodName = call.method_name();
-    const google::protobuf::MethodDescriptor *method = service->GetDescriptor()->FindMethodByName(methodName);
-    if (!method)
-    {
-        RIALTO_IPC_LOG_ERROR("no method with name '%s'", methodName.c_str());
-
-        sendErrorReply(client, call.serial_id(), "Unknown method '%s'", methodName.c_str());
+    std::shared_ptr<google::protobuf::Service> service;
+    const google::protobuf::MethodDescriptor *method = nullptr;
+    if (!findMethod(client, call, service, method))
         return;
-    }
 
     // check if the method is expecting a reply
     const bool noReply = method->options().HasExtension(no_reply) && method->options().GetExtension(no_reply);
 
-    // parse the request data
-    google::protobuf::Message *requestMessage = service->GetRequestPrototype(method).New();
+    // parse the request data, the request lives on the receive arena so is freed with the transport message
+    google::protobuf::Message *requestMessage = service->GetRequestPrototype(method).New(&m_recvArena);
     if (!requestMessage->ParseFromString(call.request_message()))
     {
         RIALTO_IPC_LOG_ERROR("failed to parse method from array");
@@ -931,10 +977,23 @@ void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, co
     else
     {
         if (m_kMonitor)
-            m_kMonitor->monitorCall(client->id(), call, noReply);
+        {
+            if (call.has_service_id())
+            {
+                // the monitor always reports calls by name
+                transport::MethodCall namedCall{call};
+                namedCall.set_service_name(method->service()->full_name());
+                namedCall.set_method_name(method->name());
+                m_kMonitor->monitorCall(client->id(), namedCall, noReply);
+            }
+            else
+            {
+                m_kMonitor->monitorCall(client->id(), call, noReply);
+            }
+        }
 
-        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s.%s { %s }", call.serial_id(), serviceName.c_str(),
-                             methodName.c_str(), requestMessage->ShortDebugString().c_str());
+        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s { %s }", call.serial_id(), method->full_name().c_str(),
+                             requestMessage->ShortDebugString().c_str());
 
         // create a controller (TODO: use a pool of these rather alloc new one each time)
         auto *controller = new ServerControllerImpl(client, call.serial_id());
@@ -957,8 +1016,111 @@ void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, co
                                                               responseMessage));
         }
     }
+}
 
-    delete requestMessage;
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Resolves the service and method of a call, either by the numeric ids or by
+    name. If not found an error reply is sent and false is returned.
+
+ */
+bool ServerImpl::findMethod(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
+                            std::shared_ptr<google::protobuf::Service> &service,
+                            const google::protobuf::MethodDescriptor *&method)
+{
+    if (call.has_service_id())
+    {
+        // fast path, both ids index into flat arrays
+        const uint32_t serviceId = call.service_id();
+        if (serviceId >= client->m_servicesById.size())
+        {
+            RIALTO_IPC_LOG_ERROR("unknown service id %u", serviceId);
+
+            sendErrorReply(client, call.serial_id(), "Unknown service id %u", serviceId);
+            return false;
+        }
+
+        service = client->m_servicesById[serviceId];
+
+        const google::protobuf::ServiceDescriptor *serviceDescriptor = service->GetDescriptor();
+        if (!call.has_method_id() || (call.method_id() >= static_cast<uint32_t>(serviceDescriptor->method_count())))
+        {
+            RIALTO_IPC_LOG_ERROR("no method with id %u", call.method_id());
+
+            sendErrorReply(client, call.serial_id(), "Unknown method id %u", call.method_id());
+            return false;
+        }
+
+        method = serviceDescriptor->method(static_cast<int>(call.method_id()));
+        return true;
+    }
+
+    // try and find the service with the given name
+    const std::string &serviceName = call.service_name();
+    auto it = client->m_services.find(serviceName);
+    if (it == client->m_services.end())
+    {
+        RIALTO_IPC_LOG_ERROR("unknown service request '%s'", serviceName.c_str());
+
+        sendErrorReply(client, call.serial_id(), "Unknown service '%s'", serviceName.c_str());
+        return false;
+    }
+
+    service = it->second;
+
+    // try and find the method
+    const std::string &methodName = call.method_name();
+    method = service->GetDescriptor()->FindMethodByName(methodName);
+    if (!method)
+    {
+        RIALTO_IPC_LOG_ERROR("no method with name '%s'", methodName.c_str());
+
+        sendErrorReply(client, call.serial_id(), "Unknown method '%s'", methodName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes the capabilities announced by a client on connect. If the client
+    supports numeric ids then it is sent the ids of all the services exported
+    so far, services exported later are sent as they are exported.
+
+ */
+void ServerImpl::processCapabilities(const std::shared_ptr<ClientImpl> &client,
+                                     const transport::ClientCapabilities &capabilities)
+{
+    if (!capabilities.numeric_ids())
+        return;
+
+    const std::shared_ptr<ClientDetails> details = findClient(client->id());
+    if (!details)
+        return;
+
+    std::lock_guard<std::mutex> locker(details->sendLock);
+    if (details->sock < 0)
+        return;
+
+    details->numericIds = true;
+
+    for (size_t serviceId = 0; serviceId < client->m_servicesById.size(); ++serviceId)
+    {
+        transport::MessageFromServer message;
+        transport::ServiceIds *serviceIds = message.mutable_service_ids();
+        const google::protobuf::ServiceDescriptor *descriptor = client->m_servicesById[serviceId]->GetDescriptor();
+        serviceIds->set_service_id(static_cast<uint32_t>(serviceId));
+        serviceIds->set_service_name(descriptor->full_name());
+        for (int i = 0; i < descriptor->method_count(); ++i)
+            serviceIds->add_method_names(descriptor->method(i)->name());
+
+        sendServerMessage(*details, client->id(), message);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -966,32 +1128,309 @@ void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, co
     \internal
     \threadsafe
 
-    Sends a message to the given client if still connected.
+    Sends the ids of a newly exported service to the client, if the client
+    supports numeric ids.
 
  */
-void ServerImpl::sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg)
+void ServerImpl::sendServiceIds(uint64_t clientId, uint32_t serviceId,
+                                const google::protobuf::ServiceDescriptor *descriptor)
 {
-    // now take the lock (so the socket is not closed beneath us) and send the reply
-    std::lock_guard<std::mutex> locker(m_clientsLock);
+    const std::shared_ptr<ClientDetails> details = findClient(clientId);
+    if (!details)
+        return;
 
-    auto it = m_clients.find(clientId);
-    if (it == m_clients.end())
+    std::lock_guard<std::mutex> locker(details->sendLock);
+    if ((details->sock < 0) || !details->numericIds)
+        return;
+
+    transport::MessageFromServer message;
+    transport::ServiceIds *serviceIds = message.mutable_service_ids();
+    serviceIds->set_service_id(serviceId);
+    serviceIds->set_service_name(descriptor->full_name());
+    for (int i = 0; i < descriptor->method_count(); ++i)
+        serviceIds->add_method_names(descriptor->method(i)->name());
+
+    sendServerMessage(*details, clientId, message);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Takes copies of the file descriptors attached to an outgoing message and
+    points the message at the copies.  Used for messages that are queued, as
+    the caller's fds may be closed before the message is sent.
+
+ */
+static std::vector<FileDescriptor> getMessageFds(struct msghdr *msg)
+{
+    std::vector<FileDescriptor> fds;
+
+    // FileDescriptor copies dup the fd, so reserve up front to keep the vector
+    // from copying the elements and changing their fd numbers
+    size_t numFds = 0;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg))
     {
-        RIALTO_IPC_LOG_WARN("socket removed before error reply could be sent");
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS))
+            numFds += (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    }
+    fds.reserve(numFds);
+
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+        if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_RIGHTS))
+        {
+            const size_t n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            int *fds_ = reinterpret_cast<int *>(CMSG_DATA(cmsg));
+            for (size_t i = 0; i < n; i++)
+            {
+                fds.emplace_back(fds_[i]);
+                if (!fds.back().isValid())
+                    RIALTO_IPC_LOG_ERROR("failed to dup fd of queued message");
+
+                fds_[i] = fds.back().fd();
+            }
+        }
     }
-    else if (it->second.sock < 0)
+
+    return fds;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends a small control message, with no file descriptors, to the client. The
+    caller must hold the client's send lock so the socket is not closed beneath us.
+
+ */
+bool ServerImpl::sendServerMessage(ClientDetails &details, uint64_t clientId,
+                                   const transport::MessageFromServer &message)
+{
+    const size_t dataLen = message.ByteSizeLong();
+    auto msgBuf = m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + dataLen);
+
+    auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
+    bzero(header, sizeof(msghdr));
+
+    auto *iov = reinterpret_cast<iovec *>(msgBuf.get() + sizeof(msghdr));
+    header->msg_iov = iov;
+    header->msg_iovlen = 1;
+
+    auto *data = msgBuf.get() + sizeof(msghdr) + sizeof(iovec);
+    iov->iov_base = data;
+    iov->iov_len = dataLen;
+
+    message.SerializeWithCachedSizesToArray(data);
+
+    return sendOrQueueMessage(details, clientId, std::shared_ptr<msghdr>(msgBuf, header));
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends the message on the client's socket without blocking.  If the socket's
+    buffer is full, earlier messages are still waiting or the client is corked
+    while its requests are processed, the message is added to the client's send
+    queue instead and sent with the rest of the queue.
+
+    If \a coalesceType is set and a queued message has the same type and
+    \a coalesceKey, that message is replaced rather than queuing another one.
+    A slow client must not block the threads sending to it, so when the queue
+    is full a coalescible event is dropped, as a newer one will follow.  Any
+    other message, like a reply, can't be dropped without stalling the client,
+    so the client is disconnected instead.
+
+    The caller must hold the client's send lock.
+
+ */
+bool ServerImpl::sendOrQueueMessage(ClientDetails &details, uint64_t clientId, const std::shared_ptr<msghdr> &msg,
+                                    const google::protobuf::Descriptor *coalesceType, uint64_t coalesceKey)
+{
+    if (details.sock < 0)
     {
-        RIALTO_IPC_LOG_WARN("socket closed before error reply could be sent");
+        RIALTO_IPC_LOG_WARN("socket closed before message could be sent");
+        return false;
     }
-    else if (!msg)
+
+    if (details.sendQueue.empty() && !details.corked)
     {
-        RIALTO_IPC_LOG_WARN("invalid msg to send on socket, ignoring");
+        const ssize_t wr = TEMP_FAILURE_RETRY(sendmsg(details.sock, msg.get(), MSG_NOSIGNAL | MSG_DONTWAIT));
+        if (wr == static_cast<ssize_t>(msg->msg_iov->iov_len))
+            return true;
+
+        if ((wr >= 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK)))
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete message");
+            return false;
+        }
+
+        // the socket is full, queue the message and wait for it to become writable
+        if (!setWriteNotify(details, clientId, true))
+            return false;
     }
-    else if (TEMP_FAILURE_RETRY(sendmsg(it->second.sock, msg.get(), MSG_NOSIGNAL)) !=
-             static_cast<ssize_t>(msg->msg_iov->iov_len))
+    else if (coalesceType)
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete error reply message");
+        for (QueuedMessage &queued : details.sendQueue)
+        {
+            if ((queued.coalesceType == coalesceType) && (queued.coalesceKey == coalesceKey))
+            {
+                queued.msg = msg;
+                queued.fds = getMessageFds(msg.get());
+                details.numCoalescedMessages++;
+                return true;
+            }
+        }
     }
+
+    if (details.sendQueue.size() >= m_kMaxSendQueueLen)
+    {
+        if (coalesceType)
+        {
+            details.numDroppedMessages++;
+            RIALTO_IPC_LOG_WARN("send queue of client %" PRIu64 " is full, dropping %s event", clientId,
+                                coalesceType->full_name().c_str());
+        }
+        else
+        {
+            RIALTO_IPC_LOG_ERROR("send queue of client %" PRIu64 " is full - disconnecting client", clientId);
+            disconnectClient(clientId);
+        }
+        return false;
+    }
+
+    QueuedMessage queued;
+    queued.msg = msg;
+    queued.fds = getMessageFds(msg.get());
+    queued.coalesceType = coalesceType;
+    queued.coalesceKey = coalesceKey;
+    details.sendQueue.emplace_back(std::move(queued));
+
+    details.numQueuedMessages++;
+    details.maxSendQueueDepth = std::max(details.maxSendQueueDepth, details.sendQueue.size());
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Enables or disables the EPOLLOUT notification for the client's socket, if
+    not already in that state.  The caller must hold the client's send lock.
+
+ */
+bool ServerImpl::setWriteNotify(ClientDetails &details, uint64_t clientId, bool enable)
+{
+    if (details.writeNotify == enable)
+        return true;
+
+    epoll_event event = {.events = EPOLLIN | (enable ? EPOLLOUT : 0u), .data = {.u64 = clientId}};
+    if (epoll_ctl(m_pollFd, EPOLL_CTL_MOD, details.sock, &event) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to modify client socket");
+        return false;
+    }
+
+    details.writeNotify = enable;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends as many of the queued messages as the socket will take, up to
+    16 messages per sendmmsg() call.  If the socket fills up the
+    EPOLLOUT notification is enabled to send the rest once it has drained.
+
+    The caller must hold the client's send lock.
+
+ */
+void ServerImpl::flushSendQueue(ClientDetails &details, uint64_t clientId)
+{
+    constexpr size_t kMaxBatchSize = 16;
+    struct mmsghdr headers[kMaxBatchSize];
+
+    while (!details.sendQueue.empty() && (details.sock >= 0))
+    {
+        const size_t count = std::min(details.sendQueue.size(), kMaxBatchSize);
+        for (size_t i = 0; i < count; i++)
+        {
+            headers[i].msg_hdr = *details.sendQueue[i].msg;
+            headers[i].msg_len = 0;
+        }
+
+        const int sent = TEMP_FAILURE_RETRY(sendmmsg(details.sock, headers, count, MSG_NOSIGNAL | MSG_DONTWAIT));
+        if ((sent < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+        {
+            // still full, wait for the socket to become writable
+            setWriteNotify(details, clientId, true);
+            return;
+        }
+
+        // seqpacket messages are sent whole or not at all, so anything short is an error
+        int numSent = 0;
+        while ((numSent < sent) && (headers[numSent].msg_len == details.sendQueue.front().msg->msg_iov->iov_len))
+        {
+            details.sendQueue.pop_front();
+            numSent++;
+        }
+        if ((sent <= 0) || (numSent != sent))
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send queued message - disconnecting client");
+            details.sendQueue.clear();
+            disconnectClient(clientId);
+            return;
+        }
+    }
+
+    if (details.sock >= 0)
+        setWriteNotify(details, clientId, false);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Called from the event loop when the client's socket has become writable,
+    sends as many of the queued messages as the socket will take.
+
+ */
+void ServerImpl::processClientWritable(ClientDetails &details, uint64_t clientId)
+{
+    std::lock_guard<std::mutex> locker(details.sendLock);
+    flushSendQueue(details, clientId);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \threadsafe
+
+    Sends a message to the given client if still connected.
+
+ */
+void ServerImpl::sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg)
+{
+    const std::shared_ptr<ClientDetails> details = findClient(clientId);
+    if (!details)
+    {
+        RIALTO_IPC_LOG_WARN("socket removed before error reply could be sent");
+        return;
+    }
+
+    if (!msg)
+    {
+        RIALTO_IPC_LOG_WARN("invalid msg to send on socket, ignoring");
+        return;
+    }
+
+    // now take the client's lock (so the socket is not closed beneath us) and send the reply
+    std::lock_guard<std::mutex> locker(details->sendLock);
+    sendOrQueueMessage(*details, clientId, msg);
 }
 
 // -----------------------------------------------------------------------------
@@ -1116,29 +1555,20 @@ static std::vector<int> getResponseFileDescriptors(google::protobuf::Message *re
 std::shared_ptr<msghdr> ServerImpl::populateReply(const std::shared_ptr<const ClientImpl> &client, uint64_t serialId,
                                                   google::protobuf::Message *response)
 {
-    // create the base reply
-    transport::MessageFromServer message;
-    transport::MethodCallReply *reply = message.mutable_reply();
-    if (!reply)
-    {
-        RIALTO_IPC_LOG_ERROR("failed to create mutable reply object");
-        return nullptr;
-    }
-
-    // convert the message response to a data string
-    std::string respString = response->SerializeAsString();
-
-    // wrap in a transport response and send that
-    reply->set_reply_id(serialId);
-    reply->set_reply_message(std::move(respString));
-
-    // next need to check if the response message has any file descriptors in
+    // first need to check if the response message has any file descriptors in
     // it that need to be attached
     const std::vector<int> fds = getResponseFileDescriptors(response);
     const size_t requiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
 
+    // create the base reply, the response is serialised straight into the send
+    // buffer as its reply_message field
+    transport::MethodCallReply reply;
+    reply.set_reply_id(serialId);
+    const EmbeddedMessageWriter writer(transport::MessageFromServer::kReplyFieldNumber, reply,
+                                       transport::MethodCallReply::kReplyMessageFieldNumber, *response);
+
     // calculate the size of the reply
-    const size_t requiredDataLen = message.ByteSizeLong();
+    const size_t requiredDataLen = writer.byteSize();
     if (requiredDataLen > m_kMaxMessageLen)
     {
         RIALTO_IPC_LOG_ERROR("reply exceeds maximum message limit (%zu, max %zu)", requiredDataLen, m_kMaxMessageLen);
@@ -1147,9 +1577,13 @@ std::shared_ptr<msghdr> ServerImpl::populateReply(const std::shared_ptr<const Cl
         return populateErrorReply(client, serialId, "Internal error - reply message to large");
     }
 
-    // send to any monitors
+    // send to any monitors, they need the complete reply
     if (m_kMonitor)
-        m_kMonitor->monitorReply(client->id(), *reply);
+    {
+        transport::MethodCallReply monitoredReply{reply};
+        monitoredReply.set_reply_message(response->SerializeAsString());
+        m_kMonitor->monitorReply(client->id(), monitoredReply);
+    }
 
     // build the socket message to send
     auto msgBuf =
@@ -1171,7 +1605,7 @@ std::shared_ptr<msghdr> ServerImpl::populateReply(const std::shared_ptr<const Cl
     iov->iov_len = requiredDataLen;
 
     // copy in the data
-    message.SerializeWithCachedSizesToArray(data);
+    writer.serializeToArray(data);
 
     // add the fds
     if (!fds.empty())
@@ -1261,10 +1695,36 @@ std::shared_ptr<msghdr> ServerImpl::populateErrorReply(const std::shared_ptr<con
  */
 bool ServerImpl::isClientConnected(uint64_t clientId) const
 {
-    std::unique_lock<std::mutex> locker(m_clientsLock);
+    std::shared_lock<std::shared_timed_mutex> locker(m_clientsLock);
     return (m_clients.count(clientId) > 0);
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \threadsafe
+
+    Returns the statistics of the send queue of the client with \a clientId,
+    or all zero if the client is not connected.
+
+ */
+IClient::SendQueueStats ServerImpl::getSendQueueStats(uint64_t clientId) const
+{
+    IClient::SendQueueStats stats;
+
+    const std::shared_ptr<ClientDetails> details = findClient(clientId);
+    if (details)
+    {
+        std::lock_guard<std::mutex> locker(details->sendLock);
+        stats.depth = details->sendQueue.size();
+        stats.maxDepth = details->maxSendQueueDepth;
+        stats.numQueuedMessages = details->numQueuedMessages;
+        stats.numCoalescedEvents = details->numCoalescedMessages;
+        stats.numDroppedEvents = details->numDroppedMessages;
+    }
+
+    return stats;
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \threadsafe
@@ -1276,7 +1736,7 @@ bool ServerImpl::isClientConnected(uint64_t clientId) const
  */
 void ServerImpl::disconnectClient(uint64_t clientId)
 {
-    std::unique_lock<std::mutex> locker(m_clientsLock);
+    std::unique_lock<std::mutex> locker(m_condemnedClientsLock);
     m_condemnedClients.insert(clientId);
     locker.unlock();
 
@@ -1291,34 +1751,55 @@ void ServerImpl::disconnectClient(uint64_t clientId)
 
     This may be called from any thread, or from within the rpc message handler.
 
-    The \a clientId is the client to send the event to.
+    The \a clientId is the client to send the event to.  If \a isCoalesced is
+    set the event replaces any queued event of the same type and \a coalesceKey.
 
  */
-bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &eventMessage)
+bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &eventMessage,
+                           bool isCoalesced, uint64_t coalesceKey)
 {
     // gets the file descriptors from the event message
     const std::vector<int> fds = getResponseFileDescriptors(eventMessage.get());
     const size_t requiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
 
-    // create the base reply
-    transport::MessageFromServer message;
-    transport::EventFromServer *event = message.mutable_event();
-    if (!event)
+    // create the base event, the event message is serialised straight into the
+    // send buffer as its message field
+    transport::EventFromServer event;
+
+    // clients that support numeric ids get the event id instead of the type name
+    const std::shared_ptr<ClientDetails> details = findClient(clientId);
+    if (!details)
     {
-        RIALTO_IPC_LOG_ERROR("failed to create mutable event object");
+        RIALTO_IPC_LOG_WARN("socket closed before event could be sent");
         return false;
     }
 
-    event->set_event_name(eventMessage->GetTypeName());
+    bool useEventId = false;
+    uint32_t eventId = 0;
+    {
+        std::lock_guard<std::mutex> locker(details->sendLock);
+
+        if (details->numericIds)
+        {
+            auto result = details->eventIds.emplace(eventMessage->GetDescriptor(),
+                                                    static_cast<uint32_t>(details->eventIds.size()));
+            eventId = result.first->second;
+            if (result.second)
+                details->eventIdsAnnounced.push_back(false);
+            useEventId = true;
+        }
+    }
 
-    // convert the event to a data string
-    std::string respString = eventMessage->SerializeAsString();
+    if (useEventId)
+        event.set_event_id(eventId);
+    else
+        event.set_event_name(eventMessage->GetTypeName());
 
-    // wrap in a transport response and send that
-    event->set_message(std::move(respString));
+    const EmbeddedMessageWriter writer(transport::MessageFromServer::kEventFieldNumber, event,
+                                       transport::EventFromServer::kMessageFieldNumber, *eventMessage);
 
     // check the reply will fit
-    size_t requiredDataLen = message.ByteSizeLong();
+    size_t requiredDataLen = writer.byteSize();
     if (requiredDataLen > m_kMaxMessageLen)
     {
         RIALTO_IPC_LOG_ERROR("event message to big to fit in buffer (size %zu, max size %zu)", requiredDataLen,
@@ -1346,7 +1827,7 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
     iov->iov_len = requiredDataLen;
 
     // copy in the data
-    message.SerializeWithCachedSizesToArray(data);
+    writer.serializeToArray(data);
 
     // add the fds
     if (!fds.empty())
@@ -1365,25 +1846,38 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
         header->msg_controllen = cmsg->cmsg_len;
     }
 
-    // finally, take the lock (so the socket is not closed beneath us) and send the reply
-    std::unique_lock<std::mutex> locker(m_clientsLock);
+    // finally, take the client's lock (so the socket is not closed beneath us) and send the reply
+    std::unique_lock<std::mutex> locker(details->sendLock);
 
-    auto it = m_clients.find(clientId);
-    if (it->second.sock < 0)
+    if (useEventId && !details->eventIdsAnnounced[eventId])
     {
-        RIALTO_IPC_LOG_WARN("socket closed before event could be sent");
-        return false;
+        // first use of the id, tell the client which event it stands for
+        transport::MessageFromServer idMessage;
+        transport::EventId *eventIdMessage = idMessage.mutable_event_id();
+        eventIdMessage->set_event_id(eventId);
+        eventIdMessage->set_event_name(eventMessage->GetTypeName());
+        if (!sendServerMessage(*details, clientId, idMessage))
+            return false;
+        details->eventIdsAnnounced[eventId] = true;
     }
-    else if (TEMP_FAILURE_RETRY(sendmsg(it->second.sock, header, MSG_NOSIGNAL)) != static_cast<ssize_t>(requiredDataLen))
+
+    if (!sendOrQueueMessage(*details, clientId, std::shared_ptr<msghdr>(msgBuf, header),
+                            isCoalesced ? eventMessage->GetDescriptor() : nullptr, coalesceKey))
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete event message");
         return false;
     }
 
     locker.unlock();
 
     if (m_kMonitor)
-        m_kMonitor->monitorEvent(clientId, *event);
+    {
+        // the monitor always reports events by name, and needs the complete event
+        transport::EventFromServer monitoredEvent{event};
+        if (useEventId)
+            monitoredEvent.set_event_name(eventMessage->GetTypeName());
+        monitoredEvent.set_message(eventMessage->SerializeAsString());
+        m_kMonitor->monitorEvent(clientId, monitoredEvent);
+    }
 
     RIALTO_IPC_LOG_DEBUG("event{ %s } - { %s }", eventMessage->GetTypeName().c_str(),
                          eventMessage->ShortDebugString().c_str());
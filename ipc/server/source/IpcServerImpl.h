@@ -25,18 +25,23 @@
 #include "IIpcServerFactory.h"
 #include "IpcServerControllerImpl.h"
 #include "IpcServerMonitor.h"
-#include "SimpleBufferPool.h"
+#include "RecvMessageBatch.h"
+#include "SlabBufferPool.h"
 
 #include "rialtoipc-transport.pb.h"
+#include <google/protobuf/arena.h>
 
 #include <sys/socket.h>
 
 #include <atomic>
+#include <cstddef>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -74,11 +79,15 @@ public:
     int fd() const override;
     bool wait(int timeoutMSecs) override;
     bool process() override;
+    void wakeEventLoop() const override;
 
 protected:
     friend class ClientImpl;
-    bool sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &message);
+    bool sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &message,
+                   bool isCoalesced = false, uint64_t coalesceKey = 0);
+    void sendServiceIds(uint64_t clientId, uint32_t serviceId, const google::protobuf::ServiceDescriptor *descriptor);
     bool isClientConnected(uint64_t clientId) const;
+    IClient::SendQueueStats getSendQueueStats(uint64_t clientId) const;
     void disconnectClient(uint64_t clientId);
 
 private:
@@ -86,8 +95,6 @@ private:
     static bool getSocketLock(Socket *socket);
     static void closeListeningSocket(Socket *socket);
 
-    void wakeEventLoop() const;
-
     void processNewConnection(uint64_t socketId);
 
     void processClientSocket(uint64_t clientId, unsigned events);
@@ -97,6 +104,13 @@ private:
     void processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
                            const std::vector<FileDescriptor> &fds);
 
+    bool findMethod(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
+                    std::shared_ptr<google::protobuf::Service> &service,
+                    const google::protobuf::MethodDescriptor *&method);
+
+    void processCapabilities(const std::shared_ptr<ClientImpl> &client,
+                             const transport::ClientCapabilities &capabilities);
+
     void processMonitorRequest(const std::shared_ptr<ClientImpl> &client,
                                const transport::RegisterMonitor &registerMonitor, const std::vector<FileDescriptor> &fds);
 
@@ -117,6 +131,8 @@ private:
 
 private:
     static const size_t m_kMaxMessageLen;
+    static const size_t m_kMaxSendQueueLen;
+    static const size_t m_kRecvBatchSize;
 
     int m_pollFd;
     int m_wakeEventFd;
@@ -139,22 +155,74 @@ private:
     std::mutex m_socketsLock;
     std::map<uint64_t, Socket> m_sockets;
 
+    struct QueuedMessage
+    {
+        std::shared_ptr<msghdr> msg;
+
+        // copies of the fds attached to the message, so they stay open until it is sent
+        std::vector<FileDescriptor> fds;
+
+        // set for events that may be replaced by a newer event of the same type and key
+        const google::protobuf::Descriptor *coalesceType = nullptr;
+        uint64_t coalesceKey = 0;
+    };
+
     struct ClientDetails
     {
+        // serialises writes to the socket and guards the fields below, the socket
+        // is closed with the lock held so it is never written after being closed
+        std::mutex sendLock;
         int sock = -1;
+
+        // set once the client announced it understands numeric service, method and event ids
+        bool numericIds = false;
+
+        // ids of the event types sent to the client, and whether the EventId message has been sent for each id
+        std::map<const google::protobuf::Descriptor *, uint32_t> eventIds;
+        std::vector<bool> eventIdsAnnounced;
+
+        // messages waiting to be sent, oldest first, the socket is polled for
+        // EPOLLOUT while the queue can't be flushed because the socket is full
+        std::deque<QueuedMessage> sendQueue;
+        bool writeNotify = false;
+
+        // set while the event loop processes a batch of more than one message from
+        // the client, anything sent meanwhile is queued and flushed together at the end
+        bool corked = false;
+
+        size_t maxSendQueueDepth = 0;
+        uint64_t numQueuedMessages = 0;
+        uint64_t numCoalescedMessages = 0;
+        uint64_t numDroppedMessages = 0;
+
         std::shared_ptr<ClientImpl> client;
         std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb;
     };
 
-    mutable std::mutex m_clientsLock;
+    std::shared_ptr<ClientDetails> findClient(uint64_t clientId) const;
+
+    bool sendServerMessage(ClientDetails &details, uint64_t clientId, const transport::MessageFromServer &message);
+    bool sendOrQueueMessage(ClientDetails &details, uint64_t clientId, const std::shared_ptr<msghdr> &msg,
+                            const google::protobuf::Descriptor *coalesceType = nullptr, uint64_t coalesceKey = 0);
+    bool setWriteNotify(ClientDetails &details, uint64_t clientId, bool enable);
+    void flushSendQueue(ClientDetails &details, uint64_t clientId);
+    void processClientWritable(ClientDetails &details, uint64_t clientId);
 
-    std::map<uint64_t, ClientDetails> m_clients;
+    // the client map is only modified by the event loop when clients connect
+    // or disconnect, all other accesses are lookups so take the lock shared
+    mutable std::shared_timed_mutex m_clientsLock;
+    std::map<uint64_t, std::shared_ptr<ClientDetails>> m_clients;
+
+    std::mutex m_condemnedClientsLock;
     std::set<uint64_t> m_condemnedClients;
 
-    uint8_t m_recvDataBuf[128 * 1024];
-    uint8_t m_recvCtrlBuf[SCM_MAX_FD * sizeof(int)];
+    RecvMessageBatch m_recvBatch;
+
+    // arena for the messages parsed from m_recvBatch, reset after each message so its initial block is reused
+    alignas(std::max_align_t) char m_recvArenaBlock[4 * 1024];
+    google::protobuf::Arena m_recvArena{m_recvArenaBlock, sizeof(m_recvArenaBlock)};
 
-    SimpleBufferPool m_sendBufPool;
+    SlabBufferPool m_sendBufPool;
 };
 
 } // namespace firebolt::rialto::ipc
@@ -22,7 +22,7 @@
 
 #include "FileDescriptor.h"
 #include "IIpcServer.h"
-#include "SimpleBufferPool.h"
+#include "SlabBufferPool.h"
 
 #include "rialtoipc-transport.pb.h"
 
@@ -61,7 +61,7 @@ private:
     std::list<FileDescriptor> m_monitorSockets;
     std::map<uint64_t, transport::ClientDetails> m_clientDetails;
 
-    SimpleBufferPool m_bufferPool;
+    SlabBufferPool m_bufferPool;
 };
 
 } // namespace firebolt::rialto::ipc
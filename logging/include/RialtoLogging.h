@@ -70,54 +70,106 @@ extern "C"
                                    const char *file, const char *func, int line, const char *fmt, ...)
         __attribute__((format(printf, 7, 8)));
 
+    /**
+     * Returns non-zero if the level is enabled for the component, used by the logging macros to skip evaluating
+     * the arguments of disabled log calls
+     */
+    extern int rialtoLogIsLevelEnabled(enum RIALTO_COMPONENT component, enum RIALTO_DEBUG_LEVEL level);
+
 /**
- * Macros to be used for logging
+ * Macros to be used for logging. The arguments are only evaluated when the level is enabled for the component.
  */
 #define RIALTO_LOG_FATAL(component, fmt, args...)                                                                      \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);           \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_FATAL))                                              \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_SYS_FATAL(component, err, fmt, args...)                                                             \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);   \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_FATAL))                                              \
+        {                                                                                                              \
+            rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_FATAL, __FILE__, __FUNCTION__, __LINE__,             \
+                               fmt, ##args);                                                                           \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_ERROR(component, fmt, args...)                                                                      \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);           \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_ERROR))                                              \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_SYS_ERROR(component, err, fmt, args...)                                                             \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);   \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_ERROR))                                              \
+        {                                                                                                              \
+            rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_ERROR, __FILE__, __FUNCTION__, __LINE__,             \
+                               fmt, ##args);                                                                           \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_WARN(component, fmt, args...)                                                                       \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);         \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_WARNING))                                            \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);     \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_SYS_WARN(component, err, fmt, args...)                                                              \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__, fmt, ##args); \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_WARNING))                                            \
+        {                                                                                                              \
+            rialtoLogSysPrintf(component, err, RIALTO_DEBUG_LEVEL_WARNING, __FILE__, __FUNCTION__, __LINE__,           \
+                               fmt, ##args);                                                                           \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_MIL(component, fmt, args...)                                                                        \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_MILESTONE, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_MILESTONE))                                          \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_MILESTONE, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);   \
+        }                                                                                                              \
     } while (false)
 #define RIALTO_LOG_INFO(component, fmt, args...)                                                                       \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_INFO, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);            \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_INFO))                                               \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_INFO, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);        \
+        }                                                                                                              \
     } while (false)
+
+/**
+ * Defining RIALTO_LOG_DISABLE_DEBUG compiles out the DEBUG call sites. The call is kept in dead code, so that the
+ * format is still checked and the arguments still count as used.
+ */
+#ifdef RIALTO_LOG_DISABLE_DEBUG
 #define RIALTO_LOG_DEBUG(component, fmt, args...)                                                                      \
     do                                                                                                                 \
     {                                                                                                                  \
-        rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_DEBUG, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);           \
+        if (false)                                                                                                     \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_DEBUG, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        }                                                                                                              \
     } while (false)
+#else
+#define RIALTO_LOG_DEBUG(component, fmt, args...)                                                                      \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (rialtoLogIsLevelEnabled(component, RIALTO_DEBUG_LEVEL_DEBUG))                                              \
+        {                                                                                                              \
+            rialtoLogPrintf(component, RIALTO_DEBUG_LEVEL_DEBUG, __FILE__, __FUNCTION__, __LINE__, fmt, ##args);       \
+        }                                                                                                              \
+    } while (false)
+#endif
 
 #ifdef __cplusplus
 }
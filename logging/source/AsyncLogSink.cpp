@@ -0,0 +1,239 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncLogSink.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+
+namespace
+{
+/**
+ * @brief Source of the unique sink ids.
+ */
+std::atomic<uint64_t> g_nextSinkId{1};
+} // namespace
+
+namespace firebolt::rialto::logging
+{
+AsyncLogSink::AsyncLogSink(LogWriter writer, size_t ringCapacity)
+    : m_sinkId{g_nextSinkId++}, m_writer{std::move(writer)}, m_ringCapacity{std::max<size_t>(ringCapacity, 1)},
+      m_isRunning{true}, m_droppedCount{0}, m_pendingRecords{0}, m_isSinkWaiting{false},
+      m_wakeFd{eventfd(0, EFD_CLOEXEC)}
+{
+    if (m_wakeFd < 0)
+        throw std::system_error(errno, std::generic_category(), "Failed to create the log sink eventfd");
+    m_thread = std::thread(&AsyncLogSink::sinkThreadLoop, this);
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+    stop();
+    close(m_wakeFd);
+}
+
+bool AsyncLogSink::push(RIALTO_DEBUG_LEVEL level, pid_t threadId, const timespec &timestamp, const char *file,
+                        int line, const char *function, const char *message, size_t messageLen)
+{
+    if (!m_isRunning.load(std::memory_order_relaxed))
+        return false;
+
+    RingBuffer &ring = getThreadRing(threadId);
+    const size_t tail = ring.tail.load(std::memory_order_relaxed);
+    if (tail - ring.head.load(std::memory_order_acquire) >= m_ringCapacity)
+    {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        notifyPendingRecord();
+        return true;
+    }
+
+    LogRecord &record = ring.records[tail % m_ringCapacity];
+    record.level = level;
+    record.threadId = threadId;
+    record.timestamp = timestamp;
+    record.file = file;
+    record.function = function;
+    record.line = line;
+    record.messageLen = std::min(messageLen, sizeof(record.message) - 1);
+    memcpy(record.message, message, record.messageLen);
+    record.message[record.messageLen] = '\0';
+    ring.tail.store(tail + 1, std::memory_order_release);
+    notifyPendingRecord();
+
+    // The sink may have stopped after the check above and after its final drain, so the record would never be
+    // written. The fence pairs with the one before the final drain: either the sink sees the record or we see it
+    // stopped.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_isRunning.load(std::memory_order_relaxed))
+    {
+        // Wait for the sink thread to finish, then this thread is the only reader of its own ring
+        std::unique_lock<std::mutex> lock(m_stopMutex);
+        size_t head = ring.head.load(std::memory_order_relaxed);
+        while (head != ring.tail.load(std::memory_order_relaxed))
+        {
+            m_writer(ring.records[head % m_ringCapacity]);
+            ring.head.store(++head, std::memory_order_release);
+        }
+    }
+    return true;
+}
+
+void AsyncLogSink::stop()
+{
+    std::unique_lock<std::mutex> stopLock(m_stopMutex);
+    m_isRunning = false;
+    wakeSinkThread();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+void AsyncLogSink::notifyPendingRecord()
+{
+    // The sink thread keeps draining until the count drops to zero, so only a blocked sink thread needs a wake up,
+    // and only once. The count and the flag are sequentially consistent, so either the sink thread sees this record
+    // before it blocks, or this thread sees the flag set. The plain load keeps the busy case free of writes to it.
+    m_pendingRecords.fetch_add(1);
+    if (m_isSinkWaiting.load() && m_isSinkWaiting.exchange(false))
+        wakeSinkThread();
+}
+
+void AsyncLogSink::wakeSinkThread()
+{
+    const uint64_t kWakeUp{1};
+    while (write(m_wakeFd, &kWakeUp, sizeof(kWakeUp)) < 0 && EINTR == errno)
+    {
+    }
+}
+
+uint64_t AsyncLogSink::getDroppedCount() const
+{
+    return m_droppedCount;
+}
+
+AsyncLogSink::RingBuffer &AsyncLogSink::getThreadRing(pid_t threadId)
+{
+    struct ThreadRing
+    {
+        ~ThreadRing()
+        {
+            if (ring)
+                ring->isOwnerAlive = false;
+        }
+
+        uint64_t sinkId{0};
+        std::shared_ptr<RingBuffer> ring;
+    };
+    static thread_local ThreadRing t_threadRing;
+
+    if (t_threadRing.sinkId != m_sinkId)
+    {
+        if (t_threadRing.ring)
+            t_threadRing.ring->isOwnerAlive = false;
+
+        t_threadRing.ring = std::make_shared<RingBuffer>(m_ringCapacity);
+        t_threadRing.ring->threadId = threadId;
+        t_threadRing.sinkId = m_sinkId;
+
+        std::unique_lock<std::mutex> lock(m_ringsMutex);
+        m_rings.push_back(t_threadRing.ring);
+    }
+    return *t_threadRing.ring;
+}
+
+void AsyncLogSink::sinkThreadLoop()
+{
+    while (m_isRunning)
+    {
+        drain();
+
+        // Announce the wait before the last check, a record pushed after it wakes the thread up. A wake up racing
+        // with the check is left in the eventfd, and only makes the next wait return straight away.
+        m_isSinkWaiting = true;
+        if (m_pendingRecords > 0 || !m_isRunning)
+        {
+            m_isSinkWaiting = false;
+            continue;
+        }
+        uint64_t numWakeUps{0};
+        while (read(m_wakeFd, &numWakeUps, sizeof(numWakeUps)) < 0 && EINTR == errno)
+        {
+        }
+        m_isSinkWaiting = false;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    drain();
+}
+
+void AsyncLogSink::drain()
+{
+    std::vector<std::shared_ptr<RingBuffer>> rings;
+    {
+        std::unique_lock<std::mutex> lock(m_ringsMutex);
+        rings = m_rings;
+    }
+
+    int64_t numConsumed{0};
+    for (const auto &ring : rings)
+    {
+        const uint64_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            m_droppedCount += dropped;
+
+            LogRecord record{};
+            record.level = RIALTO_DEBUG_LEVEL_WARNING;
+            record.threadId = ring->threadId;
+            clock_gettime(CLOCK_MONOTONIC, &record.timestamp);
+            int len = snprintf(record.message, sizeof(record.message), "Log ring full, dropped %" PRIu64 " messages",
+                               dropped);
+            record.messageLen = std::min(static_cast<size_t>(std::max(len, 0)), sizeof(record.message) - 1);
+            m_writer(record);
+            numConsumed += dropped;
+        }
+
+        size_t head = ring->head.load(std::memory_order_relaxed);
+        const size_t tail = ring->tail.load(std::memory_order_acquire);
+        while (head != tail)
+        {
+            m_writer(ring->records[head % m_ringCapacity]);
+            ring->head.store(++head, std::memory_order_release);
+            ++numConsumed;
+        }
+    }
+    m_pendingRecords -= numConsumed;
+
+    // Release the rings of the threads that are gone, once everything they logged has been written
+    std::unique_lock<std::mutex> lock(m_ringsMutex);
+    m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                 [](const std::shared_ptr<RingBuffer> &ring)
+                                 {
+                                     return !ring->isOwnerAlive &&
+                                            ring->head.load(std::memory_order_relaxed) ==
+                                                ring->tail.load(std::memory_order_acquire) &&
+                                            ring->dropped.load(std::memory_order_relaxed) == 0;
+                                 }),
+                  m_rings.end());
+}
+} // namespace firebolt::rialto::logging
@@ -0,0 +1,222 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_LOGGING_ASYNC_LOG_SINK_H_
+#define FIREBOLT_RIALTO_LOGGING_ASYNC_LOG_SINK_H_
+#ifdef __cplusplus
+
+#include "RialtoLogging.h"
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+namespace firebolt::rialto::logging
+{
+/**
+ * @brief A log message captured on the logging thread, formatted and written later by the sink thread.
+ */
+struct LogRecord
+{
+    RIALTO_DEBUG_LEVEL level; /**< The level of the message. */
+    pid_t threadId;           /**< The id of the thread that logged the message. */
+    timespec timestamp;       /**< CLOCK_MONOTONIC time of the log call. */
+    const char *file;         /**< The file name, points to a string literal. */
+    const char *function;     /**< The function name, points to a string literal. */
+    int line;                 /**< The line number. */
+    size_t messageLen;        /**< The length of the message, without the terminating null. */
+    char message[256];        /**< The null terminated message. */
+};
+
+/**
+ * @brief Asynchronous log backend.
+ *
+ * Each logging thread owns a single producer, single consumer ring of records, so pushing a message never takes a
+ * lock and never blocks. When a ring is full the message is dropped and counted. A single sink thread drains the
+ * rings, formats the records and hands them to the writer.
+ */
+class AsyncLogSink
+{
+public:
+    using LogWriter = std::function<void(const LogRecord &record)>;
+
+    /**
+     * @brief The constructor. Starts the sink thread.
+     *
+     * @throws std::system_error if the wake up eventfd can't be created.
+     *
+     * @param[in] writer       : Writes a record to the final log destination, called on the sink thread.
+     * @param[in] ringCapacity : The number of records each per-thread ring can hold.
+     */
+    AsyncLogSink(LogWriter writer, size_t ringCapacity);
+
+    /**
+     * @brief The destructor. Writes the pending records and stops the sink thread.
+     */
+    ~AsyncLogSink();
+
+    AsyncLogSink(const AsyncLogSink &) = delete;
+    AsyncLogSink(AsyncLogSink &&) = delete;
+    AsyncLogSink &operator=(const AsyncLogSink &) = delete;
+    AsyncLogSink &operator=(AsyncLogSink &&) = delete;
+
+    /**
+     * @brief Queues a message on the ring of the calling thread.
+     *
+     * @param[in] level      : The level of the message.
+     * @param[in] threadId   : The id of the calling thread.
+     * @param[in] timestamp  : The time of the log call.
+     * @param[in] file       : The file name, must outlive the sink.
+     * @param[in] line       : The line number.
+     * @param[in] function   : The function name, must outlive the sink.
+     * @param[in] message    : The formatted message.
+     * @param[in] messageLen : The length of the message.
+     *
+     * @retval false if the sink is stopped and the caller should write the message itself, true otherwise, including
+     *         when the message was dropped because the ring was full.
+     */
+    bool push(RIALTO_DEBUG_LEVEL level, pid_t threadId, const timespec &timestamp, const char *file, int line,
+              const char *function, const char *message, size_t messageLen);
+
+    /**
+     * @brief Writes the pending records and stops the sink thread. Subsequent pushes are rejected.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the number of messages dropped so far because of a full ring.
+     *
+     * @retval the number of dropped messages reported by the sink thread.
+     */
+    uint64_t getDroppedCount() const;
+
+private:
+    /**
+     * @brief Single producer, single consumer ring of log records.
+     */
+    struct RingBuffer
+    {
+        explicit RingBuffer(size_t capacity) : records(capacity) {}
+
+        std::vector<LogRecord> records;       /**< The record storage. */
+        std::atomic<size_t> head{0};          /**< Index of the next record to read, written by the sink thread. */
+        std::atomic<size_t> tail{0};          /**< Index of the next record to write, written by the owner thread. */
+        std::atomic<uint64_t> dropped{0};     /**< Messages dropped since the sink thread last checked. */
+        std::atomic<bool> isOwnerAlive{true}; /**< Cleared when the owner thread exits or moves to another sink. */
+        pid_t threadId{0};                    /**< The id of the owner thread. */
+    };
+
+    /**
+     * @brief Gets the ring of the calling thread, creating and registering it on first use.
+     *
+     * @retval the ring of the calling thread.
+     */
+    RingBuffer &getThreadRing(pid_t threadId);
+
+    /**
+     * @brief Counts a pushed or dropped record and wakes up the sink thread, if it is waiting.
+     */
+    void notifyPendingRecord();
+
+    /**
+     * @brief Wakes up the sink thread blocked on m_wakeFd.
+     */
+    void wakeSinkThread();
+
+    /**
+     * @brief The sink thread loop.
+     */
+    void sinkThreadLoop();
+
+    /**
+     * @brief Writes all the records currently queued in the rings and releases rings of exited threads.
+     */
+    void drain();
+
+    /**
+     * @brief Unique id of this sink, used to tell apart the per-thread rings of successive sinks.
+     */
+    const uint64_t m_sinkId;
+
+    /**
+     * @brief Writes the records to the final log destination.
+     */
+    const LogWriter m_writer;
+
+    /**
+     * @brief The number of records each ring can hold.
+     */
+    const size_t m_ringCapacity;
+
+    /**
+     * @brief Whether the sink accepts new messages.
+     */
+    std::atomic<bool> m_isRunning;
+
+    /**
+     * @brief The number of dropped messages reported so far.
+     */
+    std::atomic<uint64_t> m_droppedCount;
+
+    /**
+     * @brief The number of pushed and dropped records not yet handled by the sink thread. It may go below zero for a
+     *        moment, when the sink thread writes a record before its producer counts it.
+     */
+    std::atomic<int64_t> m_pendingRecords;
+
+    /**
+     * @brief Held while the sink thread is stopped. A thread that pushed a record after the final drain waits on it,
+     *        before writing the record itself.
+     */
+    std::mutex m_stopMutex;
+
+    /**
+     * @brief Protects m_rings. Taken by a logging thread only when it registers its ring.
+     */
+    std::mutex m_ringsMutex;
+
+    /**
+     * @brief The registered rings. The owner thread holds a second reference until it exits.
+     */
+    std::vector<std::shared_ptr<RingBuffer>> m_rings;
+
+    /**
+     * @brief Set by the sink thread before it blocks on m_wakeFd, and cleared by the producer that wakes it up.
+     */
+    std::atomic<bool> m_isSinkWaiting;
+
+    /**
+     * @brief The eventfd the sink thread blocks on, while there are no pending records.
+     */
+    int m_wakeFd;
+
+    /**
+     * @brief The sink thread.
+     */
+    std::thread m_thread;
+};
+} // namespace firebolt::rialto::logging
+
+#endif // defined(__cplusplus)
+#endif // FIREBOLT_RIALTO_LOGGING_ASYNC_LOG_SINK_H_
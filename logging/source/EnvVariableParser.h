@@ -38,14 +38,17 @@ public:
 
     RIALTO_DEBUG_LEVEL getLevel(const RIALTO_COMPONENT &component) const;
     bool isConsoleLoggingEnabled() const;
+    bool isAsyncLoggingEnabled() const;
 
 private:
     void configureRialtoDebug();
     void configureRialtoConsoleLog();
+    void configureRialtoAsyncLog();
 
 private:
     std::map<RIALTO_COMPONENT, RIALTO_DEBUG_LEVEL> m_debugLevels;
     bool m_logToConsole;
+    bool m_logAsync;
 };
 } // namespace firebolt::rialto::logging
 
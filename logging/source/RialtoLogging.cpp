@@ -18,12 +18,15 @@
  */
 
 #include "RialtoLogging.h"
+#include "AsyncLogSink.h"
 #include "EnvVariableParser.h"
 #include <atomic>
 #include <cstdarg>
+#include <cstdlib>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <exception>
 #include <sys/syscall.h>
 #include <sys/uio.h>
 #include <syslog.h>
@@ -49,13 +52,27 @@ static void journaldLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int l
 static firebolt::rialto::logging::LogHandler g_logHandler[RIALTO_COMPONENT_LAST] = {};
 
 /**
- * Console logging function for the library.
+ * Number of records each thread can queue on the asynchronous sink before messages get dropped.
  */
-static void consoleLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
-                              const char *message, size_t messageLen)
+static constexpr size_t kAsyncLogRingCapacity{512};
+
+/**
+ * Returns the id of the calling thread.
+ */
+static pid_t getThreadId()
+{
+    static thread_local pid_t threadId = 0;
+    if (threadId <= 0)
+        threadId = syscall(SYS_gettid);
+    return threadId;
+}
+
+/**
+ * Writes a log line to the console.
+ */
+static void writeConsoleLog(RIALTO_DEBUG_LEVEL level, const timespec &ts, pid_t threadId, const char *file, int line,
+                            const char *function, const char *message, size_t messageLen)
 {
-    timespec ts = {0, 0};
-    clock_gettime(CLOCK_MONOTONIC, &ts);
     struct iovec iov[5];
     char tbuf[32];
 
@@ -95,9 +112,6 @@ static void consoleLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int li
         break;
     }
 
-    static thread_local pid_t threadId = 0;
-    if (threadId <= 0)
-        threadId = syscall(SYS_gettid);
     char fbuf[180];
     iov[2].iov_base = reinterpret_cast<void *>(fbuf);
     if (!file || !function || (line <= 0))
@@ -115,14 +129,11 @@ static void consoleLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int li
 }
 
 /**
- * Journald logging function for the library.
+ * Writes a log line to journald.
  */
-static void journaldLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
-                               const char *message, size_t messageLen)
+static void writeJournaldLog(RIALTO_DEBUG_LEVEL level, pid_t threadId, const char *file, int line,
+                             const char *function, const char *message)
 {
-    static thread_local pid_t threadId = 0;
-    if (threadId <= 0)
-        threadId = syscall(SYS_gettid);
     char fbuf[180];
     if (!file || !function || (line <= 0))
     {
@@ -158,6 +169,70 @@ static void journaldLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int l
     }
 }
 
+/**
+ * Console logging function for the library.
+ */
+static void consoleLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
+                              const char *message, size_t messageLen)
+{
+    timespec ts = {0, 0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    writeConsoleLog(level, ts, getThreadId(), file, line, function, message, messageLen);
+}
+
+/**
+ * Journald logging function for the library.
+ */
+static void journaldLogHandler(RIALTO_DEBUG_LEVEL level, const char *file, int line, const char *function,
+                               const char *message, size_t messageLen)
+{
+    writeJournaldLog(level, getThreadId(), file, line, function, message);
+}
+
+/**
+ * Writes a record queued on the asynchronous sink to the default log destination.
+ */
+static void writeLogRecord(const firebolt::rialto::logging::LogRecord &record)
+{
+    if (g_envVariableParser.isConsoleLoggingEnabled())
+    {
+        writeConsoleLog(record.level, record.timestamp, record.threadId, record.file, record.line, record.function,
+                        record.message, record.messageLen);
+    }
+    else
+    {
+        writeJournaldLog(record.level, record.threadId, record.file, record.line, record.function, record.message);
+    }
+}
+
+/**
+ * Returns the asynchronous sink, or null when asynchronous logging is not enabled by RIALTO_ASYNC_LOG.
+ *
+ * The sink is never destroyed, so that it can be used by static destructors. It is stopped at exit, after which
+ * messages are written synchronously.
+ */
+static firebolt::rialto::logging::AsyncLogSink *getAsyncLogSink()
+{
+    static firebolt::rialto::logging::AsyncLogSink *asyncLogSink = []() -> firebolt::rialto::logging::AsyncLogSink *
+    {
+        if (!g_envVariableParser.isAsyncLoggingEnabled())
+            return nullptr;
+        firebolt::rialto::logging::AsyncLogSink *sink = nullptr;
+        try
+        {
+            sink = new firebolt::rialto::logging::AsyncLogSink(writeLogRecord, kAsyncLogRingCapacity);
+        }
+        catch (const std::exception &)
+        {
+            // Messages are written synchronously
+            return nullptr;
+        }
+        atexit([]() { getAsyncLogSink()->stop(); });
+        return sink;
+    }();
+    return asyncLogSink;
+}
+
 static void rialtoLog(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, const char *file, const char *func,
                       int line, const char *fmt, va_list ap, const char *append)
 {
@@ -201,8 +276,19 @@ static void rialtoLog(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, cons
     if (g_logHandler[component])
     {
         g_logHandler[component](level, fname, line, func, mbuf, len);
+        return;
     }
-    else if (g_envVariableParser.isConsoleLoggingEnabled())
+
+    firebolt::rialto::logging::AsyncLogSink *asyncLogSink = getAsyncLogSink();
+    if (asyncLogSink)
+    {
+        timespec ts = {0, 0};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        if (asyncLogSink->push(level, getThreadId(), ts, fname, line, func, mbuf, len))
+            return;
+    }
+
+    if (g_envVariableParser.isConsoleLoggingEnabled())
     {
         consoleLogHandler(level, fname, line, func, mbuf, len);
     }
@@ -212,6 +298,18 @@ static void rialtoLog(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, cons
     }
 }
 
+int rialtoLogIsLevelEnabled(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level)
+{
+    if (component >= RIALTO_COMPONENT_LAST)
+        return 0;
+
+    /* If log levels have not been set, set to Default */
+    if (!g_rialtoLogLevels[component])
+        g_rialtoLogLevels[component] = g_envVariableParser.getLevel(component);
+
+    return (level & g_rialtoLogLevels[component]) ? 1 : 0;
+}
+
 void rialtoLogVPrintf(RIALTO_COMPONENT component, RIALTO_DEBUG_LEVEL level, const char *file, const char *func,
                       int line, const char *fmt, va_list ap)
 {
@@ -85,6 +85,8 @@ public:
 
     bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId) override;
 
+    bool haveData(const std::vector<HaveDataIpcInfo> &sources) override;
+
     bool setPosition(int64_t position) override;
 
     bool getPosition(int64_t &position) override;
@@ -146,6 +148,14 @@ private:
      */
     void onNeedMediaData(const std::shared_ptr<firebolt::rialto::NeedMediaDataEvent> &event);
 
+    /**
+     * @brief Forwards the need data requests returned in a haveData response like the need data events.
+     *
+     * @param[in] needMediaData : The need data requests from the response.
+     */
+    void dispatchNeedMediaData(
+        const ::google::protobuf::RepeatedPtrField<firebolt::rialto::NeedMediaDataEvent> &needMediaData);
+
     /**
      * @brief Handler for a QOS update from the server.
      *
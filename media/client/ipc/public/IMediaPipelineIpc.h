@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <IMediaPipeline.h>
 #include <MediaCommon.h>
@@ -34,6 +35,16 @@ namespace firebolt::rialto::client
 {
 class IMediaPipelineIpc;
 
+/**
+ * @brief The data written to the shared memory for a single need data request.
+ */
+struct HaveDataIpcInfo
+{
+    MediaSourceStatus status; /**< The status of the media source. */
+    uint32_t numFrames;       /**< The number of frames written. */
+    uint32_t requestId;       /**< The need data request id. */
+};
+
 /**
  * @brief IMediaPipelineIpc factory class, returns a concrete implementation of IMediaPipelineIpc
  */
@@ -151,6 +162,15 @@ public:
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId) = 0;
 
+    /**
+     * @brief Notify server that the data of several media sources has been written to the shared memory.
+     *
+     * @param[in] sources : The status, number of frames and need data request id of each source.
+     *
+     * @retval true on success.
+     */
+    virtual bool haveData(const std::vector<HaveDataIpcInfo> &sources) = 0;
+
     /**
      * @brief Request new playback position.
      *
@@ -402,6 +402,7 @@ bool MediaPipelineIpc::haveData(MediaSourceStatus status, uint32_t numFrames, ui
     request.set_status(convertHaveDataRequestMediaSourceStatus(status));
     request.set_num_frames(numFrames);
     request.set_request_id(requestId);
+    request.set_accept_need_media_data(true);
 
     firebolt::rialto::HaveDataResponse response;
     auto ipcController = m_ipc->createRpcController();
@@ -418,6 +419,48 @@ bool MediaPipelineIpc::haveData(MediaSourceStatus status, uint32_t numFrames, ui
         return false;
     }
 
+    dispatchNeedMediaData(response.need_media_data());
+
+    return true;
+}
+
+bool MediaPipelineIpc::haveData(const std::vector<HaveDataIpcInfo> &sources)
+{
+    if (!reattachChannelIfRequired())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Reattachment of the ipc channel failed, ipc disconnected");
+        return false;
+    }
+
+    firebolt::rialto::HaveDataMultiSourceRequest request;
+
+    request.set_session_id(m_sessionId);
+    for (const auto &source : sources)
+    {
+        auto sourceData = request.add_sources();
+        sourceData->set_status(convertHaveDataRequestMediaSourceStatus(source.status));
+        sourceData->set_num_frames(source.numFrames);
+        sourceData->set_request_id(source.requestId);
+    }
+    request.set_accept_need_media_data(true);
+
+    firebolt::rialto::HaveDataMultiSourceResponse response;
+    auto ipcController = m_ipc->createRpcController();
+    auto blockingClosure = m_ipc->createBlockingClosure();
+    m_mediaPipelineStub->haveDataMultiSource(ipcController.get(), &request, &response, blockingClosure.get());
+
+    // wait for the call to complete
+    blockingClosure->wait();
+
+    // check the result
+    if (ipcController->Failed())
+    {
+        RIALTO_CLIENT_LOG_ERROR("failed to have data due to '%s'", ipcController->ErrorText().c_str());
+        return false;
+    }
+
+    dispatchNeedMediaData(response.need_media_data());
+
     return true;
 }
 
@@ -651,6 +694,17 @@ void MediaPipelineIpc::onNeedMediaData(const std::shared_ptr<firebolt::rialto::N
     }
 }
 
+void MediaPipelineIpc::dispatchNeedMediaData(
+    const ::google::protobuf::RepeatedPtrField<firebolt::rialto::NeedMediaDataEvent> &needMediaData)
+{
+    // Handled on the event thread, like the NeedMediaDataEvents, so the client is never called back from haveData
+    for (const auto &needMediaDataEvent : needMediaData)
+    {
+        m_eventThread->add(&MediaPipelineIpc::onNeedMediaData, this,
+                           std::make_shared<firebolt::rialto::NeedMediaDataEvent>(needMediaDataEvent));
+    }
+}
+
 void MediaPipelineIpc::onQos(const std::shared_ptr<firebolt::rialto::QosEvent> &event)
 {
     // Ignore event if not for this session
@@ -111,6 +111,8 @@ public:
 
     bool haveData(MediaSourceStatus status, uint32_t needDataRequestId) override;
 
+    bool haveData(const std::vector<HaveDataInfo> &sources) override;
+
     AddSegmentStatus addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment) override;
 
     std::weak_ptr<IMediaPipelineClient> getClient() override;
@@ -207,6 +209,15 @@ protected:
      */
     bool handleHaveData(MediaSourceStatus status, uint32_t needDataRequestId);
 
+    /**
+     * @brief Handles a multi source have data request.
+     *
+     * @param[in] sources : The status and need data request id of each request.
+     *
+     * @retval true on success.
+     */
+    bool handleHaveData(const std::vector<HaveDataInfo> &sources);
+
     /**
      * @brief Handles a set position request.
      *
@@ -334,6 +334,81 @@ bool MediaPipeline::handleHaveData(MediaSourceStatus status, uint32_t needDataRe
     return m_mediaPipelineIpc->haveData(status, numFrames, needDataRequestId);
 }
 
+bool MediaPipeline::haveData(const std::vector<HaveDataInfo> &sources)
+{
+    RIALTO_CLIENT_LOG_DEBUG("entry:");
+
+    switch (m_currentState)
+    {
+    case State::BUFFERING:
+    case State::PLAYING:
+    {
+        return handleHaveData(sources);
+    }
+    case State::SEEKING:
+    {
+        RIALTO_CLIENT_LOG_INFO("HaveData received while seeking, discarding %zu NeedData requests", sources.size());
+        for (const auto &source : sources)
+        {
+            discardNeedDataRequest(source.needDataRequestId);
+        }
+        return true;
+    }
+    case State::IDLE:
+    case State::END_OF_STREAM:
+    case State::FAILURE:
+    default:
+    {
+        RIALTO_CLIENT_LOG_WARN("HaveData received in unexpected state '%s', discarding %zu NeedData requests",
+                               toString(m_currentState), sources.size());
+        for (const auto &source : sources)
+        {
+            discardNeedDataRequest(source.needDataRequestId);
+        }
+        return false;
+    }
+    }
+}
+
+bool MediaPipeline::handleHaveData(const std::vector<HaveDataInfo> &sources)
+{
+    RIALTO_CLIENT_LOG_DEBUG("entry:");
+
+    bool result{true};
+    std::vector<std::shared_ptr<NeedDataRequest>> needDataRequests;
+    std::vector<HaveDataIpcInfo> ipcSources;
+    needDataRequests.reserve(sources.size());
+    ipcSources.reserve(sources.size());
+
+    // The needData requests can be cancelled from another thread
+    {
+        std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
+
+        for (const auto &source : sources)
+        {
+            auto needDataRequestIt = m_needDataRequestMap.find(source.needDataRequestId);
+            if (needDataRequestIt == m_needDataRequestMap.end())
+            {
+                RIALTO_CLIENT_LOG_ERROR("Could not find need data request, with id %u", source.needDataRequestId);
+                result = false;
+                continue;
+            }
+
+            std::shared_ptr<NeedDataRequest> needDataRequest = needDataRequestIt->second;
+            m_needDataRequestMap.erase(needDataRequestIt);
+            uint32_t numFrames = needDataRequest->frameWriter ? needDataRequest->frameWriter->getNumFrames() : 0;
+            ipcSources.push_back(HaveDataIpcInfo{source.status, numFrames, source.needDataRequestId});
+            needDataRequests.push_back(std::move(needDataRequest));
+        }
+    }
+
+    if (ipcSources.empty())
+    {
+        return result;
+    }
+    return m_mediaPipelineIpc->haveData(ipcSources) && result;
+}
+
 AddSegmentStatus MediaPipeline::addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment)
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
@@ -0,0 +1,126 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_COMMON_METADATA_V3_H_
+#define FIREBOLT_RIALTO_COMMON_METADATA_V3_H_
+
+#include <stdint.h>
+
+#include <type_traits>
+
+/**
+ * Metadata V3 layout of the media data region. The metadata region contains only the version.
+ *
+ * Each frame starts at an offset aligned to METADATA_V3_ALIGNMENT_BYTES, relative to the start of the media data
+ * region, and consists of:
+ * - MetadataV3FrameHeader,
+ * - subSampleCount * MetadataV3SubSample,
+ * - keyIdSize bytes of the key id,
+ * - initVectorSize bytes of the init vector,
+ * - extraDataSize bytes of the extra data,
+ * - padding up to MetadataV3FrameHeader::metadataSize,
+ * - dataLength bytes of the media data, padded up to METADATA_V3_ALIGNMENT_BYTES.
+ *
+ * All the values are little endian and the layout does not depend on the alignment of the shared memory, so the
+ * metadata can be read in place, without any parsing.
+ */
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "Metadata V3 is supported only on little endian platforms"
+#endif
+
+namespace firebolt::rialto::common
+{
+/**
+ * @brief Alignment of the frames in the metadata V3 format.
+ */
+const uint32_t METADATA_V3_ALIGNMENT_BYTES = 8U;
+
+/**
+ * @brief Frame flag set for the encrypted frames.
+ */
+const uint32_t METADATA_V3_FLAG_ENCRYPTED = 0x1U;
+
+/**
+ * @brief Fixed size header of the frame in the metadata V3 format.
+ */
+struct MetadataV3FrameHeader
+{
+    uint32_t metadataSize;      /**< Size of the header and the inline arrays, including the padding. */
+    uint32_t dataLength;        /**< Length of the media data. */
+    int64_t timePosition;       /**< Position of the frame in nanoseconds. */
+    int64_t sampleDuration;     /**< Duration of the frame in nanoseconds. */
+    int32_t streamId;           /**< The id of the source. */
+    uint32_t mediaSourceType;   /**< The MediaSourceType of the frame. */
+    uint32_t flags;             /**< Bitmask of METADATA_V3_FLAG_* values. */
+    uint32_t segmentAlignment;  /**< The SegmentAlignment of the frame. */
+    uint32_t sampleRate;        /**< Audio sample rate, 0 for video. */
+    uint32_t channelsNum;       /**< Audio channels number, 0 for video. */
+    uint32_t width;             /**< Video width, 0 for audio. */
+    uint32_t height;            /**< Video height, 0 for audio. */
+    int32_t mediaKeySessionId;  /**< The media key session id of the encrypted frame. */
+    uint32_t initWithLast15;    /**< Whether the decryption context is initialized with the last 15 bytes. */
+    uint32_t subSampleCount;    /**< Number of MetadataV3SubSample entries following the header. */
+    uint32_t keyIdSize;         /**< Size of the key id. */
+    uint32_t initVectorSize;    /**< Size of the init vector. */
+    uint32_t extraDataSize;     /**< Size of the extra data. */
+};
+
+/**
+ * @brief Subsample entry in the metadata V3 format.
+ */
+struct MetadataV3SubSample
+{
+    uint32_t numClearBytes;     /**< The number of clear bytes in the sample. */
+    uint32_t numEncryptedBytes; /**< The number of encrypted bytes in the sample. */
+};
+
+static_assert(std::is_standard_layout<MetadataV3FrameHeader>::value, "MetadataV3FrameHeader must be a POD");
+static_assert(sizeof(MetadataV3FrameHeader) == 80U, "Unexpected size of MetadataV3FrameHeader");
+static_assert(sizeof(MetadataV3SubSample) == 8U, "Unexpected size of MetadataV3SubSample");
+
+/**
+ * @brief Aligns the size to METADATA_V3_ALIGNMENT_BYTES.
+ *
+ * @param[in] size : The size to align.
+ *
+ * @retval the aligned size.
+ */
+constexpr uint64_t alignMetadataV3Size(uint64_t size)
+{
+    return (size + METADATA_V3_ALIGNMENT_BYTES - 1U) & ~static_cast<uint64_t>(METADATA_V3_ALIGNMENT_BYTES - 1U);
+}
+
+/**
+ * @brief Gets the size of the frame metadata described by the header.
+ *
+ * @param[in] header : The frame header.
+ *
+ * @retval the size of the header and the inline arrays, including the padding. Computed on 64 bits, so that
+ *         the sizes read from a corrupted header cannot overflow.
+ */
+constexpr uint64_t getMetadataV3Size(const MetadataV3FrameHeader &header)
+{
+    return alignMetadataV3Size(sizeof(MetadataV3FrameHeader) +
+                               static_cast<uint64_t>(header.subSampleCount) * sizeof(MetadataV3SubSample) +
+                               static_cast<uint64_t>(header.keyIdSize) + header.initVectorSize + header.extraDataSize);
+}
+}; // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_METADATA_V3_H_
@@ -20,6 +20,7 @@
 #include "MediaFrameWriterFactory.h"
 #include "MediaFrameWriterV1.h"
 #include "MediaFrameWriterV2.h"
+#include "MediaFrameWriterV3.h"
 #include "RialtoCommonLogging.h"
 #include <algorithm>
 #include <string>
@@ -27,7 +28,9 @@
 
 namespace
 {
-constexpr int kLatestMetadataVersion{2};
+// V3 has to be explicitly selected with RIALTO_METADATA_VERSION, as older servers do not support it.
+constexpr int kDefaultMetadataVersion{2};
+constexpr int kLatestMetadataVersion{3};
 const char *kMetadataEnvVariableName{"RIALTO_METADATA_VERSION"};
 } // namespace
 
@@ -44,7 +47,7 @@ catch (const std::exception &e)
     return nullptr;
 }
 
-MediaFrameWriterFactory::MediaFrameWriterFactory() : m_metadataVersion{kLatestMetadataVersion}
+MediaFrameWriterFactory::MediaFrameWriterFactory() : m_metadataVersion{kDefaultMetadataVersion}
 {
     const char *envVar = getenv(kMetadataEnvVariableName);
     if (!envVar)
@@ -61,7 +64,7 @@ MediaFrameWriterFactory::MediaFrameWriterFactory() : m_metadataVersion{kLatestMe
     }
     if (m_metadataVersion > kLatestMetadataVersion)
     {
-        m_metadataVersion = kLatestMetadataVersion;
+        m_metadataVersion = kDefaultMetadataVersion;
     }
 }
 
@@ -73,6 +76,10 @@ try
     {
         return std::make_unique<MediaFrameWriterV1>(shmBuffer, shmInfo);
     }
+    if (3 == m_metadataVersion)
+    {
+        return std::make_unique<MediaFrameWriterV3>(shmBuffer, shmInfo);
+    }
     return std::make_unique<MediaFrameWriterV2>(shmBuffer, shmInfo);
 }
 catch (const std::exception &e)
@@ -29,8 +29,8 @@ MediaFrameWriterV1::MediaFrameWriterV1(uint8_t *shmBuffer, const std::shared_ptr
 {
     RIALTO_COMMON_LOG_INFO("We are using a writer for Metadata V1");
 
-    // Zero metadata memory
-    m_bytewriter.fillBytes(m_shmBuffer, m_metadataOffset, 0, m_kMaxMetadataBytes);
+    // Memory is not zeroed. Server reads only the number of frames reported in haveData, and every metadata
+    // entry of those frames is fully written by writeMetaDataGeneric() and writeMetaDataTypeSpecific().
 
     // Set metadata version
     m_metadataOffset = m_bytewriter.writeUint32(m_shmBuffer, m_metadataOffset, m_kMetadataVersion);
@@ -92,8 +92,8 @@ bool MediaFrameWriterV1::writeMetaDataGeneric(const std::unique_ptr<IMediaPipeli
         m_metadataOffset =
             m_bytewriter.fillBytes(m_shmBuffer, m_metadataOffset, 0, MAX_EXTRA_DATA_SIZE - data->getExtraData().size());
 
-        // Not encrypted so skip the encrypted section of the metadata
-        m_metadataOffset += m_kEncryptionMetadataSizeBytes;
+        // Not encrypted so zero the encrypted section of the metadata
+        m_metadataOffset = m_bytewriter.fillBytes(m_shmBuffer, m_metadataOffset, 0, m_kEncryptionMetadataSizeBytes);
     }
 
     return true;
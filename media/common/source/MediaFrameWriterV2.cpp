@@ -60,9 +60,8 @@ MediaFrameWriterV2::MediaFrameWriterV2(uint8_t *shmBuffer, const std::shared_ptr
 {
     RIALTO_COMMON_LOG_INFO("We are using a writer for Metadata V2");
 
-    // Zero memory
-    m_byteWriter.fillBytes(m_shmBuffer, shmInfo->metadataOffset, 0, shmInfo->maxMetadataBytes);
-    m_byteWriter.fillBytes(m_shmBuffer, m_dataOffset, 0, m_kMaxBytes);
+    // Memory is not zeroed. Server reads only the number of frames reported in haveData and each frame is
+    // prefixed with the size of its metadata, so the bytes following the last written frame are never read.
 
     // Set metadata version
     m_byteWriter.writeUint32(m_shmBuffer, shmInfo->metadataOffset, kMetadataVersion);
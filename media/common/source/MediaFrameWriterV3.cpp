@@ -0,0 +1,127 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV3.h"
+#include "RialtoCommonLogging.h"
+
+namespace
+{
+/**
+ * @brief The version of metadata this object shall write.
+ */
+constexpr uint32_t kMetadataVersion = 3U;
+} // namespace
+
+namespace firebolt::rialto::common
+{
+MediaFrameWriterV3::MediaFrameWriterV3(uint8_t *shmBuffer, const std::shared_ptr<ShmInfo> &shmInfo)
+    : m_shmBuffer(shmBuffer), m_kMaxBytes(shmInfo->maxMediaBytes), m_bytesWritten(0U),
+      m_dataOffset(shmInfo->mediaDataOffset), m_numFrames{0}
+{
+    RIALTO_COMMON_LOG_INFO("We are using a writer for Metadata V3");
+
+    // Memory is not zeroed. Server reads only the number of frames reported in haveData and the size of each
+    // frame is stored in its header, so neither the padding nor the bytes following the last frame are read.
+
+    // Set metadata version
+    m_byteWriter.writeUint32(m_shmBuffer, shmInfo->metadataOffset, kMetadataVersion);
+}
+
+AddSegmentStatus MediaFrameWriterV3::writeFrame(const std::unique_ptr<IMediaPipeline::MediaSegment> &data)
+{
+    MetadataV3FrameHeader header{};
+    if (!buildHeader(data, header))
+    {
+        return AddSegmentStatus::ERROR;
+    }
+    const uint64_t kFrameSize{header.metadataSize + alignMetadataV3Size(header.dataLength)};
+    if (m_bytesWritten + kFrameSize > m_kMaxBytes)
+    {
+        RIALTO_COMMON_LOG_ERROR("Not enough memory available to write MediaSegment");
+        return AddSegmentStatus::NO_SPACE;
+    }
+
+    uint32_t offset = m_dataOffset;
+    offset = m_byteWriter.writeBytes(m_shmBuffer, offset, reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+    for (uint32_t i = 0; i < header.subSampleCount; ++i)
+    {
+        const MetadataV3SubSample kSubSample{static_cast<uint32_t>(data->getSubSamples()[i].numClearBytes),
+                                            static_cast<uint32_t>(data->getSubSamples()[i].numEncryptedBytes)};
+        offset = m_byteWriter.writeBytes(m_shmBuffer, offset, reinterpret_cast<const uint8_t *>(&kSubSample),
+                                         sizeof(kSubSample));
+    }
+    offset = m_byteWriter.writeBytes(m_shmBuffer, offset, data->getKeyId().data(), header.keyIdSize);
+    offset = m_byteWriter.writeBytes(m_shmBuffer, offset, data->getInitVector().data(), header.initVectorSize);
+    m_byteWriter.writeBytes(m_shmBuffer, offset, data->getExtraData().data(), header.extraDataSize);
+    m_byteWriter.writeBytes(m_shmBuffer, m_dataOffset + header.metadataSize, data->getData(), header.dataLength);
+
+    // Track the amount of bytes written
+    m_dataOffset += kFrameSize;
+    m_bytesWritten += kFrameSize;
+    ++m_numFrames;
+
+    return AddSegmentStatus::OK;
+}
+
+bool MediaFrameWriterV3::buildHeader(const std::unique_ptr<IMediaPipeline::MediaSegment> &data,
+                                     MetadataV3FrameHeader &header) const
+try
+{
+    header.dataLength = data->getDataLength();
+    header.timePosition = data->getTimeStamp();
+    header.sampleDuration = data->getDuration();
+    header.streamId = data->getId();
+    header.mediaSourceType = static_cast<uint32_t>(data->getType());
+    header.segmentAlignment = static_cast<uint32_t>(data->getSegmentAlignment());
+    if (MediaSourceType::AUDIO == data->getType())
+    {
+        IMediaPipeline::MediaSegmentAudio &audioSegment = dynamic_cast<IMediaPipeline::MediaSegmentAudio &>(*data);
+        header.sampleRate = static_cast<uint32_t>(audioSegment.getSampleRate());
+        header.channelsNum = static_cast<uint32_t>(audioSegment.getNumberOfChannels());
+    }
+    else if (MediaSourceType::VIDEO == data->getType())
+    {
+        IMediaPipeline::MediaSegmentVideo &videoSegment = dynamic_cast<IMediaPipeline::MediaSegmentVideo &>(*data);
+        header.width = static_cast<uint32_t>(videoSegment.getWidth());
+        header.height = static_cast<uint32_t>(videoSegment.getHeight());
+    }
+    else
+    {
+        RIALTO_COMMON_LOG_ERROR("Failed to write type specific metadata - media source type not known");
+        return false;
+    }
+    header.extraDataSize = static_cast<uint32_t>(data->getExtraData().size());
+    if (data->isEncrypted())
+    {
+        header.flags |= METADATA_V3_FLAG_ENCRYPTED;
+        header.mediaKeySessionId = data->getMediaKeySessionId();
+        header.initWithLast15 = data->getInitWithLast15();
+        header.subSampleCount = static_cast<uint32_t>(data->getSubSamples().size());
+        header.keyIdSize = static_cast<uint32_t>(data->getKeyId().size());
+        header.initVectorSize = static_cast<uint32_t>(data->getInitVector().size());
+    }
+    header.metadataSize = static_cast<uint32_t>(getMetadataV3Size(header));
+    return true;
+}
+catch (const std::exception &e)
+{
+    RIALTO_COMMON_LOG_ERROR("Failed to write type specific metadata - exception occured");
+    return false;
+}
+} // namespace firebolt::rialto::common
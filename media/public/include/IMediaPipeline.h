@@ -857,6 +857,30 @@ public:
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t needDataRequestId) = 0;
 
+    /**
+     * @brief Returns data requested using notifyNeedMediaData() for several media sources at once.
+     *
+     * Behaves like haveData() called for each of the requests, but commits
+     * the data of all media sources, e.g. audio and video, in a single call.
+     * The default implementation calls haveData() for each of the requests.
+     *
+     * @param[in] sources : The status and need data request id of each request.
+     *
+     * @retval true on success.
+     */
+    virtual bool haveData(const std::vector<HaveDataInfo> &sources)
+    {
+        bool result{true};
+        for (const auto &source : sources)
+        {
+            if (!haveData(source.status, source.needDataRequestId))
+            {
+                result = false;
+            }
+        }
+        return result;
+    }
+
     /**
      * @brief Adds a single segment to Rialto in response to notifyNeedData()
      *
@@ -199,6 +199,15 @@ struct QosInfo
     uint64_t dropped;   /**< The total number of video frames/audio samples dropped since MediaPipeline:load. */
 };
 
+/**
+ * @brief The data returned for a single media source in a multi source haveData() call.
+ */
+struct HaveDataInfo
+{
+    MediaSourceStatus status;   /**< The status of the media source. */
+    uint32_t needDataRequestId; /**< The id of the need data request. */
+};
+
 /**
  * @brief The error return status for session management methods.
  */
@@ -21,10 +21,10 @@
 #define FIREBOLT_RIALTO_SERVER_GST_DISPATCHER_THREAD_H_
 
 #include "IGstDispatcherThread.h"
-#include <atomic>
+#include <condition_variable>
 #include <gst/gst.h>
 #include <memory>
-#include <thread>
+#include <mutex>
 
 namespace firebolt::rialto::server
 {
@@ -38,6 +38,12 @@ public:
                               const IPlayerTaskFactory &taskFactory) const override;
 };
 
+/**
+ * @brief Dispatches the pipeline bus messages to the worker thread.
+ *
+ * Messages are picked up by a bus sync handler in the thread that posts them, so no thread is
+ * dedicated to (or periodically woken up for) polling the bus.
+ */
 class GstDispatcherThread : public IGstDispatcherThread
 {
 public:
@@ -48,10 +54,29 @@ public:
 
 private:
     /**
-     * @brief For handling gst bus messages in Gstreamer dispatcher thread
-     * @param[in] pipeline : The pipeline
+     * @brief The bus sync handler, called from the thread posting the message.
+     *
+     * @param[in] bus      : The pipeline bus.
+     * @param[in] message  : The posted message.
+     * @param[in] userData : The GstDispatcherThread instance.
+     *
+     * @retval GST_BUS_DROP, as all the messages are either dispatched or not needed.
+     */
+    static GstBusSyncReply onBusMessage(GstBus *bus, GstMessage *message, gpointer userData);
+
+    /**
+     * @brief Called by gstreamer, when the sync handler is not going to be called anymore.
+     *
+     * @param[in] userData : The GstDispatcherThread instance.
      */
-    void gstBusEventHandler(GstElement *pipeline);
+    static void onSyncHandlerReleased(gpointer userData);
+
+    /**
+     * @brief For handling gst bus messages
+     *
+     * @param[in] message : The posted message.
+     */
+    void handleBusMessage(GstMessage *message);
 
 private:
     /**
@@ -80,14 +105,29 @@ private:
     const IPlayerTaskFactory &m_kTaskFactory;
 
     /**
-     * @brief Flag used to check, if task thread is active
+     * @brief The pipeline bus.
+     */
+    GstBus *m_bus;
+
+    /**
+     * @brief Mutex protecting the dispatcher state.
+     */
+    std::mutex m_mutex;
+
+    /**
+     * @brief Notified, when the sync handler is released.
+     */
+    std::condition_variable m_syncHandlerReleasedCv;
+
+    /**
+     * @brief Flag used to check, if messages should still be dispatched
      */
-    std::atomic<bool> m_isGstreamerDispatcherActive;
+    bool m_isGstreamerDispatcherActive;
 
     /**
-     * @brief Thread for handling gst bus callbacks
+     * @brief Flag used to check, if the sync handler may still be called
      */
-    std::thread m_gstBusDispatcherThread;
+    bool m_isSyncHandlerInstalled;
 };
 } // namespace firebolt::rialto::server
 
@@ -32,7 +32,9 @@
 #include "tasks/IPlayerTask.h"
 #include "tasks/IPlayerTaskFactory.h"
 #include <IMediaPipeline.h>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace firebolt::rialto::server
@@ -109,7 +111,11 @@ private:
     bool setWesterossinkRectangle() override;
     bool setWesterossinkSecondaryVideo() override;
     void notifyNeedMediaData(bool audioNotificationNeeded, bool videoNotificationNeeded) override;
+    void requestMediaData(const MediaSourceType &mediaSourceType) override;
     GstBuffer *createBuffer(const IMediaPipeline::MediaSegment &mediaSegment) const override;
+    GstBuffer *createShmBuffer(const IMediaPipeline::MediaSegment &mediaSegment,
+                               const std::shared_ptr<IDataReader> &dataReader) override;
+    void notifyShmBuffersReleased() override;
     void attachAudioData() override;
     void attachVideoData() override;
     void updateAudioCaps(int32_t rate, int32_t channels) override;
@@ -155,6 +161,74 @@ private:
      */
     static void setupElement(GstElement *pipeline, GstElement *element, GstPlayer *self);
 
+    /**
+     * @brief Sets the protection metadata, timestamp and duration of the buffer.
+     *
+     * @param[in] gstBuffer     : The buffer to be updated.
+     * @param[in] mediaSegment  : The media segment, which data is stored in the buffer.
+     */
+    void setBufferMetadata(GstBuffer *gstBuffer, const IMediaPipeline::MediaSegment &mediaSegment) const;
+
+    /**
+     * @brief Callback called, when gstreamer frees the memory wrapping the shared memory region.
+     *        Called by the Gstreamer thread
+     *
+     * @param[in] userData  : The ShmReleaseInfo of the released memory.
+     */
+    static void onShmMemoryReleased(gpointer userData);
+
+    /**
+     * @brief Waits, at most kShmBuffersReleaseTimeout, until gstreamer releases all buffers wrapping the shared
+     *        memory. Called by the destructor, after the pipeline is stopped.
+     *
+     * Buffers released after that no longer notify the player.
+     */
+    void waitForShmBuffersReleased();
+
+    /**
+     * @brief The buffers wrapping the shared memory, which are still owned by gstreamer.
+     *
+     * Shared with the release callbacks, as gstreamer may release a buffer after the player stopped waiting for it.
+     */
+    struct ShmBuffersInUse
+    {
+        std::mutex mutex;
+        std::condition_variable releasedCv;
+        std::uint32_t audio{0};
+        std::uint32_t video{0};
+        GstPlayer *player{nullptr}; // cleared, when the player is destroyed
+    };
+
+    /**
+     * @brief Data passed to onShmMemoryReleased callback.
+     */
+    struct ShmReleaseInfo
+    {
+        std::shared_ptr<ShmBuffersInUse> buffersInUse;
+        MediaSourceType type;
+        std::shared_ptr<IDataReader> dataReader;
+    };
+
+    /**
+     * @brief Pushes all the buffers to the appsrc in one go and clears the vector. Called by the worker thread.
+     *
+     * @param[in] appSrc  : The appsrc to push to.
+     * @param[in] buffers : The buffers to push. The appsrc takes ownership of them.
+     */
+    void pushBuffers(GstElement *appSrc, std::vector<GstBuffer *> &buffers);
+
+    /**
+     * @brief Pushes the pending audio buffers to the appsrc, regardless of whether it needs data. Called by the
+     * worker thread.
+     */
+    void pushPendingAudioBuffers();
+
+    /**
+     * @brief Pushes the pending video buffers to the appsrc, regardless of whether it needs data. Called by the
+     * worker thread.
+     */
+    void pushPendingVideoBuffers();
+
 private:
     /**
      * @brief The player context.
@@ -208,6 +282,16 @@ private:
      * @brief The GstPlayer task factory
      */
     std::unique_ptr<IPlayerTaskFactory> m_taskFactory;
+
+    /**
+     * @brief Whether the buffers of clear samples should wrap the shared memory instead of copying it.
+     */
+    const bool m_isShmZeroCopyEnabled;
+
+    /**
+     * @brief The buffers wrapping the shared memory, which are still owned by gstreamer.
+     */
+    std::shared_ptr<ShmBuffersInUse> m_shmBuffersInUse;
 };
 } // namespace firebolt::rialto::server
 
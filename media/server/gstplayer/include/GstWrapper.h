@@ -227,8 +227,22 @@ public:
         return gst_app_src_push_buffer(appsrc, buffer);
     }
 
+    GstFlowReturn gstAppSrcPushBufferList(GstAppSrc *appsrc, GstBufferList *bufferList) override
+    {
+        return gst_app_src_push_buffer_list(appsrc, bufferList);
+    }
+
+    GstBufferList *gstBufferListNewSized(guint size) override { return gst_buffer_list_new_sized(size); }
+
+    void gstBufferListAdd(GstBufferList *bufferList, GstBuffer *buffer) override
+    {
+        gst_buffer_list_add(bufferList, buffer);
+    }
+
     void gstMessageUnref(GstMessage *msg) override { gst_message_unref(msg); }
 
+    GstMessage *gstMessageRef(GstMessage *msg) override { return gst_message_ref(msg); }
+
     GstMessage *gstBusTimedPopFiltered(GstBus *bus, GstClockTime timeout, GstMessageType types) override
     {
         return gst_bus_timed_pop_filtered(bus, timeout, types);
@@ -306,6 +320,12 @@ public:
         return gst_buffer_new_wrapped(data, size);
     }
 
+    GstBuffer *gstBufferNewWrappedFull(GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset, gsize size,
+                                       gpointer user_data, GDestroyNotify notify) const override
+    {
+        return gst_buffer_new_wrapped_full(flags, data, maxsize, offset, size, user_data, notify);
+    }
+
     GstCaps *gstCodecUtilsOpusCreateCapsFromHeader(gconstpointer data, guint size) const override
     {
 #if (GLIB_CHECK_VERSION(2, 67, 3))
@@ -20,6 +20,7 @@
 #ifndef FIREBOLT_RIALTO_SERVER_I_GST_PLAYER_PRIVATE_H_
 #define FIREBOLT_RIALTO_SERVER_I_GST_PLAYER_PRIVATE_H_
 
+#include "IDataReader.h"
 #include "IMediaPipeline.h"
 #include <gst/app/gstappsrc.h>
 #include <gst/gst.h>
@@ -81,12 +82,37 @@ public:
      */
     virtual void notifyNeedMediaData(bool audioNotificationNeeded, bool videoNotificationNeeded) = 0;
 
+    /**
+     * @brief Sends NeedMediaData requests for the source, until all shared memory slots are in use.
+     *        Called by the worker thread.
+     *
+     * @param[in] mediaSourceType : The media source type.
+     */
+    virtual void requestMediaData(const MediaSourceType &mediaSourceType) = 0;
+
     /**
      * @brief Constructs a new buffer with data from media segment. Does not perform decryption.
      *        Called by the worker thread.
      */
     virtual GstBuffer *createBuffer(const IMediaPipeline::MediaSegment &mediaSegment) const = 0;
 
+    /**
+     * @brief Constructs a new buffer with data from media segment stored in the shared memory. When zero copy mode is
+     *        enabled, the buffer wraps the shared memory instead of copying it. Called by the worker thread.
+     *
+     * @param[in] mediaSegment : The media segment.
+     * @param[in] dataReader   : The reader of the segment. Wrapping buffer keeps the reference to the reader, so the
+     *                           shared memory slot is not reused until gstreamer releases the buffer.
+     */
+    virtual GstBuffer *createShmBuffer(const IMediaPipeline::MediaSegment &mediaSegment,
+                                       const std::shared_ptr<IDataReader> &dataReader) = 0;
+
+    /**
+     * @brief Sends NeedMediaData for the shared memory slots, which have been freed since the last request.
+     *        Called by the worker thread, after a data reader and all buffers wrapping its data are released.
+     */
+    virtual void notifyShmBuffersReleased() = 0;
+
     /**
      * @brief Attach audio data. Called by the worker thread
      */
@@ -99,11 +125,15 @@ public:
 
     /**
      * @brief Checks the new audio mediaSegment metadata and updates the caps accordingly.
+     *
+     * Audio buffers still pending in the context are pushed before the caps change, as they belong to the old caps.
      */
     virtual void updateAudioCaps(int32_t rate, int32_t channels) = 0;
 
     /**
      * @brief Checks the new video mediaSegment metadata and updates the caps accordingly.
+     *
+     * Video buffers still pending in the context are pushed before the caps change, as they belong to the old caps.
      */
     virtual void updateVideoCaps(int32_t width, int32_t height) = 0;
 
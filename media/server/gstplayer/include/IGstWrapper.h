@@ -457,6 +457,35 @@ public:
      */
     virtual GstFlowReturn gstAppSrcPushBuffer(GstAppSrc *appsrc, GstBuffer *buffer) = 0;
 
+    /**
+     * @brief Adds a list of buffers to the queue of buffers that the appsrc element will push to its source pad.
+     * This function takes ownership of the buffer list.
+     *
+     * @param[in] appsrc       : The app src.
+     * @param[in] bufferList   : a GstBufferList to push
+     *
+     * @retval GST_FLOW_OK when the buffer list was successfuly queued. GST_FLOW_FLUSHING when appsrc is not PAUSED or
+     *         PLAYING. GST_FLOW_EOS when EOS occured.
+     */
+    virtual GstFlowReturn gstAppSrcPushBufferList(GstAppSrc *appsrc, GstBufferList *bufferList) = 0;
+
+    /**
+     * @brief Creates a new, empty GstBufferList with room for size buffers.
+     *
+     * @param[in] size : The expected number of buffers.
+     *
+     * @retval the new buffer list.
+     */
+    virtual GstBufferList *gstBufferListNewSized(guint size) = 0;
+
+    /**
+     * @brief Appends a buffer to the buffer list. The list takes ownership of the buffer.
+     *
+     * @param[in] bufferList : The buffer list.
+     * @param[in] buffer     : The buffer to append.
+     */
+    virtual void gstBufferListAdd(GstBufferList *bufferList, GstBuffer *buffer) = 0;
+
     /**
      * @brief Compare two sets of caps.
      *
@@ -535,6 +564,15 @@ public:
      */
     virtual void gstMessageUnref(GstMessage *msg) = 0;
 
+    /**
+     * @brief Increases the refcount of the message.
+     *
+     * @param[in] msg : a GstMessage.
+     *
+     * @retval the message with its refcount increased.
+     */
+    virtual GstMessage *gstMessageRef(GstMessage *msg) = 0;
+
     /**
      * @brief Gets a message fromt the bus
      *
@@ -747,6 +785,23 @@ public:
      */
     virtual GstBuffer *gstBufferNewWrapped(gpointer data, gsize size) const = 0;
 
+    /**
+     * @brief Creates a new buffer that wraps the given memory. The wrapped memory is not copied and not freed by
+     *        gstreamer - notify is called with user_data when the memory is no longer used.
+     *
+     * @param[in] flags     : GstMemoryFlags
+     * @param[in] data      : data to wrap
+     * @param[in] maxsize   : allocated size of data
+     * @param[in] offset    : offset in data
+     * @param[in] size      : size of valid data
+     * @param[in] user_data : user_data passed to notify
+     * @param[in] notify    : called with user_data when the memory is freed
+     *
+     * @retval a new GstBuffer
+     */
+    virtual GstBuffer *gstBufferNewWrappedFull(GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset,
+                                               gsize size, gpointer user_data, GDestroyNotify notify) const = 0;
+
     /**
      * @brief Creates Opus caps from the given Opus header.
      *
@@ -24,9 +24,9 @@
 #include "ITimer.h"
 #include "MediaCommon.h"
 #include <gst/gst.h>
-#include <list>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace firebolt::rialto::server
 {
@@ -97,18 +97,18 @@ struct PlayerContext
     bool videoNeedData{false};
 
     /**
-     * @brief Flag used to check, if request for audio data was sent and we didn't receive response yet.
+     * @brief Number of requests for audio data, which were sent and we didn't receive response yet.
      *
-     * Flag can be used only in worker thread
+     * Counter can be used only in worker thread
      */
-    bool audioNeedDataPending{false};
+    std::uint32_t audioNeedDataPending{0};
 
     /**
-     * @brief Flag used to check, if request for video data was sent and we didn't receive response yet.
+     * @brief Number of requests for video data, which were sent and we didn't receive response yet.
      *
-     * Flag can be used only in worker thread
+     * Counter can be used only in worker thread
      */
-    bool videoNeedDataPending{false};
+    std::uint32_t videoNeedDataPending{0};
 
     /**
      * @brief Flag used to check, if any audio data has been pushed to gstreamer (to check if BUFFERED can be sent)
@@ -132,18 +132,42 @@ struct PlayerContext
     bool bufferedNotificationSent{false};
 
     /**
-     * @brief List containing audio buffers to attach
+     * @brief Sample rate and number of channels last applied to the audio appsrc caps, 0 when not applied.
+     *
+     * Variables can be used only in worker thread
+     */
+    std::int32_t audioCapsSampleRate{0};
+    std::int32_t audioCapsNumberOfChannels{0};
+
+    /**
+     * @brief Width and height last applied to the video appsrc caps, 0 when not applied.
+     *
+     * Variables can be used only in worker thread
+     */
+    std::int32_t videoCapsWidth{0};
+    std::int32_t videoCapsHeight{0};
+
+    /**
+     * @brief Number of times the appsrc caps were rebuilt for new stream parameters, for diagnostics.
+     *
+     * Variables can be used only in worker thread
+     */
+    std::uint32_t audioCapsUpdates{0};
+    std::uint32_t videoCapsUpdates{0};
+
+    /**
+     * @brief Audio buffers to attach, pushed to the appsrc in one go
      *
-     * List can be used only in worker thread
+     * Vector can be used only in worker thread
      */
-    std::list<GstBuffer *> audioBuffers{};
+    std::vector<GstBuffer *> audioBuffers{};
 
     /**
-     * @brief List containing video buffers to attach
+     * @brief Video buffers to attach, pushed to the appsrc in one go
      *
-     * List can be used only in worker thread
+     * Vector can be used only in worker thread
      */
-    std::list<GstBuffer *> videoBuffers{};
+    std::vector<GstBuffer *> videoBuffers{};
 
     /**
      * @brief Flag used to check, if audio underflow callback occured
@@ -0,0 +1,87 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FIREBOLT_RIALTO_SERVER_RECYCLING_QUEUE_H_
+#define FIREBOLT_RIALTO_SERVER_RECYCLING_QUEUE_H_
+
+#include <list>
+#include <utility>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief FIFO queue keeping the nodes of popped elements for reuse.
+ *
+ * Once the queue has grown to its usual length, pushing and popping makes no heap allocations,
+ * which is not the case for std::queue, whose std::deque allocates and frees a chunk every few elements.
+ */
+template <typename T> class RecyclingQueue
+{
+public:
+    /**
+     * @brief Checks if the queue is empty.
+     *
+     * @retval true if there are no elements in the queue.
+     */
+    bool empty() const { return m_elements.empty(); }
+
+    /**
+     * @brief Appends an element to the queue.
+     *
+     * @param[in] element : The element to append.
+     */
+    void push(T &&element)
+    {
+        if (m_freeNodes.empty())
+        {
+            m_elements.push_back(std::move(element));
+        }
+        else
+        {
+            m_elements.splice(m_elements.end(), m_freeNodes, m_freeNodes.begin());
+            m_elements.back() = std::move(element);
+        }
+    }
+
+    /**
+     * @brief Removes the first element from the queue. The queue must not be empty.
+     *
+     * @retval the removed element.
+     */
+    T pop()
+    {
+        T element{std::move(m_elements.front())};
+        m_elements.front() = T{};
+        m_freeNodes.splice(m_freeNodes.begin(), m_elements, m_elements.begin());
+        return element;
+    }
+
+private:
+    /**
+     * @brief The queued elements.
+     */
+    std::list<T> m_elements;
+
+    /**
+     * @brief Nodes of the popped elements, holding default constructed values.
+     */
+    std::list<T> m_freeNodes;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_RECYCLING_QUEUE_H_
@@ -21,12 +21,12 @@
 #define FIREBOLT_RIALTO_SERVER_WORKER_THREAD_H_
 
 #include "IWorkerThread.h"
+#include "RecyclingQueue.h"
+#include "WorkerThreadPool.h"
 #include "tasks/IPlayerTask.h"
 #include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <queue>
-#include <thread>
 
 namespace firebolt::rialto::server
 {
@@ -36,10 +36,20 @@ public:
     std::unique_ptr<IWorkerThread> createWorkerThread() const override;
 };
 
+/**
+ * @brief Serial task queue of a player ("strand") running on the shared WorkerThreadPool.
+ *
+ * The tasks are executed one at a time in the order they were enqueued, but not necessarily on the same thread.
+ */
 class WorkerThread : public IWorkerThread
 {
 public:
-    WorkerThread();
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] pool : The pool executing the tasks.
+     */
+    explicit WorkerThread(const std::shared_ptr<WorkerThreadPool> &pool);
     ~WorkerThread() override;
 
     void stop() override;
@@ -48,27 +58,32 @@ public:
 
 private:
     /**
-     * @brief For handling new tasks in the worker thread.
+     * @brief Runs the queued tasks on a pool thread.
      */
     void taskHandler();
 
     /**
-     * @brief Gets the next task or wait for a task on the queue.
+     * @brief Gets the next task, if the worker is active and has any queued. Otherwise marks it as not scheduled.
      *
-     * @retval Next task to process.
+     * @retval Next task to process or null.
      */
-    std::unique_ptr<IPlayerTask> waitForTask();
+    std::unique_ptr<IPlayerTask> getNextTask();
 
 private:
+    /**
+     * @brief The pool executing the tasks.
+     */
+    std::shared_ptr<WorkerThreadPool> m_pool;
+
     /**
      * @brief Flag used to check, if task thread is active
      */
     bool m_isTaskThreadActive{true};
 
     /**
-     * @brief Thread for handling player tasks.
+     * @brief Flag used to check, if taskHandler is queued on or running in the pool
      */
-    std::thread m_taskThread{};
+    bool m_isScheduled{false};
 
     /**
      * @brief Mutex to protect the task handling.
@@ -76,14 +91,14 @@ private:
     std::mutex m_taskMutex{};
 
     /**
-     * @brief New task condition varaible.
+     * @brief Notified, when the worker stops being scheduled.
      */
     std::condition_variable m_taskCV{};
 
     /**
      * @brief Queue to store new tasks.
      */
-    std::queue<std::unique_ptr<IPlayerTask>> m_taskQueue{};
+    RecyclingQueue<std::unique_ptr<IPlayerTask>> m_taskQueue{};
 };
 } // namespace firebolt::rialto::server
 
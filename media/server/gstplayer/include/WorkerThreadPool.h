@@ -0,0 +1,145 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FIREBOLT_RIALTO_SERVER_WORKER_THREAD_POOL_H_
+#define FIREBOLT_RIALTO_SERVER_WORKER_THREAD_POOL_H_
+
+#include "RecyclingQueue.h"
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief Pool of threads shared by all the player worker threads of the process.
+ *
+ * The pool runs jobs in the order they were posted. Serialising the tasks of a player is up to the
+ * WorkerThread strand posting them.
+ *
+ * Player tasks may block (state changes, flushing seeks, waiting for the main thread), so a job never waits for
+ * a busy thread: when no thread is idle, the pool starts a new one. Threads above the initial number exit after
+ * staying idle for a while. As a strand has at most one job queued or running, the pool never grows beyond the
+ * number of players or its initial size, whichever is bigger.
+ */
+class WorkerThreadPool
+{
+public:
+    /**
+     * @brief Gets the pool shared by all the players, creating it if needed.
+     *
+     * @retval the pool instance.
+     */
+    static std::shared_ptr<WorkerThreadPool> getInstance();
+
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] numOfThreads : Number of threads kept in the pool, even if idle.
+     */
+    explicit WorkerThreadPool(unsigned numOfThreads);
+
+    /**
+     * @brief The destructor. Waits for the running jobs to finish, the queued ones are dropped.
+     */
+    ~WorkerThreadPool();
+
+    WorkerThreadPool(const WorkerThreadPool &) = delete;
+    WorkerThreadPool(WorkerThreadPool &&) = delete;
+    WorkerThreadPool &operator=(const WorkerThreadPool &) = delete;
+    WorkerThreadPool &operator=(WorkerThreadPool &&) = delete;
+
+    /**
+     * @brief Queues a job to be run by one of the pool threads.
+     *
+     * @param[in] job : The job to run.
+     */
+    void post(std::function<void()> &&job);
+
+    /**
+     * @brief Gets the number of threads currently in the pool.
+     *
+     * @retval the number of threads.
+     */
+    size_t getNumOfThreads();
+
+private:
+    /**
+     * @brief Starts a new pool thread. Must be called with m_jobMutex held.
+     */
+    void startThread();
+
+    /**
+     * @brief The pool thread loop.
+     *
+     * @param[in] self : The position of the thread in m_threads.
+     */
+    void threadHandler(std::list<std::thread>::iterator self);
+
+    /**
+     * @brief Flag used to check, if the pool threads should keep running
+     */
+    bool m_isActive{true};
+
+    /**
+     * @brief Number of threads kept in the pool, even if idle.
+     */
+    const unsigned m_kMinNumOfThreads;
+
+    /**
+     * @brief Number of threads waiting for a job.
+     */
+    unsigned m_numOfIdleThreads{0};
+
+    /**
+     * @brief Number of jobs in m_jobQueue.
+     */
+    unsigned m_numOfQueuedJobs{0};
+
+    /**
+     * @brief Mutex to protect the job queue.
+     */
+    std::mutex m_jobMutex{};
+
+    /**
+     * @brief New job condition variable.
+     */
+    std::condition_variable m_jobCV{};
+
+    /**
+     * @brief Queue of jobs waiting for a free thread.
+     */
+    RecyclingQueue<std::function<void()>> m_jobQueue{};
+
+    /**
+     * @brief The pool threads.
+     */
+    std::list<std::thread> m_threads{};
+
+    /**
+     * @brief Threads which left the pool after being idle, waiting to be joined.
+     */
+    std::vector<std::thread> m_exitedThreads{};
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_WORKER_THREAD_POOL_H_
@@ -47,6 +47,7 @@ private:
     void addSampleRateAndChannelsToCaps(GstCaps *caps) const;
     void addMpegVersionToCaps(GstCaps *caps) const;
     GstCaps *createCapsFromMediaSource() const;
+    void resetAppliedCapsParameters() const;
 
     PlayerContext &m_context;
     std::shared_ptr<IGstWrapper> m_gstWrapper;
@@ -20,6 +20,8 @@
 #ifndef FIREBOLT_RIALTO_SERVER_I_PLAYER_TASK_H_
 #define FIREBOLT_RIALTO_SERVER_I_PLAYER_TASK_H_
 
+#include <cstddef>
+
 namespace firebolt::rialto::server
 {
 class IPlayerTask
@@ -33,6 +35,23 @@ public:
     IPlayerTask &operator=(IPlayerTask &&) = delete;
 
     virtual void execute() const = 0;
+
+    /**
+     * @brief Allocates the task from the PlayerTaskPool, so that creating tasks does not hit the heap.
+     *
+     * @param[in] size : The size of the task object.
+     *
+     * @retval the memory for the task.
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     * @brief Returns the task memory to the PlayerTaskPool.
+     *
+     * @param[in] ptr  : The memory of the task object.
+     * @param[in] size : The size of the task object.
+     */
+    static void operator delete(void *ptr, std::size_t size);
 };
 } // namespace firebolt::rialto::server
 
@@ -112,11 +112,13 @@ public:
      * @brief Creates a NeedData task.
      *
      * @param[in] context : The GstPlayer context
+     * @param[in] player  : The GstPlayer instance
      * @param[in] src     : The source, which reports need data.
      *
      * @retval the new NeedData task instance.
      */
-    virtual std::unique_ptr<IPlayerTask> createNeedData(PlayerContext &context, GstAppSrc *src) const = 0;
+    virtual std::unique_ptr<IPlayerTask> createNeedData(PlayerContext &context, IGstPlayerPrivate &player,
+                                                        GstAppSrc *src) const = 0;
 
     /**
      * @brief Creates a Pause task.
@@ -227,6 +229,15 @@ public:
     virtual std::unique_ptr<IPlayerTask> createSetVideoGeometry(PlayerContext &context, IGstPlayerPrivate &player,
                                                                 const Rectangle &rectangle) const = 0;
 
+    /**
+     * @brief Creates a ShmBuffersReleased task.
+     *
+     * @param[in] player    : The GstPlayer instance
+     *
+     * @retval the new ShmBuffersReleased task instance.
+     */
+    virtual std::unique_ptr<IPlayerTask> createShmBuffersReleased(IGstPlayerPrivate &player) const = 0;
+
     /**
      * @brief Creates a Shutdown task.
      *
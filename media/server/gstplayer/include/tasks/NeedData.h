@@ -20,7 +20,7 @@
 #ifndef FIREBOLT_RIALTO_SERVER_NEED_DATA_H_
 #define FIREBOLT_RIALTO_SERVER_NEED_DATA_H_
 
-#include "IGstPlayerClient.h"
+#include "IGstPlayerPrivate.h"
 #include "IPlayerTask.h"
 #include "PlayerContext.h"
 #include <gst/app/gstappsrc.h>
@@ -30,13 +30,13 @@ namespace firebolt::rialto::server
 class NeedData : public IPlayerTask
 {
 public:
-    NeedData(PlayerContext &context, IGstPlayerClient *client, GstAppSrc *src);
+    NeedData(PlayerContext &context, IGstPlayerPrivate &player, GstAppSrc *src);
     ~NeedData() override;
     void execute() const override;
 
 private:
     PlayerContext &m_context;
-    IGstPlayerClient *m_gstPlayerClient;
+    IGstPlayerPrivate &m_player;
     GstAppSrc *m_src;
 };
 } // namespace firebolt::rialto::server
@@ -46,7 +46,8 @@ public:
     std::unique_ptr<IPlayerTask> createFinishSetupSource(PlayerContext &context, IGstPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createHandleBusMessage(PlayerContext &context, IGstPlayerPrivate &player,
                                                         GstMessage *message) const override;
-    std::unique_ptr<IPlayerTask> createNeedData(PlayerContext &context, GstAppSrc *src) const override;
+    std::unique_ptr<IPlayerTask> createNeedData(PlayerContext &context, IGstPlayerPrivate &player,
+                                                GstAppSrc *src) const override;
     std::unique_ptr<IPlayerTask> createPause(IGstPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createPlay(IGstPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask>
@@ -64,6 +65,7 @@ public:
                                                    GstElement *source) const override;
     std::unique_ptr<IPlayerTask> createSetVideoGeometry(PlayerContext &context, IGstPlayerPrivate &player,
                                                         const Rectangle &rectangle) const override;
+    std::unique_ptr<IPlayerTask> createShmBuffersReleased(IGstPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createShutdown(IGstPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createStop(PlayerContext &context, IGstPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createUnderflow(IGstPlayerPrivate &player, bool &underflowFlag) const override;
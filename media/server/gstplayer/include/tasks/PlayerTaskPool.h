@@ -0,0 +1,67 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef FIREBOLT_RIALTO_SERVER_PLAYER_TASK_POOL_H_
+#define FIREBOLT_RIALTO_SERVER_PLAYER_TASK_POOL_H_
+
+#include <cstddef>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief Process wide pool of fixed size memory blocks for the player tasks.
+ *
+ * Blocks are allocated in chunks and never returned to the heap, so once the pool has grown to the
+ * number of tasks alive at the same time, creating and destroying tasks makes no heap allocations.
+ * Objects bigger than a block are allocated on the heap.
+ */
+class PlayerTaskPool
+{
+public:
+    /**
+     * @brief The size of a single block.
+     */
+    static constexpr std::size_t kBlockSize{256};
+
+    /**
+     * @brief Allocates memory for a task.
+     *
+     * @param[in] size : The size of the task object.
+     *
+     * @retval the allocated memory.
+     */
+    static void *allocate(std::size_t size);
+
+    /**
+     * @brief Releases memory allocated with allocate().
+     *
+     * @param[in] ptr  : The memory to release.
+     * @param[in] size : The size passed to allocate().
+     */
+    static void deallocate(void *ptr, std::size_t size);
+
+    /**
+     * @brief Gets the number of blocks allocated from the heap so far.
+     *
+     * @retval the number of blocks.
+     */
+    static std::size_t getNumOfBlocks();
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_PLAYER_TASK_POOL_H_
@@ -25,6 +25,15 @@
 #include "tasks/IPlayerTask.h"
 #include "tasks/IPlayerTaskFactory.h"
 
+namespace
+{
+/**
+ * @brief Time to wait for the sync handler release. Gstreamer refuses to replace an already installed sync handler
+ *        without releasing ours, so it can't be waited for indefinitely.
+ */
+constexpr std::chrono::seconds kSyncHandlerReleaseTimeout{1};
+} // namespace
+
 namespace firebolt::rialto::server
 {
 std::unique_ptr<IGstDispatcherThread> GstDispatcherThreadFactory::createGstDispatcherThread(
@@ -38,81 +47,112 @@ GstDispatcherThread::GstDispatcherThread(PlayerContext &playerContext, IGstPlaye
                                          const std::shared_ptr<IGstWrapper> &gstWrapper, IWorkerThread &workerThread,
                                          const IPlayerTaskFactory &taskFactory)
     : m_context{playerContext}, m_player{player}, m_gstWrapper{gstWrapper}, m_workerThread{workerThread},
-      m_kTaskFactory{taskFactory}, m_isGstreamerDispatcherActive{true}
+      m_kTaskFactory{taskFactory}, m_bus{nullptr}, m_isGstreamerDispatcherActive{true}, m_isSyncHandlerInstalled{false}
 {
     RIALTO_SERVER_LOG_INFO("GstDispatcherThread is starting");
-    m_gstBusDispatcherThread = std::thread(&GstDispatcherThread::gstBusEventHandler, this, m_context.pipeline);
+    m_bus = m_gstWrapper->gstPipelineGetBus(GST_PIPELINE(m_context.pipeline));
+    if (!m_bus)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to get gst bus");
+        return;
+    }
+
+    m_isSyncHandlerInstalled = true;
+    m_gstWrapper->gstBusSetSyncHandler(m_bus, &GstDispatcherThread::onBusMessage, this,
+                                       &GstDispatcherThread::onSyncHandlerReleased);
 }
 
 GstDispatcherThread::~GstDispatcherThread()
 {
     RIALTO_SERVER_LOG_INFO("Stopping GstDispatcherThread");
-    m_isGstreamerDispatcherActive = false;
-    if (m_gstBusDispatcherThread.joinable())
+    if (!m_bus)
     {
-        m_gstBusDispatcherThread.join();
+        return;
     }
+
+    // Replacing the handler releases the old one as soon as no streaming thread is running it anymore
+    m_gstWrapper->gstBusSetSyncHandler(m_bus, nullptr, nullptr, nullptr);
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isGstreamerDispatcherActive = false;
+        if (!m_syncHandlerReleasedCv.wait_for(lock, kSyncHandlerReleaseTimeout,
+                                              [this]() { return !m_isSyncHandlerInstalled; }))
+        {
+            RIALTO_SERVER_LOG_ERROR("Gst bus sync handler was not released, it might have never been installed");
+        }
+    }
+
+    RIALTO_SERVER_LOG_INFO("Gstbus dispatcher exitting");
+    m_gstWrapper->gstObjectUnref(m_bus);
+}
+
+GstBusSyncReply GstDispatcherThread::onBusMessage(GstBus *bus, GstMessage *message, gpointer userData)
+{
+    static_cast<GstDispatcherThread *>(userData)->handleBusMessage(message);
+    return GST_BUS_DROP;
 }
 
-void GstDispatcherThread::gstBusEventHandler(GstElement *pipeline)
+void GstDispatcherThread::onSyncHandlerReleased(gpointer userData)
 {
-    GstBus *bus = m_gstWrapper->gstPipelineGetBus(GST_PIPELINE(m_context.pipeline));
-    if (!bus)
+    GstDispatcherThread *self = static_cast<GstDispatcherThread *>(userData);
+    std::unique_lock<std::mutex> lock{self->m_mutex};
+    self->m_isSyncHandlerInstalled = false;
+    self->m_syncHandlerReleasedCv.notify_one();
+}
+
+void GstDispatcherThread::handleBusMessage(GstMessage *message)
+{
+    constexpr GstMessageType kDispatchedMessageTypes{
+        static_cast<GstMessageType>(GST_MESSAGE_STATE_CHANGED | GST_MESSAGE_QOS | GST_MESSAGE_EOS | GST_MESSAGE_ERROR)};
+    if (!(GST_MESSAGE_TYPE(message) & kDispatchedMessageTypes))
     {
-        RIALTO_SERVER_LOG_ERROR("Failed to get gst bus");
         return;
     }
 
-    while (m_isGstreamerDispatcherActive)
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (!m_isGstreamerDispatcherActive)
     {
-        GstMessage *message =
-            m_gstWrapper->gstBusTimedPopFiltered(bus, 100 * GST_MSECOND,
-                                                 static_cast<GstMessageType>(GST_MESSAGE_STATE_CHANGED | GST_MESSAGE_QOS |
-                                                                             GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+        return;
+    }
 
-        if (message)
+    if (GST_MESSAGE_SRC(message) == GST_OBJECT(m_context.pipeline))
+    {
+        switch (GST_MESSAGE_TYPE(message))
+        {
+        case GST_MESSAGE_STATE_CHANGED:
         {
-            if (GST_MESSAGE_SRC(message) == GST_OBJECT(m_context.pipeline))
+            GstState oldState, newState, pending;
+            m_gstWrapper->gstMessageParseStateChanged(message, &oldState, &newState, &pending);
+            switch (newState)
             {
-                switch (GST_MESSAGE_TYPE(message))
-                {
-                case GST_MESSAGE_STATE_CHANGED:
-                {
-                    GstState oldState, newState, pending;
-                    m_gstWrapper->gstMessageParseStateChanged(message, &oldState, &newState, &pending);
-                    switch (newState)
-                    {
-                    case GST_STATE_NULL:
-                    {
-                        m_isGstreamerDispatcherActive = false;
-                    }
-                    case GST_STATE_READY:
-                    case GST_STATE_PAUSED:
-                    case GST_STATE_PLAYING:
-                    case GST_STATE_VOID_PENDING:
-                    {
-                        break;
-                    }
-                    }
-                    break;
-                }
-                case GST_MESSAGE_ERROR:
-                {
-                    m_isGstreamerDispatcherActive = false;
-                    break;
-                }
-                default:
-                {
-                    break;
-                }
-                }
+            case GST_STATE_NULL:
+            {
+                m_isGstreamerDispatcherActive = false;
             }
-
-            m_workerThread.enqueueTask(m_kTaskFactory.createHandleBusMessage(m_context, m_player, message));
+            case GST_STATE_READY:
+            case GST_STATE_PAUSED:
+            case GST_STATE_PLAYING:
+            case GST_STATE_VOID_PENDING:
+            {
+                break;
+            }
+            }
+            break;
+        }
+        case GST_MESSAGE_ERROR:
+        {
+            m_isGstreamerDispatcherActive = false;
+            break;
+        }
+        default:
+        {
+            break;
+        }
         }
     }
 
-    RIALTO_SERVER_LOG_INFO("Gstbus dispatcher exitting");
-    m_gstWrapper->gstObjectUnref(bus);
+    // The bus drops its reference once the sync handler returns
+    m_workerThread.enqueueTask(
+        m_kTaskFactory.createHandleBusMessage(m_context, m_player, m_gstWrapper->gstMessageRef(message)));
 }
 } // namespace firebolt::rialto::server
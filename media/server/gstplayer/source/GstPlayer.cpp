@@ -19,12 +19,15 @@
 
 #include "GstPlayer.h"
 #include "GstDispatcherThread.h"
+#include "ISharedMemoryBuffer.h"
 #include "ITimer.h"
 #include "RialtoServerLogging.h"
 #include "WorkerThread.h"
 #include "tasks/PlayerTaskFactory.h"
 #include <IMediaPipeline.h>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 
 namespace
 {
@@ -41,6 +44,27 @@ constexpr std::chrono::milliseconds kSourceSetupFinishTimeoutMs{200};
  *        whenever the session moves to another playback state.
  */
 constexpr std::chrono::milliseconds kPositionReportTimerMs{250};
+
+/**
+ * @brief The longest time the player destruction waits for gstreamer to release the buffers wrapping the shared
+ *        memory. An element leaking a buffer must not hang the teardown of the session.
+ */
+constexpr std::chrono::seconds kShmBuffersReleaseTimeout{3};
+
+/**
+ * @brief Name of the environment variable enabling the zero copy mode of shared memory media samples.
+ *        When enabled, GstBuffers of clear samples wrap the shared memory region instead of copying the samples.
+ *        The region stays mapped writable in the client, so the client can change the data, while the demuxers
+ *        and decoders of the server are still parsing it. Encrypted samples are always copied, as they are
+ *        decrypted in place and the clear content must not be exposed to the client.
+ */
+const char *kShmZeroCopyEnvVariableName{"RIALTO_SHM_ZERO_COPY"};
+
+bool isShmZeroCopyEnabled()
+{
+    const char *envVar = getenv(kShmZeroCopyEnvVariableName);
+    return envVar && (strcmp(envVar, "1") == 0 || strcmp(envVar, "true") == 0);
+}
 } // namespace
 
 namespace firebolt::rialto::server
@@ -136,10 +160,18 @@ GstPlayer::GstPlayer(IGstPlayerClient *client, IDecryptionService &decryptionSer
                      std::unique_ptr<IWorkerThreadFactory> workerThreadFactory,
                      std::unique_ptr<IGstDispatcherThreadFactory> gstDispatcherThreadFactory)
     : m_gstPlayerClient(client), m_gstWrapper{gstWrapper}, m_glibWrapper{glibWrapper}, m_timerFactory{timerFactory},
-      m_taskFactory{std::move(taskFactory)}
+      m_taskFactory{std::move(taskFactory)}, m_isShmZeroCopyEnabled{isShmZeroCopyEnabled()},
+      m_shmBuffersInUse{std::make_shared<ShmBuffersInUse>()}
 {
     RIALTO_SERVER_LOG_DEBUG("GstPlayer is constructed.");
 
+    m_shmBuffersInUse->player = this;
+    if (m_isShmZeroCopyEnabled)
+    {
+        RIALTO_SERVER_LOG_WARN("Shared memory zero copy mode enabled, decoders read clear samples from memory "
+                               "writable by the client");
+    }
+
     m_context.decryptionService = &decryptionService;
 
     // Check the video requirements for a limited video.
@@ -197,7 +229,6 @@ GstPlayer::~GstPlayer()
     // Shutdown task thread
     m_workerThread->enqueueTask(m_taskFactory->createShutdown(*this));
     m_workerThread->join();
-    m_workerThread.reset();
 
     if (m_finishSourceSetupTimer && m_finishSourceSetupTimer->isActive())
     {
@@ -218,9 +249,11 @@ GstPlayer::~GstPlayer()
     m_context.videoBuffers.clear();
 
     m_taskFactory->createStop(m_context, *this)->execute();
-    GstBus *bus = m_gstWrapper->gstPipelineGetBus(GST_PIPELINE(m_context.pipeline));
-    m_gstWrapper->gstBusSetSyncHandler(bus, nullptr, nullptr, nullptr);
-    m_gstWrapper->gstObjectUnref(bus);
+
+    // The shared memory partition is unmapped after the player is destroyed, so gstreamer must not be using it anymore.
+    // Worker thread is kept until then, the release callbacks may still schedule tasks on it.
+    waitForShmBuffersReleased();
+    m_workerThread.reset();
 
     if (m_context.source)
     {
@@ -324,7 +357,25 @@ void GstPlayer::attachSamples(const std::shared_ptr<IDataReader> &dataReader)
 {
     if (m_workerThread)
     {
-        m_workerThread->enqueueTask(m_taskFactory->createReadShmDataAndAttachSamples(m_context, *this, dataReader));
+        // The shared memory slot is freed with the last reference to the data reader. It may be held by the task or
+        // by the buffers wrapping the shared memory, so more data is requested, when the wrapping reader is dropped.
+        // The last buffer may be released after the player is destroyed, the request is skipped then.
+        std::shared_ptr<IDataReader> playerDataReader{dataReader.get(),
+                                                      [buffersInUse = m_shmBuffersInUse,
+                                                       reader = dataReader](IDataReader *) mutable
+                                                      {
+                                                          reader.reset();
+                                                          std::unique_lock<std::mutex> lock{buffersInUse->mutex};
+                                                          GstPlayer *player{buffersInUse->player};
+                                                          if (player && player->m_workerThread)
+                                                          {
+                                                              player->m_workerThread->enqueueTask(
+                                                                  player->m_taskFactory->createShmBuffersReleased(
+                                                                      *player));
+                                                          }
+                                                      }};
+        m_workerThread->enqueueTask(
+            m_taskFactory->createReadShmDataAndAttachSamples(m_context, *this, playerDataReader));
     }
 }
 
@@ -363,7 +414,74 @@ GstBuffer *GstPlayer::createBuffer(const IMediaPipeline::MediaSegment &mediaSegm
 {
     GstBuffer *gstBuffer = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.getDataLength(), nullptr);
     m_gstWrapper->gstBufferFill(gstBuffer, 0, mediaSegment.getData(), mediaSegment.getDataLength());
+    setBufferMetadata(gstBuffer, mediaSegment);
+    return gstBuffer;
+}
+
+GstBuffer *GstPlayer::createShmBuffer(const IMediaPipeline::MediaSegment &mediaSegment,
+                                      const std::shared_ptr<IDataReader> &dataReader)
+{
+    // Encrypted samples are decrypted in place, so they are copied. Otherwise the clear content would be written
+    // to the shared memory, which the client can read.
+    const bool kIsSupportedType{mediaSegment.getType() == MediaSourceType::AUDIO ||
+                                mediaSegment.getType() == MediaSourceType::VIDEO};
+    if (!m_isShmZeroCopyEnabled || !kIsSupportedType || mediaSegment.isEncrypted() || !mediaSegment.getData() ||
+        0 == mediaSegment.getDataLength())
+    {
+        return createBuffer(mediaSegment);
+    }
 
+    ShmReleaseInfo *releaseInfo = new ShmReleaseInfo{m_shmBuffersInUse, mediaSegment.getType(), dataReader};
+    GstBuffer *gstBuffer =
+        m_gstWrapper->gstBufferNewWrappedFull(GST_MEMORY_FLAG_READONLY, const_cast<uint8_t *>(mediaSegment.getData()),
+                                              mediaSegment.getDataLength(), 0, mediaSegment.getDataLength(),
+                                              releaseInfo, &GstPlayer::onShmMemoryReleased);
+    if (!gstBuffer)
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to wrap shared memory, sample will be copied");
+        delete releaseInfo;
+        return createBuffer(mediaSegment);
+    }
+    {
+        std::unique_lock<std::mutex> lock{m_shmBuffersInUse->mutex};
+        ++((mediaSegment.getType() == MediaSourceType::AUDIO) ? m_shmBuffersInUse->audio : m_shmBuffersInUse->video);
+    }
+    setBufferMetadata(gstBuffer, mediaSegment);
+    return gstBuffer;
+}
+
+void GstPlayer::onShmMemoryReleased(gpointer userData)
+{
+    ShmReleaseInfo *releaseInfo = static_cast<ShmReleaseInfo *>(userData);
+    std::shared_ptr<ShmBuffersInUse> buffersInUse{releaseInfo->buffersInUse};
+    const MediaSourceType kType = releaseInfo->type;
+    // Dropping the data reader reference frees the shared memory slot, if it was the last one
+    delete releaseInfo;
+
+    std::unique_lock<std::mutex> lock{buffersInUse->mutex};
+    std::uint32_t &count = (kType == MediaSourceType::AUDIO) ? buffersInUse->audio : buffersInUse->video;
+    if (--count == 0)
+    {
+        buffersInUse->releasedCv.notify_all();
+    }
+}
+
+void GstPlayer::waitForShmBuffersReleased()
+{
+    ShmBuffersInUse &inUse{*m_shmBuffersInUse};
+    std::unique_lock<std::mutex> lock{inUse.mutex};
+    if (!inUse.releasedCv.wait_for(lock, kShmBuffersReleaseTimeout,
+                                   [&inUse]() { return 0 == inUse.audio && 0 == inUse.video; }))
+    {
+        RIALTO_SERVER_LOG_ERROR("Gstreamer didn't release %u audio and %u video shared memory buffers in %lld s. "
+                                "Elements still holding them may read the data of the next session.",
+                                inUse.audio, inUse.video, static_cast<long long>(kShmBuffersReleaseTimeout.count()));
+    }
+    inUse.player = nullptr;
+}
+
+void GstPlayer::setBufferMetadata(GstBuffer *gstBuffer, const IMediaPipeline::MediaSegment &mediaSegment) const
+{
     if (mediaSegment.isEncrypted())
     {
         GstBuffer *keyId = nullptr;
@@ -419,7 +537,6 @@ GstBuffer *GstPlayer::createBuffer(const IMediaPipeline::MediaSegment &mediaSegm
 
     GST_BUFFER_TIMESTAMP(gstBuffer) = mediaSegment.getTimeStamp();
     GST_BUFFER_DURATION(gstBuffer) = mediaSegment.getDuration();
-    return gstBuffer;
 }
 
 void GstPlayer::notifyNeedMediaData(bool audioNotificationNeeded, bool videoNotificationNeeded)
@@ -427,22 +544,42 @@ void GstPlayer::notifyNeedMediaData(bool audioNotificationNeeded, bool videoNoti
     if (audioNotificationNeeded)
     {
         // Mark needMediaData as received
-        m_context.audioNeedDataPending = false;
-        // Send new NeedMediaData if we still need it
-        if (m_gstPlayerClient && m_context.audioNeedData)
+        if (m_context.audioNeedDataPending > 0)
         {
-            m_context.audioNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::AUDIO);
+            --m_context.audioNeedDataPending;
         }
+        requestMediaData(MediaSourceType::AUDIO);
     }
     else if (videoNotificationNeeded)
     {
         // Mark needMediaData as received
-        m_context.videoNeedDataPending = false;
-        // Send new NeedMediaData if we still need it
-        if (m_gstPlayerClient && m_context.videoNeedData)
+        if (m_context.videoNeedDataPending > 0)
         {
-            m_context.videoNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::VIDEO);
+            --m_context.videoNeedDataPending;
         }
+        requestMediaData(MediaSourceType::VIDEO);
+    }
+}
+
+void GstPlayer::notifyShmBuffersReleased()
+{
+    // The data reader doesn't know its source, requests are sent only for the sources with a free slot
+    requestMediaData(MediaSourceType::AUDIO);
+    requestMediaData(MediaSourceType::VIDEO);
+}
+
+void GstPlayer::requestMediaData(const MediaSourceType &mediaSourceType)
+{
+    const bool kIsAudio{MediaSourceType::AUDIO == mediaSourceType};
+    bool &needData{kIsAudio ? m_context.audioNeedData : m_context.videoNeedData};
+    std::uint32_t &needDataPending{kIsAudio ? m_context.audioNeedDataPending : m_context.videoNeedDataPending};
+
+    // Send new NeedMediaData requests if we still need data, to keep all shared memory slots filled. Sending fails,
+    // when no slot is free, because gstreamer still uses its data. It is retried in notifyShmBuffersReleased().
+    while (m_gstPlayerClient && needData && needDataPending < kShmSlotsPerSource &&
+           m_gstPlayerClient->notifyNeedMediaData(mediaSourceType))
+    {
+        ++needDataPending;
     }
 }
 
@@ -452,6 +589,11 @@ void GstPlayer::attachAudioData()
     {
         return;
     }
+    pushPendingAudioBuffers();
+}
+
+void GstPlayer::pushPendingAudioBuffers()
+{
     if (!m_context.audioAppSrc)
     {
         auto elem = m_context.streamInfo.find(firebolt::rialto::MediaSourceType::AUDIO);
@@ -463,16 +605,8 @@ void GstPlayer::attachAudioData()
 
     if (m_context.audioAppSrc)
     {
-        for (GstBuffer *buffer : m_context.audioBuffers)
-        {
-            m_gstWrapper->gstAppSrcPushBuffer(GST_APP_SRC(m_context.audioAppSrc), buffer);
-        }
-
-        if (m_context.audioBuffers.size())
-        {
-            m_context.lastAudioSampleTimestamps = static_cast<int64_t>(GST_BUFFER_PTS(m_context.audioBuffers.back()));
-        }
-        m_context.audioBuffers.clear();
+        m_context.lastAudioSampleTimestamps = static_cast<int64_t>(GST_BUFFER_PTS(m_context.audioBuffers.back()));
+        pushBuffers(m_context.audioAppSrc, m_context.audioBuffers);
         m_context.audioDataPushed = true;
         if (!m_context.bufferedNotificationSent && m_context.videoDataPushed && m_gstPlayerClient)
         {
@@ -489,6 +623,11 @@ void GstPlayer::attachVideoData()
     {
         return;
     }
+    pushPendingVideoBuffers();
+}
+
+void GstPlayer::pushPendingVideoBuffers()
+{
     if (!m_context.videoAppSrc)
     {
         auto elem = m_context.streamInfo.find(firebolt::rialto::MediaSourceType::VIDEO);
@@ -499,11 +638,7 @@ void GstPlayer::attachVideoData()
     }
     if (m_context.videoAppSrc)
     {
-        for (GstBuffer *buffer : m_context.videoBuffers)
-        {
-            m_gstWrapper->gstAppSrcPushBuffer(GST_APP_SRC(m_context.videoAppSrc), buffer);
-        }
-        m_context.videoBuffers.clear();
+        pushBuffers(m_context.videoAppSrc, m_context.videoBuffers);
         m_context.videoDataPushed = true;
         if (!m_context.bufferedNotificationSent && m_context.audioDataPushed && m_gstPlayerClient)
         {
@@ -514,8 +649,35 @@ void GstPlayer::attachVideoData()
     }
 }
 
+void GstPlayer::pushBuffers(GstElement *appSrc, std::vector<GstBuffer *> &buffers)
+{
+    if (buffers.size() == 1)
+    {
+        m_gstWrapper->gstAppSrcPushBuffer(GST_APP_SRC(appSrc), buffers.front());
+    }
+    else
+    {
+        // One push takes the appsrc lock and emits its signals once for the whole batch
+        GstBufferList *bufferList = m_gstWrapper->gstBufferListNewSized(buffers.size());
+        for (GstBuffer *buffer : buffers)
+        {
+            m_gstWrapper->gstBufferListAdd(bufferList, buffer);
+        }
+        m_gstWrapper->gstAppSrcPushBufferList(GST_APP_SRC(appSrc), bufferList);
+    }
+    buffers.clear();
+}
+
 void GstPlayer::updateAudioCaps(int32_t rate, int32_t channels)
 {
+    constexpr int kInvalidRate{0}, kInvalidChannels{0};
+    const bool kRateChanged{rate != kInvalidRate && rate != m_context.audioCapsSampleRate};
+    const bool kChannelsChanged{channels != kInvalidChannels && channels != m_context.audioCapsNumberOfChannels};
+    if (!kRateChanged && !kChannelsChanged)
+    {
+        return;
+    }
+
     if (!m_context.audioAppSrc)
     {
         auto elem = m_context.streamInfo.find(firebolt::rialto::MediaSourceType::AUDIO);
@@ -527,24 +689,28 @@ void GstPlayer::updateAudioCaps(int32_t rate, int32_t channels)
 
     if (m_context.audioAppSrc)
     {
-        constexpr int kInvalidRate{0}, kInvalidChannels{0};
-        bool capsChanged{false};
+        if (!m_context.audioBuffers.empty())
+        {
+            // The pending buffers belong to the old caps, so they have to reach the appsrc first
+            pushPendingAudioBuffers();
+        }
         GstCaps *currentCaps = m_gstWrapper->gstAppSrcGetCaps(GST_APP_SRC(m_context.audioAppSrc));
         GstCaps *newCaps = m_gstWrapper->gstCapsCopy(currentCaps);
-        if (rate != kInvalidRate)
+        if (kRateChanged)
         {
             m_gstWrapper->gstCapsSetSimple(newCaps, "rate", G_TYPE_INT, rate, NULL);
-            capsChanged = true;
+            m_context.audioCapsSampleRate = rate;
         }
-        if (channels != kInvalidChannels)
+        if (kChannelsChanged)
         {
             m_gstWrapper->gstCapsSetSimple(newCaps, "channels", G_TYPE_INT, channels, NULL);
-            capsChanged = true;
-        }
-        if (capsChanged)
-        {
-            m_gstWrapper->gstAppSrcSetCaps(GST_APP_SRC(m_context.audioAppSrc), newCaps);
+            m_context.audioCapsNumberOfChannels = channels;
         }
+        m_gstWrapper->gstAppSrcSetCaps(GST_APP_SRC(m_context.audioAppSrc), newCaps);
+        ++m_context.audioCapsUpdates;
+        RIALTO_SERVER_LOG_DEBUG("Audio caps updated to rate: %d, channels: %d, caps updates: %u",
+                                m_context.audioCapsSampleRate, m_context.audioCapsNumberOfChannels,
+                                m_context.audioCapsUpdates);
         m_gstWrapper->gstCapsUnref(newCaps);
         m_gstWrapper->gstCapsUnref(currentCaps);
     }
@@ -552,6 +718,11 @@ void GstPlayer::updateAudioCaps(int32_t rate, int32_t channels)
 
 void GstPlayer::updateVideoCaps(int32_t width, int32_t height)
 {
+    if (width == m_context.videoCapsWidth && height == m_context.videoCapsHeight)
+    {
+        return;
+    }
+
     if (!m_context.videoAppSrc)
     {
         auto elem = m_context.streamInfo.find(firebolt::rialto::MediaSourceType::VIDEO);
@@ -563,12 +734,22 @@ void GstPlayer::updateVideoCaps(int32_t width, int32_t height)
 
     if (m_context.videoAppSrc)
     {
+        if (!m_context.videoBuffers.empty())
+        {
+            // The pending buffers belong to the old caps, so they have to reach the appsrc first
+            pushPendingVideoBuffers();
+        }
         GstCaps *currentCaps = m_gstWrapper->gstAppSrcGetCaps(GST_APP_SRC(m_context.videoAppSrc));
         GstCaps *newCaps = m_gstWrapper->gstCapsCopy(currentCaps);
 
         m_gstWrapper->gstCapsSetSimple(newCaps, "width", G_TYPE_INT, width, "height", G_TYPE_INT, height, NULL);
 
         m_gstWrapper->gstAppSrcSetCaps(GST_APP_SRC(m_context.videoAppSrc), newCaps);
+        m_context.videoCapsWidth = width;
+        m_context.videoCapsHeight = height;
+        ++m_context.videoCapsUpdates;
+        RIALTO_SERVER_LOG_DEBUG("Video caps updated to %dx%d, caps updates: %u", width, height,
+                                m_context.videoCapsUpdates);
 
         m_gstWrapper->gstCapsUnref(currentCaps);
         m_gstWrapper->gstCapsUnref(newCaps);
@@ -579,7 +760,7 @@ void GstPlayer::scheduleNeedMediaData(GstAppSrc *src)
 {
     if (m_workerThread)
     {
-        m_workerThread->enqueueTask(m_taskFactory->createNeedData(m_context, src));
+        m_workerThread->enqueueTask(m_taskFactory->createNeedData(m_context, *this, src));
     }
 }
 
@@ -22,69 +22,77 @@
 
 namespace firebolt::rialto::server
 {
+namespace
+{
+/**
+ * @brief Maximum number of tasks run in one go, before giving the pool thread to the other players.
+ */
+constexpr int kMaxTasksPerRun{16};
+} // namespace
+
 std::unique_ptr<IWorkerThread> WorkerThreadFactory::createWorkerThread() const
 {
-    return std::make_unique<WorkerThread>();
+    return std::make_unique<WorkerThread>(WorkerThreadPool::getInstance());
 }
 
-WorkerThread::WorkerThread()
+WorkerThread::WorkerThread(const std::shared_ptr<WorkerThreadPool> &pool) : m_pool{pool}
 {
     RIALTO_SERVER_LOG_INFO("Worker thread is starting");
-    m_taskThread = std::thread(&WorkerThread::taskHandler, this);
 }
 
 WorkerThread::~WorkerThread()
 {
-    if (m_taskThread.joinable())
-    {
-        m_taskThread.join();
-    }
+    join();
 }
 
 void WorkerThread::stop()
 {
     RIALTO_SERVER_LOG_INFO("Stopping worker thread");
-    if (m_isTaskThreadActive)
-    {
-        m_isTaskThreadActive = false;
-    }
+    std::unique_lock<std::mutex> lock(m_taskMutex);
+    m_isTaskThreadActive = false;
 }
 
 void WorkerThread::join()
 {
-    if (m_taskThread.joinable())
-    {
-        m_taskThread.join();
-    }
+    std::unique_lock<std::mutex> lock(m_taskMutex);
+    m_taskCV.wait(lock, [this] { return !m_isScheduled && (!m_isTaskThreadActive || m_taskQueue.empty()); });
 }
 
 void WorkerThread::enqueueTask(std::unique_ptr<IPlayerTask> &&task)
 {
+    std::unique_lock<std::mutex> lock(m_taskMutex);
+    m_taskQueue.push(std::move(task));
+    if (m_isTaskThreadActive && !m_isScheduled)
     {
-        std::unique_lock<std::mutex> lock(m_taskMutex);
-        m_taskQueue.push(std::move(task));
+        m_isScheduled = true;
+        m_pool->post([this]() { taskHandler(); });
     }
-    m_taskCV.notify_one();
 }
 
 void WorkerThread::taskHandler()
 {
-    while (m_isTaskThreadActive)
+    for (int i = 0; i < kMaxTasksPerRun; ++i)
     {
-        std::unique_ptr<IPlayerTask> task = waitForTask();
+        std::unique_ptr<IPlayerTask> task = getNextTask();
+        if (!task)
+        {
+            // Nothing may access this object anymore, it can be destroyed as soon as the lock is released
+            return;
+        }
         task->execute();
     }
+    m_pool->post([this]() { taskHandler(); });
 }
 
-std::unique_ptr<IPlayerTask> WorkerThread::waitForTask()
+std::unique_ptr<IPlayerTask> WorkerThread::getNextTask()
 {
     std::unique_lock<std::mutex> lock(m_taskMutex);
-    if (m_taskQueue.empty())
+    if (!m_isTaskThreadActive || m_taskQueue.empty())
     {
-        m_taskCV.wait(lock, [this] { return !m_taskQueue.empty(); });
+        m_isScheduled = false;
+        m_taskCV.notify_all();
+        return nullptr;
     }
-    std::unique_ptr<IPlayerTask> task = std::move(m_taskQueue.front());
-    m_taskQueue.pop();
-    return task;
+    return m_taskQueue.pop();
 }
 } // namespace firebolt::rialto::server
@@ -0,0 +1,147 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "WorkerThreadPool.h"
+#include "RialtoServerLogging.h"
+#include <algorithm>
+
+namespace
+{
+/**
+ * @brief The minimum number of pool threads, so that one blocking task does not stall the other players.
+ */
+constexpr unsigned kMinNumOfThreads{2};
+
+/**
+ * @brief Time after which an idle thread above the initial number of threads leaves the pool.
+ */
+constexpr std::chrono::seconds kIdleThreadTimeout{10};
+} // namespace
+
+namespace firebolt::rialto::server
+{
+std::shared_ptr<WorkerThreadPool> WorkerThreadPool::getInstance()
+{
+    static std::mutex instanceMutex;
+    static std::weak_ptr<WorkerThreadPool> instance;
+
+    std::unique_lock<std::mutex> lock{instanceMutex};
+    std::shared_ptr<WorkerThreadPool> pool = instance.lock();
+    if (!pool)
+    {
+        pool = std::make_shared<WorkerThreadPool>(std::max(kMinNumOfThreads, std::thread::hardware_concurrency()));
+        instance = pool;
+    }
+    return pool;
+}
+
+WorkerThreadPool::WorkerThreadPool(unsigned numOfThreads) : m_kMinNumOfThreads{numOfThreads}
+{
+    RIALTO_SERVER_LOG_INFO("Worker thread pool is starting %u threads", numOfThreads);
+    std::unique_lock<std::mutex> lock(m_jobMutex);
+    for (unsigned i = 0; i < numOfThreads; ++i)
+    {
+        startThread();
+    }
+}
+
+WorkerThreadPool::~WorkerThreadPool()
+{
+    RIALTO_SERVER_LOG_INFO("Stopping worker thread pool");
+    {
+        std::unique_lock<std::mutex> lock(m_jobMutex);
+        m_isActive = false;
+    }
+    m_jobCV.notify_all();
+    // The threads do not leave the pool once it is inactive, so the lists are not modified anymore
+    for (auto &thread : m_threads)
+    {
+        thread.join();
+    }
+    for (auto &thread : m_exitedThreads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerThreadPool::post(std::function<void()> &&job)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_jobMutex);
+        m_jobQueue.push(std::move(job));
+        ++m_numOfQueuedJobs;
+        for (auto &thread : m_exitedThreads)
+        {
+            thread.join();
+        }
+        m_exitedThreads.clear();
+        if (m_isActive && m_numOfQueuedJobs > m_numOfIdleThreads)
+        {
+            // All the threads are busy, possibly blocked in a task, so do not let the job wait for them
+            startThread();
+            RIALTO_SERVER_LOG_DEBUG("All worker threads are busy, pool grown to %zu threads", m_threads.size());
+        }
+    }
+    m_jobCV.notify_one();
+}
+
+size_t WorkerThreadPool::getNumOfThreads()
+{
+    std::unique_lock<std::mutex> lock(m_jobMutex);
+    return m_threads.size();
+}
+
+void WorkerThreadPool::startThread()
+{
+    // The new thread cannot look at its list node before m_jobMutex is released
+    auto self = m_threads.emplace(m_threads.end());
+    *self = std::thread(&WorkerThreadPool::threadHandler, this, self);
+}
+
+void WorkerThreadPool::threadHandler(std::list<std::thread>::iterator self)
+{
+    std::unique_lock<std::mutex> lock(m_jobMutex);
+    while (true)
+    {
+        ++m_numOfIdleThreads;
+        const bool kHasJob{
+            m_jobCV.wait_for(lock, kIdleThreadTimeout, [this] { return !m_isActive || !m_jobQueue.empty(); })};
+        --m_numOfIdleThreads;
+        if (!m_isActive)
+        {
+            break;
+        }
+        if (!kHasJob)
+        {
+            if (m_threads.size() > m_kMinNumOfThreads)
+            {
+                m_exitedThreads.push_back(std::move(*self));
+                m_threads.erase(self);
+                break;
+            }
+            continue;
+        }
+        std::function<void()> job = m_jobQueue.pop();
+        --m_numOfQueuedJobs;
+        lock.unlock();
+        job();
+        job = nullptr;
+        lock.lock();
+    }
+}
+} // namespace firebolt::rialto::server
@@ -71,18 +71,32 @@ AttachSamples::~AttachSamples()
 void AttachSamples::execute() const
 {
     RIALTO_SERVER_LOG_DEBUG("Executing AttachSamples");
-    for (AudioData audioData : m_audioData)
+    // Buffers are pushed to the appsrc in one go. Caps are only updated when they differ from the applied ones,
+    // which pushes the buffers queued with the previous caps first.
+    for (const AudioData &audioData : m_audioData)
     {
-        m_player.updateAudioCaps(audioData.rate, audioData.channels);
-
+        if (audioData.rate != m_context.audioCapsSampleRate ||
+            audioData.channels != m_context.audioCapsNumberOfChannels)
+        {
+            m_player.updateAudioCaps(audioData.rate, audioData.channels);
+        }
         m_context.audioBuffers.push_back(audioData.buffer);
-        m_player.attachAudioData();
     }
-    for (VideoData videoData : m_videoData)
+    if (!m_context.audioBuffers.empty())
     {
-        m_player.updateVideoCaps(videoData.width, videoData.height);
+        m_player.attachAudioData();
+    }
 
+    for (const VideoData &videoData : m_videoData)
+    {
+        if (videoData.width != m_context.videoCapsWidth || videoData.height != m_context.videoCapsHeight)
+        {
+            m_player.updateVideoCaps(videoData.width, videoData.height);
+        }
         m_context.videoBuffers.push_back(videoData.buffer);
+    }
+    if (!m_context.videoBuffers.empty())
+    {
         m_player.attachVideoData();
     }
     m_player.notifyNeedMediaData(!m_audioData.empty(), !m_videoData.empty());
@@ -72,6 +72,7 @@ void AttachSource::execute() const
 
         m_gstWrapper->gstAppSrcSetCaps(GST_APP_SRC(appSrc), caps);
         m_context.streamInfo.emplace(m_attachedSource.getType(), appSrc);
+        resetAppliedCapsParameters();
     }
     else
     {
@@ -82,6 +83,7 @@ void AttachSource::execute() const
                                   m_attachedSource.getType() == MediaSourceType::AUDIO ? "Audio" : "Video",
                                   strCaps.c_str());
             m_gstWrapper->gstAppSrcSetCaps(GST_APP_SRC(elem->second), caps);
+            resetAppliedCapsParameters();
         }
 
         if (appsrcCaps)
@@ -92,6 +94,21 @@ void AttachSource::execute() const
         m_gstWrapper->gstCapsUnref(caps);
 }
 
+void AttachSource::resetAppliedCapsParameters() const
+{
+    // The new caps do not carry the parameters of the samples, so the next sample has to apply them again
+    if (m_attachedSource.getType() == MediaSourceType::AUDIO)
+    {
+        m_context.audioCapsSampleRate = 0;
+        m_context.audioCapsNumberOfChannels = 0;
+    }
+    else if (m_attachedSource.getType() == MediaSourceType::VIDEO)
+    {
+        m_context.videoCapsWidth = 0;
+        m_context.videoCapsHeight = 0;
+    }
+}
+
 GstCaps *AttachSource::createSimpleCapsFromMimeType(const std::string &mimeType) const
 {
     static const std::unordered_map<std::string, std::string> mimeToMediaType =
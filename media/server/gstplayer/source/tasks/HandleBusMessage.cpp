@@ -22,6 +22,7 @@
 #include "IGstWrapper.h"
 #include "PlayerContext.h"
 #include "RialtoServerLogging.h"
+#include <string>
 
 namespace firebolt::rialto::server
 {
@@ -48,13 +49,13 @@ void HandleBusMessage::execute() const
         {
             GstState oldState, newState, pending;
             m_gstWrapper->gstMessageParseStateChanged(m_message, &oldState, &newState, &pending);
-            RIALTO_SERVER_LOG_INFO("State changed (old: %s, new: %s, pending: %s)",
-                                   m_gstWrapper->gstElementStateGetName(oldState),
-                                   m_gstWrapper->gstElementStateGetName(newState),
-                                   m_gstWrapper->gstElementStateGetName(pending));
+            // The state names are needed for the dot file, so they are taken once, whether INFO logs are enabled
+            const std::string oldStateName{m_gstWrapper->gstElementStateGetName(oldState)};
+            const std::string newStateName{m_gstWrapper->gstElementStateGetName(newState)};
+            RIALTO_SERVER_LOG_INFO("State changed (old: %s, new: %s, pending: %s)", oldStateName.c_str(),
+                                   newStateName.c_str(), m_gstWrapper->gstElementStateGetName(pending));
 
-            std::string filename = std::string(m_gstWrapper->gstElementStateGetName(oldState)) + "-" +
-                                   std::string(m_gstWrapper->gstElementStateGetName(newState));
+            std::string filename = oldStateName + "-" + newStateName;
             m_gstWrapper->gstDebugBinToDotFileWithTs(GST_BIN(m_context.pipeline), GST_DEBUG_GRAPH_SHOW_ALL,
                                                      filename.c_str());
             if (!m_gstPlayerClient)
@@ -18,15 +18,15 @@
  */
 
 #include "tasks/NeedData.h"
-#include "IGstPlayerClient.h"
+#include "IGstPlayerPrivate.h"
 #include "PlayerContext.h"
 #include "RialtoServerLogging.h"
 #include <gst/gst.h>
 
 namespace firebolt::rialto::server
 {
-NeedData::NeedData(PlayerContext &context, IGstPlayerClient *client, GstAppSrc *src)
-    : m_context{context}, m_gstPlayerClient{client}, m_src{src}
+NeedData::NeedData(PlayerContext &context, IGstPlayerPrivate &player, GstAppSrc *src)
+    : m_context{context}, m_player{player}, m_src{src}
 {
     RIALTO_SERVER_LOG_DEBUG("Constructing NeedData");
 }
@@ -45,10 +45,7 @@ void NeedData::execute() const
         if (elem->second == GST_ELEMENT(m_src))
         {
             m_context.audioNeedData = true;
-            if (m_gstPlayerClient && !m_context.audioNeedDataPending)
-            {
-                m_context.audioNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::AUDIO);
-            }
+            m_player.requestMediaData(MediaSourceType::AUDIO);
         }
     }
     elem = m_context.streamInfo.find(firebolt::rialto::MediaSourceType::VIDEO);
@@ -57,10 +54,7 @@ void NeedData::execute() const
         if (elem->second == GST_ELEMENT(m_src))
         {
             m_context.videoNeedData = true;
-            if (m_gstPlayerClient && !m_context.videoNeedDataPending)
-            {
-                m_context.videoNeedDataPending = m_gstPlayerClient->notifyNeedMediaData(MediaSourceType::VIDEO);
-            }
+            m_player.requestMediaData(MediaSourceType::VIDEO);
         }
     }
 }
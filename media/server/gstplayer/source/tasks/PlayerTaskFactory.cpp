@@ -36,6 +36,7 @@
 #include "tasks/SetVideoGeometry.h"
 #include "tasks/SetupElement.h"
 #include "tasks/SetupSource.h"
+#include "tasks/ShmBuffersReleased.h"
 #include "tasks/Shutdown.h"
 #include "tasks/Stop.h"
 #include "tasks/Underflow.h"
@@ -84,9 +85,10 @@ std::unique_ptr<IPlayerTask> PlayerTaskFactory::createHandleBusMessage(PlayerCon
     return std::make_unique<HandleBusMessage>(context, player, m_client, m_gstWrapper, message);
 }
 
-std::unique_ptr<IPlayerTask> PlayerTaskFactory::createNeedData(PlayerContext &context, GstAppSrc *src) const
+std::unique_ptr<IPlayerTask> PlayerTaskFactory::createNeedData(PlayerContext &context, IGstPlayerPrivate &player,
+                                                               GstAppSrc *src) const
 {
-    return std::make_unique<NeedData>(context, m_client, src);
+    return std::make_unique<NeedData>(context, player, src);
 }
 
 std::unique_ptr<IPlayerTask> PlayerTaskFactory::createPause(IGstPlayerPrivate &player) const
@@ -146,6 +148,11 @@ std::unique_ptr<IPlayerTask> PlayerTaskFactory::createSetVideoGeometry(PlayerCon
     return std::make_unique<SetVideoGeometry>(context, player, rectangle);
 }
 
+std::unique_ptr<IPlayerTask> PlayerTaskFactory::createShmBuffersReleased(IGstPlayerPrivate &player) const
+{
+    return std::make_unique<ShmBuffersReleased>(player);
+}
+
 std::unique_ptr<IPlayerTask> PlayerTaskFactory::createShutdown(IGstPlayerPrivate &player) const
 {
     return std::make_unique<Shutdown>(player);
@@ -0,0 +1,119 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "tasks/PlayerTaskPool.h"
+#include "tasks/IPlayerTask.h"
+#include <mutex>
+#include <new>
+
+namespace
+{
+/**
+ * @brief Number of blocks allocated from the heap at once.
+ */
+constexpr std::size_t kBlocksPerChunk{32};
+
+/**
+ * @brief An unused block, linked into the free list.
+ */
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+/**
+ * @brief The pool state.
+ */
+struct PoolState
+{
+    std::mutex mutex;
+    FreeBlock *freeList{nullptr};
+    std::size_t numOfBlocks{0};
+};
+
+PoolState &getPoolState()
+{
+    // Intentionally leaked: tasks may still be destroyed by other static objects during process exit.
+    static PoolState *state = new PoolState();
+    return *state;
+}
+} // namespace
+
+namespace firebolt::rialto::server
+{
+void *PlayerTaskPool::allocate(std::size_t size)
+{
+    if (size > kBlockSize)
+    {
+        return ::operator new(size);
+    }
+
+    PoolState &state = getPoolState();
+    std::unique_lock<std::mutex> lock{state.mutex};
+    if (!state.freeList)
+    {
+        char *chunk = static_cast<char *>(::operator new(kBlockSize * kBlocksPerChunk));
+        for (std::size_t i = 0; i < kBlocksPerChunk; ++i)
+        {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(chunk + i * kBlockSize);
+            block->next = state.freeList;
+            state.freeList = block;
+        }
+        state.numOfBlocks += kBlocksPerChunk;
+    }
+    FreeBlock *block = state.freeList;
+    state.freeList = block->next;
+    return block;
+}
+
+void PlayerTaskPool::deallocate(void *ptr, std::size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+    if (size > kBlockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    PoolState &state = getPoolState();
+    std::unique_lock<std::mutex> lock{state.mutex};
+    FreeBlock *block = static_cast<FreeBlock *>(ptr);
+    block->next = state.freeList;
+    state.freeList = block;
+}
+
+std::size_t PlayerTaskPool::getNumOfBlocks()
+{
+    PoolState &state = getPoolState();
+    std::unique_lock<std::mutex> lock{state.mutex};
+    return state.numOfBlocks;
+}
+
+void *IPlayerTask::operator new(std::size_t size)
+{
+    return PlayerTaskPool::allocate(size);
+}
+
+void IPlayerTask::operator delete(void *ptr, std::size_t size)
+{
+    PlayerTaskPool::deallocate(ptr, size);
+}
+} // namespace firebolt::rialto::server
@@ -44,16 +44,22 @@ void ReadShmDataAndAttachSamples::execute() const
     // Read media segments from shared memory
     IMediaPipeline::MediaSegmentVector mediaSegments = m_dataReader->readData();
 
+    // Buffers are pushed to the appsrc in one go. Caps are only updated when they differ from the applied ones,
+    // which pushes the buffers queued with the previous caps first.
     for (const auto &mediaSegment : mediaSegments)
     {
-        GstBuffer *gstBuffer = m_player.createBuffer(*mediaSegment);
+        GstBuffer *gstBuffer = m_player.createShmBuffer(*mediaSegment, m_dataReader);
         if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::VIDEO)
         {
             try
             {
                 IMediaPipeline::MediaSegmentVideo &videoSegment =
                     dynamic_cast<IMediaPipeline::MediaSegmentVideo &>(*mediaSegment);
-                m_player.updateVideoCaps(videoSegment.getWidth(), videoSegment.getHeight());
+                if (videoSegment.getWidth() != m_context.videoCapsWidth ||
+                    videoSegment.getHeight() != m_context.videoCapsHeight)
+                {
+                    m_player.updateVideoCaps(videoSegment.getWidth(), videoSegment.getHeight());
+                }
             }
             catch (const std::exception &e)
             {
@@ -61,7 +67,6 @@ void ReadShmDataAndAttachSamples::execute() const
             }
 
             m_context.videoBuffers.push_back(gstBuffer);
-            m_player.attachVideoData();
         }
         else if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::AUDIO)
         {
@@ -69,7 +74,11 @@ void ReadShmDataAndAttachSamples::execute() const
             {
                 IMediaPipeline::MediaSegmentAudio &audioSegment =
                     dynamic_cast<IMediaPipeline::MediaSegmentAudio &>(*mediaSegment);
-                m_player.updateAudioCaps(audioSegment.getSampleRate(), audioSegment.getNumberOfChannels());
+                if (audioSegment.getSampleRate() != m_context.audioCapsSampleRate ||
+                    audioSegment.getNumberOfChannels() != m_context.audioCapsNumberOfChannels)
+                {
+                    m_player.updateAudioCaps(audioSegment.getSampleRate(), audioSegment.getNumberOfChannels());
+                }
             }
             catch (const std::exception &e)
             {
@@ -77,9 +86,16 @@ void ReadShmDataAndAttachSamples::execute() const
             }
 
             m_context.audioBuffers.push_back(gstBuffer);
-            m_player.attachAudioData();
         }
     }
+    if (!m_context.videoBuffers.empty())
+    {
+        m_player.attachVideoData();
+    }
+    if (!m_context.audioBuffers.empty())
+    {
+        m_player.attachAudioData();
+    }
     // All segments in vector have the same type
     m_player.notifyNeedMediaData((!mediaSegments.empty() &&
                                   mediaSegments.front()->getType() == firebolt::rialto::MediaSourceType::AUDIO),
@@ -29,7 +29,7 @@ namespace firebolt::rialto::server
 {
 SetPosition::SetPosition(PlayerContext &context, IGstPlayerPrivate &player, IGstPlayerClient *client,
                          std::shared_ptr<IGstWrapper> gstWrapper, std::int64_t position)
-    : m_context{context}, m_gstPlayerClient{client}, m_gstWrapper{gstWrapper}, m_position{position}
+    : m_context{context}, m_player{player}, m_gstPlayerClient{client}, m_gstWrapper{gstWrapper}, m_position{position}
 {
     RIALTO_SERVER_LOG_DEBUG("Constructing SetPosition");
 }
@@ -54,8 +54,8 @@ void SetPosition::execute() const
     m_context.videoNeedData = false;
 
     // Clear local cache of any active data requests for player session
-    m_context.audioNeedDataPending = false;
-    m_context.videoNeedDataPending = false;
+    m_context.audioNeedDataPending = 0;
+    m_context.videoNeedDataPending = 0;
     m_gstPlayerClient->clearActiveRequestsCache();
 
     // Clear buffered samples for player session
@@ -94,7 +94,7 @@ void SetPosition::execute() const
     {
         if (streamInfo.second)
         {
-            NeedData task{m_context, m_gstPlayerClient, GST_APP_SRC(streamInfo.second)};
+            NeedData task{m_context, m_player, GST_APP_SRC(streamInfo.second)};
             task.execute();
         }
     }
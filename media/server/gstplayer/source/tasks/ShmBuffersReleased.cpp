@@ -0,0 +1,40 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "tasks/ShmBuffersReleased.h"
+#include "IGstPlayerPrivate.h"
+#include "RialtoServerLogging.h"
+
+namespace firebolt::rialto::server
+{
+ShmBuffersReleased::ShmBuffersReleased(IGstPlayerPrivate &player) : m_player{player}
+{
+    RIALTO_SERVER_LOG_DEBUG("Constructing ShmBuffersReleased");
+}
+
+ShmBuffersReleased::~ShmBuffersReleased()
+{
+    RIALTO_SERVER_LOG_DEBUG("ShmBuffersReleased finished");
+}
+
+void ShmBuffersReleased::execute() const
+{
+    RIALTO_SERVER_LOG_DEBUG("Executing ShmBuffersReleased");
+    m_player.notifyShmBuffersReleased();
+}
+} // namespace firebolt::rialto::server
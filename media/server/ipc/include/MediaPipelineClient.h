@@ -22,7 +22,10 @@
 
 #include "IIpcServer.h"
 #include "IMediaPipelineClient.h"
+#include "mediapipelinemodule.pb.h"
+#include <list>
 #include <memory>
+#include <mutex>
 
 namespace firebolt::rialto::server::ipc
 {
@@ -44,9 +47,45 @@ public:
     void notifyCancelNeedMediaData(int32_t sourceId) override;
     void notifyQos(int32_t sourceId, const QosInfo &qosInfo) override;
 
+    /**
+     * @brief Starts collecting NeedMediaData requests into a haveData response instead of sending them as events.
+     *
+     * Used while a haveData call of the client is processed, so that the requests issued in the meantime reach the
+     * client together with the response. Several haveData calls may be in progress at once, the requests are added
+     * to the oldest one, which is the first to be answered.
+     *
+     * @param[in] needMediaData : The response field to append the requests to.
+     */
+    void startNeedMediaDataCapture(
+        ::google::protobuf::RepeatedPtrField<::firebolt::rialto::NeedMediaDataEvent> *needMediaData);
+
+    /**
+     * @brief Stops collecting NeedMediaData requests into the given response.
+     *
+     * Once no capture is in progress, subsequent requests are sent as events again.
+     *
+     * @param[in] needMediaData  : The response field passed to startNeedMediaDataCapture().
+     * @param[in] isResponseSent : Whether the response is sent to the client. If not, e.g. when the call failed,
+     *                             the collected requests are sent as events and removed from the response.
+     */
+    void stopNeedMediaDataCapture(
+        ::google::protobuf::RepeatedPtrField<::firebolt::rialto::NeedMediaDataEvent> *needMediaData,
+        bool isResponseSent);
+
 private:
     int m_sessionId;
     std::shared_ptr<::firebolt::rialto::ipc::IClient> m_ipcClient;
+
+    /**
+     * @brief Protects m_capturedNeedMediaData, NeedMediaData requests are issued on the main thread.
+     */
+    std::mutex m_captureMutex;
+
+    /**
+     * @brief The response fields of the haveData calls in progress, oldest first. NeedMediaData requests are collected
+     *        into the first one, and are sent as events if there is none.
+     */
+    std::list<::google::protobuf::RepeatedPtrField<::firebolt::rialto::NeedMediaDataEvent> *> m_capturedNeedMediaData;
 };
 } // namespace firebolt::rialto::server::ipc
 
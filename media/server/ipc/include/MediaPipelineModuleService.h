@@ -23,6 +23,7 @@
 #include "IMediaPipelineClient.h"
 #include "IMediaPipelineModuleService.h"
 #include "IPlaybackService.h"
+#include "MediaPipelineClient.h"
 #include <map>
 #include <memory>
 #include <set>
@@ -74,6 +75,10 @@ public:
                      ::firebolt::rialto::SetPositionResponse *response, ::google::protobuf::Closure *done) override;
     void haveData(::google::protobuf::RpcController *controller, const ::firebolt::rialto::HaveDataRequest *request,
                   ::firebolt::rialto::HaveDataResponse *response, ::google::protobuf::Closure *done) override;
+    void haveDataMultiSource(::google::protobuf::RpcController *controller,
+                             const ::firebolt::rialto::HaveDataMultiSourceRequest *request,
+                             ::firebolt::rialto::HaveDataMultiSourceResponse *response,
+                             ::google::protobuf::Closure *done) override;
     void setPlaybackRate(::google::protobuf::RpcController *controller,
                          const ::firebolt::rialto::SetPlaybackRateRequest *request,
                          ::firebolt::rialto::SetPlaybackRateResponse *response,
@@ -86,6 +91,20 @@ public:
 private:
     service::IPlaybackService &m_playbackService;
     std::map<std::shared_ptr<::firebolt::rialto::ipc::IClient>, std::set<int>> m_clientSessions;
+
+    /**
+     * @brief The media pipeline clients of the sessions, used to return NeedMediaData requests in haveData responses.
+     */
+    std::map<int, std::shared_ptr<MediaPipelineClient>> m_mediaPipelineClients;
+
+    /**
+     * @brief Gets the media pipeline client of the session.
+     *
+     * @param[in] sessionId : The id of the session.
+     *
+     * @retval the media pipeline client or null if the session doesn't exist.
+     */
+    std::shared_ptr<MediaPipelineClient> getMediaPipelineClient(int sessionId) const;
 };
 } // namespace firebolt::rialto::server::ipc
 
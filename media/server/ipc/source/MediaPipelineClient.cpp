@@ -21,6 +21,7 @@
 #include "RialtoServerLogging.h"
 #include "mediapipelinemodule.pb.h"
 #include <IIpcServer.h>
+#include <utility>
 
 namespace
 {
@@ -113,6 +114,20 @@ convertNetworkState(const firebolt::rialto::NetworkState &networkState)
     }
     return firebolt::rialto::NetworkStateChangeEvent_NetworkState_UNKNOWN;
 }
+
+void fillNeedMediaDataEvent(firebolt::rialto::NeedMediaDataEvent &event, int sessionId, int32_t sourceId,
+                            size_t frameCount, uint32_t needDataRequestId,
+                            const std::shared_ptr<firebolt::rialto::ShmInfo> &shmInfo)
+{
+    event.set_session_id(sessionId);
+    event.set_source_id(sourceId);
+    event.set_request_id(needDataRequestId);
+    event.set_frame_count(frameCount);
+    event.mutable_shm_info()->set_max_metadata_bytes(shmInfo->maxMetadataBytes);
+    event.mutable_shm_info()->set_metadata_offset(shmInfo->metadataOffset);
+    event.mutable_shm_info()->set_media_data_offset(shmInfo->mediaDataOffset);
+    event.mutable_shm_info()->set_max_media_bytes(shmInfo->maxMediaBytes);
+}
 } // namespace
 
 namespace firebolt::rialto::server::ipc
@@ -137,7 +152,8 @@ void MediaPipelineClient::notifyPosition(int64_t position)
     event->set_session_id(m_sessionId);
     event->set_position(position);
 
-    m_ipcClient->sendEvent(event);
+    // Only the latest position matters to a client that is behind on its events
+    m_ipcClient->sendCoalescedEvent(event, static_cast<uint32_t>(m_sessionId));
 }
 
 void MediaPipelineClient::notifyNativeSize(uint32_t width, uint32_t height, double aspect)
@@ -180,17 +196,20 @@ void MediaPipelineClient::notifyAudioData(bool hasData)
 void MediaPipelineClient::notifyNeedMediaData(int32_t sourceId, size_t frameCount, uint32_t needDataRequestId,
                                               const std::shared_ptr<ShmInfo> &shmInfo)
 {
+    std::unique_lock<std::mutex> lock{m_captureMutex};
+    if (!m_capturedNeedMediaData.empty())
+    {
+        RIALTO_SERVER_LOG_DEBUG("Adding NeedMediaData to the HaveDataResponse...");
+        fillNeedMediaDataEvent(*m_capturedNeedMediaData.front()->Add(), m_sessionId, sourceId, frameCount,
+                               needDataRequestId, shmInfo);
+        return;
+    }
+    lock.unlock();
+
     RIALTO_SERVER_LOG_DEBUG("Sending NeedMediaDataEvent...");
 
     auto event = std::make_shared<firebolt::rialto::NeedMediaDataEvent>();
-    event->set_session_id(m_sessionId);
-    event->set_source_id(sourceId);
-    event->set_request_id(needDataRequestId);
-    event->set_frame_count(frameCount);
-    event->mutable_shm_info()->set_max_metadata_bytes(shmInfo->maxMetadataBytes);
-    event->mutable_shm_info()->set_metadata_offset(shmInfo->metadataOffset);
-    event->mutable_shm_info()->set_media_data_offset(shmInfo->mediaDataOffset);
-    event->mutable_shm_info()->set_max_media_bytes(shmInfo->maxMediaBytes);
+    fillNeedMediaDataEvent(*event, m_sessionId, sourceId, frameCount, needDataRequestId, shmInfo);
 
     m_ipcClient->sendEvent(event);
 }
@@ -210,6 +229,35 @@ void MediaPipelineClient::notifyQos(int32_t sourceId, const QosInfo &qosInfo)
     event->mutable_qos_info()->set_processed(qosInfo.processed);
     event->mutable_qos_info()->set_dropped(qosInfo.dropped);
 
-    m_ipcClient->sendEvent(event);
+    // The counters are cumulative, so a newer event for the same source supersedes an older one
+    m_ipcClient->sendCoalescedEvent(event, (static_cast<uint64_t>(static_cast<uint32_t>(m_sessionId)) << 32) |
+                                               static_cast<uint32_t>(sourceId));
+}
+
+void MediaPipelineClient::startNeedMediaDataCapture(
+    ::google::protobuf::RepeatedPtrField<::firebolt::rialto::NeedMediaDataEvent> *needMediaData)
+{
+    std::lock_guard<std::mutex> lock{m_captureMutex};
+    m_capturedNeedMediaData.push_back(needMediaData);
+}
+
+void MediaPipelineClient::stopNeedMediaDataCapture(
+    ::google::protobuf::RepeatedPtrField<::firebolt::rialto::NeedMediaDataEvent> *needMediaData, bool isResponseSent)
+{
+    {
+        std::lock_guard<std::mutex> lock{m_captureMutex};
+        m_capturedNeedMediaData.remove(needMediaData);
+    }
+    if (isResponseSent)
+    {
+        return;
+    }
+    // Failed calls are answered with an error only, so the requests would never reach the client
+    for (const auto &capturedNeedMediaData : *needMediaData)
+    {
+        RIALTO_SERVER_LOG_DEBUG("Sending NeedMediaDataEvent...");
+        m_ipcClient->sendEvent(std::make_shared<firebolt::rialto::NeedMediaDataEvent>(capturedNeedMediaData));
+    }
+    needMediaData->Clear();
 }
 } // namespace firebolt::rialto::server::ipc
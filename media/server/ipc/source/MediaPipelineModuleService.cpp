@@ -24,7 +24,12 @@
 #include "RialtoServerLogging.h"
 #include <IIpcController.h>
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -126,6 +131,78 @@ firebolt::rialto::StreamFormat convertStreamFormat(const firebolt::rialto::Attac
     }
 }
 
+/**
+ * @brief Replies to an IPC call once the playback service has finished processing it.
+ *
+ * The reply is sent when the last reference is released, which happens on the thread that processed the call. The
+ * call only succeeds if all the expected results were reported and successful. A call whose queued task was dropped,
+ * e.g. because the session was destroyed, therefore fails instead of never being answered.
+ */
+class CallCompletion
+{
+public:
+    CallCompletion(::google::protobuf::RpcController *controller, ::google::protobuf::Closure *done,
+                   const char *callName, std::uint32_t numExpectedResults = 1,
+                   std::function<void(bool)> onComplete = nullptr)
+        : m_controller{controller}, m_done{done}, m_kCallName{callName}, m_kNumExpectedResults{numExpectedResults},
+          m_onComplete{std::move(onComplete)}, m_numResults{0}, m_isSuccessful{true}
+    {
+    }
+
+    ~CallCompletion()
+    {
+        const bool result{m_isSuccessful && (m_numResults == m_kNumExpectedResults)};
+        if (m_onComplete)
+        {
+            m_onComplete(result);
+        }
+        if (!result)
+        {
+            RIALTO_SERVER_LOG_ERROR("%s failed", m_kCallName);
+            m_controller->SetFailed("Operation failed");
+        }
+        m_done->Run();
+    }
+
+    CallCompletion(const CallCompletion &) = delete;
+    CallCompletion &operator=(const CallCompletion &) = delete;
+
+    void addResult(bool result)
+    {
+        if (!result)
+        {
+            m_isSuccessful = false;
+        }
+        ++m_numResults;
+    }
+
+private:
+    ::google::protobuf::RpcController *m_controller;
+    ::google::protobuf::Closure *m_done;
+    const char *m_kCallName;
+    const std::uint32_t m_kNumExpectedResults;
+    std::function<void(bool)> m_onComplete;
+    std::atomic<std::uint32_t> m_numResults;
+    std::atomic<bool> m_isSuccessful;
+};
+
+/**
+ * @brief Starts collecting the NeedMediaData requests of a session into a haveData response.
+ *
+ * @retval the function stopping the capture once the call completes, null if there is no client to capture from.
+ */
+std::function<void(bool)>
+captureNeedMediaData(const std::shared_ptr<firebolt::rialto::server::ipc::MediaPipelineClient> &mediaPipelineClient,
+                     ::google::protobuf::RepeatedPtrField<::firebolt::rialto::NeedMediaDataEvent> *needMediaData)
+{
+    if (!mediaPipelineClient)
+    {
+        return nullptr;
+    }
+    mediaPipelineClient->startNeedMediaDataCapture(needMediaData);
+    return [mediaPipelineClient, needMediaData](bool result)
+    { mediaPipelineClient->stopNeedMediaDataCapture(needMediaData, result); };
+}
 } // namespace
 
 namespace firebolt::rialto::server::ipc
@@ -196,6 +273,7 @@ void MediaPipelineModuleService::clientDisconnected(const std::shared_ptr<::fire
     for (const auto &sessionId : sessionIds)
     {
         m_playbackService.destroySession(sessionId);
+        m_mediaPipelineClients.erase(sessionId);
     }
 }
 
@@ -214,14 +292,14 @@ void MediaPipelineModuleService::createSession(::google::protobuf::RpcController
         return;
     }
     int sessionId = generateSessionId();
-    bool sessionCreated =
-        m_playbackService.createSession(sessionId,
-                                        std::make_shared<MediaPipelineClient>(sessionId, ipcController->getClient()),
-                                        request->max_width(), request->max_height());
+    auto mediaPipelineClient = std::make_shared<MediaPipelineClient>(sessionId, ipcController->getClient());
+    bool sessionCreated = m_playbackService.createSession(sessionId, mediaPipelineClient, request->max_width(),
+                                                          request->max_height());
     if (sessionCreated)
     {
         // Assume that IPC library works well and client is present
         m_clientSessions[ipcController->getClient()].insert(sessionId);
+        m_mediaPipelineClients[sessionId] = mediaPipelineClient;
         response->set_session_id(sessionId);
     }
     else
@@ -258,6 +336,7 @@ void MediaPipelineModuleService::destroySession(::google::protobuf::RpcControlle
     {
         sessionIter->second.erase(request->session_id());
     }
+    m_mediaPipelineClients.erase(request->session_id());
     done->Run();
 }
 
@@ -355,12 +434,8 @@ void MediaPipelineModuleService::play(::google::protobuf::RpcController *control
                                       ::firebolt::rialto::PlayResponse *response, ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_playbackService.play(request->session_id()))
-    {
-        RIALTO_SERVER_LOG_ERROR("Play failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+    auto completion = std::make_shared<CallCompletion>(controller, done, "Play");
+    m_playbackService.play(request->session_id(), [completion](bool result) { completion->addResult(result); });
 }
 
 void MediaPipelineModuleService::pause(::google::protobuf::RpcController *controller,
@@ -368,12 +443,8 @@ void MediaPipelineModuleService::pause(::google::protobuf::RpcController *contro
                                        ::firebolt::rialto::PauseResponse *response, ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_playbackService.pause(request->session_id()))
-    {
-        RIALTO_SERVER_LOG_ERROR("pause failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+    auto completion = std::make_shared<CallCompletion>(controller, done, "Pause");
+    m_playbackService.pause(request->session_id(), [completion](bool result) { completion->addResult(result); });
 }
 
 void MediaPipelineModuleService::stop(::google::protobuf::RpcController *controller,
@@ -395,12 +466,9 @@ void MediaPipelineModuleService::setPosition(::google::protobuf::RpcController *
                                              ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    if (!m_playbackService.setPosition(request->session_id(), request->position()))
-    {
-        RIALTO_SERVER_LOG_ERROR("Set Position failed");
-        controller->SetFailed("Operation failed");
-    }
-    done->Run();
+    auto completion = std::make_shared<CallCompletion>(controller, done, "Set Position");
+    m_playbackService.setPosition(request->session_id(), request->position(),
+                                  [completion](bool result) { completion->addResult(result); });
 }
 
 void MediaPipelineModuleService::haveData(::google::protobuf::RpcController *controller,
@@ -409,13 +477,43 @@ void MediaPipelineModuleService::haveData(::google::protobuf::RpcController *con
                                           ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
+    std::shared_ptr<MediaPipelineClient> mediaPipelineClient;
+    if (request->accept_need_media_data())
+    {
+        mediaPipelineClient = getMediaPipelineClient(request->session_id());
+    }
+    // NeedMediaData requests issued while the data is committed are returned with the response
+    auto completion = std::make_shared<CallCompletion>(controller, done, "Have data", 1,
+                                                       captureNeedMediaData(mediaPipelineClient,
+                                                                            response->mutable_need_media_data()));
     firebolt::rialto::MediaSourceStatus status{convertMediaSourceStatus(request->status())};
-    if (!m_playbackService.haveData(request->session_id(), status, request->num_frames(), request->request_id()))
+    m_playbackService.haveData(request->session_id(), status, request->num_frames(), request->request_id(),
+                               [completion](bool result) { completion->addResult(result); });
+}
+
+void MediaPipelineModuleService::haveDataMultiSource(::google::protobuf::RpcController *controller,
+                                                     const ::firebolt::rialto::HaveDataMultiSourceRequest *request,
+                                                     ::firebolt::rialto::HaveDataMultiSourceResponse *response,
+                                                     ::google::protobuf::Closure *done)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+    std::shared_ptr<MediaPipelineClient> mediaPipelineClient;
+    if (request->accept_need_media_data())
     {
-        RIALTO_SERVER_LOG_ERROR("Have data failed");
-        controller->SetFailed("Operation failed");
+        mediaPipelineClient = getMediaPipelineClient(request->session_id());
     }
-    done->Run();
+    // The data of all the sources is processed in a single main thread task
+    auto completion = std::make_shared<CallCompletion>(controller, done, "Have data", 1,
+                                                       captureNeedMediaData(mediaPipelineClient,
+                                                                            response->mutable_need_media_data()));
+    std::vector<HaveDataShmInfo> sources;
+    sources.reserve(request->sources_size());
+    for (const auto &source : request->sources())
+    {
+        sources.push_back({convertMediaSourceStatus(source.status()), source.num_frames(), source.request_id()});
+    }
+    m_playbackService.haveData(request->session_id(), sources,
+                               [completion](bool result) { completion->addResult(result); });
 }
 
 void MediaPipelineModuleService::setPlaybackRate(::google::protobuf::RpcController *controller,
@@ -438,17 +536,16 @@ void MediaPipelineModuleService::getPosition(::google::protobuf::RpcController *
                                              ::google::protobuf::Closure *done)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    int64_t position{};
-    if (!m_playbackService.getPosition(request->session_id(), position))
-    {
-        RIALTO_SERVER_LOG_ERROR("Get position failed");
-        controller->SetFailed("Operation failed");
-    }
-    else
-    {
-        response->set_position(position);
-    }
-    done->Run();
+    auto completion = std::make_shared<CallCompletion>(controller, done, "Get position");
+    m_playbackService.getPosition(request->session_id(),
+                                  [completion, response](bool result, int64_t position)
+                                  {
+                                      if (result)
+                                      {
+                                          response->set_position(position);
+                                      }
+                                      completion->addResult(result);
+                                  });
 }
 
 void MediaPipelineModuleService::renderFrame(::google::protobuf::RpcController *controller,
@@ -466,4 +563,14 @@ void MediaPipelineModuleService::renderFrame(::google::protobuf::RpcController *
 
     done->Run();
 }
+
+std::shared_ptr<MediaPipelineClient> MediaPipelineModuleService::getMediaPipelineClient(int sessionId) const
+{
+    auto mediaPipelineClientIter = m_mediaPipelineClients.find(sessionId);
+    if (mediaPipelineClientIter == m_mediaPipelineClients.end())
+    {
+        return nullptr;
+    }
+    return mediaPipelineClientIter->second;
+}
 } // namespace firebolt::rialto::server::ipc
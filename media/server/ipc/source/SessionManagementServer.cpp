@@ -93,10 +93,10 @@ void SessionManagementServer::start()
     m_ipcServerThread = std::thread(
         [this]()
         {
-            constexpr int pollInterval{100};
+            // stop() wakes the loop, so there is no need to poll for the running flag
             while (m_ipcServer->process() && m_isRunning.load())
             {
-                m_ipcServer->wait(pollInterval);
+                m_ipcServer->wait(-1);
             }
             RIALTO_SERVER_LOG_DEBUG("Session Management Server event loop finished.");
         });
@@ -104,7 +104,10 @@ void SessionManagementServer::start()
 
 void SessionManagementServer::stop()
 {
-    m_isRunning.store(false);
+    if (m_isRunning.exchange(false))
+    {
+        m_ipcServer->wakeEventLoop();
+    }
 }
 
 void SessionManagementServer::setLogLevels(RIALTO_DEBUG_LEVEL defaultLogLevels, RIALTO_DEBUG_LEVEL clientLogLevels,
@@ -31,7 +31,8 @@ public:
     DataReaderFactory() = default;
     ~DataReaderFactory() override = default;
     std::shared_ptr<IDataReader> createDataReader(const MediaSourceType &mediaSourceType, std::uint8_t *buffer,
-                                                  std::uint32_t dataOffset, std::uint32_t numFrames) const override;
+                                                  std::uint32_t dataOffset, std::uint32_t dataLength,
+                                                  std::uint32_t numFrames) const override;
 };
 } // namespace firebolt::rialto::server
 
@@ -23,13 +23,14 @@
 #include "IMainThread.h"
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace firebolt::rialto::server
 {
@@ -69,13 +70,16 @@ public:
 private:
     /**
      * @brief Information of a task.
+     *
+     * Task slots are pooled and reused, so enqueuing a task does not allocate any synchronisation primitives.
      */
     struct TaskInfo
     {
-        uint32_t clientId;                           /**< The id of the client creating the task. */
-        Task task;                                   /**< The task to execute. */
-        std::unique_ptr<std::mutex> mutex;           /**< Mutex for the task condition variable. */
-        std::unique_ptr<std::condition_variable> cv; /**< The condition variable of the task. */
+        uint32_t clientId{0};               /**< The id of the client creating the task. */
+        Task task;                          /**< The task to execute. */
+        bool isWaitedFor{false};            /**< Whether the enqueuing thread waits for the task to finish. */
+        bool isDone{false};                 /**< Set once a waited for task has been executed. */
+        std::condition_variable taskDoneCv; /**< Notified when a waited for task has been executed. */
     };
 
     /**
@@ -86,14 +90,41 @@ private:
     /**
      * @brief Waits for tasks to enter the queue and returns the next task.
      *
-     * @retval The next task in the queue.
+     * Tasks of the main thread client are handled first, the remaining clients are served round-robin.
+     *
+     * @retval The next task in the queue or nullptr, when the thread is shutting down and all the queues are empty.
+     */
+    TaskInfo *waitForTask();
+
+    /**
+     * @brief Signals the waiting thread or returns the task slot to the pool once the task is executed.
+     *
+     * @param[in] taskInfo : The executed task.
+     */
+    void finishTask(TaskInfo *taskInfo);
+
+    /**
+     * @brief Takes a free task slot from the pool and queues it for the client. m_taskQueueMutex must be locked.
+     *
+     * @param[in] clientId    : The id of the client creating the task.
+     * @param[in] task        : The task to execute.
+     * @param[in] isWaitedFor : Whether the enqueuing thread waits for the task to finish.
+     *
+     * @retval The queued task slot or nullptr, when the client is not registered.
      */
-    const std::shared_ptr<TaskInfo> waitForTask();
+    TaskInfo *pushTask(uint32_t clientId, Task &&task, bool isWaitedFor);
 
     /**
-     * @brief Whether the main thread is running.
+     * @brief Returns the task slot to the pool. m_taskQueueMutex must be locked.
+     *
+     * @param[in] taskInfo : The task slot to release.
      */
-    bool m_isMainThreadRunning;
+    void releaseTask(TaskInfo *taskInfo);
+
+    /**
+     * @brief Set on destruction, the main thread stops once all the queued tasks are executed.
+     */
+    bool m_isShuttingDown;
 
     /**
      * @brief The main thread.
@@ -101,7 +132,7 @@ private:
     std::thread m_thread;
 
     /**
-     * @brief A mutex protecting access to the task queue.
+     * @brief A mutex protecting access to the task queues and the task pool.
      */
     std::mutex m_taskQueueMutex;
 
@@ -111,9 +142,29 @@ private:
     std::condition_variable m_taskQueueCv;
 
     /**
-     * @brief The queue of tasks and there infomation.
+     * @brief The pending tasks of each client, in the order they were enqueued.
+     */
+    std::map<uint32_t, std::deque<TaskInfo *>> m_clientTaskQueues;
+
+    /**
+     * @brief Clients, other than the main thread client, with pending tasks in round-robin order.
+     */
+    std::deque<uint32_t> m_readyClients;
+
+    /**
+     * @brief The number of tasks waiting in m_clientTaskQueues.
+     */
+    uint32_t m_numPendingTasks;
+
+    /**
+     * @brief Storage of all the task slots ever allocated.
+     */
+    std::vector<std::unique_ptr<TaskInfo>> m_taskPool;
+
+    /**
+     * @brief Task slots available for reuse.
      */
-    std::queue<std::shared_ptr<TaskInfo>> m_taskQueue;
+    std::vector<TaskInfo *> m_freeTasks;
 
     /**
      * @brief The main thread objects client id, for registering new clients.
@@ -25,6 +25,7 @@
 #include "IOcdmSessionClient.h"
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -165,6 +166,14 @@ private:
      */
     std::vector<uint8_t> m_selectedKeyId;
 
+    /**
+     * @brief Serialises the calls to the ocdm session.
+     *
+     * decrypt() and selectKeyId() are called directly from the gstreamer streaming threads, all other
+     * operations on the session are executed on the main thread.
+     */
+    std::mutex m_ocdmSessionMutex;
+
     /**
      * @brief Posts a getChallenge task onto the main thread.
      *
@@ -24,8 +24,10 @@
 #include "IMediaKeySession.h"
 #include "IMediaKeysServerInternal.h"
 #include "IOcdmSystem.h"
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -134,8 +136,22 @@ private:
 
     /**
      * @brief Map containing created sessions.
+     *
+     * The map is only modified on the main thread, under m_mediaKeySessionsMutex. Callers outside of the main
+     * thread (decrypt, selectKeyId...) take their own copy of the session with getKeySession and drop it with
+     * releaseKeySession, so that the last reference of a session is always released on the main thread.
      */
-    std::map<int32_t, std::unique_ptr<IMediaKeySession>> m_mediaKeySessions;
+    std::map<int32_t, std::shared_ptr<IMediaKeySession>> m_mediaKeySessions;
+
+    /**
+     * @brief Mutex protecting the m_mediaKeySessions map.
+     */
+    mutable std::mutex m_mediaKeySessionsMutex;
+
+    /**
+     * @brief Signalled when a copy of a session taken with getKeySession is released.
+     */
+    mutable std::condition_variable m_keySessionReleasedCv;
 
     /**
      * @brief KeySystem type of the MediaKeysServerInternal.
@@ -220,34 +236,22 @@ private:
     MediaKeyErrorStatus getCdmKeySessionIdInternal(int32_t keySessionId, std::string &cdmKeySessionId);
 
     /**
-     * @brief Decrypt internally, only to be called on the main thread.
+     * @brief Gets the key session, can be called from any thread.
      *
-     * @param[in] keySessionId    : The session id for the session.
-     * @param[in]  encrypted      : Gstreamer buffer containing encrypted data and related meta data. If applicable,
-     *                              decrypted data will be stored here after this call returns.
-     * @param[in]  subSample      : Gstreamer buffer containing subsamples size which has been parsed from protection
-     *                              meta data.
-     * @param[in]  subSampleCount : count of subsamples
-     * @param[in]  IV             : Gstreamer buffer containing initial vector (IV) used during decryption.
-     * @param[in]  keyId          : Gstreamer buffer containing keyID to use for decryption
-     * @param[in]  initWithLast15 : The value deciding whether decryption context needs to be initialized with
-     *                              last 15 bytes. Currently this only applies to PlayReady DRM.
+     * The returned copy must be dropped with releaseKeySession.
      *
-     * @retval an error status.
+     * @param[in] keySessionId : The key session id.
+     *
+     * @retval the key session or nullptr if not found.
      */
-    MediaKeyErrorStatus decryptInternal(int32_t keySessionId, GstBuffer *encrypted, GstBuffer *subSample,
-                                        const uint32_t subSampleCount, GstBuffer *IV, GstBuffer *keyId,
-                                        uint32_t initWithLast15);
+    std::shared_ptr<IMediaKeySession> getKeySession(int32_t keySessionId) const;
 
     /**
-     * @brief Selects the specified keyId for the key session internally, only to be called on the main thread.
-     *
-     * @param[in] keySessionId : The key session id for the session.
-     * @param[in] keyId        : The key id to select.
+     * @brief Drops the copy of the key session taken with getKeySession, can be called from any thread.
      *
-     * @retval an error status.
+     * @param[in] session : The copy of the key session, reset on return.
      */
-    MediaKeyErrorStatus selectKeyIdInternal(int32_t keySessionId, const std::vector<uint8_t> &keyId);
+    void releaseKeySession(std::shared_ptr<IMediaKeySession> &session) const;
 
     /**
      * @brief Returns true if the Key Session object contains the specified key internally,
@@ -279,15 +283,6 @@ private:
      * @retval the return status value.
      */
     MediaKeyErrorStatus getLastDrmErrorInternal(int32_t keySessionId, uint32_t &errorCode);
-
-    /**
-     * @brief Checks, if key system of media key session is Netflix internally, only to be called on the main thread.
-     *
-     * @param[in] keySessionId    : The session id for the session.
-     *
-     * @retval true if key system is Netflix
-     */
-    bool isNetflixKeySystemInternal(int32_t keySessionId) const;
 };
 
 }; // namespace firebolt::rialto::server
@@ -25,6 +25,8 @@
 #include "IGstPlayer.h"
 #include "IMainThread.h"
 #include "IMediaPipelineServerInternal.h"
+#include "ShmSlots.h"
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -108,10 +110,25 @@ public:
 
     bool setVideoWindow(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 
+    using IMediaPipeline::haveData;
+
     bool haveData(MediaSourceStatus status, uint32_t needDataRequestId) override;
 
     bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId) override;
 
+    void haveDataAsync(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId,
+                       ResultCallback callback) override;
+
+    void haveDataAsync(const std::vector<HaveDataShmInfo> &sources, ResultCallback callback) override;
+
+    void playAsync(ResultCallback callback) override;
+
+    void pauseAsync(ResultCallback callback) override;
+
+    void setPositionAsync(int64_t position, ResultCallback callback) override;
+
+    void getPositionAsync(PositionCallback callback) override;
+
     bool renderFrame() override;
 
     AddSegmentStatus addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment) override;
@@ -176,6 +193,11 @@ protected:
      */
     std::unique_ptr<IActiveRequests> m_activeRequests;
 
+    /**
+     * @brief Usage of the shared memory slots of audio and video regions
+     */
+    std::map<MediaSourceType, std::shared_ptr<ShmSlots>> m_shmSlots;
+
     /**
      * @brief This objects id registered on the main thread
      */
@@ -303,6 +325,14 @@ protected:
      * @param[in] mediaSourceType    : The media source type.
      */
     bool notifyNeedMediaDataInternal(MediaSourceType mediaSourceType);
+
+    /**
+     * @brief Releases the shared memory slot used by the need data request, only to be called on the main thread.
+     *
+     * @param[in] mediaSourceType   : The media source type.
+     * @param[in] needDataRequestId : Need data request id
+     */
+    void releaseShmSlot(MediaSourceType mediaSourceType, uint32_t needDataRequestId);
 };
 
 }; // namespace firebolt::rialto::server
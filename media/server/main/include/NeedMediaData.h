@@ -33,7 +33,8 @@ class NeedMediaData
 {
 public:
     NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActiveRequests &activeRequests,
-                  const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType);
+                  const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType,
+                  std::uint32_t shmSlot);
     ~NeedMediaData() = default;
 
     bool send() const;
@@ -44,6 +45,7 @@ private:
     MediaSourceType m_mediaSourceType;
     std::uint32_t m_frameCount;
     std::uint32_t m_maxMediaBytes;
+    std::uint32_t m_shmSlot;
     std::shared_ptr<ShmInfo> m_shmInfo;
     bool m_isValid;
 };
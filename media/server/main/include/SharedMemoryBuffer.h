@@ -47,10 +47,11 @@ public:
     bool mapPartition(int sessionId) override;
     bool unmapPartition(int sessionId) override;
 
-    bool clearData(int sessionId, const MediaSourceType &mediaSourceType) const override;
-
     std::uint32_t getDataOffset(int sessionId, const MediaSourceType &mediaSourceType) const override;
     std::uint32_t getMaxDataLen(int sessionId, const MediaSourceType &mediaSourceType) const override;
+    std::uint32_t getSlotDataOffset(int sessionId, const MediaSourceType &mediaSourceType,
+                                    std::uint32_t slot) const override;
+    std::uint32_t getMaxSlotDataLen(int sessionId, const MediaSourceType &mediaSourceType) const override;
     std::uint8_t *getDataPtr(int sessionId, const MediaSourceType &mediaSourceType) const override;
 
     int getFd() const override;
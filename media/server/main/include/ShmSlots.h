@@ -0,0 +1,99 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_SHM_SLOTS_H_
+#define FIREBOLT_RIALTO_SERVER_SHM_SLOTS_H_
+
+#include "ISharedMemoryBuffer.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief Tracks the usage of the shared memory slots of a single media source region.
+ *
+ * Slots are reserved on the main thread, when NeedMediaData is sent. Slots, which data is read by the gstreamer
+ * player, are released from the player worker thread, so the state of each slot is atomic.
+ */
+class ShmSlots
+{
+public:
+    ShmSlots();
+    ~ShmSlots() = default;
+    ShmSlots(const ShmSlots &) = delete;
+    ShmSlots(ShmSlots &&) = delete;
+    ShmSlots &operator=(const ShmSlots &) = delete;
+    ShmSlots &operator=(ShmSlots &&) = delete;
+
+    /**
+     * @brief Reserves the next free slot for a NeedMediaData request. Slots are used in round-robin order.
+     *
+     * @param[out] slot : The reserved slot.
+     *
+     * @retval true on success, false if all slots are in use.
+     */
+    bool acquire(std::uint32_t &slot);
+
+    /**
+     * @brief Marks the slot as being read by the gstreamer player.
+     *
+     * Slot in this state is not released by releaseRequested().
+     *
+     * @param[in] slot : The slot to be read.
+     */
+    void startReading(std::uint32_t slot);
+
+    /**
+     * @brief Releases the slot.
+     *
+     * @param[in] slot : The slot to be released.
+     */
+    void release(std::uint32_t slot);
+
+    /**
+     * @brief Releases all slots, that are reserved for NeedMediaData requests, which haven't been answered yet.
+     */
+    void releaseRequested();
+
+private:
+    /**
+     * @brief The state of the slot.
+     */
+    enum class SlotState
+    {
+        FREE,
+        REQUESTED,
+        READING
+    };
+
+    /**
+     * @brief The states of the slots.
+     */
+    std::array<std::atomic<SlotState>, kShmSlotsPerSource> m_slots;
+
+    /**
+     * @brief The slot to be checked first by the next acquire(). Used only in main thread.
+     */
+    std::uint32_t m_nextSlot;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_SHM_SLOTS_H_
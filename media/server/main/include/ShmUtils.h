@@ -32,7 +32,7 @@ constexpr std::uint32_t getMaxMetadataBytes()
     // 4 bytes version + max_frames_to_request * (maximum metadata struct size for stream type &
     //                                            supported metadata format versions)
 
-    // Metadata V2 contains version only, so maximum metadata size is size of MetadataV1
+    // Metadata V2 and V3 contain version only, so maximum metadata size is size of MetadataV1
     std::uint32_t maxMetadataStructSize = common::METADATA_V1_SIZE_PER_FRAME_BYTES;
     return common::VERSION_SIZE_BYTES + maxFrames * maxMetadataStructSize;
 }
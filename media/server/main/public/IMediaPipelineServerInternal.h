@@ -30,6 +30,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,6 +44,16 @@ namespace firebolt::rialto::server
 {
 class IMediaPipelineServerInternal;
 
+/**
+ * @brief The data written to the shared memory for a single need data request.
+ */
+struct HaveDataShmInfo
+{
+    MediaSourceStatus status;   /**< The status of the media source. */
+    uint32_t numFrames;         /**< The number of frames written. */
+    uint32_t needDataRequestId; /**< The need data request id. */
+};
+
 /**
  * @brief IMediaPipelineServerInternal factory class, returns a concrete implementation of IMediaPipelineServerInternal
  */
@@ -97,6 +108,70 @@ public:
      * @param[in] needDataRequestId : Need data request id
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId) = 0;
+
+    /**
+     * @brief Callback receiving the result of an asynchronous call, invoked on the main thread.
+     */
+    using ResultCallback = std::function<void(bool)>;
+
+    /**
+     * @brief Callback receiving the result and the position of an asynchronous getPosition call.
+     */
+    using PositionCallback = std::function<void(bool, int64_t)>;
+
+    /**
+     * @brief Asynchronous version of haveData().
+     *
+     * Queues the data on the main thread and returns immediately, the callback is invoked once it has been processed.
+     * The callback is destroyed without being invoked if the session is destroyed first.
+     *
+     * @param[in] status            : The status
+     * @param[in] numFrames         : The number of frames written.
+     * @param[in] needDataRequestId : Need data request id
+     * @param[in] callback          : Receives the result.
+     */
+    virtual void haveDataAsync(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId,
+                               ResultCallback callback) = 0;
+
+    /**
+     * @brief Asynchronous version of haveData() for several media sources at once.
+     *
+     * The data of all the sources is processed in a single main thread task, the callback receives false if any of
+     * them failed.
+     *
+     * @param[in] sources  : The status, number of frames and need data request id of each source.
+     * @param[in] callback : Receives the result.
+     */
+    virtual void haveDataAsync(const std::vector<HaveDataShmInfo> &sources, ResultCallback callback) = 0;
+
+    /**
+     * @brief Asynchronous version of play(), see haveDataAsync().
+     *
+     * @param[in] callback : Receives the result.
+     */
+    virtual void playAsync(ResultCallback callback) = 0;
+
+    /**
+     * @brief Asynchronous version of pause(), see haveDataAsync().
+     *
+     * @param[in] callback : Receives the result.
+     */
+    virtual void pauseAsync(ResultCallback callback) = 0;
+
+    /**
+     * @brief Asynchronous version of setPosition(), see haveDataAsync().
+     *
+     * @param[in] position : The playback position in nanoseconds.
+     * @param[in] callback : Receives the result.
+     */
+    virtual void setPositionAsync(int64_t position, ResultCallback callback) = 0;
+
+    /**
+     * @brief Asynchronous version of getPosition(), see haveDataAsync().
+     *
+     * @param[in] callback : Receives the result and the playback position in nanoseconds.
+     */
+    virtual void getPositionAsync(PositionCallback callback) = 0;
 };
 
 }; // namespace firebolt::rialto::server
@@ -25,8 +25,22 @@
 
 #include "MediaCommon.h"
 
+#ifndef RIALTO_SHM_SLOTS_PER_SOURCE
+#define RIALTO_SHM_SLOTS_PER_SOURCE 2
+#endif
+
 namespace firebolt::rialto::server
 {
+/**
+ * @brief Number of slots, that each media source region is divided into.
+ *
+ * Every NeedMediaData request uses its own slot, so it is also the maximum number of requests in flight per source.
+ * Each slot holds a whole NeedMediaData batch (7MB video, 1MB audio), so the region grows with the number of slots.
+ * Configured with the RIALTO_SHM_SLOTS_PER_SOURCE cmake option.
+ */
+constexpr std::uint32_t kShmSlotsPerSource{RIALTO_SHM_SLOTS_PER_SOURCE};
+static_assert(kShmSlotsPerSource > 0, "Media source region must have at least one shm slot");
+
 class ISharedMemoryBuffer;
 class ISharedMemoryBufferFactory
 {
@@ -52,10 +66,11 @@ public:
     virtual bool mapPartition(int sessionId) = 0;
     virtual bool unmapPartition(int sessionId) = 0;
 
-    virtual bool clearData(int sessionId, const MediaSourceType &mediaSourceType) const = 0;
-
     virtual std::uint32_t getDataOffset(int sessionId, const MediaSourceType &mediaSourceType) const = 0;
     virtual std::uint32_t getMaxDataLen(int sessionId, const MediaSourceType &mediaSourceType) const = 0;
+    virtual std::uint32_t getSlotDataOffset(int sessionId, const MediaSourceType &mediaSourceType,
+                                            std::uint32_t slot) const = 0;
+    virtual std::uint32_t getMaxSlotDataLen(int sessionId, const MediaSourceType &mediaSourceType) const = 0;
     virtual std::uint8_t *getDataPtr(int sessionId, const MediaSourceType &mediaSourceType) const = 0;
 
     virtual int getFd() const = 0;
@@ -19,6 +19,8 @@
 
 #include "ActiveRequests.h"
 #include <cstring>
+#include <stdexcept>
+#include <string>
 
 namespace firebolt::rialto::server
 {
@@ -49,10 +51,11 @@ AddSegmentStatus ActiveRequests::ActiveRequestsData::addSegment(const std::uniqu
 
 ActiveRequests::ActiveRequests() : m_currentId{0} {}
 
-std::uint32_t ActiveRequests::insert(const MediaSourceType &mediaSourceType, std::uint32_t maxMediaBytes)
+std::uint32_t ActiveRequests::insert(const MediaSourceType &mediaSourceType, std::uint32_t maxMediaBytes,
+                                     std::uint32_t shmSlot)
 {
     std::unique_lock<std::mutex> lock{m_mutex};
-    m_requestMap.insert(std::make_pair(m_currentId, ActiveRequestsData(mediaSourceType, maxMediaBytes)));
+    m_requestMap.insert(std::make_pair(m_currentId, ActiveRequestsData(mediaSourceType, maxMediaBytes, shmSlot)));
     return m_currentId++;
 }
 
@@ -67,6 +70,17 @@ MediaSourceType ActiveRequests::getType(std::uint32_t requestId) const
     return MediaSourceType::UNKNOWN;
 }
 
+std::uint32_t ActiveRequests::getShmSlot(std::uint32_t requestId) const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto requestIter{m_requestMap.find(requestId)};
+    if (requestIter != m_requestMap.end())
+    {
+        return requestIter->second.getShmSlot();
+    }
+    throw std::runtime_error("No shm slot for request id " + std::to_string(requestId));
+}
+
 void ActiveRequests::erase(std::uint32_t requestId)
 {
     std::unique_lock<std::mutex> lock{m_mutex};
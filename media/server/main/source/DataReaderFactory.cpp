@@ -20,6 +20,7 @@
 #include "DataReaderFactory.h"
 #include "DataReaderV1.h"
 #include "DataReaderV2.h"
+#include "DataReaderV3.h"
 #include "ShmCommon.h"
 #include "ShmUtils.h"
 
@@ -36,6 +37,7 @@ namespace firebolt::rialto::server
 {
 std::shared_ptr<IDataReader> DataReaderFactory::createDataReader(const MediaSourceType &mediaSourceType,
                                                                  std::uint8_t *buffer, std::uint32_t dataOffset,
+                                                                 std::uint32_t dataLength,
                                                                  std::uint32_t numFrames) const
 {
     // Version is always first 4 bytes of data
@@ -51,6 +53,12 @@ std::shared_ptr<IDataReader> DataReaderFactory::createDataReader(const MediaSour
         std::uint32_t v2DataOffset = dataOffset + getMaxMetadataBytes();
         return std::make_shared<DataReaderV2>(mediaSourceType, buffer, v2DataOffset, numFrames);
     }
+    if (3 == version)
+    {
+        std::uint32_t v3DataOffset = dataOffset + getMaxMetadataBytes();
+        std::uint32_t v3DataLength = dataLength > getMaxMetadataBytes() ? dataLength - getMaxMetadataBytes() : 0;
+        return std::make_shared<DataReaderV3>(mediaSourceType, buffer, v3DataOffset, v3DataLength, numFrames);
+    }
     return nullptr;
 }
 } // namespace firebolt::rialto::server
@@ -0,0 +1,139 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataReaderV3.h"
+#include "RialtoServerLogging.h"
+#include <cstring>
+#include <vector>
+
+namespace firebolt::rialto::server
+{
+DataReaderV3::DataReaderV3(const MediaSourceType &mediaSourceType, std::uint8_t *buffer, std::uint32_t dataOffset,
+                           std::uint32_t dataLength, std::uint32_t numFrames)
+    : m_mediaSourceType{mediaSourceType}, m_buffer{buffer}, m_dataOffset{dataOffset}, m_dataLength{dataLength},
+      m_numFrames{numFrames}
+{
+    RIALTO_SERVER_LOG_DEBUG("Detected Metadata in Version 3.");
+}
+
+IMediaPipeline::MediaSegmentVector DataReaderV3::readData() const
+{
+    IMediaPipeline::MediaSegmentVector mediaSegments;
+    mediaSegments.reserve(m_numFrames);
+    const std::uint8_t *kData{m_buffer + m_dataOffset};
+    // Sizes are written by the client, so the position is computed on 64 bits and checked against the region length
+    std::uint64_t position{0};
+    for (auto i = 0U; i < m_numFrames; ++i)
+    {
+        if (position + sizeof(common::MetadataV3FrameHeader) > m_dataLength)
+        {
+            RIALTO_SERVER_LOG_ERROR("Frame %u header exceeds the shared memory region", i);
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+        // The header is copied, as the shared memory offsets do not guarantee its alignment
+        common::MetadataV3FrameHeader header;
+        std::memcpy(&header, kData + position, sizeof(header));
+        if (header.metadataSize < common::getMetadataV3Size(header) || position + header.metadataSize > m_dataLength)
+        {
+            RIALTO_SERVER_LOG_ERROR("Metadata corrupted!");
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+        if (position + header.metadataSize + header.dataLength > m_dataLength)
+        {
+            RIALTO_SERVER_LOG_ERROR("Frame %u data of %u bytes exceeds the shared memory region", i, header.dataLength);
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+        auto newSegment{createSegment(header, kData + position + sizeof(header))};
+        if (!newSegment)
+        {
+            RIALTO_SERVER_LOG_ERROR("Segment parsing failed!");
+            return IMediaPipeline::MediaSegmentVector{};
+        }
+        position += header.metadataSize;
+        newSegment->setData(header.dataLength, kData + position);
+        position += common::alignMetadataV3Size(header.dataLength);
+        mediaSegments.emplace_back(std::move(newSegment));
+    }
+    return mediaSegments;
+}
+
+std::unique_ptr<IMediaPipeline::MediaSegment>
+DataReaderV3::createSegment(const common::MetadataV3FrameHeader &header, const std::uint8_t *inlineData) const
+{
+    if (static_cast<std::uint32_t>(m_mediaSourceType) != header.mediaSourceType)
+    {
+        RIALTO_SERVER_LOG_ERROR("Unexpected segment type: %u", header.mediaSourceType);
+        return nullptr;
+    }
+    if (header.segmentAlignment > static_cast<std::uint32_t>(SegmentAlignment::AU))
+    {
+        RIALTO_SERVER_LOG_ERROR("Unknown segment alignment: %u", header.segmentAlignment);
+        return nullptr;
+    }
+
+    std::unique_ptr<IMediaPipeline::MediaSegment> segment;
+    if (MediaSourceType::AUDIO == m_mediaSourceType)
+    {
+        segment = std::make_unique<IMediaPipeline::MediaSegmentAudio>(header.streamId, header.timePosition,
+                                                                      header.sampleDuration, header.sampleRate,
+                                                                      header.channelsNum);
+    }
+    else if (MediaSourceType::VIDEO == m_mediaSourceType)
+    {
+        segment = std::make_unique<IMediaPipeline::MediaSegmentVideo>(header.streamId, header.timePosition,
+                                                                      header.sampleDuration, header.width,
+                                                                      header.height);
+    }
+    else
+    {
+        RIALTO_SERVER_LOG_ERROR("Unknown segment type");
+        return nullptr;
+    }
+
+    segment->setSegmentAlignment(static_cast<SegmentAlignment>(header.segmentAlignment));
+    segment->setEncrypted(header.flags & common::METADATA_V3_FLAG_ENCRYPTED);
+    if (segment->isEncrypted())
+    {
+        segment->setMediaKeySessionId(header.mediaKeySessionId);
+        segment->setInitWithLast15(header.initWithLast15);
+    }
+    for (std::uint32_t i = 0; i < header.subSampleCount; ++i)
+    {
+        common::MetadataV3SubSample subSample;
+        std::memcpy(&subSample, inlineData, sizeof(subSample));
+        segment->addSubSample(subSample.numClearBytes, subSample.numEncryptedBytes);
+        inlineData += sizeof(subSample);
+    }
+    if (0 != header.keyIdSize)
+    {
+        segment->setKeyId(std::vector<std::uint8_t>(inlineData, inlineData + header.keyIdSize));
+        inlineData += header.keyIdSize;
+    }
+    if (0 != header.initVectorSize)
+    {
+        segment->setInitVector(std::vector<std::uint8_t>(inlineData, inlineData + header.initVectorSize));
+        inlineData += header.initVectorSize;
+    }
+    if (0 != header.extraDataSize)
+    {
+        segment->setExtraData(std::vector<std::uint8_t>(inlineData, inlineData + header.extraDataSize));
+    }
+    return segment;
+}
+} // namespace firebolt::rialto::server
@@ -19,10 +19,19 @@
 
 #include "MainThread.h"
 #include "RialtoServerLogging.h"
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 
+namespace
+{
+/**
+ * @brief The number of task slots allocated up front, the pool grows on demand.
+ */
+constexpr size_t kInitialTaskPoolSize{32};
+} // namespace
+
 namespace firebolt::rialto::server
 {
 std::weak_ptr<IMainThread> MainThreadFactory::m_mainThread;
@@ -62,9 +71,19 @@ std::shared_ptr<IMainThread> MainThreadFactory::getMainThread() const
     return mainThread;
 }
 
-MainThread::MainThread() : m_isMainThreadRunning{true}, m_mainThreadClientId{0}, m_nextClientId{1}
+MainThread::MainThread()
+    : m_isShuttingDown{false}, m_numPendingTasks{0}, m_mainThreadClientId{0}, m_nextClientId{1}
 {
     RIALTO_SERVER_LOG_DEBUG("MainThread is constructed");
+    m_taskPool.reserve(kInitialTaskPoolSize);
+    m_freeTasks.reserve(kInitialTaskPoolSize);
+    for (size_t i = 0; i < kInitialTaskPoolSize; ++i)
+    {
+        m_taskPool.push_back(std::make_unique<TaskInfo>());
+        m_freeTasks.push_back(m_taskPool.back().get());
+    }
+    m_clientTaskQueues[m_mainThreadClientId];
+
     m_thread = std::thread(std::bind(&MainThread::mainThreadLoop, this));
 
     // Register itself
@@ -74,16 +93,19 @@ MainThread::MainThread() : m_isMainThreadRunning{true}, m_mainThreadClientId{0},
 MainThread::~MainThread()
 {
     RIALTO_SERVER_LOG_DEBUG("MainThread is destructed");
-    auto shutdownTask = [this]() { m_isMainThreadRunning = false; };
-    enqueueTask(m_mainThreadClientId, shutdownTask);
+    {
+        // The queued tasks are drained before the thread stops, so that no waiting caller is left blocked
+        std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+        m_isShuttingDown = true;
+    }
+    m_taskQueueCv.notify_one();
     m_thread.join();
 }
 
 void MainThread::mainThreadLoop()
 {
-    while (m_isMainThreadRunning)
+    while (TaskInfo *taskInfo = waitForTask())
     {
-        const std::shared_ptr<TaskInfo> taskInfo = waitForTask();
         if (m_registeredClients.find(taskInfo->clientId) != m_registeredClients.end())
         {
             taskInfo->task();
@@ -93,29 +115,104 @@ void MainThread::mainThreadLoop()
             RIALTO_SERVER_LOG_WARN("Task ignored, client '%d' not registered", taskInfo->clientId);
         }
 
-        if (nullptr != taskInfo->cv)
-        {
-            std::unique_lock<std::mutex> lockTask(*(taskInfo->mutex));
-            taskInfo->cv->notify_one();
-        }
+        // Destroy the captures outside of the queue lock, they may enqueue new tasks on destruction
+        taskInfo->task = nullptr;
+        finishTask(taskInfo);
     }
 }
 
-const std::shared_ptr<MainThread::TaskInfo> MainThread::waitForTask()
+MainThread::TaskInfo *MainThread::waitForTask()
 {
     std::unique_lock<std::mutex> lock(m_taskQueueMutex);
-    if (m_taskQueue.empty())
+    m_taskQueueCv.wait(lock, [this] { return m_numPendingTasks > 0 || m_isShuttingDown; });
+    if (0 == m_numPendingTasks)
+    {
+        return nullptr;
+    }
+
+    std::deque<TaskInfo *> &mainThreadQueue{m_clientTaskQueues[m_mainThreadClientId]};
+    if (!mainThreadQueue.empty())
     {
-        m_taskQueueCv.wait(lock, [this] { return !m_taskQueue.empty(); });
+        TaskInfo *taskInfo{mainThreadQueue.front()};
+        mainThreadQueue.pop_front();
+        --m_numPendingTasks;
+        return taskInfo;
     }
-    const std::shared_ptr<TaskInfo> taskInfo = m_taskQueue.front();
-    m_taskQueue.pop();
+
+    // Serve one task of the next client and move it to the back, so that a busy client cannot starve the others
+    const uint32_t clientId{m_readyClients.front()};
+    m_readyClients.pop_front();
+    std::deque<TaskInfo *> &clientQueue{m_clientTaskQueues[clientId]};
+    TaskInfo *taskInfo{clientQueue.front()};
+    clientQueue.pop_front();
+    if (!clientQueue.empty())
+    {
+        m_readyClients.push_back(clientId);
+    }
+    --m_numPendingTasks;
     return taskInfo;
 }
 
+void MainThread::finishTask(TaskInfo *taskInfo)
+{
+    std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+    if (taskInfo->isWaitedFor)
+    {
+        // The waiting thread returns the slot to the pool
+        taskInfo->isDone = true;
+        taskInfo->taskDoneCv.notify_one();
+    }
+    else
+    {
+        releaseTask(taskInfo);
+    }
+}
+
+MainThread::TaskInfo *MainThread::pushTask(uint32_t clientId, Task &&task, bool isWaitedFor)
+{
+    auto clientQueueIt = m_clientTaskQueues.find(clientId);
+    if (clientQueueIt == m_clientTaskQueues.end())
+    {
+        RIALTO_SERVER_LOG_WARN("Task ignored, client '%u' not registered", clientId);
+        return nullptr;
+    }
+    std::deque<TaskInfo *> &clientQueue{clientQueueIt->second};
+
+    if (m_freeTasks.empty())
+    {
+        m_taskPool.push_back(std::make_unique<TaskInfo>());
+        m_freeTasks.push_back(m_taskPool.back().get());
+    }
+    TaskInfo *taskInfo{m_freeTasks.back()};
+    m_freeTasks.pop_back();
+
+    taskInfo->clientId = clientId;
+    taskInfo->task = std::move(task);
+    taskInfo->isWaitedFor = isWaitedFor;
+    taskInfo->isDone = false;
+
+    if (clientQueue.empty() && clientId != m_mainThreadClientId)
+    {
+        m_readyClients.push_back(clientId);
+    }
+    clientQueue.push_back(taskInfo);
+    ++m_numPendingTasks;
+
+    return taskInfo;
+}
+
+void MainThread::releaseTask(TaskInfo *taskInfo)
+{
+    m_freeTasks.push_back(taskInfo);
+}
+
 int32_t MainThread::registerClient()
 {
     uint32_t clientId = m_nextClientId++;
+    {
+        std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+        m_clientTaskQueues[clientId];
+    }
 
     auto task = [&, clientId]()
     {
@@ -131,38 +228,66 @@ void MainThread::unregisterClient(uint32_t clientId)
 {
     RIALTO_SERVER_LOG_INFO("Unregistering client '%u'", clientId);
     m_registeredClients.erase(clientId);
+
+    // Captures of the dropped tasks are destroyed outside of the queue lock, they may enqueue new tasks
+    std::vector<Task> droppedTasks;
+    {
+        std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+        auto clientQueueIt = m_clientTaskQueues.find(clientId);
+        if (clientQueueIt == m_clientTaskQueues.end())
+        {
+            return;
+        }
+        if (!clientQueueIt->second.empty())
+        {
+            RIALTO_SERVER_LOG_WARN("Dropping %zu pending tasks of client '%u'", clientQueueIt->second.size(), clientId);
+        }
+        for (TaskInfo *taskInfo : clientQueueIt->second)
+        {
+            droppedTasks.push_back(std::move(taskInfo->task));
+            taskInfo->task = nullptr;
+            --m_numPendingTasks;
+            if (taskInfo->isWaitedFor)
+            {
+                // The waiting thread is released without the task being executed and returns the slot to the pool
+                taskInfo->isDone = true;
+                taskInfo->taskDoneCv.notify_one();
+            }
+            else
+            {
+                releaseTask(taskInfo);
+            }
+        }
+        m_clientTaskQueues.erase(clientQueueIt);
+        m_readyClients.erase(std::remove(m_readyClients.begin(), m_readyClients.end(), clientId),
+                             m_readyClients.end());
+    }
 }
 
 void MainThread::enqueueTask(uint32_t clientId, Task task)
 {
-    std::shared_ptr<TaskInfo> newTask = std::make_shared<TaskInfo>();
-    newTask->clientId = clientId;
-    newTask->task = task;
     {
         std::unique_lock<std::mutex> lock(m_taskQueueMutex);
-        m_taskQueue.push(newTask);
+        if (!pushTask(clientId, std::move(task), false))
+        {
+            return;
+        }
     }
     m_taskQueueCv.notify_one();
 }
 
 void MainThread::enqueueTaskAndWait(uint32_t clientId, Task task)
 {
-    std::shared_ptr<TaskInfo> newTask = std::make_shared<TaskInfo>();
-    newTask->clientId = clientId;
-    newTask->task = task;
-    newTask->mutex = std::make_unique<std::mutex>();
-    newTask->cv = std::make_unique<std::condition_variable>();
-
+    std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+    TaskInfo *taskInfo{pushTask(clientId, std::move(task), true)};
+    if (!taskInfo)
     {
-        std::unique_lock<std::mutex> lockTask(*(newTask->mutex));
-        {
-            std::unique_lock<std::mutex> lockQueue(m_taskQueueMutex);
-            m_taskQueue.push(newTask);
-        }
-        m_taskQueueCv.notify_one();
-
-        newTask->cv->wait(lockTask);
+        return;
     }
+    m_taskQueueCv.notify_one();
+
+    taskInfo->taskDoneCv.wait(lock, [taskInfo] { return taskInfo->isDone; });
+    releaseTask(taskInfo);
 }
 
 } // namespace firebolt::rialto::server
@@ -101,29 +101,30 @@ MediaKeyErrorStatus MediaKeySession::generateRequest(InitDataType initDataType,
     m_licenseRequested = true;
 
     // Only construct session if it hasnt previously been constructed
-    if (!m_isSessionConstructed)
+    MediaKeyErrorStatus status;
     {
-        MediaKeyErrorStatus status =
-            m_ocdmSession->constructSession(m_kSessionType, initDataType, &initData[0], initData.size());
+        std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
+        if (m_isSessionConstructed)
+        {
+            return MediaKeyErrorStatus::OK;
+        }
+        status = m_ocdmSession->constructSession(m_kSessionType, initDataType, &initData[0], initData.size());
         if (MediaKeyErrorStatus::OK != status)
         {
             RIALTO_SERVER_LOG_ERROR("Failed to construct the key session");
             m_licenseRequested = false;
+            return status;
         }
-        else
-        {
-            m_isSessionConstructed = true;
-            if (kNetflixKeySystem == m_kKeySystem)
-            {
-                // Ocdm-playready netflix does not notify onProcessChallenge when complete.
-                // Fetch the challenge manually.
-                getChallenge();
-            }
-        }
-        return status;
+        m_isSessionConstructed = true;
     }
 
-    return MediaKeyErrorStatus::OK;
+    if (kNetflixKeySystem == m_kKeySystem)
+    {
+        // Ocdm-playready netflix does not notify onProcessChallenge when complete.
+        // Fetch the challenge manually.
+        getChallenge();
+    }
+    return status;
 }
 
 void MediaKeySession::getChallenge()
@@ -131,6 +132,7 @@ void MediaKeySession::getChallenge()
     RIALTO_SERVER_LOG_DEBUG("entry:");
     auto task = [&]()
     {
+        std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
         uint32_t challengeSize = 0;
         MediaKeyErrorStatus status = m_ocdmSession->getChallengeData(m_kIsLDL, nullptr, &challengeSize);
         std::vector<uint8_t> challenge(challengeSize, 0x00);
@@ -149,6 +151,7 @@ void MediaKeySession::getChallenge()
 
 MediaKeyErrorStatus MediaKeySession::loadSession()
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status = m_ocdmSession->load();
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -159,6 +162,7 @@ MediaKeyErrorStatus MediaKeySession::loadSession()
 
 MediaKeyErrorStatus MediaKeySession::updateSession(const std::vector<uint8_t> &responseData)
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status;
     if (kNetflixKeySystem == m_kKeySystem)
     {
@@ -183,6 +187,7 @@ MediaKeyErrorStatus MediaKeySession::updateSession(const std::vector<uint8_t> &r
 MediaKeyErrorStatus MediaKeySession::decrypt(GstBuffer *encrypted, GstBuffer *subSample, const uint32_t subSampleCount,
                                              GstBuffer *IV, GstBuffer *keyId, uint32_t initWithLast15)
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status = m_ocdmSession->decrypt(encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -193,6 +198,7 @@ MediaKeyErrorStatus MediaKeySession::decrypt(GstBuffer *encrypted, GstBuffer *su
 
 MediaKeyErrorStatus MediaKeySession::closeKeySession()
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status;
     if (kNetflixKeySystem == m_kKeySystem)
     {
@@ -233,6 +239,7 @@ MediaKeyErrorStatus MediaKeySession::closeKeySession()
 
 MediaKeyErrorStatus MediaKeySession::removeKeySession()
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status = m_ocdmSession->remove();
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -245,6 +252,7 @@ MediaKeyErrorStatus MediaKeySession::removeKeySession()
 
 MediaKeyErrorStatus MediaKeySession::getCdmKeySessionId(std::string &cdmKeySessionId)
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status = m_ocdmSession->getCdmKeySessionId(cdmKeySessionId);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -257,6 +265,7 @@ MediaKeyErrorStatus MediaKeySession::getCdmKeySessionId(std::string &cdmKeySessi
 
 bool MediaKeySession::containsKey(const std::vector<uint8_t> &keyId)
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     uint32_t result = m_ocdmSession->hasKeyId(keyId.data(), keyId.size());
 
     return static_cast<bool>(result);
@@ -264,6 +273,7 @@ bool MediaKeySession::containsKey(const std::vector<uint8_t> &keyId)
 
 MediaKeyErrorStatus MediaKeySession::setDrmHeader(const std::vector<uint8_t> &requestData)
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status = m_ocdmSession->setDrmHeader(requestData.data(), requestData.size());
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -274,6 +284,7 @@ MediaKeyErrorStatus MediaKeySession::setDrmHeader(const std::vector<uint8_t> &re
 
 MediaKeyErrorStatus MediaKeySession::getLastDrmError(uint32_t &errorCode)
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     MediaKeyErrorStatus status = m_ocdmSession->getLastDrmError(errorCode);
     if (MediaKeyErrorStatus::OK != status)
     {
@@ -284,6 +295,7 @@ MediaKeyErrorStatus MediaKeySession::getLastDrmError(uint32_t &errorCode)
 
 MediaKeyErrorStatus MediaKeySession::selectKeyId(const std::vector<uint8_t> &keyId)
 {
+    std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
     if (m_selectedKeyId == keyId)
     {
         return MediaKeyErrorStatus::OK;
@@ -333,6 +345,7 @@ void MediaKeySession::onKeyUpdated(const uint8_t keyId[], const uint8_t keyIdLen
         std::shared_ptr<IMediaKeysClient> client = m_mediaKeysClient.lock();
         if (client)
         {
+            std::lock_guard<std::mutex> lock{m_ocdmSessionMutex};
             KeyStatus status = m_ocdmSession->getStatus(&keyIdVec[0], keyIdVec.size());
             m_updatedKeyStatuses.push_back(std::make_pair(keyIdVec, status));
         }
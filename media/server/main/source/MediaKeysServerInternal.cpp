@@ -136,23 +136,16 @@ MediaKeyErrorStatus MediaKeysServerInternal::selectKeyId(int32_t keySessionId, c
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status;
-    auto task = [&]() { status = selectKeyIdInternal(keySessionId, keyId); };
-
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-    return status;
-}
-
-MediaKeyErrorStatus MediaKeysServerInternal::selectKeyIdInternal(int32_t keySessionId, const std::vector<uint8_t> &keyId)
-{
-    auto sessionIter = m_mediaKeySessions.find(keySessionId);
-    if (sessionIter == m_mediaKeySessions.end())
+    // Called from the streaming threads, the session serialises the access to the ocdm session.
+    std::shared_ptr<IMediaKeySession> session = getKeySession(keySessionId);
+    if (!session)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to find the session");
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
-    MediaKeyErrorStatus status = sessionIter->second->selectKeyId(keyId);
+    MediaKeyErrorStatus status = session->selectKeyId(keyId);
+    releaseKeySession(session);
     if (MediaKeyErrorStatus::OK != status)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to select key id");
@@ -212,6 +205,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::createKeySessionInternal(KeySession
         return MediaKeyErrorStatus::FAIL;
     }
     keySessionId = keySessionIdTemp;
+    std::lock_guard<std::mutex> lock{m_mediaKeySessionsMutex};
     m_mediaKeySessions.emplace(std::make_pair(keySessionId, std::move(mediaKeySession)));
 
     return MediaKeyErrorStatus::OK;
@@ -364,7 +358,16 @@ MediaKeyErrorStatus MediaKeysServerInternal::closeKeySessionInternal(int32_t key
         RIALTO_SERVER_LOG_ERROR("Failed to close the key session");
         return status;
     }
+
+    std::unique_lock<std::mutex> lock{m_mediaKeySessionsMutex};
+    std::shared_ptr<IMediaKeySession> session{std::move(sessionIter->second)};
     m_mediaKeySessions.erase(sessionIter);
+
+    // The streaming threads may still be using the session, wait for them to release it, so that the session is
+    // destroyed here on the main thread.
+    m_keySessionReleasedCv.wait(lock, [&session]() { return 1 == session.use_count(); });
+    lock.unlock();
+    session.reset();
     return status;
 }
 
@@ -528,27 +531,17 @@ MediaKeyErrorStatus MediaKeysServerInternal::decrypt(int32_t keySessionId, GstBu
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status;
-    auto task = [&]()
-    { status = decryptInternal(keySessionId, encrypted, subSample, subSampleCount, IV, keyId, initWithLast15); };
-
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-    return status;
-}
-
-MediaKeyErrorStatus MediaKeysServerInternal::decryptInternal(int32_t keySessionId, GstBuffer *encrypted,
-                                                             GstBuffer *subSample, const uint32_t subSampleCount,
-                                                             GstBuffer *IV, GstBuffer *keyId, uint32_t initWithLast15)
-{
-    auto sessionIter = m_mediaKeySessions.find(keySessionId);
-    if (sessionIter == m_mediaKeySessions.end())
+    // Decryption is executed on the calling streaming thread, so that the main thread does not serialise the
+    // decryption of all playbacks. The session serialises the access to the ocdm session.
+    std::shared_ptr<IMediaKeySession> session = getKeySession(keySessionId);
+    if (!session)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to find the session");
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
-    MediaKeyErrorStatus status =
-        sessionIter->second->decrypt(encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
+    MediaKeyErrorStatus status = session->decrypt(encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
+    releaseKeySession(session);
     if (MediaKeyErrorStatus::OK != status)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to decrypt buffer.");
@@ -562,31 +555,40 @@ bool MediaKeysServerInternal::hasSession(int32_t keySessionId) const
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    bool result;
-    auto task = [&]() { result = m_mediaKeySessions.find(keySessionId) != m_mediaKeySessions.end(); };
-
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-    return result;
+    std::lock_guard<std::mutex> lock{m_mediaKeySessionsMutex};
+    return m_mediaKeySessions.find(keySessionId) != m_mediaKeySessions.end();
 }
 
 bool MediaKeysServerInternal::isNetflixKeySystem(int32_t keySessionId) const
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
-    bool result;
-    auto task = [&]() { result = isNetflixKeySystemInternal(keySessionId); };
 
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
+    std::shared_ptr<IMediaKeySession> session = getKeySession(keySessionId);
+    if (!session)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to find the session");
+        return false;
+    }
+    bool result{session->isNetflixKeySystem()};
+    releaseKeySession(session);
     return result;
 }
 
-bool MediaKeysServerInternal::isNetflixKeySystemInternal(int32_t keySessionId) const
+std::shared_ptr<IMediaKeySession> MediaKeysServerInternal::getKeySession(int32_t keySessionId) const
 {
+    std::lock_guard<std::mutex> lock{m_mediaKeySessionsMutex};
     auto sessionIter = m_mediaKeySessions.find(keySessionId);
     if (sessionIter == m_mediaKeySessions.end())
     {
-        RIALTO_SERVER_LOG_ERROR("Failed to find the session");
-        return false;
+        return nullptr;
     }
-    return sessionIter->second->isNetflixKeySystem();
+    return sessionIter->second;
+}
+
+void MediaKeysServerInternal::releaseKeySession(std::shared_ptr<IMediaKeySession> &session) const
+{
+    session.reset();
+    std::lock_guard<std::mutex> lock{m_mediaKeySessionsMutex};
+    m_keySessionReleasedCv.notify_all();
 }
 }; // namespace firebolt::rialto::server
@@ -124,7 +124,10 @@ MediaPipelineServerInternal::MediaPipelineServerInternal(
     IDecryptionService &decryptionService)
     : m_mediaPipelineClient(client), m_kGstPlayerFactory(gstPlayerFactory), m_kVideoRequirements(videoRequirements),
       m_sessionId{sessionId}, m_shmBuffer{shmBuffer}, m_dataReaderFactory{std::move(dataReaderFactory)},
-      m_activeRequests{std::move(activeRequests)}, m_decryptionService{decryptionService}
+      m_activeRequests{std::move(activeRequests)},
+      m_shmSlots{{MediaSourceType::AUDIO, std::make_shared<ShmSlots>()},
+                 {MediaSourceType::VIDEO, std::make_shared<ShmSlots>()}},
+      m_decryptionService{decryptionService}
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
@@ -161,6 +164,9 @@ MediaPipelineServerInternal::~MediaPipelineServerInternal()
 
     auto task = [&]()
     {
+        // The player waits until gstreamer releases the buffers wrapping the shared memory
+        m_gstPlayer.reset();
+
         if (!m_shmBuffer->unmapPartition(m_sessionId))
         {
             RIALTO_SERVER_LOG_ERROR("Unable to unmap shm partition");
@@ -434,6 +440,8 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
         RIALTO_SERVER_LOG_WARN("NeedData RequestID is not valid: %u", needDataRequestId);
         return true;
     }
+    // Segments have been already copied by addSegment(), shared memory slot is no longer needed
+    releaseShmSlot(mediaSourceType, needDataRequestId);
 
     if (status != MediaSourceStatus::OK && status != MediaSourceStatus::EOS)
     {
@@ -475,6 +483,79 @@ bool MediaPipelineServerInternal::haveData(MediaSourceStatus status, uint32_t nu
     return result;
 }
 
+void MediaPipelineServerInternal::haveDataAsync(MediaSourceStatus status, uint32_t numFrames,
+                                                uint32_t needDataRequestId, ResultCallback callback)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    auto task = [this, status, numFrames, needDataRequestId, callback = std::move(callback)]()
+    { callback(haveDataInternal(status, numFrames, needDataRequestId)); };
+
+    m_mainThread->enqueueTask(m_mainThreadClientId, std::move(task));
+}
+
+void MediaPipelineServerInternal::haveDataAsync(const std::vector<HaveDataShmInfo> &sources, ResultCallback callback)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    auto task = [this, sources, callback = std::move(callback)]()
+    {
+        bool result{true};
+        for (const auto &source : sources)
+        {
+            if (!haveDataInternal(source.status, source.numFrames, source.needDataRequestId))
+            {
+                RIALTO_SERVER_LOG_ERROR("Have data failed for request id: %u", source.needDataRequestId);
+                result = false;
+            }
+        }
+        callback(result);
+    };
+
+    m_mainThread->enqueueTask(m_mainThreadClientId, std::move(task));
+}
+
+void MediaPipelineServerInternal::playAsync(ResultCallback callback)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    auto task = [this, callback = std::move(callback)]() { callback(playInternal()); };
+
+    m_mainThread->enqueueTask(m_mainThreadClientId, std::move(task));
+}
+
+void MediaPipelineServerInternal::pauseAsync(ResultCallback callback)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    auto task = [this, callback = std::move(callback)]() { callback(pauseInternal()); };
+
+    m_mainThread->enqueueTask(m_mainThreadClientId, std::move(task));
+}
+
+void MediaPipelineServerInternal::setPositionAsync(int64_t position, ResultCallback callback)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    auto task = [this, position, callback = std::move(callback)]() { callback(setPositionInternal(position)); };
+
+    m_mainThread->enqueueTask(m_mainThreadClientId, std::move(task));
+}
+
+void MediaPipelineServerInternal::getPositionAsync(PositionCallback callback)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    auto task = [this, callback = std::move(callback)]()
+    {
+        int64_t position{0};
+        const bool result{getPositionInternal(position)};
+        callback(result, position);
+    };
+
+    m_mainThread->enqueueTask(m_mainThreadClientId, std::move(task));
+}
+
 bool MediaPipelineServerInternal::renderFrame()
 {
     if (!m_gstPlayer)
@@ -501,16 +582,30 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
         RIALTO_SERVER_LOG_WARN("NeedData RequestID is not valid: %u", needDataRequestId);
         return true;
     }
+    std::uint32_t shmSlot = 0;
+    try
+    {
+        shmSlot = m_activeRequests->getShmSlot(needDataRequestId);
+    }
+    catch (const std::runtime_error &e)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to get shm slot, reason: %s", e.what());
+        m_activeRequests->erase(needDataRequestId);
+        return false;
+    }
     m_activeRequests->erase(needDataRequestId);
+    std::shared_ptr<ShmSlots> shmSlots = m_shmSlots.at(mediaSourceType);
     if (status != MediaSourceStatus::OK && status != MediaSourceStatus::EOS)
     {
         RIALTO_SERVER_LOG_WARN("Data request for needDataRequestId: %u received with wrong status", needDataRequestId);
+        shmSlots->release(shmSlot);
         return notifyNeedMediaDataInternal(mediaSourceType); // Resend NeedMediaData
     }
     uint8_t *buffer = m_shmBuffer->getBuffer();
     if (!buffer)
     {
         RIALTO_SERVER_LOG_ERROR("No buffer available");
+        shmSlots->release(shmSlot);
         notifyPlaybackState(PlaybackState::FAILURE);
         return false;
     }
@@ -518,26 +613,40 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
     std::uint32_t regionOffset = 0;
     try
     {
-        regionOffset = m_shmBuffer->getDataOffset(m_sessionId, mediaSourceType);
+        regionOffset = m_shmBuffer->getSlotDataOffset(m_sessionId, mediaSourceType, shmSlot);
     }
     catch (const std::runtime_error &e)
     {
         RIALTO_SERVER_LOG_ERROR("Failed to get region's buffer offset, reason: %s", e.what());
+        shmSlots->release(shmSlot);
         notifyPlaybackState(PlaybackState::FAILURE);
         return false;
     }
 
     if (0 != numFrames)
     {
+        // Frames written by the client are bounded by the slot's region
+        const std::uint32_t kRegionLength{m_shmBuffer->getMaxSlotDataLen(m_sessionId, mediaSourceType)};
         std::shared_ptr<IDataReader> dataReader =
-            m_dataReaderFactory->createDataReader(mediaSourceType, buffer, regionOffset, numFrames);
+            m_dataReaderFactory->createDataReader(mediaSourceType, buffer, regionOffset, kRegionLength, numFrames);
         if (!dataReader)
         {
             RIALTO_SERVER_LOG_ERROR("Metadata version not supported for request id: %u", needDataRequestId);
+            shmSlots->release(shmSlot);
             notifyPlaybackState(PlaybackState::FAILURE);
             return false;
         }
-        m_gstPlayer->attachSamples(dataReader);
+        // Shared memory slot can't be reused, until gstreamer player finishes reading the data.
+        // Slot is released, when the last reference to the data reader is dropped.
+        shmSlots->startReading(shmSlot);
+        std::shared_ptr<IDataReader> slotDataReader{dataReader.get(),
+                                                    [dataReader, shmSlots, shmSlot](IDataReader *)
+                                                    { shmSlots->release(shmSlot); }};
+        m_gstPlayer->attachSamples(slotDataReader);
+    }
+    else
+    {
+        shmSlots->release(shmSlot);
     }
     if (status == MediaSourceStatus::EOS)
     {
@@ -604,16 +713,45 @@ bool MediaPipelineServerInternal::notifyNeedMediaData(MediaSourceType mediaSourc
 
 bool MediaPipelineServerInternal::notifyNeedMediaDataInternal(MediaSourceType mediaSourceType)
 {
-    m_shmBuffer->clearData(m_sessionId, mediaSourceType);
-    NeedMediaData event{m_mediaPipelineClient, *m_activeRequests, *m_shmBuffer, m_sessionId, mediaSourceType};
+    auto shmSlotsIt = m_shmSlots.find(mediaSourceType);
+    if (shmSlotsIt == m_shmSlots.end())
+    {
+        RIALTO_SERVER_LOG_ERROR("NeedMediaData event sending failed - unknown mediaSourceType");
+        return false;
+    }
+    std::uint32_t shmSlot = 0;
+    if (!shmSlotsIt->second->acquire(shmSlot))
+    {
+        RIALTO_SERVER_LOG_DEBUG("NeedMediaData event not sent - all shared memory slots are in use");
+        return false;
+    }
+    NeedMediaData event{m_mediaPipelineClient, *m_activeRequests, *m_shmBuffer, m_sessionId, mediaSourceType, shmSlot};
     if (!event.send())
     {
         RIALTO_SERVER_LOG_WARN("NeedMediaData event sending failed");
+        shmSlotsIt->second->release(shmSlot);
         return false;
     }
     return true;
 }
 
+void MediaPipelineServerInternal::releaseShmSlot(MediaSourceType mediaSourceType, uint32_t needDataRequestId)
+{
+    auto shmSlotsIt = m_shmSlots.find(mediaSourceType);
+    if (shmSlotsIt == m_shmSlots.end())
+    {
+        return;
+    }
+    try
+    {
+        shmSlotsIt->second->release(m_activeRequests->getShmSlot(needDataRequestId));
+    }
+    catch (const std::runtime_error &e)
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to release shm slot, reason: %s", e.what());
+    }
+}
+
 void MediaPipelineServerInternal::notifyPosition(std::int64_t position)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
@@ -648,7 +786,15 @@ void MediaPipelineServerInternal::clearActiveRequestsCache()
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    auto task = [&]() { m_activeRequests->clear(); };
+    auto task = [&]()
+    {
+        m_activeRequests->clear();
+        // Slots, which data is being read by the gstreamer player, are released when reading is finished
+        for (auto &shmSlots : m_shmSlots)
+        {
+            shmSlots.second->releaseRequested();
+        }
+    };
 
     m_mainThread->enqueueTask(m_mainThreadClientId, task);
 }
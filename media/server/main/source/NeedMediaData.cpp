@@ -27,8 +27,10 @@
 namespace firebolt::rialto::server
 {
 NeedMediaData::NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActiveRequests &activeRequests,
-                             const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType)
-    : m_client{client}, m_activeRequests{activeRequests}, m_mediaSourceType{mediaSourceType}, m_frameCount{maxFrames}
+                             const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType,
+                             std::uint32_t shmSlot)
+    : m_client{client}, m_activeRequests{activeRequests}, m_mediaSourceType{mediaSourceType}, m_frameCount{maxFrames},
+      m_shmSlot{shmSlot}
 {
     if (MediaSourceType::AUDIO != mediaSourceType && MediaSourceType::VIDEO != mediaSourceType)
     {
@@ -38,8 +40,8 @@ NeedMediaData::NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActive
     }
     try
     {
-        m_maxMediaBytes = shmBuffer.getMaxDataLen(sessionId, mediaSourceType) - getMaxMetadataBytes();
-        auto metadataOffset = shmBuffer.getDataOffset(sessionId, mediaSourceType);
+        m_maxMediaBytes = shmBuffer.getMaxSlotDataLen(sessionId, mediaSourceType) - getMaxMetadataBytes();
+        auto metadataOffset = shmBuffer.getSlotDataOffset(sessionId, mediaSourceType, shmSlot);
         auto mediadataOffset = metadataOffset + getMaxMetadataBytes();
         m_shmInfo =
             std::make_shared<ShmInfo>(ShmInfo{getMaxMetadataBytes(), metadataOffset, mediadataOffset, m_maxMediaBytes});
@@ -58,8 +60,8 @@ bool NeedMediaData::send() const
     if (client && m_isValid)
     {
         auto sourceId = static_cast<std::uint64_t>(m_mediaSourceType);
-        client->notifyNeedMediaData(sourceId, m_frameCount, m_activeRequests.insert(m_mediaSourceType, m_maxMediaBytes),
-                                    m_shmInfo);
+        client->notifyNeedMediaData(sourceId, m_frameCount,
+                                    m_activeRequests.insert(m_mediaSourceType, m_maxMediaBytes, m_shmSlot), m_shmInfo);
         return true;
     }
     return false;
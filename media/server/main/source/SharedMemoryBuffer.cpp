@@ -20,7 +20,6 @@
 #include "SharedMemoryBuffer.h"
 #include "RialtoServerLogging.h"
 #include <algorithm>
-#include <cstring>
 #include <fcntl.h>
 #include <numeric>
 #include <stdexcept>
@@ -61,8 +60,11 @@ namespace
 {
 const char *memoryBufferName{"rialto_avbuf"};
 constexpr int NO_SESSION_ASSIGNED{-1};
-const uint32_t videoRegionSize = 7 * 1024 * 1024; // 7MB
-const uint32_t audioRegionSize = 1 * 1024 * 1024; // 1MB
+const uint32_t videoSlotSize = 7 * 1024 * 1024; // 7MB - max size of a single video NeedMediaData batch
+const uint32_t audioSlotSize = 1 * 1024 * 1024; // 1MB - max size of a single audio NeedMediaData batch
+const uint32_t videoRegionSize = videoSlotSize * firebolt::rialto::server::kShmSlotsPerSource;
+const uint32_t audioRegionSize = audioSlotSize * firebolt::rialto::server::kShmSlotsPerSource;
+const uint32_t slotAlignment = 64; // Keep slots cache line aligned
 
 std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition> calculatePartitionSize(int numOfPlaybacks)
 {
@@ -180,30 +182,6 @@ bool SharedMemoryBuffer::unmapPartition(int sessionId)
     return true;
 }
 
-bool SharedMemoryBuffer::clearData(int sessionId, const MediaSourceType &mediaSourceType) const
-{
-    auto sessionPartition = std::find_if(m_partitions.begin(), m_partitions.end(),
-                                         [sessionId](const auto &p) { return p.sessionId == sessionId; });
-    if (sessionPartition == m_partitions.end())
-    {
-        RIALTO_SERVER_LOG_WARN("Failed to clear data for session: %d. - partition could not be found", sessionId);
-        return false;
-    }
-    if (MediaSourceType::AUDIO == mediaSourceType)
-    {
-        std::uint8_t *audioData = getDataPtrForSession(sessionId) + sessionPartition->dataBufferVideoLen;
-        memset(audioData, 0x00, sessionPartition->dataBufferAudioLen);
-        return true;
-    }
-    if (MediaSourceType::VIDEO == mediaSourceType)
-    {
-        std::uint8_t *videoData = getDataPtrForSession(sessionId);
-        memset(videoData, 0x00, sessionPartition->dataBufferVideoLen);
-        return true;
-    }
-    return false;
-}
-
 std::uint32_t SharedMemoryBuffer::getDataOffset(int sessionId, const MediaSourceType &mediaSourceType) const
 {
     std::uint8_t *sessionBuffer = getDataPtr(sessionId, mediaSourceType);
@@ -234,6 +212,22 @@ std::uint32_t SharedMemoryBuffer::getMaxDataLen(int sessionId, const MediaSource
     return 0;
 }
 
+std::uint32_t SharedMemoryBuffer::getSlotDataOffset(int sessionId, const MediaSourceType &mediaSourceType,
+                                                    std::uint32_t slot) const
+{
+    if (slot >= kShmSlotsPerSource)
+    {
+        throw std::runtime_error("Invalid slot: " + std::to_string(slot) +
+                                 " for session: " + std::to_string(sessionId));
+    }
+    return getDataOffset(sessionId, mediaSourceType) + slot * getMaxSlotDataLen(sessionId, mediaSourceType);
+}
+
+std::uint32_t SharedMemoryBuffer::getMaxSlotDataLen(int sessionId, const MediaSourceType &mediaSourceType) const
+{
+    return (getMaxDataLen(sessionId, mediaSourceType) / kShmSlotsPerSource) & ~(slotAlignment - 1);
+}
+
 std::uint8_t *SharedMemoryBuffer::getDataPtr(int sessionId, const MediaSourceType &mediaSourceType) const
 {
     auto sessionPartition = std::find_if(m_partitions.begin(), m_partitions.end(),
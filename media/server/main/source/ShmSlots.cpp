@@ -0,0 +1,77 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmSlots.h"
+#include "RialtoServerLogging.h"
+
+namespace firebolt::rialto::server
+{
+ShmSlots::ShmSlots() : m_nextSlot{0}
+{
+    for (auto &slot : m_slots)
+    {
+        slot.store(SlotState::FREE);
+    }
+}
+
+bool ShmSlots::acquire(std::uint32_t &slot)
+{
+    for (std::uint32_t i = 0; i < kShmSlotsPerSource; ++i)
+    {
+        const std::uint32_t kCandidate{(m_nextSlot + i) % kShmSlotsPerSource};
+        SlotState expected{SlotState::FREE};
+        if (m_slots[kCandidate].compare_exchange_strong(expected, SlotState::REQUESTED))
+        {
+            slot = kCandidate;
+            m_nextSlot = (kCandidate + 1) % kShmSlotsPerSource;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ShmSlots::startReading(std::uint32_t slot)
+{
+    if (slot >= kShmSlotsPerSource)
+    {
+        RIALTO_SERVER_LOG_ERROR("Invalid shm slot: %u", slot);
+        return;
+    }
+    m_slots[slot].store(SlotState::READING);
+}
+
+void ShmSlots::release(std::uint32_t slot)
+{
+    if (slot >= kShmSlotsPerSource)
+    {
+        RIALTO_SERVER_LOG_ERROR("Invalid shm slot: %u", slot);
+        return;
+    }
+    m_slots[slot].store(SlotState::FREE);
+}
+
+void ShmSlots::releaseRequested()
+{
+    for (auto &slot : m_slots)
+    {
+        SlotState expected{SlotState::REQUESTED};
+        slot.compare_exchange_strong(expected, SlotState::FREE);
+    }
+}
+} // namespace firebolt::rialto::server
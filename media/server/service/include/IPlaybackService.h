@@ -22,8 +22,10 @@
 
 #include "IMediaPipeline.h"
 #include "IMediaPipelineClient.h"
+#include "IMediaPipelineServerInternal.h"
 #include "MediaCommon.h"
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -41,6 +43,14 @@ public:
     IPlaybackService &operator=(const IPlaybackService &) = delete;
     IPlaybackService &operator=(IPlaybackService &&) = delete;
 
+    /**
+     * @brief Receives the result of an asynchronous call, invoked from the session's main thread.
+     *
+     * If the session is destroyed before the call is processed the callback is destroyed without being invoked.
+     */
+    using ResultCallback = std::function<void(bool)>;
+    using PositionCallback = std::function<void(bool, std::int64_t)>;
+
     virtual bool switchToActive() = 0;
     virtual void switchToInactive() = 0;
     virtual void setMaxPlaybacks(int maxPlaybacks) = 0;
@@ -51,16 +61,17 @@ public:
     virtual bool load(int sessionId, MediaType type, const std::string &mimeType, const std::string &url) = 0;
     virtual bool attachSource(int sessionId, IMediaPipeline::MediaSource &source) = 0;
     virtual bool removeSource(int sessionId, std::int32_t sourceId) = 0;
-    virtual bool play(int sessionId) = 0;
-    virtual bool pause(int sessionId) = 0;
+    virtual void play(int sessionId, ResultCallback callback) = 0;
+    virtual void pause(int sessionId, ResultCallback callback) = 0;
     virtual bool stop(int sessionId) = 0;
     virtual bool setPlaybackRate(int sessionId, double rate) = 0;
-    virtual bool setPosition(int sessionId, std::int64_t position) = 0;
-    virtual bool getPosition(int sessionId, std::int64_t &position) = 0;
+    virtual void setPosition(int sessionId, std::int64_t position, ResultCallback callback) = 0;
+    virtual void getPosition(int sessionId, PositionCallback callback) = 0;
     virtual bool setVideoWindow(int sessionId, std::uint32_t x, std::uint32_t y, std::uint32_t width,
                                 std::uint32_t height) = 0;
-    virtual bool haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
-                          std::uint32_t needDataRequestId) = 0;
+    virtual void haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
+                          std::uint32_t needDataRequestId, ResultCallback callback) = 0;
+    virtual void haveData(int sessionId, const std::vector<HaveDataShmInfo> &sources, ResultCallback callback) = 0;
     virtual bool renderFrame(int sessionId) = 0;
     virtual bool getSharedMemory(int32_t &fd, uint32_t &size) = 0;
     virtual std::vector<std::string> getSupportedMimeTypes(MediaSourceType type) = 0;
@@ -19,7 +19,6 @@
 
 #include "CdmService.h"
 #include "RialtoServerLogging.h"
-#include <algorithm>
 #include <exception>
 #include <memory>
 #include <string>
@@ -54,6 +53,16 @@ void CdmService::switchToInactive()
 
     {
         std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+        {
+            std::unique_lock<std::mutex> keySessionLock{m_keySessionMediaKeysMutex};
+            m_keySessionMediaKeys.clear();
+            // Wait for the in-flight decryptions, so that the media keys are not destroyed on a streaming thread
+            for (const auto &mediaKeys : m_mediaKeys)
+            {
+                m_keySessionMediaKeysReleasedCv.wait(keySessionLock,
+                                                     [&mediaKeys]() { return 1 == mediaKeys.second.use_count(); });
+            }
+        }
         m_mediaKeys.clear();
     }
 }
@@ -100,7 +109,9 @@ bool CdmService::destroyMediaKeys(int mediaKeysHandle)
             RIALTO_SERVER_LOG_ERROR("Media keys handle: %d does not exists", mediaKeysHandle);
             return false;
         }
+        std::shared_ptr<IMediaKeysServerInternal> mediaKeys{std::move(mediaKeysIter->second)};
         m_mediaKeys.erase(mediaKeysIter);
+        removeKeySessionMediaKeys(std::move(mediaKeys));
     }
 
     RIALTO_SERVER_LOG_INFO("Media keys handle: %d destroyed", mediaKeysHandle);
@@ -131,6 +142,9 @@ MediaKeyErrorStatus CdmService::createKeySession(int mediaKeysHandle, KeySession
             return MediaKeyErrorStatus::FAIL;
         }
         m_mediaKeysClients.emplace(std::make_pair(keySessionId, client));
+
+        std::lock_guard<std::mutex> keySessionLock{m_keySessionMediaKeysMutex};
+        m_keySessionMediaKeys[keySessionId] = mediaKeysIter->second;
     }
 
     return status;
@@ -191,7 +205,14 @@ MediaKeyErrorStatus CdmService::closeKeySession(int mediaKeysHandle, int32_t key
         RIALTO_SERVER_LOG_ERROR("Media keys handle: %d does not exists", mediaKeysHandle);
         return MediaKeyErrorStatus::FAIL;
     }
-    return mediaKeysIter->second->closeKeySession(keySessionId);
+
+    MediaKeyErrorStatus status = mediaKeysIter->second->closeKeySession(keySessionId);
+    if (MediaKeyErrorStatus::OK == status)
+    {
+        std::lock_guard<std::mutex> keySessionLock{m_keySessionMediaKeysMutex};
+        m_keySessionMediaKeys.erase(keySessionId);
+    }
+    return status;
 }
 
 MediaKeyErrorStatus CdmService::removeKeySession(int mediaKeysHandle, int32_t keySessionId)
@@ -415,40 +436,85 @@ MediaKeyErrorStatus CdmService::decrypt(int32_t keySessionId, GstBuffer *encrypt
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to decrypt, key session id: %d", keySessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    // Decryption does not take m_mediaKeysMutex, so that it is not blocked by the (slow) cdm operations
+    // executed for the other playbacks.
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = getMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return MediaKeyErrorStatus::FAIL;
     }
-    return mediaKeysIter->second->decrypt(keySessionId, encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
+    MediaKeyErrorStatus status =
+        mediaKeys->decrypt(keySessionId, encrypted, subSample, subSampleCount, IV, keyId, initWithLast15);
+    releaseMediaKeysForKeySession(mediaKeys);
+    return status;
 }
 
 bool CdmService::isNetflixKeySystem(int32_t keySessionId) const
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to check if key system is Netflix, key session id: %d", keySessionId);
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = getMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return false;
     }
-    return mediaKeysIter->second->isNetflixKeySystem(keySessionId);
+    bool result{mediaKeys->isNetflixKeySystem(keySessionId)};
+    releaseMediaKeysForKeySession(mediaKeys);
+    return result;
 }
 
 MediaKeyErrorStatus CdmService::selectKeyId(int32_t keySessionId, const std::vector<uint8_t> &keyId)
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to select key id, key session id: %d", keySessionId);
-    auto mediaKeysIter = std::find_if(m_mediaKeys.begin(), m_mediaKeys.end(),
-                                      [&](const auto &iter) { return iter.second->hasSession(keySessionId); });
-    if (mediaKeysIter == m_mediaKeys.end())
+    std::shared_ptr<IMediaKeysServerInternal> mediaKeys = getMediaKeysForKeySession(keySessionId);
+    if (!mediaKeys)
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return MediaKeyErrorStatus::FAIL;
     }
-    return mediaKeysIter->second->selectKeyId(keySessionId, keyId);
+    MediaKeyErrorStatus status = mediaKeys->selectKeyId(keySessionId, keyId);
+    releaseMediaKeysForKeySession(mediaKeys);
+    return status;
+}
+
+std::shared_ptr<IMediaKeysServerInternal> CdmService::getMediaKeysForKeySession(int32_t keySessionId) const
+{
+    std::lock_guard<std::mutex> lock{m_keySessionMediaKeysMutex};
+    auto keySessionIter = m_keySessionMediaKeys.find(keySessionId);
+    if (keySessionIter == m_keySessionMediaKeys.end())
+    {
+        return nullptr;
+    }
+    return keySessionIter->second;
+}
+
+void CdmService::releaseMediaKeysForKeySession(std::shared_ptr<IMediaKeysServerInternal> &mediaKeys) const
+{
+    mediaKeys.reset();
+    std::lock_guard<std::mutex> lock{m_keySessionMediaKeysMutex};
+    m_keySessionMediaKeysReleasedCv.notify_all();
+}
+
+void CdmService::removeKeySessionMediaKeys(std::shared_ptr<IMediaKeysServerInternal> &&mediaKeys)
+{
+    std::unique_lock<std::mutex> lock{m_keySessionMediaKeysMutex};
+    for (auto it = m_keySessionMediaKeys.begin(); it != m_keySessionMediaKeys.end();)
+    {
+        if (it->second == mediaKeys)
+        {
+            it = m_keySessionMediaKeys.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // The streaming threads may still be decrypting with the media keys. Wait for them to release their copies, so
+    // that the media keys are destroyed here and not on a streaming thread.
+    m_keySessionMediaKeysReleasedCv.wait(lock, [&mediaKeys]() { return 1 == mediaKeys.use_count(); });
+    lock.unlock();
+    mediaKeys.reset();
 }
 } // namespace firebolt::rialto::server::service
@@ -27,6 +27,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -80,11 +81,17 @@ private:
     std::shared_ptr<IMediaKeysServerInternalFactory> m_mediaKeysFactory;
     std::shared_ptr<IMediaKeysCapabilitiesFactory> m_mediaKeysCapabilitiesFactory;
     std::atomic<bool> m_isActive;
-    std::map<int, std::unique_ptr<IMediaKeysServerInternal>> m_mediaKeys;
+    std::map<int, std::shared_ptr<IMediaKeysServerInternal>> m_mediaKeys;
     std::map<int, std::shared_ptr<IMediaKeysClient>> m_mediaKeysClients;
     std::mutex m_mediaKeysMutex;
+    std::map<int32_t, std::shared_ptr<IMediaKeysServerInternal>> m_keySessionMediaKeys;
+    mutable std::mutex m_keySessionMediaKeysMutex;
+    mutable std::condition_variable m_keySessionMediaKeysReleasedCv;
 
     MediaKeyErrorStatus removeKeySessionInternal(int mediaKeysHandle, int32_t keySessionId);
+    std::shared_ptr<IMediaKeysServerInternal> getMediaKeysForKeySession(int32_t keySessionId) const;
+    void releaseMediaKeysForKeySession(std::shared_ptr<IMediaKeysServerInternal> &mediaKeys) const;
+    void removeKeySessionMediaKeys(std::shared_ptr<IMediaKeysServerInternal> &&mediaKeys);
 };
 } // namespace firebolt::rialto::server::service
 
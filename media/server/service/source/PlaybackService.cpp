@@ -184,7 +184,7 @@ bool PlaybackService::removeSource(int sessionId, std::int32_t sourceId)
     return mediaPipelineIter->second->removeSource(sourceId);
 }
 
-bool PlaybackService::play(int sessionId)
+void PlaybackService::play(int sessionId, ResultCallback callback)
 {
     RIALTO_SERVER_LOG_INFO("PlaybackService requested to play, session id: %d", sessionId);
 
@@ -193,12 +193,13 @@ bool PlaybackService::play(int sessionId)
     if (mediaPipelineIter == m_mediaPipelines.end())
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
-        return false;
+        callback(false);
+        return;
     }
-    return mediaPipelineIter->second->play();
+    mediaPipelineIter->second->playAsync(std::move(callback));
 }
 
-bool PlaybackService::pause(int sessionId)
+void PlaybackService::pause(int sessionId, ResultCallback callback)
 {
     RIALTO_SERVER_LOG_INFO("PlaybackService requested to pause, session id: %d", sessionId);
 
@@ -207,9 +208,10 @@ bool PlaybackService::pause(int sessionId)
     if (mediaPipelineIter == m_mediaPipelines.end())
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
-        return false;
+        callback(false);
+        return;
     }
-    return mediaPipelineIter->second->pause();
+    mediaPipelineIter->second->pauseAsync(std::move(callback));
 }
 
 bool PlaybackService::stop(int sessionId)
@@ -240,7 +242,7 @@ bool PlaybackService::setPlaybackRate(int sessionId, double rate)
     return mediaPipelineIter->second->setPlaybackRate(rate);
 }
 
-bool PlaybackService::setPosition(int sessionId, std::int64_t position)
+void PlaybackService::setPosition(int sessionId, std::int64_t position, ResultCallback callback)
 {
     RIALTO_SERVER_LOG_INFO("PlaybackService requested to set position, session id: %d", sessionId);
 
@@ -249,12 +251,13 @@ bool PlaybackService::setPosition(int sessionId, std::int64_t position)
     if (mediaPipelineIter == m_mediaPipelines.end())
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
-        return false;
+        callback(false);
+        return;
     }
-    return mediaPipelineIter->second->setPosition(position);
+    mediaPipelineIter->second->setPositionAsync(position, std::move(callback));
 }
 
-bool PlaybackService::getPosition(int sessionId, std::int64_t &position)
+void PlaybackService::getPosition(int sessionId, PositionCallback callback)
 {
     RIALTO_SERVER_LOG_INFO("PlaybackService requested to get position, session id: %d", sessionId);
 
@@ -263,9 +266,10 @@ bool PlaybackService::getPosition(int sessionId, std::int64_t &position)
     if (mediaPipelineIter == m_mediaPipelines.end())
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
-        return false;
+        callback(false, 0);
+        return;
     }
-    return mediaPipelineIter->second->getPosition(position);
+    mediaPipelineIter->second->getPositionAsync(std::move(callback));
 }
 
 bool PlaybackService::setVideoWindow(int sessionId, std::uint32_t x, std::uint32_t y, std::uint32_t width,
@@ -283,8 +287,8 @@ bool PlaybackService::setVideoWindow(int sessionId, std::uint32_t x, std::uint32
     return mediaPipelineIter->second->setVideoWindow(x, y, width, height);
 }
 
-bool PlaybackService::haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
-                               std::uint32_t needDataRequestId)
+void PlaybackService::haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
+                               std::uint32_t needDataRequestId, ResultCallback callback)
 {
     RIALTO_SERVER_LOG_DEBUG("New data available, session id: %d", sessionId);
 
@@ -293,9 +297,25 @@ bool PlaybackService::haveData(int sessionId, MediaSourceStatus status, std::uin
     if (mediaPipelineIter == m_mediaPipelines.end())
     {
         RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
-        return false;
+        callback(false);
+        return;
+    }
+    mediaPipelineIter->second->haveDataAsync(status, numFrames, needDataRequestId, std::move(callback));
+}
+
+void PlaybackService::haveData(int sessionId, const std::vector<HaveDataShmInfo> &sources, ResultCallback callback)
+{
+    RIALTO_SERVER_LOG_DEBUG("New data of %zu sources available, session id: %d", sources.size(), sessionId);
+
+    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
+    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
+    if (mediaPipelineIter == m_mediaPipelines.end())
+    {
+        RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
+        callback(false);
+        return;
     }
-    return mediaPipelineIter->second->haveData(status, numFrames, needDataRequestId);
+    mediaPipelineIter->second->haveDataAsync(sources, std::move(callback));
 }
 
 bool PlaybackService::renderFrame(int sessionId)
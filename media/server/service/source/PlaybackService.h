@@ -61,16 +61,17 @@ public:
     bool load(int sessionId, MediaType type, const std::string &mimeType, const std::string &url) override;
     bool attachSource(int sessionId, IMediaPipeline::MediaSource &source) override;
     bool removeSource(int sessionId, std::int32_t sourceId) override;
-    bool play(int sessionId) override;
-    bool pause(int sessionId) override;
+    void play(int sessionId, ResultCallback callback) override;
+    void pause(int sessionId, ResultCallback callback) override;
     bool stop(int sessionId) override;
     bool setPlaybackRate(int sessionId, double rate) override;
-    bool setPosition(int sessionId, std::int64_t position) override;
-    bool getPosition(int sessionId, std::int64_t &position) override;
+    void setPosition(int sessionId, std::int64_t position, ResultCallback callback) override;
+    void getPosition(int sessionId, PositionCallback callback) override;
     bool setVideoWindow(int sessionId, std::uint32_t x, std::uint32_t y, std::uint32_t width,
                         std::uint32_t height) override;
-    bool haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
-                  std::uint32_t needDataRequestId) override;
+    void haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames, std::uint32_t needDataRequestId,
+                  ResultCallback callback) override;
+    void haveData(int sessionId, const std::vector<HaveDataShmInfo> &sources, ResultCallback callback) override;
     bool renderFrame(int sessionId) override;
     bool getSharedMemory(int32_t &fd, uint32_t &size) override;
     std::vector<std::string> getSupportedMimeTypes(MediaSourceType type) override;
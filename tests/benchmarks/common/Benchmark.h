@@ -0,0 +1,70 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_BENCHMARKS_BENCHMARK_H_
+#define FIREBOLT_RIALTO_BENCHMARKS_BENCHMARK_H_
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace firebolt::rialto::benchmarks
+{
+/**
+ * @brief Calls the function the given number of times.
+ *
+ * @param[in] iterations : The number of calls.
+ * @param[in] function   : The measured function.
+ *
+ * @retval the total time of the calls in nanoseconds.
+ */
+template <typename Function> double measureNanoseconds(uint32_t iterations, Function &&function)
+{
+    auto start{std::chrono::steady_clock::now()};
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+    auto end{std::chrono::steady_clock::now()};
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * @brief Prints the result of a benchmark and records it in the xml output of the current test.
+ *
+ * @param[in] name  : The name of the result.
+ * @param[in] value : The measured value.
+ * @param[in] unit  : The unit of the value, e.g. "ns per call".
+ */
+inline void report(const std::string &name, double value, const std::string &unit)
+{
+    // Counts are printed as whole numbers, measurements with three decimals
+    std::ostringstream formatted;
+    formatted << std::fixed << std::setprecision(std::floor(value) == value ? 0 : 3) << value;
+    std::cout << "[ BENCHMARK] " << name << ": " << formatted.str() << " " << unit << std::endl;
+    ::testing::Test::RecordProperty(name, formatted.str());
+}
+} // namespace firebolt::rialto::benchmarks
+
+#endif // FIREBOLT_RIALTO_BENCHMARKS_BENCHMARK_H_
@@ -0,0 +1,120 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Benchmark.h"
+#include "SimpleBufferPool.h"
+#include "SlabBufferPool.h"
+#include <array>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using firebolt::rialto::benchmarks::measureNanoseconds;
+using firebolt::rialto::benchmarks::report;
+
+namespace
+{
+constexpr uint32_t kIterations{20000};
+constexpr uint32_t kNumThreads{4};
+constexpr size_t kNumOutstanding{16};
+constexpr std::array<size_t, 4> kMessageSizes{200, 900, 3000, 70000};
+} // namespace
+
+class RialtoIpcBufferPoolBenchmark : public ::testing::Test
+{
+protected:
+    SimpleBufferPool m_simplePool;
+    SlabBufferPool m_slabPool;
+
+    template <typename Pool> void allocateAndFree(Pool &pool, size_t iteration)
+    {
+        std::array<uint8_t *, kNumOutstanding> buffers;
+        for (size_t i = 0; i < kNumOutstanding; ++i)
+        {
+            buffers[i] = pool.template allocate<uint8_t>(kMessageSizes[(iteration + i) % kMessageSizes.size()]);
+            buffers[i][0] = static_cast<uint8_t>(i);
+        }
+        for (uint8_t *buffer : buffers)
+        {
+            pool.deallocate(buffer);
+        }
+    }
+
+    template <typename Pool> void allocateAndFreeFromThreads(Pool &pool, uint32_t numThreads)
+    {
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back(
+                [this, &pool]()
+                {
+                    for (uint32_t i = 0; i < kIterations; ++i)
+                    {
+                        allocateAndFree(pool, i);
+                    }
+                });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    template <typename Pool> double measureNanosecondsPerBuffer(Pool &pool, uint32_t numThreads)
+    {
+        double nanoseconds = measureNanoseconds(1, [&]() { allocateAndFreeFromThreads(pool, numThreads); });
+        return nanoseconds / (kIterations * kNumOutstanding);
+    }
+
+    void checkSlabStats()
+    {
+        const SlabBufferPool::Stats stats{m_slabPool.getStats()};
+        report("IPC slab pool hits", stats.hits, "buffers");
+        report("IPC slab pool misses", stats.misses, "buffers");
+        report("IPC slab pool high-water mark", stats.highWaterMark, "bytes");
+
+        EXPECT_EQ(stats.bytesInUse, 0U);
+        EXPECT_GT(stats.hits, stats.misses);
+        EXPECT_GE(stats.highWaterMark, kMessageSizes.back());
+    }
+};
+
+/**
+ * Measures allocating and freeing a burst of replies of mixed sizes from one thread, which is how the IPC server
+ * builds replies and events.
+ */
+TEST_F(RialtoIpcBufferPoolBenchmark, SingleThread)
+{
+    report("IPC simple pool, 1 thread", measureNanosecondsPerBuffer(m_simplePool, 1), "ns per buffer");
+    report("IPC slab pool, 1 thread", measureNanosecondsPerBuffer(m_slabPool, 1), "ns per buffer");
+
+    checkSlabStats();
+}
+
+/**
+ * Measures the same load from several threads sharing one pool, as when replies are completed on other threads.
+ */
+TEST_F(RialtoIpcBufferPoolBenchmark, MultipleThreads)
+{
+    report("IPC simple pool, 4 threads", measureNanosecondsPerBuffer(m_simplePool, kNumThreads), "ns per buffer");
+    report("IPC slab pool, 4 threads", measureNanosecondsPerBuffer(m_slabPool, kNumThreads), "ns per buffer");
+
+    checkSlabStats();
+}
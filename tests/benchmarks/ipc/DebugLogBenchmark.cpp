@@ -0,0 +1,100 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Benchmark.h"
+#include "IpcLogging.h"
+#include "testmodule.pb.h"
+#include <cinttypes>
+#include <gtest/gtest.h>
+#include <string>
+
+using firebolt::rialto::TestMultiVar;
+using firebolt::rialto::TestMultiVar_TestType_ENUM2;
+using firebolt::rialto::benchmarks::measureNanoseconds;
+using firebolt::rialto::benchmarks::report;
+using firebolt::rialto::logging::getLogLevels;
+using firebolt::rialto::logging::setLogLevels;
+
+namespace
+{
+constexpr uint32_t kIterations{20000};
+constexpr uint64_t kSerialId{123};
+} // namespace
+
+class RialtoIpcDebugLogBenchmark : public ::testing::Test
+{
+protected:
+    RIALTO_DEBUG_LEVEL m_savedLogLevels{getLogLevels(RIALTO_COMPONENT_IPC)};
+    TestMultiVar m_message;
+    uint32_t m_numDescriptions{0};
+
+    RialtoIpcDebugLogBenchmark()
+    {
+        m_message.set_var1(-432);
+        m_message.set_var2(678U);
+        m_message.set_var3(TestMultiVar_TestType_ENUM2);
+        m_message.set_var4("a string long enough to make the formatting cost visible");
+
+        // The usual production configuration, DEBUG is off for the IPC component
+        setLogLevels(RIALTO_COMPONENT_IPC, RIALTO_DEBUG_LEVEL_DEFAULT);
+    }
+
+    ~RialtoIpcDebugLogBenchmark() { setLogLevels(RIALTO_COMPONENT_IPC, m_savedLogLevels); }
+
+    std::string describeMessage()
+    {
+        ++m_numDescriptions;
+        return m_message.ShortDebugString();
+    }
+};
+
+/**
+ * Measures a disabled debug log call that formats its message argument before the level is checked, which is how
+ * the IPC debug logs used to behave.
+ */
+TEST_F(RialtoIpcDebugLogBenchmark, EagerDebugLog)
+{
+    double nanoseconds = measureNanoseconds(kIterations,
+                                            [this]()
+                                            {
+                                                rialtoLogPrintf(RIALTO_COMPONENT_IPC, RIALTO_DEBUG_LEVEL_DEBUG,
+                                                                __FILE__, __FUNCTION__, __LINE__,
+                                                                "reply{ serial %" PRIu64 " } - { %s }", kSerialId,
+                                                                describeMessage().c_str());
+                                            });
+    report("IPC eager debug log", nanoseconds / kIterations, "ns per call");
+
+    EXPECT_EQ(m_numDescriptions, kIterations);
+}
+
+/**
+ * Measures a disabled RIALTO_IPC_LOG_DEBUG call, the message argument must not be formatted.
+ */
+TEST_F(RialtoIpcDebugLogBenchmark, LazyDebugLog)
+{
+    double nanoseconds = measureNanoseconds(kIterations,
+                                            [this]()
+                                            {
+                                                RIALTO_IPC_LOG_DEBUG("reply{ serial %" PRIu64 " } - { %s }",
+                                                                     kSerialId, describeMessage().c_str());
+                                            });
+    report("IPC lazy debug log", nanoseconds / kIterations, "ns per call");
+
+    EXPECT_EQ(m_numDescriptions, 0U);
+}
@@ -24,6 +24,7 @@
 #include <memory>
 #include <mutex>
 
+// The IPC buffer pool used before SlabBufferPool, kept as the baseline of BufferPoolBenchmark
 class SimpleBufferPool
 {
 public:
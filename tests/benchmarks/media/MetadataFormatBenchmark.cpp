@@ -0,0 +1,177 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Benchmark.h"
+#include "DataReaderFactory.h"
+#include "IDataReader.h"
+#include "IMediaFrameWriter.h"
+#include "ShmUtils.h"
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using firebolt::rialto::AddSegmentStatus;
+using firebolt::rialto::IMediaPipeline;
+using firebolt::rialto::MediaSourceType;
+using firebolt::rialto::ShmInfo;
+using firebolt::rialto::benchmarks::measureNanoseconds;
+using firebolt::rialto::common::IMediaFrameWriter;
+using firebolt::rialto::common::IMediaFrameWriterFactory;
+using firebolt::rialto::server::DataReaderFactory;
+using firebolt::rialto::server::getMaxMetadataBytes;
+using firebolt::rialto::server::maxFrames;
+
+namespace
+{
+constexpr uint32_t kIterations{2000};
+constexpr uint32_t kFrameBytes{256};
+constexpr uint32_t kMaxMediaBytes{maxFrames * 2 * kFrameBytes};
+constexpr uint32_t kNumSubSamples{4};
+const std::vector<uint8_t> kKeyId(16, 0x4B);
+const std::vector<uint8_t> kInitVector(16, 0x49);
+constexpr int32_t kMksId{7};
+
+class RialtoServerMetadataFormatBenchmark : public ::testing::Test
+{
+protected:
+    std::vector<uint8_t> m_shmBuffer = std::vector<uint8_t>(getMaxMetadataBytes() + kMaxMediaBytes);
+    std::vector<uint8_t> m_frameData = std::vector<uint8_t>(kFrameBytes, 0x55);
+    std::vector<std::unique_ptr<IMediaPipeline::MediaSegment>> m_segments;
+    std::shared_ptr<ShmInfo> m_shmInfo;
+    std::shared_ptr<IMediaFrameWriterFactory> m_mediaFrameWriterFactory;
+    DataReaderFactory m_dataReaderFactory;
+    int m_version{0};
+
+    void SetUp() override
+    {
+        m_shmInfo = std::make_shared<ShmInfo>();
+        m_shmInfo->maxMetadataBytes = getMaxMetadataBytes();
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = getMaxMetadataBytes();
+        m_shmInfo->maxMediaBytes = kMaxMediaBytes;
+
+        for (uint32_t i = 0; i < maxFrames; ++i)
+        {
+            m_segments.emplace_back(
+                std::make_unique<IMediaPipeline::MediaSegmentVideo>(1, i * 40000000, 40000000, 1920, 1080));
+            m_segments.back()->setData(kFrameBytes, m_frameData.data());
+            m_segments.back()->setEncrypted(true);
+            m_segments.back()->setMediaKeySessionId(kMksId);
+            m_segments.back()->setKeyId(kKeyId);
+            m_segments.back()->setInitVector(kInitVector);
+            for (uint32_t j = 0; j < kNumSubSamples; ++j)
+            {
+                m_segments.back()->addSubSample(16, kFrameBytes / kNumSubSamples - 16);
+            }
+        }
+    }
+
+    void TearDown() override { unsetenv("RIALTO_METADATA_VERSION"); }
+
+    void selectVersion(int version)
+    {
+        m_version = version;
+        setenv("RIALTO_METADATA_VERSION", std::to_string(version).c_str(), 1);
+        m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+    }
+
+    uint32_t encode()
+    {
+        std::unique_ptr<IMediaFrameWriter> writer{
+            m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer.data(), m_shmInfo)};
+        for (const auto &segment : m_segments)
+        {
+            if (AddSegmentStatus::OK != writer->writeFrame(segment))
+            {
+                break;
+            }
+        }
+        return writer->getNumFrames();
+    }
+
+    IMediaPipeline::MediaSegmentVector decode(uint32_t numFrames)
+    {
+        auto reader{m_dataReaderFactory.createDataReader(MediaSourceType::VIDEO, m_shmBuffer.data(),
+                                                         m_shmInfo->metadataOffset,
+                                                         m_shmInfo->maxMetadataBytes + m_shmInfo->maxMediaBytes,
+                                                         numFrames)};
+        return reader ? reader->readData() : IMediaPipeline::MediaSegmentVector{};
+    }
+
+    template <typename Function> double measureNanosecondsPerFrame(Function &&function)
+    {
+        return measureNanoseconds(kIterations, function) / (kIterations * maxFrames);
+    }
+
+    void report(const std::string &name, double nanoseconds)
+    {
+        firebolt::rialto::benchmarks::report("Metadata V" + std::to_string(m_version) + " " + name, nanoseconds,
+                                             "ns per frame");
+    }
+
+    /**
+     * Measures the per frame cost of writing and reading 24 encrypted video frames in the selected metadata version,
+     * and checks that the frames are read back unchanged.
+     */
+    void encodeAndDecode()
+    {
+        const uint32_t kNumFrames{encode()};
+        ASSERT_EQ(kNumFrames, maxFrames);
+        auto result{decode(kNumFrames)};
+        ASSERT_EQ(result.size(), maxFrames);
+        for (uint32_t i = 0; i < maxFrames; ++i)
+        {
+            EXPECT_EQ(result[i]->getTimeStamp(), m_segments[i]->getTimeStamp());
+            EXPECT_EQ(result[i]->getDuration(), m_segments[i]->getDuration());
+            ASSERT_EQ(result[i]->getDataLength(), kFrameBytes);
+            EXPECT_EQ(std::vector<uint8_t>(result[i]->getData(), result[i]->getData() + kFrameBytes), m_frameData);
+            if (1 != m_version) // Metadata V1 writer does not support encryption
+            {
+                EXPECT_EQ(result[i]->getMediaKeySessionId(), kMksId);
+                EXPECT_EQ(result[i]->getKeyId(), kKeyId);
+                EXPECT_EQ(result[i]->getInitVector(), kInitVector);
+                EXPECT_EQ(result[i]->getSubSamples().size(), kNumSubSamples);
+            }
+        }
+
+        report("encode", measureNanosecondsPerFrame([this]() { encode(); }));
+        report("decode", measureNanosecondsPerFrame([this, kNumFrames]() { decode(kNumFrames); }));
+    }
+};
+} // namespace
+
+TEST_F(RialtoServerMetadataFormatBenchmark, MetadataV1)
+{
+    selectVersion(1);
+    encodeAndDecode();
+}
+
+TEST_F(RialtoServerMetadataFormatBenchmark, MetadataV2)
+{
+    selectVersion(2);
+    encodeAndDecode();
+}
+
+TEST_F(RialtoServerMetadataFormatBenchmark, MetadataV3)
+{
+    selectVersion(3);
+    encodeAndDecode();
+}
@@ -0,0 +1,141 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Benchmark.h"
+#include "IMediaFrameWriter.h"
+#include "ShmCommon.h"
+#include <algorithm>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+using firebolt::rialto::benchmarks::measureNanoseconds;
+
+namespace
+{
+// Layout of a single video shm slot, as sent by the server in NeedMediaData
+constexpr uint32_t kMaxFrames{24};
+constexpr uint32_t kMaxMetadataBytes{VERSION_SIZE_BYTES + kMaxFrames * METADATA_V1_SIZE_PER_FRAME_BYTES};
+constexpr uint32_t kSlotBytes{7 * 1024 * 1024 / 2};
+constexpr uint32_t kMaxMediaBytes{kSlotBytes - kMaxMetadataBytes};
+constexpr uint32_t kFrameBytes{16 * 1024};
+constexpr uint32_t kRequests{64};
+constexpr uint8_t kStaleByte{0xAA};
+constexpr double kNanosecondsPerMillisecond{1000000.0};
+
+struct BenchmarkResult
+{
+    double milliseconds;
+    uint64_t bytesTouched;
+};
+
+class RialtoPlayerCommonShmZeroingBenchmark : public ::testing::Test
+{
+protected:
+    std::vector<uint8_t> m_shmBuffer = std::vector<uint8_t>(kSlotBytes, kStaleByte);
+    std::vector<uint8_t> m_frameData = std::vector<uint8_t>(kFrameBytes, 0x55);
+    std::shared_ptr<ShmInfo> m_shmInfo;
+    std::shared_ptr<IMediaFrameWriterFactory> m_mediaFrameWriterFactory;
+
+    void SetUp() override
+    {
+        m_shmInfo = std::make_shared<ShmInfo>();
+        m_shmInfo->maxMetadataBytes = kMaxMetadataBytes;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = kMaxMetadataBytes;
+        m_shmInfo->maxMediaBytes = kMaxMediaBytes;
+        m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+    }
+
+    uint32_t writeRequest()
+    {
+        std::unique_ptr<IMediaFrameWriter> writer{
+            m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer.data(), m_shmInfo)};
+        for (uint32_t i = 0; i < kMaxFrames; ++i)
+        {
+            std::unique_ptr<IMediaPipeline::MediaSegment> segment{
+                std::make_unique<IMediaPipeline::MediaSegmentVideo>(1, i * 40000000, 40000000, 1920, 1080)};
+            segment->setData(kFrameBytes, m_frameData.data());
+            EXPECT_EQ(writer->writeFrame(segment), AddSegmentStatus::OK);
+        }
+        return writer->getNumFrames();
+    }
+
+    // Zeroing done per request before metadata was protected by the frame count and length prefixes:
+    // the server cleared the whole slot and the writer cleared metadata and media regions once more.
+    void zeroLikeLegacyProtocol()
+    {
+        memset(m_shmBuffer.data(), 0, kSlotBytes);
+        memset(m_shmBuffer.data() + m_shmInfo->metadataOffset, 0, kMaxMetadataBytes);
+        memset(m_shmBuffer.data() + m_shmInfo->mediaDataOffset, 0, kMaxMediaBytes);
+    }
+
+    uint64_t bytesTouchedByWriter()
+    {
+        std::fill(m_shmBuffer.begin(), m_shmBuffer.end(), kStaleByte);
+        writeRequest();
+        for (uint32_t i = kSlotBytes; i > 0; --i)
+        {
+            if (m_shmBuffer[i - 1] != kStaleByte)
+            {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    void report(const std::string &name, const BenchmarkResult &result)
+    {
+        const double kMegabytes{static_cast<double>(result.bytesTouched) * kRequests / (1024.0 * 1024.0)};
+        benchmarks::report(name + ", " + std::to_string(kRequests) + " requests", result.milliseconds, "ms");
+        benchmarks::report(name + ", " + std::to_string(kRequests) + " requests written", kMegabytes, "MB");
+    }
+};
+} // namespace
+
+/**
+ * Measures the cost of filling a video shm slot with 24 frames, with and without zeroing the slot for each request,
+ * and checks that the writer touches only the extent of the written frames.
+ */
+TEST_F(RialtoPlayerCommonShmZeroingBenchmark, CompareZeroedAndNotZeroedRequests)
+{
+    const uint64_t kWriterBytes{bytesTouchedByWriter()};
+    const uint64_t kWrittenExtent{kMaxMetadataBytes + kMaxFrames * kFrameBytes};
+    EXPECT_LE(kWriterBytes, kWrittenExtent + kMaxFrames * 64); // metadata of the frames is not larger than 64 bytes
+    EXPECT_LT(kWriterBytes, kSlotBytes);
+
+    BenchmarkResult legacy{measureNanoseconds(kRequests,
+                                              [this]()
+                                              {
+                                                  zeroLikeLegacyProtocol();
+                                                  writeRequest();
+                                              }) /
+                               kNanosecondsPerMillisecond,
+                           2 * static_cast<uint64_t>(kSlotBytes) + kWriterBytes};
+    BenchmarkResult current{measureNanoseconds(kRequests, [this]() { writeRequest(); }) / kNanosecondsPerMillisecond,
+                            kWriterBytes};
+
+    report("Zeroed request", legacy);
+    report("Not zeroed request", current);
+    benchmarks::report("Memory writes saved per request", (legacy.bytesTouched - current.bytesTouched) / 1024.0,
+                       "KB");
+}
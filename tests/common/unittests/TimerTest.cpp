@@ -0,0 +1,211 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ITimer.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace firebolt::rialto::common;
+
+namespace
+{
+constexpr std::chrono::milliseconds kShortTimeout{10};
+constexpr std::chrono::milliseconds kLongTimeout{5000};
+constexpr std::chrono::milliseconds kWaitTimeout{2000};
+} // namespace
+
+class TimerTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<ITimerFactory> m_factory{ITimerFactory::getFactory()};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    int m_callCount{0};
+
+    void notifyCalled()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        ++m_callCount;
+        m_cv.notify_all();
+    }
+
+    bool waitForCalls(int callCount)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cv.wait_for(lock, kWaitTimeout, [this, callCount]() { return m_callCount >= callCount; });
+    }
+
+    int getCallCount()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_callCount;
+    }
+};
+
+/**
+ * Test that a one shot timer runs its callback exactly once.
+ */
+TEST_F(TimerTest, OneShotTimerFiresOnce)
+{
+    ASSERT_TRUE(m_factory);
+    std::unique_ptr<ITimer> timer = m_factory->createTimer(kShortTimeout, [this]() { notifyCalled(); });
+    ASSERT_TRUE(timer);
+
+    EXPECT_TRUE(waitForCalls(1));
+    std::this_thread::sleep_for(kShortTimeout * 5);
+    EXPECT_EQ(getCallCount(), 1);
+}
+
+/**
+ * Test that a periodic timer keeps running its callback until it is cancelled.
+ */
+TEST_F(TimerTest, PeriodicTimerFiresUntilCancelled)
+{
+    std::unique_ptr<ITimer> timer =
+        m_factory->createTimer(kShortTimeout, [this]() { notifyCalled(); }, TimerType::PERIODIC);
+    ASSERT_TRUE(timer);
+
+    EXPECT_TRUE(waitForCalls(3));
+    timer->cancel();
+    EXPECT_FALSE(timer->isActive());
+
+    const int kCallCount{getCallCount()};
+    std::this_thread::sleep_for(kShortTimeout * 5);
+    EXPECT_EQ(getCallCount(), kCallCount);
+}
+
+/**
+ * Test that a timer cancelled before its timeout never runs its callback.
+ */
+TEST_F(TimerTest, CancelledTimerDoesNotFire)
+{
+    std::unique_ptr<ITimer> timer = m_factory->createTimer(kShortTimeout * 5, [this]() { notifyCalled(); });
+    timer->cancel();
+    EXPECT_FALSE(timer->isActive());
+
+    std::this_thread::sleep_for(kShortTimeout * 10);
+    EXPECT_EQ(getCallCount(), 0);
+}
+
+/**
+ * Test that a periodic timer can be cancelled from its own callback.
+ */
+TEST_F(TimerTest, PeriodicTimerCancelledFromCallback)
+{
+    std::unique_ptr<ITimer> timer;
+    std::mutex timerMutex;
+    std::unique_lock<std::mutex> timerLock{timerMutex};
+    timer = m_factory->createTimer(
+        kShortTimeout,
+        [&]()
+        {
+            std::unique_lock<std::mutex> lock{timerMutex};
+            timer->cancel();
+            notifyCalled();
+        },
+        TimerType::PERIODIC);
+    timerLock.unlock();
+
+    EXPECT_TRUE(waitForCalls(1));
+    std::this_thread::sleep_for(kShortTimeout * 5);
+    EXPECT_EQ(getCallCount(), 1);
+    EXPECT_FALSE(timer->isActive());
+}
+
+/**
+ * Test that a periodic timer can be destroyed from its own callback.
+ */
+TEST_F(TimerTest, PeriodicTimerDestroyedFromCallback)
+{
+    std::unique_ptr<ITimer> timer;
+    std::mutex timerMutex;
+    std::unique_lock<std::mutex> timerLock{timerMutex};
+    timer = m_factory->createTimer(
+        kShortTimeout,
+        [&]()
+        {
+            std::unique_lock<std::mutex> lock{timerMutex};
+            timer.reset();
+            notifyCalled();
+        },
+        TimerType::PERIODIC);
+    timerLock.unlock();
+
+    EXPECT_TRUE(waitForCalls(1));
+    std::this_thread::sleep_for(kShortTimeout * 5);
+    EXPECT_EQ(getCallCount(), 1);
+    std::unique_lock<std::mutex> lock{timerMutex};
+    EXPECT_FALSE(timer);
+}
+
+/**
+ * Test that cancelling a timer while its callback runs waits for the callback to return.
+ */
+TEST_F(TimerTest, CancelWaitsForRunningCallback)
+{
+    std::atomic<bool> callbackStarted{false};
+    std::atomic<bool> callbackFinished{false};
+    std::unique_ptr<ITimer> timer = m_factory->createTimer(kShortTimeout,
+                                                           [&]()
+                                                           {
+                                                               callbackStarted = true;
+                                                               std::this_thread::sleep_for(kShortTimeout * 10);
+                                                               callbackFinished = true;
+                                                           });
+
+    while (!callbackStarted)
+    {
+        std::this_thread::yield();
+    }
+    timer->cancel();
+    EXPECT_TRUE(callbackFinished);
+}
+
+/**
+ * Test that a timer blocked in its callback does not hold back the other timers' cancellation.
+ */
+TEST_F(TimerTest, CancelIdleTimerWhileAnotherCallbackRuns)
+{
+    std::atomic<bool> callbackStarted{false};
+    std::atomic<bool> releaseCallback{false};
+    std::unique_ptr<ITimer> busyTimer = m_factory->createTimer(kShortTimeout,
+                                                               [&]()
+                                                               {
+                                                                   callbackStarted = true;
+                                                                   while (!releaseCallback)
+                                                                   {
+                                                                       std::this_thread::yield();
+                                                                   }
+                                                               });
+    std::unique_ptr<ITimer> idleTimer = m_factory->createTimer(kLongTimeout, [this]() { notifyCalled(); });
+
+    while (!callbackStarted)
+    {
+        std::this_thread::yield();
+    }
+    idleTimer.reset();
+    releaseCallback = true;
+    busyTimer.reset();
+    EXPECT_EQ(getCallCount(), 0);
+}
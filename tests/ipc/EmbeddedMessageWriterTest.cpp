@@ -0,0 +1,155 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EmbeddedMessageWriter.h"
+#include "rialtoipc-transport.pb.h"
+#include "testmodule.pb.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::ipc;
+
+class EmbeddedMessageWriterTest : public ::testing::Test
+{
+protected:
+    const uint64_t m_kSerialId{0x123456789};
+
+    static std::string serialize(const EmbeddedMessageWriter &writer)
+    {
+        std::string data(writer.byteSize(), '\0');
+        uint8_t *begin = reinterpret_cast<uint8_t *>(&data[0]);
+        EXPECT_EQ(writer.serializeToArray(begin), begin + data.size());
+        return data;
+    }
+
+    std::string serializeReply(const google::protobuf::Message &payload) const
+    {
+        transport::MethodCallReply reply;
+        reply.set_reply_id(m_kSerialId);
+        const EmbeddedMessageWriter writer(transport::MessageFromServer::kReplyFieldNumber, reply,
+                                           transport::MethodCallReply::kReplyMessageFieldNumber, payload);
+        return serialize(writer);
+    }
+
+    std::string serializeReplyAsString(const google::protobuf::Message &payload) const
+    {
+        transport::MessageFromServer message;
+        message.mutable_reply()->set_reply_id(m_kSerialId);
+        message.mutable_reply()->set_reply_message(payload.SerializeAsString());
+        return message.SerializeAsString();
+    }
+};
+
+/**
+ * Test that a reply with an empty payload is serialised as by SerializeAsString.
+ */
+TEST_F(EmbeddedMessageWriterTest, EmptyPayload)
+{
+    const TestNoVar kPayload;
+    const std::string kData = serializeReply(kPayload);
+    EXPECT_EQ(kData, serializeReplyAsString(kPayload));
+
+    transport::MessageFromServer message;
+    ASSERT_TRUE(message.ParseFromString(kData));
+    ASSERT_TRUE(message.has_reply());
+    EXPECT_EQ(message.reply().reply_id(), m_kSerialId);
+    EXPECT_TRUE(message.reply().has_reply_message());
+    EXPECT_TRUE(message.reply().reply_message().empty());
+}
+
+/**
+ * Test that a payload with multi byte length prefixes is serialised as by SerializeAsString, and parses back.
+ */
+TEST_F(EmbeddedMessageWriterTest, LargePayload)
+{
+    TestMultiVar payload;
+    payload.set_var1(-1);
+    payload.set_var2(0xffffffff);
+    payload.set_var3(TestMultiVar_TestType_ENUM2);
+    payload.set_var4(std::string(200 * 1024, 'x'));
+    const std::string kData = serializeReply(payload);
+    EXPECT_EQ(kData, serializeReplyAsString(payload));
+
+    transport::MessageFromServer message;
+    ASSERT_TRUE(message.ParseFromString(kData));
+    TestMultiVar parsedPayload;
+    ASSERT_TRUE(parsedPayload.ParseFromString(message.reply().reply_message()));
+    EXPECT_EQ(parsedPayload.SerializeAsString(), payload.SerializeAsString());
+}
+
+/**
+ * Test that a payload carrying an fd, which the server replaces with -1, is serialised as by SerializeAsString.
+ */
+TEST_F(EmbeddedMessageWriterTest, FdPayload)
+{
+    TestFdVar payload;
+    payload.set_fd(-1);
+    const std::string kData = serializeReply(payload);
+    EXPECT_EQ(kData, serializeReplyAsString(payload));
+
+    transport::MessageFromServer message;
+    ASSERT_TRUE(message.ParseFromString(kData));
+    TestFdVar parsedPayload;
+    ASSERT_TRUE(parsedPayload.ParseFromString(message.reply().reply_message()));
+    EXPECT_EQ(parsedPayload.fd(), -1);
+}
+
+/**
+ * Test that a method call is serialised as by SerializeAsString, with the request embedded in the call.
+ */
+TEST_F(EmbeddedMessageWriterTest, MethodCall)
+{
+    transport::MethodCall call;
+    call.set_serial_id(m_kSerialId);
+    call.set_service_name(TestModule::descriptor()->full_name());
+    call.set_method_name("TestRequestSingleVar");
+    TestSingleVar request;
+    request.set_var1(432);
+    const EmbeddedMessageWriter kWriter(transport::MessageToServer::kCallFieldNumber, call,
+                                        transport::MethodCall::kRequestMessageFieldNumber, request);
+
+    transport::MessageToServer expectedMessage;
+    *expectedMessage.mutable_call() = call;
+    expectedMessage.mutable_call()->set_request_message(request.SerializeAsString());
+    EXPECT_EQ(serialize(kWriter), expectedMessage.SerializeAsString());
+}
+
+/**
+ * Test that the request is still parsed back, when the call has fields numbered after the embedded one.
+ */
+TEST_F(EmbeddedMessageWriterTest, MethodCallWithIds)
+{
+    transport::MethodCall call;
+    call.set_serial_id(m_kSerialId);
+    call.set_service_id(1);
+    call.set_method_id(2);
+    TestSingleVar request;
+    request.set_var1(432);
+    const EmbeddedMessageWriter kWriter(transport::MessageToServer::kCallFieldNumber, call,
+                                        transport::MethodCall::kRequestMessageFieldNumber, request);
+
+    transport::MessageToServer message;
+    ASSERT_TRUE(message.ParseFromString(serialize(kWriter)));
+    EXPECT_EQ(message.call().serial_id(), m_kSerialId);
+    EXPECT_EQ(message.call().service_id(), 1U);
+    EXPECT_EQ(message.call().method_id(), 2U);
+    EXPECT_FALSE(message.call().has_service_name());
+    EXPECT_EQ(message.call().request_message(), request.SerializeAsString());
+}
@@ -18,10 +18,26 @@
  */
 
 #include "ClientStub.h"
+#include "IIpcChannel.h"
+#include "IIpcControllerFactory.h"
 #include "ServerStub.h"
 #include "TestClientMock.h"
 #include "TestModuleMock.h"
+#include "rialtoipc-transport.pb.h"
+#include "testmodule.pb.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
 #include <gtest/gtest.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace firebolt::rialto;
 using namespace firebolt::rialto::ipc;
@@ -44,6 +60,67 @@ MATCHER_P4(MultiVarRequestMatcher, var1, var2, var3, var4, "")
     return ((arg->var1() == var1) && (arg->var2() == var2) && (arg->var3() == var3) && (arg->var4() == var4));
 }
 
+namespace
+{
+/**
+ * The number of messages the server queues for a client, as set in ServerImpl.
+ */
+constexpr size_t kMaxSendQueueLen{256};
+
+/**
+ * Connects a socket to the server, without the IPC channel, to see the transport messages as sent on the wire.
+ */
+int connectRawSocket(const std::string &socketName)
+{
+    int sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketName.c_str(), sizeof(addr.sun_path) - 1);
+    if (sock >= 0 && connect(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+        close(sock);
+        sock = -1;
+    }
+    return sock;
+}
+
+template <typename Message> bool sendRawMessage(int sock, const Message &message, int fd = -1)
+{
+    std::string data = message.SerializeAsString();
+    iovec io{&data[0], data.size()};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))]{};
+    msghdr header{};
+    header.msg_iov = &io;
+    header.msg_iovlen = 1;
+    if (fd >= 0)
+    {
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    return sendmsg(sock, &header, MSG_NOSIGNAL) == static_cast<ssize_t>(data.size());
+}
+
+template <typename Message> bool receiveRawMessage(int sock, Message &message, int timeoutMs = 1000)
+{
+    pollfd fd{sock, POLLIN, 0};
+    if (poll(&fd, 1, timeoutMs) != 1)
+        return false;
+    std::vector<char> data(128 * 1024);
+    ssize_t len = recv(sock, data.data(), data.size(), 0);
+    return len > 0 && message.ParseFromArray(data.data(), static_cast<int>(len));
+}
+
+/**
+ * The timeout of the method calls, as set in ChannelImpl.
+ */
+constexpr std::chrono::milliseconds kCallTimeout{3000};
+} // namespace
+
 class RialtoIpcTest : public ::testing::Test
 {
 protected:
@@ -81,6 +158,308 @@ protected:
     }
 };
 
+/**
+ * Connects the client channel to a raw socket, so the test decides when and whether each method call is replied.
+ */
+class RialtoIpcChannelTest : public ::testing::Test
+{
+protected:
+    struct PendingCall
+    {
+        std::shared_ptr<google::protobuf::RpcController> controller{IControllerFactory::createFactory()->create()};
+        TestNoVar request;
+        TestSingleVar response;
+        uint64_t serialId{0};
+        int numCompletions{0};
+        std::chrono::steady_clock::time_point sentTime;
+        std::chrono::steady_clock::time_point completedTime;
+    };
+
+    int m_serverSock{-1};
+    std::shared_ptr<IChannel> m_channel;
+    std::unique_ptr<TestModule::Stub> m_testModuleStub;
+
+    void SetUp() override
+    {
+        m_channel = createRawChannel(m_serverSock);
+        ASSERT_TRUE(m_channel);
+        m_testModuleStub = std::make_unique<TestModule::Stub>(m_channel.get());
+    }
+
+    void TearDown() override
+    {
+        m_testModuleStub.reset();
+        m_channel.reset();
+        close(m_serverSock);
+    }
+
+    static std::shared_ptr<IChannel> createRawChannel(int &serverSock)
+    {
+        int socks[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, socks) != 0)
+            return nullptr;
+        serverSock = socks[0];
+        return IChannelFactory::createFactory()->createChannel(socks[1]);
+    }
+
+    static void onCallCompleted(PendingCall *call)
+    {
+        call->numCompletions++;
+        call->completedTime = std::chrono::steady_clock::now();
+    }
+
+    void sendCall(PendingCall &call)
+    {
+        call.sentTime = std::chrono::steady_clock::now();
+        m_testModuleStub->TestResponseSingleVar(call.controller.get(), &call.request, &call.response,
+                                                google::protobuf::NewCallback(onCallCompleted, &call));
+        call.serialId = receiveCallSerialId();
+    }
+
+    uint64_t receiveCallSerialId()
+    {
+        // skip the client capabilities sent when the channel is created
+        transport::MessageToServer message;
+        while (receiveRawMessage(m_serverSock, message) && !message.has_call())
+        {
+        }
+        EXPECT_TRUE(message.has_call());
+        return message.call().serial_id();
+    }
+
+    void sendReply(const PendingCall &call, int32_t var1)
+    {
+        TestSingleVar response;
+        response.set_var1(var1);
+        transport::MessageFromServer message;
+        message.mutable_reply()->set_reply_id(call.serialId);
+        message.mutable_reply()->set_reply_message(response.SerializeAsString());
+        EXPECT_TRUE(sendRawMessage(m_serverSock, message));
+    }
+
+    void processUntilCompleted(const std::vector<const PendingCall *> &calls, std::chrono::milliseconds maxWait)
+    {
+        const auto kDeadline = std::chrono::steady_clock::now() + maxWait;
+        auto isCompleted = [](const PendingCall *call) { return call->numCompletions > 0; };
+        while (!std::all_of(calls.begin(), calls.end(), isCompleted) && (std::chrono::steady_clock::now() < kDeadline))
+        {
+            m_channel->wait(50);
+            m_channel->process();
+        }
+    }
+};
+
+/**
+ * Test that a call times out at its own deadline, while the calls pipelined before and after it are replied out of
+ * order.
+ */
+TEST_F(RialtoIpcChannelTest, PipelinedCallTimesOutBetweenRepliedCalls)
+{
+    PendingCall first, second, third;
+    sendCall(first);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sendCall(second);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sendCall(third);
+
+    sendReply(third, 3);
+    sendReply(first, 1);
+    processUntilCompleted({&first, &third}, std::chrono::milliseconds(1000));
+    ASSERT_EQ(first.numCompletions, 1);
+    ASSERT_EQ(third.numCompletions, 1);
+    EXPECT_FALSE(first.controller->Failed());
+    EXPECT_EQ(first.response.var1(), 1);
+    EXPECT_FALSE(third.controller->Failed());
+    EXPECT_EQ(third.response.var1(), 3);
+    EXPECT_EQ(second.numCompletions, 0);
+
+    // the timer is re-armed for the second call, once the replied first call is dropped from the timeouts
+    processUntilCompleted({&second}, 2 * kCallTimeout);
+    ASSERT_EQ(second.numCompletions, 1);
+    EXPECT_TRUE(second.controller->Failed());
+    EXPECT_EQ(second.controller->ErrorText(), "Timed out");
+    EXPECT_GE(second.completedTime - second.sentTime, kCallTimeout);
+    EXPECT_LT(second.completedTime - second.sentTime, kCallTimeout + std::chrono::milliseconds(500));
+    EXPECT_EQ(first.numCompletions, 1);
+    EXPECT_EQ(third.numCompletions, 1);
+}
+
+/**
+ * Test that pipelined calls, with a replied call between them, each time out at their own deadline.
+ */
+TEST_F(RialtoIpcChannelTest, PipelinedCallsTimeOutAtTheirOwnDeadlines)
+{
+    PendingCall first, second, third;
+    sendCall(first);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    sendCall(second);
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    sendCall(third);
+
+    sendReply(second, 2);
+    processUntilCompleted({&first, &second, &third}, 2 * kCallTimeout);
+    ASSERT_EQ(first.numCompletions, 1);
+    ASSERT_EQ(second.numCompletions, 1);
+    ASSERT_EQ(third.numCompletions, 1);
+    EXPECT_FALSE(second.controller->Failed());
+    EXPECT_EQ(second.response.var1(), 2);
+    EXPECT_LT(second.completedTime, first.completedTime);
+
+    for (const PendingCall *call : {&first, &third})
+    {
+        EXPECT_TRUE(call->controller->Failed());
+        EXPECT_EQ(call->controller->ErrorText(), "Timed out");
+        EXPECT_GE(call->completedTime - call->sentTime, kCallTimeout);
+        EXPECT_LT(call->completedTime - call->sentTime, kCallTimeout + std::chrono::milliseconds(300));
+    }
+    EXPECT_GE(third.completedTime - first.completedTime, std::chrono::milliseconds(300));
+}
+
+/**
+ * Test that two channels, each serviced by its own thread at the same time, receive all their replies and events.
+ */
+TEST_F(RialtoIpcChannelTest, ChannelsServicedFromSeparateThreads)
+{
+    constexpr int kNumCalls{50};
+    int otherServerSock{-1};
+    std::shared_ptr<IChannel> otherChannel = createRawChannel(otherServerSock);
+    ASSERT_TRUE(otherChannel);
+
+    // the server side of each channel replies to every call with its serial id, and sends an event after it
+    auto serveCalls = [](int serverSock)
+    {
+        int numCalls{0};
+        transport::MessageToServer request;
+        while ((numCalls < kNumCalls) && receiveRawMessage(serverSock, request))
+        {
+            if (!request.has_call())
+                continue;
+            numCalls++;
+
+            TestSingleVar response;
+            response.set_var1(static_cast<int32_t>(request.call().serial_id()));
+            transport::MessageFromServer reply;
+            reply.mutable_reply()->set_reply_id(request.call().serial_id());
+            reply.mutable_reply()->set_reply_message(response.SerializeAsString());
+            EXPECT_TRUE(sendRawMessage(serverSock, reply));
+
+            TestEventSingleVar event;
+            event.set_var1(numCalls);
+            transport::MessageFromServer eventMessage;
+            eventMessage.mutable_event()->set_event_name(event.GetTypeName());
+            eventMessage.mutable_event()->set_message(event.SerializeAsString());
+            EXPECT_TRUE(sendRawMessage(serverSock, eventMessage));
+        }
+    };
+
+    // each client thread makes its calls one after the other, and services its channel until the events arrive
+    auto makeCalls = [](IChannel &channel, int &numReplies, int &numEvents)
+    {
+        TestModule::Stub stub{&channel};
+        const int kEventTag = channel.subscribe<TestEventSingleVar>(
+            [&numEvents](const std::shared_ptr<TestEventSingleVar> &event)
+            {
+                if (event->var1() == numEvents + 1)
+                    numEvents++;
+            });
+        EXPECT_GE(kEventTag, 0);
+
+        for (int i = 0; i < kNumCalls; ++i)
+        {
+            PendingCall call;
+            stub.TestResponseSingleVar(call.controller.get(), &call.request, &call.response,
+                                       google::protobuf::NewCallback(onCallCompleted, &call));
+            while ((call.numCompletions == 0) && channel.process())
+                channel.wait(100);
+            if ((call.numCompletions == 1) && !call.controller->Failed() && (call.response.var1() > 0))
+                numReplies++;
+        }
+
+        const auto kDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while ((numEvents < kNumCalls) && (std::chrono::steady_clock::now() < kDeadline) && channel.process())
+            channel.wait(100);
+        EXPECT_TRUE(channel.unsubscribe(kEventTag));
+    };
+
+    int numReplies{0}, numEvents{0}, otherNumReplies{0}, otherNumEvents{0};
+    std::thread server{serveCalls, m_serverSock};
+    std::thread otherServer{serveCalls, otherServerSock};
+    std::thread client{makeCalls, std::ref(*m_channel), std::ref(numReplies), std::ref(numEvents)};
+    std::thread otherClient{makeCalls, std::ref(*otherChannel), std::ref(otherNumReplies), std::ref(otherNumEvents)};
+    client.join();
+    otherClient.join();
+    server.join();
+    otherServer.join();
+
+    EXPECT_EQ(numReplies, kNumCalls);
+    EXPECT_EQ(numEvents, kNumCalls);
+    EXPECT_EQ(otherNumReplies, kNumCalls);
+    EXPECT_EQ(otherNumEvents, kNumCalls);
+
+    otherChannel.reset();
+    close(otherServerSock);
+}
+
+/**
+ * Test that the fd sent with a reply replaces the -1 the server puts in the fd field of the reply message.
+ */
+TEST_F(RialtoIpcChannelTest, ReplyFdIsSubstituted)
+{
+    int pipeFds[2];
+    ASSERT_EQ(pipe2(pipeFds, O_CLOEXEC), 0);
+
+    auto controller = IControllerFactory::createFactory()->create();
+    TestNoVar request;
+    TestFdVar response;
+    int numCompletions{0};
+    m_testModuleStub->TestResponseFd(controller.get(), &request, &response,
+                                     google::protobuf::NewCallback(+[](int *count) { (*count)++; }, &numCompletions));
+
+    TestFdVar replyMessage;
+    replyMessage.set_fd(-1);
+    transport::MessageFromServer reply;
+    reply.mutable_reply()->set_reply_id(receiveCallSerialId());
+    reply.mutable_reply()->set_reply_message(replyMessage.SerializeAsString());
+    EXPECT_TRUE(sendRawMessage(m_serverSock, reply, pipeFds[0]));
+    close(pipeFds[0]);
+
+    const auto kDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while ((numCompletions == 0) && (std::chrono::steady_clock::now() < kDeadline) && m_channel->process())
+        m_channel->wait(50);
+    ASSERT_EQ(numCompletions, 1);
+    ASSERT_FALSE(controller->Failed());
+    ASSERT_GE(response.fd(), 0);
+
+    // the received fd is the read end of the pipe
+    const char kData{'x'};
+    char data{0};
+    EXPECT_EQ(write(pipeFds[1], &kData, sizeof(kData)), 1);
+    EXPECT_EQ(read(response.fd(), &data, sizeof(data)), 1);
+    EXPECT_EQ(data, kData);
+
+    close(response.fd());
+    close(pipeFds[1]);
+}
+
+/**
+ * Test that disconnecting fails the outstanding calls straight away, rather than when they time out.
+ */
+TEST_F(RialtoIpcChannelTest, DisconnectFailsOutstandingCalls)
+{
+    PendingCall first, second;
+    sendCall(first);
+    sendCall(second);
+    sendReply(first, 1);
+    processUntilCompleted({&first}, std::chrono::milliseconds(1000));
+    ASSERT_EQ(first.numCompletions, 1);
+
+    m_channel->disconnect();
+    ASSERT_EQ(second.numCompletions, 1);
+    EXPECT_TRUE(second.controller->Failed());
+    EXPECT_EQ(second.controller->ErrorText(), "Channel disconnected");
+    EXPECT_FALSE(m_channel->process());
+}
+
 /**
  * Test that IPC can send a request with a single variable.
  */
@@ -108,6 +487,31 @@ TEST_F(RialtoIpcTest, SingleVarResponse)
     EXPECT_EQ(m_int, retInt);
 }
 
+/**
+ * Test that the reply to a request, read from the socket on its own, is sent straight away rather than queued.
+ */
+TEST_F(RialtoIpcTest, SingleRequestReplyIsNotQueued)
+{
+    constexpr int kNumRequests{5};
+    int32_t retInt = 0;
+
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .Times(kNumRequests)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int)),
+                              WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+
+    // the first request may be read together with the client's setup messages
+    EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+    const uint64_t kNumQueuedMessages = m_serverStub->getSendQueueStats().numQueuedMessages;
+
+    for (int i = 1; i < kNumRequests; ++i)
+    {
+        EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+        EXPECT_EQ(m_int, retInt);
+    }
+    EXPECT_EQ(m_serverStub->getSendQueueStats().numQueuedMessages, kNumQueuedMessages);
+}
+
 /**
  * Test that IPC can send a request with a multiple variables.
  */
@@ -183,3 +587,197 @@ TEST_F(RialtoIpcTest, MultiVarEvent)
 
     m_clientStub->waitForMultiVarEvent(retInt, retUint, retEnum, retStr);
 }
+
+/**
+ * Test that IPC client receives every event when the server sends them from several threads at once.
+ */
+TEST_F(RialtoIpcTest, SingleVarEventsFromMultipleThreads)
+{
+    constexpr int kNumThreads{4};
+    constexpr int kNumEventsPerThread{25};
+    int32_t retInt = 0;
+
+    m_clientStub->startMessageThread(1 + kNumThreads * kNumEventsPerThread);
+
+    // the first event waits for the server to register the client
+    m_serverStub->sendSingleVarEvent(m_int);
+
+    std::vector<std::thread> senders;
+    for (int i = 0; i < kNumThreads; ++i)
+    {
+        senders.emplace_back(
+            [this]()
+            {
+                for (int j = 0; j < kNumEventsPerThread; ++j)
+                    m_serverStub->sendSingleVarEvent(m_int);
+            });
+    }
+    for (auto &sender : senders)
+        sender.join();
+
+    m_clientStub->waitForSingleVarEvent(retInt);
+
+    EXPECT_EQ(m_int, retInt);
+    EXPECT_EQ(static_cast<size_t>(1 + kNumThreads * kNumEventsPerThread), m_clientStub->getNumSingleVarEvents());
+}
+
+/**
+ * Test that the server does not block sending events to a client that is not reading its socket. Queued coalescible
+ * events are replaced by newer ones, and dropped once the queue is full, while the other events are delivered in
+ * full once the client starts processing.
+ */
+TEST_F(RialtoIpcTest, SingleVarEventsToSlowClient)
+{
+    constexpr size_t kMaxNumEvents{10000};
+    constexpr uint64_t kNumCoalescedKeys{2 * kMaxSendQueueLen};
+    constexpr uint64_t kSupersededKey{0};
+    const int32_t kSupersededValue{m_int + 1};
+    const int32_t kLatestValue{m_int + 2};
+    int32_t retInt = 0;
+
+    // fill the socket, until an event has to wait in the queue
+    size_t numEvents = 0;
+    while ((numEvents < kMaxNumEvents) && (m_serverStub->getSendQueueStats().depth == 0))
+    {
+        m_serverStub->sendSingleVarEvent(m_int);
+        numEvents++;
+    }
+    ASSERT_EQ(m_serverStub->getSendQueueStats().depth, 1U);
+
+    // a newer event of the same type and key replaces the queued one
+    m_serverStub->sendCoalescedSingleVarEvent(kSupersededValue, kSupersededKey);
+    m_serverStub->sendCoalescedSingleVarEvent(kLatestValue, kSupersededKey);
+    EXPECT_EQ(m_serverStub->getSendQueueStats().numCoalescedEvents, 1U);
+
+    // once the queue is full coalescible events are dropped, and the client stays connected
+    for (uint64_t key = kSupersededKey + 1; key <= kNumCoalescedKeys; ++key)
+        m_serverStub->sendCoalescedSingleVarEvent(m_int, key);
+
+    const IClient::SendQueueStats kStats = m_serverStub->getSendQueueStats();
+    EXPECT_EQ(kStats.depth, kMaxSendQueueLen);
+    EXPECT_EQ(kStats.maxDepth, kMaxSendQueueLen);
+    EXPECT_EQ(kStats.numCoalescedEvents, 1U);
+    EXPECT_GT(kStats.numDroppedEvents, 0U);
+
+    const size_t kNumDelivered =
+        numEvents + 2 + kNumCoalescedKeys - kStats.numCoalescedEvents - kStats.numDroppedEvents;
+    m_clientStub->startMessageThread(kNumDelivered);
+    m_clientStub->waitForSingleVarEvent(retInt);
+
+    EXPECT_EQ(kNumDelivered, m_clientStub->getNumSingleVarEvents());
+    const std::vector<int32_t> kValues = m_clientStub->getSingleVarEventValues();
+    EXPECT_EQ(std::count(kValues.begin(), kValues.end(), m_int), static_cast<int>(kNumDelivered - 1));
+    EXPECT_EQ(std::count(kValues.begin(), kValues.end(), kSupersededValue), 0);
+    EXPECT_EQ(std::count(kValues.begin(), kValues.end(), kLatestValue), 1);
+}
+
+/**
+ * Test that the server disconnects a client that is not reading its socket, rather than drop an event that can't
+ * be coalesced when the client's queue is full.
+ */
+TEST_F(RialtoIpcTest, NonCoalescibleEventsOverflowDisconnectsSlowClient)
+{
+    constexpr size_t kMaxNumEvents{10000};
+
+    // waits for the client to connect
+    m_serverStub->sendSingleVarEvent(m_int);
+
+    // the events fill the socket and then the queue, the first one that doesn't fit fails
+    EXPECT_LT(m_serverStub->sendSingleVarEvents(m_int, kMaxNumEvents), kMaxNumEvents);
+    EXPECT_TRUE(m_serverStub->waitForClientDisconnected());
+}
+
+/**
+ * Test that IPC keeps dispatching requests of several methods once the numeric service and method ids have been
+ * negotiated with the server.
+ */
+TEST_F(RialtoIpcTest, RepeatedRequestsAfterIdNegotiation)
+{
+    constexpr int kNumRequests{5};
+    int32_t retInt = 0;
+
+    // The server monitor reports the calls as received, but accepts only root clients
+    if (0 != getuid())
+    {
+        GTEST_SKIP() << "Registering a server monitor requires root";
+    }
+
+    // A raw client announcing numeric ids registers the monitor. It also becomes the client the server stub sends
+    // the events to, so the events can be checked on the wire.
+    int rawSock = connectRawSocket(m_socketName);
+    ASSERT_GE(rawSock, 0);
+    int monitorSocks[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, monitorSocks), 0);
+    transport::MessageToServer capabilities;
+    capabilities.mutable_capabilities()->set_numeric_ids(true);
+    EXPECT_TRUE(sendRawMessage(rawSock, capabilities));
+    transport::MessageToServer registerMonitor;
+    registerMonitor.mutable_monitor()->set_socket(0);
+    EXPECT_TRUE(sendRawMessage(rawSock, registerMonitor, monitorSocks[1]));
+    close(monitorSocks[1]);
+    transport::MonitorMessage monitorMessage;
+    ASSERT_TRUE(receiveRawMessage(monitorSocks[0], monitorMessage));
+    EXPECT_TRUE(monitorMessage.has_current_clients());
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .Times(kNumRequests)
+        .WillRepeatedly(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .Times(kNumRequests)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int)),
+                              WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+
+    for (int i = 0; i < kNumRequests; ++i)
+    {
+        EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+        retInt = 0;
+        EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+        EXPECT_EQ(m_int, retInt);
+    }
+
+    for (int i = 0; i < kNumRequests; ++i)
+        m_serverStub->sendSingleVarEvent(m_int);
+
+    // The first call may be sent before the client has received the ids, all the others use them
+    int numCalls{0};
+    while (receiveRawMessage(monitorSocks[0], monitorMessage, 100))
+    {
+        if (monitorMessage.has_call())
+        {
+            const transport::MethodCall &call = monitorMessage.call().call();
+            if (numCalls++ > 0)
+            {
+                EXPECT_TRUE(call.has_service_id());
+                EXPECT_TRUE(call.has_method_id());
+            }
+        }
+    }
+    EXPECT_EQ(numCalls, 2 * kNumRequests);
+
+    // Events are sent by id, after the EventId announcing it
+    bool isEventIdAnnounced{false};
+    uint32_t eventId{0};
+    int numEvents{0};
+    transport::MessageFromServer serverMessage;
+    while (numEvents < kNumRequests && receiveRawMessage(rawSock, serverMessage))
+    {
+        if (serverMessage.has_event_id())
+        {
+            EXPECT_EQ(serverMessage.event_id().event_name(), TestEventSingleVar::descriptor()->full_name());
+            eventId = serverMessage.event_id().event_id();
+            isEventIdAnnounced = true;
+        }
+        else if (serverMessage.has_event())
+        {
+            ASSERT_TRUE(isEventIdAnnounced);
+            EXPECT_TRUE(serverMessage.event().has_event_id());
+            EXPECT_EQ(serverMessage.event().event_id(), eventId);
+            EXPECT_FALSE(serverMessage.event().has_event_name());
+            ++numEvents;
+        }
+    }
+    EXPECT_EQ(numEvents, kNumRequests);
+
+    close(monitorSocks[0]);
+    close(rawSock);
+}
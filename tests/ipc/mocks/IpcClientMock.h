@@ -38,6 +38,9 @@ public:
     MOCK_METHOD(void, disconnect, (), (override));
     MOCK_METHOD(void, exportService, (const std::shared_ptr<google::protobuf::Service> &service), (override));
     MOCK_METHOD(bool, sendEvent, (const std::shared_ptr<google::protobuf::Message> &message), (override));
+    MOCK_METHOD(bool, sendCoalescedEvent,
+                (const std::shared_ptr<google::protobuf::Message> &message, uint64_t coalesceKey), (override));
+    MOCK_METHOD(SendQueueStats, getSendQueueStats, (), (override, const));
     MOCK_METHOD(bool, isConnected, (), (override, const));
 };
 } // namespace firebolt::rialto::ipc
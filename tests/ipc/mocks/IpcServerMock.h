@@ -42,6 +42,7 @@ public:
     MOCK_METHOD(int, fd, (), (override, const));
     MOCK_METHOD(bool, wait, (int timeoutMSecs), (override));
     MOCK_METHOD(bool, process, (), (override));
+    MOCK_METHOD(void, wakeEventLoop, (), (const, override));
 };
 } // namespace firebolt::rialto::ipc
 
@@ -33,7 +33,8 @@ void onMessageReceived(bool *done)
 
 ClientStub::ClientStub(const std::shared_ptr<firebolt::rialto::ipc::TestClientMock> &clientMock,
                        const std::string &socketName)
-    : m_socketName{socketName}, m_clientMock{clientMock}, m_messageReceived{false}
+    : m_socketName{socketName}, m_clientMock{clientMock}, m_messageReceived{false}, m_numExpectedEvents{1},
+      m_numSingleVarEvents{0}
 {
 }
 
@@ -202,13 +203,18 @@ bool ClientStub::sendRequestWithMultiVarResponse(int32_t &var1, uint32_t &var2,
     return true;
 }
 
-void ClientStub::startMessageThread()
+void ClientStub::startMessageThread(size_t numExpectedEvents)
 {
+    m_numExpectedEvents = numExpectedEvents;
     m_eventThread = std::thread{[this]()
                                 {
+                                    {
+                                        std::unique_lock<std::mutex> startThreadLock(m_startThreadMutex);
+                                        m_threadStarted.store(true);
+                                    }
+                                    m_startThreadCond.notify_one();
                                     while (m_channel->process() && !m_messageReceived.load())
                                     {
-                                        m_startThreadCond.notify_one();
                                         m_channel->wait(10);
                                     }
                                     EXPECT_TRUE(m_messageReceived.load());
@@ -216,17 +222,16 @@ void ClientStub::startMessageThread()
                                 }};
 
     std::unique_lock<std::mutex> startThreadLock(m_startThreadMutex);
-    std::cv_status status = m_startThreadCond.wait_for(startThreadLock, std::chrono::milliseconds(100));
-    ASSERT_NE(std::cv_status::timeout, status);
+    ASSERT_TRUE(m_startThreadCond.wait_for(startThreadLock, std::chrono::milliseconds(100),
+                                           [this]() { return m_threadStarted.load(); }));
 }
 
 void ClientStub::waitForSingleVarEvent(int32_t &var1)
 {
-    if (!m_messageReceived.load())
     {
         std::unique_lock<std::mutex> messageLock(m_messageMutex);
-        std::cv_status status = m_messageCond.wait_for(messageLock, std::chrono::milliseconds(100));
-        EXPECT_NE(std::cv_status::timeout, status);
+        EXPECT_TRUE(m_messageCond.wait_for(messageLock, std::chrono::milliseconds(100),
+                                           [this]() { return m_messageReceived.load(); }));
     }
     ASSERT_NE(m_singleVarEvent, nullptr);
 
@@ -253,7 +258,21 @@ void ClientStub::waitForMultiVarEvent(int32_t &var1, uint32_t &var2, firebolt::r
 void ClientStub::onTestEventSingleVarReceived(const std::shared_ptr<firebolt::rialto::TestEventSingleVar> &event)
 {
     m_singleVarEvent = event;
-    m_messageReceived.store(true);
+    m_singleVarEventValues.push_back(event->var1());
+    if (++m_numSingleVarEvents >= m_numExpectedEvents)
+    {
+        m_messageReceived.store(true);
+    }
+}
+
+size_t ClientStub::getNumSingleVarEvents() const
+{
+    return m_numSingleVarEvents;
+}
+
+std::vector<int32_t> ClientStub::getSingleVarEventValues() const
+{
+    return m_singleVarEventValues;
 }
 
 void ClientStub::onTestEventMultiVarReceived(const std::shared_ptr<firebolt::rialto::TestEventMultiVar> &event)
@@ -45,8 +45,10 @@ public:
     bool sendRequestWithMultiVarResponse(int32_t &var1, uint32_t &var2, firebolt::rialto::TestMultiVar_TestType &var3,
                                          std::string &var4);
 
-    void startMessageThread();
+    void startMessageThread(size_t numExpectedEvents = 1);
     void waitForSingleVarEvent(int32_t &var1);
+    size_t getNumSingleVarEvents() const;
+    std::vector<int32_t> getSingleVarEventValues() const;
     void waitForMultiVarEvent(int32_t &var1, uint32_t &var2, firebolt::rialto::TestEventMultiVar_TestType &var3,
                               std::string &var4);
 
@@ -60,11 +62,15 @@ private:
     std::unique_ptr<firebolt::rialto::TestModule_Stub> m_testModuleStub;
     std::shared_ptr<firebolt::rialto::ipc::TestClientMock> m_clientMock;
     std::atomic<bool> m_messageReceived;
+    size_t m_numExpectedEvents;
+    size_t m_numSingleVarEvents;
+    std::vector<int32_t> m_singleVarEventValues;
     std::thread m_eventThread;
     std::mutex m_messageMutex;
     std::condition_variable m_messageCond;
     std::mutex m_startThreadMutex;
     std::condition_variable m_startThreadCond;
+    std::atomic<bool> m_threadStarted{false};
     std::shared_ptr<firebolt::rialto::TestEventSingleVar> m_singleVarEvent;
     std::shared_ptr<firebolt::rialto::TestEventMultiVar> m_multiVarEvent;
     std::vector<int> m_eventTags;
@@ -110,6 +110,51 @@ void ServerStub::sendSingleVarEvent(int32_t var1)
     m_client->sendEvent(event);
 }
 
+void ServerStub::sendCoalescedSingleVarEvent(int32_t var1, uint64_t coalesceKey)
+{
+    auto event = std::make_shared<firebolt::rialto::TestEventSingleVar>();
+    event->set_var1(var1);
+
+    if (!m_clientConnected.load())
+    {
+        std::unique_lock<std::mutex> clientConnectedLock(m_clientConnectMutex);
+        std::cv_status status = m_clientConnectCond.wait_for(clientConnectedLock, std::chrono::milliseconds(100));
+        ASSERT_NE(std::cv_status::timeout, status);
+    }
+
+    m_client->sendCoalescedEvent(event, coalesceKey);
+}
+
+size_t ServerStub::sendSingleVarEvents(int32_t var1, size_t numEvents)
+{
+    auto event = std::make_shared<firebolt::rialto::TestEventSingleVar>();
+    event->set_var1(var1);
+
+    // the client may be disconnected while sending, so keep hold of it
+    std::shared_ptr<::firebolt::rialto::ipc::IClient> client = m_client;
+    size_t numSent = 0;
+    while (client && (numSent < numEvents) && client->sendEvent(event))
+        numSent++;
+
+    return numSent;
+}
+
+::firebolt::rialto::ipc::IClient::SendQueueStats ServerStub::getSendQueueStats()
+{
+    std::shared_ptr<::firebolt::rialto::ipc::IClient> client = m_client;
+    if (!client)
+        return ::firebolt::rialto::ipc::IClient::SendQueueStats();
+
+    return client->getSendQueueStats();
+}
+
+bool ServerStub::waitForClientDisconnected()
+{
+    std::unique_lock<std::mutex> clientConnectedLock(m_clientConnectMutex);
+    return m_clientConnectCond.wait_for(clientConnectedLock, std::chrono::milliseconds(1000),
+                                        [this]() { return !m_clientConnected.load(); });
+}
+
 void ServerStub::sendMultiVarEvent(int32_t var1, uint32_t var2, firebolt::rialto::TestEventMultiVar_TestType var3,
                                    std::string var4)
 {
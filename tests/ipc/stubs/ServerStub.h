@@ -41,6 +41,10 @@ public:
     void clientConnected(const std::shared_ptr<::firebolt::rialto::ipc::IClient> &client);
 
     void sendSingleVarEvent(int32_t var1);
+    void sendCoalescedSingleVarEvent(int32_t var1, uint64_t coalesceKey);
+    size_t sendSingleVarEvents(int32_t var1, size_t numEvents);
+    ::firebolt::rialto::ipc::IClient::SendQueueStats getSendQueueStats();
+    bool waitForClientDisconnected();
     void sendMultiVarEvent(int32_t var1, uint32_t var2, firebolt::rialto::TestEventMultiVar_TestType var3,
                            std::string var4);
 
@@ -0,0 +1,243 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncLogSink.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace firebolt::rialto::logging;
+
+namespace
+{
+constexpr size_t kRingCapacity{8};
+constexpr timespec kTimestamp{12, 34};
+const char *kFile{"File.cpp"};
+const char *kFunction{"function"};
+constexpr int kLine{56};
+} // namespace
+
+class AsyncLogSinkTest : public ::testing::Test
+{
+protected:
+    std::mutex m_recordsMutex;
+    std::vector<LogRecord> m_records;
+
+    AsyncLogSink::LogWriter createWriter()
+    {
+        return [this](const LogRecord &record)
+        {
+            std::unique_lock<std::mutex> lock(m_recordsMutex);
+            m_records.push_back(record);
+        };
+    }
+
+    bool push(AsyncLogSink &sink, pid_t threadId, const std::string &message)
+    {
+        return sink.push(RIALTO_DEBUG_LEVEL_INFO, threadId, kTimestamp, kFile, kLine, kFunction, message.c_str(),
+                         message.size());
+    }
+};
+
+/**
+ * Test that the records pushed by one thread are written in order with all their fields.
+ */
+TEST_F(AsyncLogSinkTest, WritesRecordsInOrder)
+{
+    AsyncLogSink sink{createWriter(), kRingCapacity};
+    EXPECT_TRUE(push(sink, 1, "first"));
+    EXPECT_TRUE(push(sink, 1, "second"));
+    sink.stop();
+
+    ASSERT_EQ(m_records.size(), 2U);
+    EXPECT_EQ(m_records[0].level, RIALTO_DEBUG_LEVEL_INFO);
+    EXPECT_EQ(m_records[0].threadId, 1);
+    EXPECT_EQ(m_records[0].timestamp.tv_sec, kTimestamp.tv_sec);
+    EXPECT_EQ(m_records[0].timestamp.tv_nsec, kTimestamp.tv_nsec);
+    EXPECT_STREQ(m_records[0].file, kFile);
+    EXPECT_STREQ(m_records[0].function, kFunction);
+    EXPECT_EQ(m_records[0].line, kLine);
+    EXPECT_EQ(std::string(m_records[0].message, m_records[0].messageLen), "first");
+    EXPECT_EQ(std::string(m_records[1].message, m_records[1].messageLen), "second");
+    EXPECT_EQ(sink.getDroppedCount(), 0U);
+}
+
+/**
+ * Test that an idle sink thread is woken up for each new record, without waiting for it to be stopped.
+ */
+TEST_F(AsyncLogSinkTest, WakesUpIdleSinkThread)
+{
+    constexpr size_t kNumMessages{20};
+    AsyncLogSink sink{createWriter(), kRingCapacity};
+    for (size_t i = 1; i <= kNumMessages; ++i)
+    {
+        EXPECT_TRUE(push(sink, 1, "message"));
+
+        const auto kDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        size_t numRecords{0};
+        while (numRecords < i && std::chrono::steady_clock::now() < kDeadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::unique_lock<std::mutex> lock(m_recordsMutex);
+            numRecords = m_records.size();
+        }
+        ASSERT_EQ(numRecords, i);
+    }
+    sink.stop();
+}
+
+/**
+ * Test that messages longer than a record are truncated.
+ */
+TEST_F(AsyncLogSinkTest, TruncatesLongMessages)
+{
+    AsyncLogSink sink{createWriter(), kRingCapacity};
+    const std::string kLongMessage(1000, 'x');
+    EXPECT_TRUE(push(sink, 1, kLongMessage));
+    sink.stop();
+
+    ASSERT_EQ(m_records.size(), 1U);
+    EXPECT_EQ(m_records[0].messageLen, sizeof(m_records[0].message) - 1);
+    EXPECT_EQ(m_records[0].message[m_records[0].messageLen], '\0');
+}
+
+/**
+ * Test that the records of several threads are all written.
+ */
+TEST_F(AsyncLogSinkTest, WritesRecordsOfAllThreads)
+{
+    constexpr int kNumThreads{4};
+    constexpr int kNumMessages{100};
+    AsyncLogSink sink{createWriter(), kNumMessages};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i)
+    {
+        threads.emplace_back(
+            [this, &sink, i]()
+            {
+                for (int j = 0; j < kNumMessages; ++j)
+                {
+                    push(sink, i, "message");
+                }
+            });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    sink.stop();
+
+    EXPECT_EQ(m_records.size(), kNumThreads * kNumMessages);
+    EXPECT_EQ(sink.getDroppedCount(), 0U);
+}
+
+/**
+ * Test that messages are dropped and reported, without blocking, when the ring of a thread is full.
+ */
+TEST_F(AsyncLogSinkTest, DropsMessagesWhenRingIsFull)
+{
+    constexpr size_t kNumExtraMessages{5};
+    std::promise<void> writerEnteredPromise;
+    std::promise<void> unblockPromise;
+    std::shared_future<void> unblockFuture{unblockPromise.get_future()};
+    bool isFirstRecord{true};
+    AsyncLogSink sink{[&](const LogRecord &record)
+                      {
+                          if (isFirstRecord)
+                          {
+                              isFirstRecord = false;
+                              writerEnteredPromise.set_value();
+                              unblockFuture.wait();
+                          }
+                          std::unique_lock<std::mutex> lock(m_recordsMutex);
+                          m_records.push_back(record);
+                      },
+                      kRingCapacity};
+
+    // The sink thread holds the first record until it is unblocked, so the ring has one free slot less
+    EXPECT_TRUE(push(sink, 1, "blocking"));
+    writerEnteredPromise.get_future().wait();
+    for (size_t i = 0; i < kRingCapacity + kNumExtraMessages; ++i)
+    {
+        EXPECT_TRUE(push(sink, 1, "message"));
+    }
+    unblockPromise.set_value();
+    sink.stop();
+
+    EXPECT_EQ(sink.getDroppedCount(), kNumExtraMessages + 1);
+    // The blocking record, the drop report and the messages that fitted in the ring
+    ASSERT_EQ(m_records.size(), kRingCapacity + 1);
+    EXPECT_EQ(m_records[1].level, RIALTO_DEBUG_LEVEL_WARNING);
+    EXPECT_EQ(std::string(m_records[1].message), "Log ring full, dropped 6 messages");
+}
+
+/**
+ * Test that a stopped sink rejects new messages, so that the caller can write them itself.
+ */
+TEST_F(AsyncLogSinkTest, RejectsMessagesWhenStopped)
+{
+    AsyncLogSink sink{createWriter(), kRingCapacity};
+    sink.stop();
+    EXPECT_FALSE(push(sink, 1, "message"));
+    EXPECT_TRUE(m_records.empty());
+}
+
+/**
+ * Test that every message accepted while the sink is stopping is written.
+ */
+TEST_F(AsyncLogSinkTest, WritesMessagesPushedWhileStopping)
+{
+    constexpr int kNumThreads{4};
+    constexpr int kNumMessages{1000};
+    AsyncLogSink sink{createWriter(), kNumMessages};
+    std::atomic<size_t> numAccepted{0};
+    std::promise<void> startPromise;
+    std::shared_future<void> startFuture{startPromise.get_future()};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i)
+    {
+        threads.emplace_back(
+            [this, &sink, &numAccepted, startFuture, i]()
+            {
+                startFuture.wait();
+                for (int j = 0; j < kNumMessages; ++j)
+                {
+                    if (push(sink, i, "message"))
+                    {
+                        ++numAccepted;
+                    }
+                }
+            });
+    }
+    startPromise.set_value();
+    sink.stop();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::unique_lock<std::mutex> lock(m_recordsMutex);
+    EXPECT_EQ(m_records.size(), numAccepted);
+    EXPECT_EQ(sink.getDroppedCount(), 0U);
+}
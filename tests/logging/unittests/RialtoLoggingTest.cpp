@@ -24,6 +24,12 @@ using namespace firebolt::rialto::logging;
 
 uint32_t g_handlerCalledCount = 0U;
 
+#ifdef RIALTO_LOG_DISABLE_DEBUG
+constexpr bool kIsDebugLogCompiledIn{false};
+#else
+constexpr bool kIsDebugLogCompiledIn{true};
+#endif
+
 class RialtoLoggingTest : public ::testing::Test
 {
 protected:
@@ -79,8 +85,9 @@ protected:
                   (logLevels & RIALTO_DEBUG_LEVEL_INFO) ? ++expectedHandlerCalledCount : expectedHandlerCalledCount);
 
         RIALTO_LOG_DEBUG(component, "RIALTO_LOG_DEBUG");
-        EXPECT_EQ(g_handlerCalledCount,
-                  (logLevels & RIALTO_DEBUG_LEVEL_DEBUG) ? ++expectedHandlerCalledCount : expectedHandlerCalledCount);
+        EXPECT_EQ(g_handlerCalledCount, ((logLevels & RIALTO_DEBUG_LEVEL_DEBUG) && kIsDebugLogCompiledIn)
+                                            ? ++expectedHandlerCalledCount
+                                            : expectedHandlerCalledCount);
     }
 };
 
@@ -233,3 +240,37 @@ TEST_F(RialtoLoggingTest, GetLogLevelDebug)
 
     ASSERT_EQ(getLogLevels(RIALTO_COMPONENT_DEFAULT), logLevel);
 }
+
+/**
+ * Test that the arguments of a log call are not evaluated when its level is disabled.
+ */
+TEST_F(RialtoLoggingTest, ArgumentsNotEvaluatedForDisabledLevel)
+{
+    uint32_t numEvaluations = 0U;
+    auto evaluate = [&numEvaluations]() { return ++numEvaluations; };
+
+    setLogHandler(RIALTO_COMPONENT_DEFAULT, RialtoLoggingTest::TestLogHandler);
+    setLogLevels(RIALTO_COMPONENT_DEFAULT, RIALTO_DEBUG_LEVEL_ERROR);
+
+    RIALTO_LOG_DEBUG(RIALTO_COMPONENT_DEFAULT, "%u", evaluate());
+    RIALTO_LOG_SYS_WARN(RIALTO_COMPONENT_DEFAULT, 1, "%u", evaluate());
+    EXPECT_EQ(numEvaluations, 0U);
+    EXPECT_EQ(g_handlerCalledCount, 0U);
+
+    RIALTO_LOG_ERROR(RIALTO_COMPONENT_DEFAULT, "%u", evaluate());
+    EXPECT_EQ(numEvaluations, 1U);
+    EXPECT_EQ(g_handlerCalledCount, 1U);
+}
+
+/**
+ * Test that the level check matches the configured log levels.
+ */
+TEST_F(RialtoLoggingTest, IsLevelEnabled)
+{
+    setLogLevels(RIALTO_COMPONENT_DEFAULT, RIALTO_DEBUG_LEVEL(RIALTO_DEBUG_LEVEL_ERROR | RIALTO_DEBUG_LEVEL_INFO));
+
+    EXPECT_TRUE(rialtoLogIsLevelEnabled(RIALTO_COMPONENT_DEFAULT, RIALTO_DEBUG_LEVEL_ERROR));
+    EXPECT_TRUE(rialtoLogIsLevelEnabled(RIALTO_COMPONENT_DEFAULT, RIALTO_DEBUG_LEVEL_INFO));
+    EXPECT_FALSE(rialtoLogIsLevelEnabled(RIALTO_COMPONENT_DEFAULT, RIALTO_DEBUG_LEVEL_DEBUG));
+    EXPECT_FALSE(rialtoLogIsLevelEnabled(RIALTO_COMPONENT_LAST, RIALTO_DEBUG_LEVEL_ERROR));
+}
@@ -37,6 +37,25 @@ MATCHER_P4(HaveDataRequestMatcher, sessionId, status, numFrames, requestId, "")
             (request->request_id() == requestId) && (request->num_frames() == numFrames));
 }
 
+MATCHER_P2(HaveDataMultiSourceRequestMatcher, sessionId, requestIds, "")
+{
+    const ::firebolt::rialto::HaveDataMultiSourceRequest *request =
+        dynamic_cast<const ::firebolt::rialto::HaveDataMultiSourceRequest *>(arg);
+    if ((request->session_id() != sessionId) || !request->accept_need_media_data() ||
+        (request->sources_size() != static_cast<int>(requestIds.size())))
+    {
+        return false;
+    }
+    for (int i = 0; i < request->sources_size(); ++i)
+    {
+        if (request->sources(i).request_id() != requestIds[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 class RialtoClientMediaPipelineIpcDataTest : public MediaPipelineIpcTestBase
 {
 protected:
@@ -93,6 +112,13 @@ protected:
 
         return needMediaDataEvent;
     }
+
+    void setHaveDataResponse(google::protobuf::Message *response)
+    {
+        firebolt::rialto::HaveDataResponse *haveDataResponse =
+            dynamic_cast<firebolt::rialto::HaveDataResponse *>(response);
+        *haveDataResponse->add_need_media_data() = *createNeedDataEvent(true);
+    }
 };
 
 /**
@@ -151,6 +177,52 @@ TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataSuccess)
     EXPECT_EQ(m_mediaPipelineIpc->haveData(MediaSourceStatus::OK, m_numFrames, m_requestId), true);
 }
 
+/**
+ * Test that the need data requests returned in the haveData response are forwarded to the client.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataWithNeedDataInResponse)
+{
+    expectIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveData"), m_controllerMock.get(), _, _,
+                                           m_blockingClosureMock.get()))
+        .WillOnce(WithArgs<3>(Invoke([this](google::protobuf::Message *response)
+                                     { setHaveDataResponse(response); })));
+    EXPECT_CALL(*m_eventThreadMock, addImpl(_)).WillOnce(Invoke([](std::function<void()> &&func) { func(); }));
+    EXPECT_CALL(*m_clientMock, notifyNeedMediaData(m_sourceId, m_frameCount, m_requestId, ShmInfoMatcher(m_shmInfo)));
+
+    EXPECT_EQ(m_mediaPipelineIpc->haveData(MediaSourceStatus::OK, m_numFrames, m_requestId), true);
+}
+
+/**
+ * Test that haveData for several sources is sent in a single call.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataMultiSourceSuccess)
+{
+    const std::vector<uint32_t> kRequestIds{m_requestId, m_requestId + 1};
+    expectIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveDataMultiSource"), m_controllerMock.get(),
+                                           HaveDataMultiSourceRequestMatcher(m_sessionId, kRequestIds), _,
+                                           m_blockingClosureMock.get()));
+
+    EXPECT_EQ(m_mediaPipelineIpc->haveData({{MediaSourceStatus::OK, m_numFrames, kRequestIds[0]},
+                                            {MediaSourceStatus::EOS, m_numFrames, kRequestIds[1]}}),
+              true);
+}
+
+/**
+ * Test that haveData for several sources fails when ipc fails.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataMultiSourceFailure)
+{
+    expectIpcApiCallFailure();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveDataMultiSource"), _, _, _, _));
+
+    EXPECT_EQ(m_mediaPipelineIpc->haveData({{MediaSourceStatus::OK, m_numFrames, m_requestId}}), false);
+}
+
 /**
  * Test that haveData fails when ipc fails.
  */
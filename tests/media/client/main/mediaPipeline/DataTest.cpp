@@ -25,12 +25,19 @@
 #include <thread>
 #include <vector>
 
+using ::testing::ElementsAre;
+
 MATCHER_P(ShmInfoMatcher, shmInfo, "")
 {
     return ((arg->maxMetadataBytes == shmInfo->maxMetadataBytes) && (arg->metadataOffset == shmInfo->metadataOffset) &&
             (arg->mediaDataOffset == shmInfo->mediaDataOffset) && (arg->maxMediaBytes == shmInfo->maxMediaBytes));
 }
 
+MATCHER_P3(HaveDataIpcInfoMatcher, status, numFrames, requestId, "")
+{
+    return ((arg.status == status) && (arg.numFrames == numFrames) && (arg.requestId == requestId));
+}
+
 class RialtoClientMediaPipelineDataTest : public MediaPipelineTestBase
 {
 protected:
@@ -296,6 +303,51 @@ TEST_F(RialtoClientMediaPipelineDataTest, haveDataSuccess)
     EXPECT_EQ(m_mediaPipeline->haveData(m_status, m_requestId), true);
 }
 
+/**
+ * Test that a multi source have data call commits the data of all sources in one ipc call.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataMultiSourceSuccess)
+{
+    const uint32_t kVideoRequestId{m_requestId + 1};
+    needDataGeneric();
+    needData(m_sourceId + 1, m_frameCount, kVideoRequestId, m_shmInfo);
+
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveData(ElementsAre(HaveDataIpcInfoMatcher(m_status, 0U, m_requestId),
+                                                              HaveDataIpcInfoMatcher(MediaSourceStatus::EOS, 0U,
+                                                                                     kVideoRequestId))))
+        .WillOnce(Return(true));
+    EXPECT_EQ(m_mediaPipeline->haveData({{m_status, m_requestId}, {MediaSourceStatus::EOS, kVideoRequestId}}), true);
+}
+
+/**
+ * Test that a multi source have data call commits the known requests and returns error for the unknown ones.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataMultiSourceUnknownRequest)
+{
+    needDataGeneric();
+
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveData(ElementsAre(HaveDataIpcInfoMatcher(m_status, 0U, m_requestId))))
+        .WillOnce(Return(true));
+    EXPECT_EQ(m_mediaPipeline->haveData({{m_status, m_requestId}, {m_status, m_requestId + 1}}), false);
+}
+
+/**
+ * Test that a multi source have data call is ignored and the needDataRequests discarded in the SEEKING state.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataMultiSourceSeeking)
+{
+    needDataGeneric();
+
+    setPlaybackState(PlaybackState::SEEKING);
+
+    EXPECT_EQ(m_mediaPipeline->haveData({{m_status, m_requestId}}), true);
+
+    // Check that the needDataRequest has been discarded by initiating another haveData
+    setPlaybackState(PlaybackState::PLAYING);
+
+    EXPECT_EQ(m_mediaPipeline->haveData({{m_status, m_requestId}}), false);
+}
+
 // /**
 //  * Test that an add segment call with a null segment returns error.
 //  */
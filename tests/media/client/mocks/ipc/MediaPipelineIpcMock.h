@@ -41,6 +41,7 @@ public:
     MOCK_METHOD(bool, pause, (), (override));
     MOCK_METHOD(bool, stop, (), (override));
     MOCK_METHOD(bool, haveData, (MediaSourceStatus status, uint32_t numFrames, uint32_t requestId), (override));
+    MOCK_METHOD(bool, haveData, (const std::vector<HaveDataIpcInfo> &sources), (override));
     MOCK_METHOD(bool, setPosition, (int64_t position), (override));
     MOCK_METHOD(bool, getPosition, (int64_t & position), (override));
     MOCK_METHOD(bool, setPlaybackRate, (double rate), (override));
@@ -19,6 +19,7 @@
 
 #include "MediaFrameWriterV1.h"
 #include <cstdlib>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -27,6 +28,7 @@ using namespace firebolt::rialto::common;
 
 const uint32_t MAX_MEDIA_BYTES = 10;
 const uint32_t MAX_METADATA_BYTES = VERSION_SIZE_BYTES + 24 * METADATA_V1_SIZE_PER_FRAME_BYTES;
+const uint8_t kStaleByte = 0xAA;
 
 class RialtoPlayerCommonCreateMediaFrameWriterV1Test : public ::testing::Test
 {
@@ -76,10 +78,11 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV1Test, CreateMediaFrameWriter)
 }
 
 /**
- * Test that an MediaFrameWriterV1 writes the version to the shared buffer and zeros the rest of the metadata.
+ * Test that an MediaFrameWriterV1 writes the version to the shared buffer and does not touch the rest of the metadata.
  */
 TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV1Test, CheckSharedBufferData)
 {
+    memset(m_shmBuffer, kStaleByte, sizeof(m_shmBuffer));
     std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
         m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
     EXPECT_NE(mediaFrameWriter, nullptr);
@@ -87,9 +90,11 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV1Test, CheckSharedBufferData)
     // Version should be set to 1
     EXPECT_EQ(readLEUint32(m_shmBuffer), 1U);
 
-    // Rest of the metadata should be zeroed
-    uint8_t zeroedMem[MAX_METADATA_BYTES] = {0};
-    EXPECT_EQ(memcmp(zeroedMem, m_shmBuffer + VERSION_SIZE_BYTES, MAX_METADATA_BYTES), 0);
+    // Rest of the metadata should not be zeroed
+    constexpr size_t kStaleMemSize{MAX_METADATA_BYTES - VERSION_SIZE_BYTES};
+    uint8_t staleMem[kStaleMemSize];
+    memset(staleMem, kStaleByte, kStaleMemSize);
+    EXPECT_EQ(memcmp(staleMem, m_shmBuffer + VERSION_SIZE_BYTES, kStaleMemSize), 0);
 }
 
 /**
@@ -100,6 +105,7 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV1Test, Offset)
     m_shmInfo->metadataOffset += 3;
     m_shmInfo->mediaDataOffset += 3;
 
+    memset(m_shmBuffer, kStaleByte, sizeof(m_shmBuffer));
     std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
         m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
     EXPECT_NE(mediaFrameWriter, nullptr);
@@ -107,7 +113,9 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV1Test, Offset)
     // Version should be set to 1
     EXPECT_EQ(readLEUint32(m_shmBuffer + m_shmInfo->metadataOffset), 1U);
 
-    // Rest of the metadata should be zeroed
-    uint8_t zeroedMem[MAX_METADATA_BYTES] = {0};
-    EXPECT_EQ(memcmp(zeroedMem, m_shmBuffer + VERSION_SIZE_BYTES + m_shmInfo->metadataOffset, MAX_METADATA_BYTES), 0);
+    // Rest of the metadata should not be zeroed
+    constexpr size_t kStaleMemSize{MAX_METADATA_BYTES - VERSION_SIZE_BYTES};
+    uint8_t staleMem[kStaleMemSize];
+    memset(staleMem, kStaleByte, kStaleMemSize);
+    EXPECT_EQ(memcmp(staleMem, m_shmBuffer + VERSION_SIZE_BYTES + m_shmInfo->metadataOffset, kStaleMemSize), 0);
 }
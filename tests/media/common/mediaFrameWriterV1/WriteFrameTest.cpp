@@ -18,6 +18,7 @@
  */
 
 #include "MediaFrameWriterV1.h"
+#include <cstring>
 #include <gtest/gtest.h>
 
 using namespace firebolt::rialto;
@@ -118,6 +119,9 @@ protected:
             metadataOffsetPtr += MAX_EXTRA_DATA_SIZE - (*it)->getExtraData().size();
 
             // Encrypted generic metadata
+            constexpr uint32_t kEncryptionSize{MediaFrameWriterV1::m_kEncryptionMetadataSizeBytes};
+            uint8_t zeroedEncryptionMem[kEncryptionSize] = {0};
+            EXPECT_EQ(memcmp(zeroedEncryptionMem, metadataOffsetPtr, kEncryptionSize), 0);
             metadataOffsetPtr += MediaFrameWriterV1::m_kEncryptionMetadataSizeBytes;
 
             if (MediaSourceType::AUDIO == sourceType)
@@ -191,6 +195,22 @@ TEST_F(RialtoPlayerCommonWriteFrameV1Test, WriteVideoFrame)
     CheckSharedBuffer(MediaSourceType::VIDEO, m_shmInfo);
 }
 
+/**
+ * Test that an MediaFrameWriterV1 object fully writes the frame metadata to the shared buffer
+ * that contains data of a previous request.
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV1Test, WriteVideoFrameToNotZeroedBuffer)
+{
+    memset(m_shmBuffer, 0xAA, sizeof(m_shmBuffer));
+    m_mediaFrameWriter = std::make_unique<MediaFrameWriterV1>(m_shmBuffer, m_shmInfo);
+
+    AddVideoFrame(1000000000, 0, 8, 9, 4);
+
+    EXPECT_EQ(m_mediaFrameWriter->writeFrame(m_dataVec[0]), AddSegmentStatus::OK);
+
+    CheckSharedBuffer(MediaSourceType::VIDEO, m_shmInfo);
+}
+
 /**
  * Test that an FrameWriter object returns failure if the maximum metadata bytes to
  * write has been reached.
@@ -19,6 +19,7 @@
 
 #include "MediaFrameWriterV2.h"
 #include <cstdlib>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -27,6 +28,7 @@ using namespace firebolt::rialto::common;
 
 const uint32_t MAX_METADATA_BYTES = 6;
 const uint32_t MAX_MEDIA_BYTES = 4;
+const uint8_t kStaleByte = 0xAA;
 
 class RialtoPlayerCommonCreateMediaFrameWriterV2Test : public ::testing::Test
 {
@@ -70,10 +72,11 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, CreateMediaFrameWriter)
 }
 
 /**
- * Test that an MediaFrameWriterV2 writes the version to the shared buffer and zeroes the rest of the metadata.
+ * Test that an MediaFrameWriterV2 writes the version to the shared buffer and does not touch the rest of the data.
  */
 TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, CheckSharedBufferData)
 {
+    memset(m_shmBuffer, kStaleByte, sizeof(m_shmBuffer));
     std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
         m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
     EXPECT_NE(mediaFrameWriter, nullptr);
@@ -81,10 +84,11 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, CheckSharedBufferData)
     // Version should be set to 2
     EXPECT_EQ(readLEUint32(m_shmBuffer), 2U);
 
-    // Rest of the data should be zeroed
-    constexpr size_t kZeroedMemSize{MAX_METADATA_BYTES + MAX_MEDIA_BYTES - VERSION_SIZE_BYTES};
-    uint8_t zeroedMem[kZeroedMemSize] = {0};
-    EXPECT_EQ(memcmp(zeroedMem, m_shmBuffer + VERSION_SIZE_BYTES, kZeroedMemSize), 0);
+    // Rest of the data should not be zeroed
+    constexpr size_t kStaleMemSize{MAX_METADATA_BYTES + MAX_MEDIA_BYTES - VERSION_SIZE_BYTES};
+    uint8_t staleMem[kStaleMemSize];
+    memset(staleMem, kStaleByte, kStaleMemSize);
+    EXPECT_EQ(memcmp(staleMem, m_shmBuffer + VERSION_SIZE_BYTES, kStaleMemSize), 0);
 }
 
 /**
@@ -97,6 +101,7 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, Offset)
     m_shmInfo->mediaDataOffset += kOffset;
     m_shmInfo->maxMediaBytes -= kOffset;
 
+    memset(m_shmBuffer, kStaleByte, sizeof(m_shmBuffer));
     std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
         m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
     EXPECT_NE(mediaFrameWriter, nullptr);
@@ -104,10 +109,13 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, Offset)
     // Version should be set to 2
     EXPECT_EQ(readLEUint32(m_shmBuffer + m_shmInfo->metadataOffset), 2U);
 
-    // Rest of the metadata should be zeroed
-    constexpr size_t kZeroedMemSize{MAX_METADATA_BYTES + MAX_MEDIA_BYTES - VERSION_SIZE_BYTES - kOffset};
-    uint8_t zeroedMem[kZeroedMemSize] = {0};
-    EXPECT_EQ(memcmp(zeroedMem, m_shmBuffer + VERSION_SIZE_BYTES + kOffset, kZeroedMemSize), 0);
+    // Bytes before the offset and the rest of the data should not be touched
+    EXPECT_EQ(m_shmBuffer[0], kStaleByte);
+    EXPECT_EQ(m_shmBuffer[kOffset - 1], kStaleByte);
+    constexpr size_t kStaleMemSize{MAX_METADATA_BYTES + MAX_MEDIA_BYTES - VERSION_SIZE_BYTES - kOffset};
+    uint8_t staleMem[kStaleMemSize];
+    memset(staleMem, kStaleByte, kStaleMemSize);
+    EXPECT_EQ(memcmp(staleMem, m_shmBuffer + VERSION_SIZE_BYTES + kOffset, kStaleMemSize), 0);
 }
 
 /**
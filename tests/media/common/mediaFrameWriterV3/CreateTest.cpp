@@ -0,0 +1,97 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV3.h"
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+
+const uint32_t MAX_METADATA_BYTES = 6;
+const uint32_t MAX_MEDIA_BYTES = 4;
+const uint8_t kStaleByte = 0xAA;
+
+class RialtoPlayerCommonCreateMediaFrameWriterV3Test : public ::testing::Test
+{
+protected:
+    std::shared_ptr<IMediaFrameWriterFactory> m_mediaFrameWriterFactory;
+
+    uint8_t m_shmBuffer[MAX_METADATA_BYTES + MAX_MEDIA_BYTES] = {0};
+    std::shared_ptr<ShmInfo> m_shmInfo;
+
+    virtual void SetUp()
+    {
+        setenv("RIALTO_METADATA_VERSION", "3", 1);
+        m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+
+        // init shm info
+        m_shmInfo = std::make_shared<ShmInfo>();
+        m_shmInfo->maxMetadataBytes = MAX_METADATA_BYTES;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = MAX_METADATA_BYTES;
+        m_shmInfo->maxMediaBytes = MAX_MEDIA_BYTES;
+    }
+
+    virtual void TearDown()
+    {
+        m_mediaFrameWriterFactory.reset();
+        unsetenv("RIALTO_METADATA_VERSION");
+    }
+
+    uint32_t readLEUint32(const uint8_t *buffer)
+    {
+        uint32_t value = buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
+        return value;
+    }
+};
+
+/**
+ * Test that an MediaFrameWriterV3 object can be created successfully.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriter)
+{
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV3 &>(*mediaFrameWriter));
+}
+
+/**
+ * Test that an MediaFrameWriterV3 writes the version to the shared buffer and does not touch the rest of the data.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CheckSharedBufferData)
+{
+    memset(m_shmBuffer, kStaleByte, sizeof(m_shmBuffer));
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+    EXPECT_NE(mediaFrameWriter, nullptr);
+
+    // Version should be set to 3
+    EXPECT_EQ(readLEUint32(m_shmBuffer), 3U);
+
+    // Rest of the data should not be zeroed
+    constexpr size_t kStaleMemSize{MAX_METADATA_BYTES + MAX_MEDIA_BYTES - VERSION_SIZE_BYTES};
+    uint8_t staleMem[kStaleMemSize];
+    memset(staleMem, kStaleByte, kStaleMemSize);
+    EXPECT_EQ(memcmp(staleMem, m_shmBuffer + VERSION_SIZE_BYTES, kStaleMemSize), 0);
+}
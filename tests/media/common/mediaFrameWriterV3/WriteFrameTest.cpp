@@ -0,0 +1,324 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV3.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+
+namespace
+{
+constexpr uint32_t kMaxMetaBytes{6};
+constexpr uint32_t kMaxBytes{250};
+constexpr uint8_t kMediaData[]{0xD, 0xE, 0xA, 0xD, 0xB, 0xE, 0xE, 0xF, 0x1};
+constexpr uint32_t kMediaDataLength{9};
+constexpr int32_t kSourceId{1};
+constexpr int64_t kTimeStamp{1423435};
+constexpr int64_t kDuration{12324};
+constexpr int32_t kSampleRate{3536};
+constexpr int32_t kNumberOfChannels{3};
+constexpr int32_t kWidth{1024};
+constexpr int32_t kHeight{768};
+const std::vector<uint8_t> kExtraData{1, 2, 3, 4};
+const int32_t kMksId{43};
+const std::vector<uint8_t> kKeyId{9, 2, 6, 2, 0, 1};
+const std::vector<uint8_t> kInitVector{34, 53, 54, 62, 56};
+constexpr size_t kNumClearBytes{2};
+constexpr size_t kNumEncryptedBytes{7};
+constexpr uint32_t kInitWithLast15{1};
+
+uint32_t readLEUint32(const uint8_t *buffer)
+{
+    uint32_t value = buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
+    return value;
+}
+
+std::unique_ptr<IMediaPipeline::MediaSegment> createAudioSegment()
+{
+    auto segment{std::make_unique<IMediaPipeline::MediaSegmentAudio>(kSourceId, kTimeStamp, kDuration, kSampleRate,
+                                                                     kNumberOfChannels)};
+    segment->setData(kMediaDataLength, kMediaData);
+    return segment;
+}
+
+std::unique_ptr<IMediaPipeline::MediaSegment> createVideoSegment()
+{
+    auto segment{
+        std::make_unique<IMediaPipeline::MediaSegmentVideo>(kSourceId, kTimeStamp, kDuration, kWidth, kHeight)};
+    segment->setData(kMediaDataLength, kMediaData);
+    return segment;
+}
+
+void addOptionalData(std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
+{
+    segment->setSegmentAlignment(SegmentAlignment::NAL);
+    segment->setExtraData(kExtraData);
+}
+
+void addEncryptionData(std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
+{
+    segment->setEncrypted(true);
+    segment->setMediaKeySessionId(kMksId);
+    segment->setKeyId(kKeyId);
+    segment->setInitVector(kInitVector);
+    segment->addSubSample(kNumClearBytes, kNumEncryptedBytes);
+    segment->setInitWithLast15(kInitWithLast15);
+}
+
+void checkMandatoryMetadata(const MetadataV3FrameHeader &header)
+{
+    EXPECT_EQ(header.dataLength, kMediaDataLength);
+    EXPECT_EQ(header.timePosition, kTimeStamp);
+    EXPECT_EQ(header.sampleDuration, kDuration);
+    EXPECT_EQ(header.streamId, kSourceId);
+    EXPECT_EQ(header.metadataSize % METADATA_V3_ALIGNMENT_BYTES, 0U);
+    EXPECT_EQ(header.metadataSize, getMetadataV3Size(header));
+}
+
+void checkAudioMetadata(const MetadataV3FrameHeader &header)
+{
+    EXPECT_EQ(header.mediaSourceType, static_cast<uint32_t>(MediaSourceType::AUDIO));
+    EXPECT_EQ(header.sampleRate, kSampleRate);
+    EXPECT_EQ(header.channelsNum, kNumberOfChannels);
+    EXPECT_EQ(header.width, 0U);
+    EXPECT_EQ(header.height, 0U);
+}
+
+void checkVideoMetadata(const MetadataV3FrameHeader &header)
+{
+    EXPECT_EQ(header.mediaSourceType, static_cast<uint32_t>(MediaSourceType::VIDEO));
+    EXPECT_EQ(header.sampleRate, 0U);
+    EXPECT_EQ(header.channelsNum, 0U);
+    EXPECT_EQ(header.width, kWidth);
+    EXPECT_EQ(header.height, kHeight);
+}
+
+void checkOptionalMetadataNotPresent(const MetadataV3FrameHeader &header)
+{
+    EXPECT_EQ(header.segmentAlignment, static_cast<uint32_t>(SegmentAlignment::UNDEFINED));
+    EXPECT_EQ(header.extraDataSize, 0U);
+}
+
+void checkOptionalMetadataPresent(const MetadataV3FrameHeader &header, const uint8_t *extraData)
+{
+    EXPECT_EQ(header.segmentAlignment, static_cast<uint32_t>(SegmentAlignment::NAL));
+    EXPECT_EQ(std::vector<uint8_t>(extraData, extraData + header.extraDataSize), kExtraData);
+}
+
+void checkEncryptionMetadataNotPresent(const MetadataV3FrameHeader &header)
+{
+    EXPECT_EQ(header.flags & METADATA_V3_FLAG_ENCRYPTED, 0U);
+    EXPECT_EQ(header.mediaKeySessionId, 0);
+    EXPECT_EQ(header.initWithLast15, 0U);
+    EXPECT_EQ(header.subSampleCount, 0U);
+    EXPECT_EQ(header.keyIdSize, 0U);
+    EXPECT_EQ(header.initVectorSize, 0U);
+}
+
+void checkEncryptionMetadataPresent(const MetadataV3FrameHeader &header, const uint8_t *inlineData)
+{
+    EXPECT_EQ(header.flags & METADATA_V3_FLAG_ENCRYPTED, METADATA_V3_FLAG_ENCRYPTED);
+    EXPECT_EQ(header.mediaKeySessionId, kMksId);
+    EXPECT_EQ(header.initWithLast15, kInitWithLast15);
+    ASSERT_EQ(header.subSampleCount, 1U);
+    MetadataV3SubSample subSample;
+    memcpy(&subSample, inlineData, sizeof(subSample));
+    EXPECT_EQ(subSample.numClearBytes, kNumClearBytes);
+    EXPECT_EQ(subSample.numEncryptedBytes, kNumEncryptedBytes);
+    inlineData += sizeof(subSample);
+    EXPECT_EQ(std::vector<uint8_t>(inlineData, inlineData + header.keyIdSize), kKeyId);
+    inlineData += header.keyIdSize;
+    EXPECT_EQ(std::vector<uint8_t>(inlineData, inlineData + header.initVectorSize), kInitVector);
+}
+
+void checkMediaData(const uint8_t *readPosition)
+{
+    EXPECT_EQ(0, memcmp(readPosition, kMediaData, kMediaDataLength));
+}
+} // namespace
+
+class RialtoPlayerCommonWriteFrameV3Test : public ::testing::Test
+{
+protected:
+    uint8_t m_shmBuffer[kMaxMetaBytes + kMaxBytes] = {0};
+    std::shared_ptr<ShmInfo> m_shmInfo;
+
+    virtual void SetUp()
+    {
+        // init shm info
+        m_shmInfo = std::make_shared<ShmInfo>();
+        m_shmInfo->maxMetadataBytes = kMaxMetaBytes;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = kMaxMetaBytes;
+        m_shmInfo->maxMediaBytes = kMaxBytes;
+    }
+
+    MetadataV3FrameHeader readSegment(uint32_t frameOffset = 0)
+    {
+        // Version should be set to 3
+        EXPECT_EQ(readLEUint32(m_shmBuffer), 3U);
+
+        const uint8_t *readPosition{m_shmBuffer + kMaxMetaBytes + frameOffset};
+        MetadataV3FrameHeader header;
+        memcpy(&header, readPosition, sizeof(header));
+
+        checkMandatoryMetadata(header);
+        checkMediaData(readPosition + header.metadataSize);
+
+        return header;
+    }
+
+    const uint8_t *getInlineData(uint32_t frameOffset = 0)
+    {
+        return m_shmBuffer + kMaxMetaBytes + frameOffset + sizeof(MetadataV3FrameHeader);
+    }
+};
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted audio without optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedAudioWithoutOptionalParams)
+{
+    auto segment = createAudioSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    EXPECT_EQ(header.metadataSize, sizeof(MetadataV3FrameHeader));
+    checkAudioMetadata(header);
+    checkOptionalMetadataNotPresent(header);
+    checkEncryptionMetadataNotPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted audio with optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedAudioWithOptionalParams)
+{
+    auto segment = createAudioSegment();
+    addOptionalData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkAudioMetadata(header);
+    checkOptionalMetadataPresent(header, getInlineData());
+    checkEncryptionMetadataNotPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write encrypted audio
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteEncryptedAudio)
+{
+    auto segment = createAudioSegment();
+    addEncryptionData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkAudioMetadata(header);
+    checkOptionalMetadataNotPresent(header);
+    checkEncryptionMetadataPresent(header, getInlineData());
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted video without optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedVideoWithoutOptionalParams)
+{
+    auto segment = createVideoSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkVideoMetadata(header);
+    checkOptionalMetadataNotPresent(header);
+    checkEncryptionMetadataNotPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted video with optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedVideoWithOptionalParams)
+{
+    auto segment = createVideoSegment();
+    addOptionalData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkVideoMetadata(header);
+    checkOptionalMetadataPresent(header, getInlineData());
+    checkEncryptionMetadataNotPresent(header);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write encrypted video
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteEncryptedVideo)
+{
+    auto segment = createVideoSegment();
+    addEncryptionData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readSegment();
+    checkVideoMetadata(header);
+    checkOptionalMetadataNotPresent(header);
+    checkEncryptionMetadataPresent(header, getInlineData());
+}
+
+/**
+ * Test that an MediaFrameWriterV3 writes the following frames at aligned offsets
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteTwoFramesAtAlignedOffsets)
+{
+    auto firstSegment = createVideoSegment();
+    addEncryptionData(firstSegment);
+    auto secondSegment = createVideoSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(firstSegment));
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(secondSegment));
+    EXPECT_EQ(2, mediaFrameWriter.getNumFrames());
+
+    auto firstHeader = readSegment();
+    const uint32_t kSecondFrameOffset{firstHeader.metadataSize +
+                                      static_cast<uint32_t>(alignMetadataV3Size(kMediaDataLength))};
+    EXPECT_EQ(kSecondFrameOffset % METADATA_V3_ALIGNMENT_BYTES, 0U);
+    auto secondHeader = readSegment(kSecondFrameOffset);
+    checkVideoMetadata(secondHeader);
+    checkEncryptionMetadataNotPresent(secondHeader);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 fails to write a frame that does not fit in the shared buffer
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteFrameWithNoSpace)
+{
+    m_shmInfo->maxMediaBytes = sizeof(MetadataV3FrameHeader) + kMediaDataLength - 1;
+    auto segment = createVideoSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::NO_SPACE, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(0, mediaFrameWriter.getNumFrames());
+}
@@ -76,7 +76,6 @@ protected:
     GstElement m_pipeline{};
     GFlagsClass m_flagsClass{};
     GstElement m_playsink{};
-    GstBus m_bus{};
     GType m_gstPlayFlagsType{static_cast<GType>(123)};
     GFlagsValue m_audioFlag{1, "audio", "audio"};
     GFlagsValue m_videoFlag{2, "video", "video"};
@@ -143,9 +142,6 @@ protected:
         EXPECT_CALL(m_workerThreadMock, join());
         EXPECT_CALL(m_taskFactoryMock, createShutdown(_)).WillOnce(Return(ByMove(std::move(shutdownTask))));
         EXPECT_CALL(m_taskFactoryMock, createStop(_, _)).WillOnce(Return(ByMove(std::move(stopTask))));
-        EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-        EXPECT_CALL(*m_gstWrapperMock, gstBusSetSyncHandler(&m_bus, nullptr, nullptr, nullptr));
-        EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus));
     }
 
     void createGstPlayerSuccess()
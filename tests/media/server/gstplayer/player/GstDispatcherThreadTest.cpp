@@ -24,20 +24,18 @@
 #include "PlayerTaskFactoryMock.h"
 #include "PlayerTaskMock.h"
 #include "WorkerThreadMock.h"
-#include <condition_variable>
 #include <gst/gst.h>
 #include <gtest/gtest.h>
 #include <memory>
-#include <mutex>
 
 using namespace firebolt::rialto::server;
 
 using ::testing::_;
 using ::testing::ByMove;
 using ::testing::DoAll;
-using ::testing::InSequence;
 using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::SaveArg;
 using ::testing::SetArgPointee;
 using ::testing::StrictMock;
 
@@ -51,51 +49,86 @@ protected:
     StrictMock<WorkerThreadMock> m_workerThreadMock;
     StrictMock<PlayerTaskFactoryMock> m_taskFactoryMock;
 
-    std::mutex m_dispatcherThreadMutex;
-    std::condition_variable m_dispatcherThreadCond;
-    bool m_dispatcherThreadDone{false};
     GstBus m_bus{};
     GstMessage m_message{};
+    GstBusSyncHandler m_syncHandler{nullptr};
+    gpointer m_syncHandlerData{nullptr};
+    GDestroyNotify m_syncHandlerNotify{nullptr};
+    std::unique_ptr<GstDispatcherThread> m_sut;
 
     GstDispatcherThreadTest() { m_context.pipeline = &m_pipeline; }
-};
 
-/**
- * Test when gstBusTimedPopFiltered exits with timeout
- */
-TEST_F(GstDispatcherThreadTest, PollTimeout)
-{
-    GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
-    GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_ERROR;
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-    std::unique_ptr<IPlayerTask> errorTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*errorTask), execute());
+    ~GstDispatcherThreadTest()
+    {
+        if (m_sut)
+        {
+            // Unsetting the sync handler releases the previous one
+            EXPECT_CALL(*m_gstWrapperMock, gstBusSetSyncHandler(&m_bus, nullptr, nullptr, nullptr))
+                .WillOnce(Invoke([this](GstBus *, GstBusSyncHandler, gpointer, GDestroyNotify)
+                                 { m_syncHandlerNotify(m_syncHandlerData); }));
+            EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus));
+            m_sut.reset();
+        }
+    }
+
+    void createDispatcher()
+    {
+        EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
+        EXPECT_CALL(*m_gstWrapperMock, gstBusSetSyncHandler(&m_bus, _, _, _))
+            .WillOnce(DoAll(SaveArg<1>(&m_syncHandler), SaveArg<2>(&m_syncHandlerData),
+                            SaveArg<3>(&m_syncHandlerNotify)));
+        m_sut = std::make_unique<GstDispatcherThread>(m_context, m_gstPlayer, m_gstWrapperMock, m_workerThreadMock,
+                                                      m_taskFactoryMock);
+        ASSERT_NE(m_syncHandler, nullptr);
+        ASSERT_NE(m_syncHandlerNotify, nullptr);
+    }
+
+    void expectDispatch(GstMessage *message)
     {
-        InSequence seq;
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(nullptr));
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-        EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(errorTask))));
+        std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
+        EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
+        EXPECT_CALL(*m_gstWrapperMock, gstMessageRef(message)).WillOnce(Return(message));
+        EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, message)).WillOnce(Return(ByMove(std::move(task))));
         EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
-            .WillOnce(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
+            .WillOnce(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }))
+            .RetiresOnSaturation();
     }
 
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
-        .WillOnce(Invoke(
-            [this](gpointer bus)
-            {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
-            }));
+    GstBusSyncReply postMessage(GstMessage *message) { return m_syncHandler(&m_bus, message, m_syncHandlerData); }
+};
+
+/**
+ * Test that the dispatcher is not installed when the pipeline has no bus
+ */
+TEST_F(GstDispatcherThreadTest, NoBus)
+{
+    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(nullptr));
+    auto sut = std::make_unique<GstDispatcherThread>(m_context, m_gstPlayer, m_gstWrapperMock, m_workerThreadMock,
+                                                     m_taskFactoryMock);
+}
 
+/**
+ * Test that the destruction doesn't hang, when gstreamer never releases the sync handler
+ */
+TEST_F(GstDispatcherThreadTest, SyncHandlerNotReleased)
+{
+    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
+    EXPECT_CALL(*m_gstWrapperMock, gstBusSetSyncHandler(&m_bus, _, _, _)).Times(2);
+    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus));
     auto sut = std::make_unique<GstDispatcherThread>(m_context, m_gstPlayer, m_gstWrapperMock, m_workerThreadMock,
                                                      m_taskFactoryMock);
+    sut.reset();
+}
 
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+/**
+ * Test that messages of other types are dropped without being dispatched
+ */
+TEST_F(GstDispatcherThreadTest, IgnoredMessage)
+{
+    createDispatcher();
+    GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
+    GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_TAG;
+    EXPECT_EQ(postMessage(&m_message), GST_BUS_DROP);
 }
 
 /**
@@ -103,6 +136,7 @@ TEST_F(GstDispatcherThreadTest, PollTimeout)
  */
 TEST_F(GstDispatcherThreadTest, StateChangedToPaused)
 {
+    createDispatcher();
     GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_STATE_CHANGED;
 
@@ -114,49 +148,21 @@ TEST_F(GstDispatcherThreadTest, StateChangedToPaused)
     GST_MESSAGE_SRC(&messageError) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&messageError) = GST_MESSAGE_ERROR;
 
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-
     EXPECT_CALL(*m_gstWrapperMock, gstMessageParseStateChanged(&m_message, _, _, _))
         .WillOnce(DoAll(SetArgPointee<1>(oldState), SetArgPointee<2>(newState), SetArgPointee<3>(pending)));
-    std::unique_ptr<IPlayerTask> stateChangeTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*stateChangeTask), execute());
-    std::unique_ptr<IPlayerTask> errorTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*errorTask), execute());
-    EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
-        .WillRepeatedly(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
-
-    {
-        InSequence seq;
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-        EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(stateChangeTask))));
-        EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&messageError));
-        EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(errorTask))));
-    }
-
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
-        .WillOnce(Invoke(
-            [this](gpointer bus)
-            {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
-            }));
+    expectDispatch(&m_message);
+    EXPECT_EQ(postMessage(&m_message), GST_BUS_DROP);
 
-    auto sut = std::make_unique<GstDispatcherThread>(m_context, m_gstPlayer, m_gstWrapperMock, m_workerThreadMock,
-                                                     m_taskFactoryMock);
-
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+    expectDispatch(&messageError);
+    EXPECT_EQ(postMessage(&messageError), GST_BUS_DROP);
 }
 
 /**
- * Test that a GST_MESSAGE_STATE_CHANGED message is handled correctly by GstPlayer.
+ * Test that messages are not dispatched anymore after the pipeline went to the NULL state.
  */
 TEST_F(GstDispatcherThreadTest, StateChangedToStop)
 {
+    createDispatcher();
     GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_STATE_CHANGED;
 
@@ -166,61 +172,28 @@ TEST_F(GstDispatcherThreadTest, StateChangedToStop)
 
     EXPECT_CALL(*m_gstWrapperMock, gstMessageParseStateChanged(&m_message, _, _, _))
         .WillOnce(DoAll(SetArgPointee<1>(oldState), SetArgPointee<2>(newState), SetArgPointee<3>(pending)));
-    std::unique_ptr<IPlayerTask> stateChangeTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
-        .WillOnce(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*stateChangeTask), execute());
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-    EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(stateChangeTask))));
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
-        .WillOnce(Invoke(
-            [this](gpointer bus)
-            {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
-            }));
-
-    auto sut = std::make_unique<GstDispatcherThread>(m_context, m_gstPlayer, m_gstWrapperMock, m_workerThreadMock,
-                                                     m_taskFactoryMock);
+    expectDispatch(&m_message);
+    EXPECT_EQ(postMessage(&m_message), GST_BUS_DROP);
 
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+    GstMessage messageEos = {};
+    GST_MESSAGE_SRC(&messageEos) = GST_OBJECT(&m_pipeline);
+    GST_MESSAGE_TYPE(&messageEos) = GST_MESSAGE_EOS;
+    EXPECT_EQ(postMessage(&messageEos), GST_BUS_DROP);
 }
 
 /**
- * Test that a GST_MESSAGE_ERROR message is handled correctly by GstPlayer.
+ * Test that messages are not dispatched anymore after a GST_MESSAGE_ERROR message.
  */
 TEST_F(GstDispatcherThreadTest, Error)
 {
+    createDispatcher();
     GST_MESSAGE_SRC(&m_message) = GST_OBJECT(&m_pipeline);
     GST_MESSAGE_TYPE(&m_message) = GST_MESSAGE_ERROR;
-    std::unique_ptr<IPlayerTask> errorTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
-    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*errorTask), execute());
-    EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
-        .WillOnce(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
-    EXPECT_CALL(*m_gstWrapperMock, gstPipelineGetBus(GST_PIPELINE(&m_pipeline))).WillOnce(Return(&m_bus));
-    EXPECT_CALL(*m_gstWrapperMock, gstBusTimedPopFiltered(&m_bus, 100 * GST_MSECOND, _)).WillOnce(Return(&m_message));
-    EXPECT_CALL(m_taskFactoryMock, createHandleBusMessage(_, _, _)).WillOnce(Return(ByMove(std::move(errorTask))));
-    EXPECT_CALL(*m_gstWrapperMock, gstObjectUnref(&m_bus))
-        .WillOnce(Invoke(
-            [this](gpointer bus)
-            {
-                std::unique_lock<std::mutex> lock(m_dispatcherThreadMutex);
-                m_dispatcherThreadDone = true;
-                m_dispatcherThreadCond.notify_all();
-            }));
-
-    auto sut = std::make_unique<GstDispatcherThread>(m_context, m_gstPlayer, m_gstWrapperMock, m_workerThreadMock,
-                                                     m_taskFactoryMock);
+    expectDispatch(&m_message);
+    EXPECT_EQ(postMessage(&m_message), GST_BUS_DROP);
 
-    // wait for dispatcher thread
-    std::unique_lock<std::mutex> dispatcherLock(m_dispatcherThreadMutex);
-    bool status = m_dispatcherThreadCond.wait_for(dispatcherLock, std::chrono::milliseconds(200),
-                                                  [this]() { return m_dispatcherThreadDone; });
-    EXPECT_TRUE(status);
+    GstMessage messageQos = {};
+    GST_MESSAGE_SRC(&messageQos) = GST_OBJECT(&m_pipeline);
+    GST_MESSAGE_TYPE(&messageQos) = GST_MESSAGE_QOS;
+    EXPECT_EQ(postMessage(&messageQos), GST_BUS_DROP);
 }
@@ -17,16 +17,22 @@
  * limitations under the License.
  */
 
+#include "DataReaderMock.h"
 #include "GstPlayerTestCommon.h"
+#include "ISharedMemoryBuffer.h"
 #include "Matchers.h"
 #include "MediaSourceUtil.h"
 #include "PlayerTaskMock.h"
 #include "TimerMock.h"
+#include <atomic>
+#include <thread>
 
 using testing::_;
 using testing::ByMove;
+using testing::InSequence;
 using testing::Invoke;
 using testing::Return;
+using testing::Sequence;
 
 namespace
 {
@@ -75,9 +81,9 @@ protected:
         GstAppSrc appSrc{};
         std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
         EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
-        EXPECT_CALL(m_taskFactoryMock, createNeedData(_, &appSrc))
+        EXPECT_CALL(m_taskFactoryMock, createNeedData(_, _, &appSrc))
             .WillOnce(Invoke(
-                [&](PlayerContext &context, GstAppSrc *src)
+                [&](PlayerContext &context, IGstPlayerPrivate &player, GstAppSrc *src)
                 {
                     fun(context);
                     return std::move(task);
@@ -144,7 +150,7 @@ TEST_F(GstPlayerPrivateTest, shouldScheduleNeedData)
     GstAppSrc appSrc{};
     std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
     EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
-    EXPECT_CALL(m_taskFactoryMock, createNeedData(_, &appSrc)).WillOnce(Return(ByMove(std::move(task))));
+    EXPECT_CALL(m_taskFactoryMock, createNeedData(_, _, &appSrc)).WillOnce(Return(ByMove(std::move(task))));
 
     m_sut->scheduleNeedMediaData(&appSrc);
 }
@@ -259,7 +265,9 @@ TEST_F(GstPlayerPrivateTest, shouldNotifyNeedAudioData)
 {
     modifyContext([&](PlayerContext &context) { context.audioNeedData = true; });
 
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::AUDIO)).WillOnce(Return(true));
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::AUDIO))
+        .Times(kShmSlotsPerSource)
+        .WillRepeatedly(Return(true));
     m_sut->notifyNeedMediaData(true, false);
 }
 
@@ -267,7 +275,30 @@ TEST_F(GstPlayerPrivateTest, shouldNotifyNeedVideoData)
 {
     modifyContext([&](PlayerContext &context) { context.videoNeedData = true; });
 
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::VIDEO)).WillOnce(Return(true));
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::VIDEO))
+        .Times(kShmSlotsPerSource)
+        .WillRepeatedly(Return(true));
+    m_sut->notifyNeedMediaData(false, true);
+}
+
+TEST_F(GstPlayerPrivateTest, shouldNotifyNeedAudioDataForReleasedShmSlotOnly)
+{
+    modifyContext(
+        [&](PlayerContext &context)
+        {
+            context.audioNeedData = true;
+            context.audioNeedDataPending = kShmSlotsPerSource;
+        });
+
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::AUDIO)).WillOnce(Return(true));
+    m_sut->notifyNeedMediaData(true, false);
+}
+
+TEST_F(GstPlayerPrivateTest, shouldStopNotifyingNeedVideoDataWhenRequestFails)
+{
+    modifyContext([&](PlayerContext &context) { context.videoNeedData = true; });
+
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::VIDEO)).WillOnce(Return(false));
     m_sut->notifyNeedMediaData(false, true);
 }
 
@@ -281,6 +312,66 @@ TEST_F(GstPlayerPrivateTest, shouldNotNotifyNeedVideoDataWhenNotNeeded)
     m_sut->notifyNeedMediaData(false, true);
 }
 
+TEST_F(GstPlayerPrivateTest, shouldNotifyNeedAudioDataWhileShmBuffersAreInUse)
+{
+    modifyContext([&](PlayerContext &context) { context.audioNeedData = true; });
+
+    // Requests are limited by the free shared memory slots only
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::AUDIO))
+        .Times(kShmSlotsPerSource)
+        .WillRepeatedly(Return(true));
+    m_sut->notifyNeedMediaData(true, false);
+}
+
+TEST_F(GstPlayerPrivateTest, shouldStopRequestingMediaDataWhenNoShmSlotIsFree)
+{
+    modifyContext([&](PlayerContext &context) { context.videoNeedData = true; });
+
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::VIDEO))
+        .WillOnce(Return(true))
+        .WillOnce(Return(false));
+    m_sut->requestMediaData(MediaSourceType::VIDEO);
+}
+
+TEST_F(GstPlayerPrivateTest, shouldNotRequestMediaDataWhenDataIsNotNeeded)
+{
+    m_sut->requestMediaData(MediaSourceType::AUDIO);
+}
+
+TEST_F(GstPlayerPrivateTest, shouldNotifyNeedDataForFreedShmSlotsWhenShmBuffersAreReleased)
+{
+    modifyContext(
+        [&](PlayerContext &context)
+        {
+            context.audioNeedData = true;
+            context.videoNeedData = true;
+            context.audioNeedDataPending = kShmSlotsPerSource - 1;
+            context.videoNeedDataPending = kShmSlotsPerSource - 1;
+        });
+
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::AUDIO)).WillOnce(Return(true));
+    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(MediaSourceType::VIDEO)).WillOnce(Return(true));
+    m_sut->notifyShmBuffersReleased();
+}
+
+TEST_F(GstPlayerPrivateTest, shouldNotNotifyNeedDataWhenShmBuffersAreReleasedAndDataIsNotNeeded)
+{
+    m_sut->notifyShmBuffersReleased();
+}
+
+TEST_F(GstPlayerPrivateTest, shouldCopyShmDataWhenZeroCopyIsDisabled)
+{
+    GstBuffer buffer{};
+    const std::vector<uint8_t> kData{1, 2, 3};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight};
+    mediaSegment.setData(kData.size(), kData.data());
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, kData.size(), nullptr)).WillOnce(Return(&buffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&buffer, 0, kData.data(), kData.size()));
+    EXPECT_EQ(m_sut->createShmBuffer(mediaSegment, nullptr), &buffer);
+    EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
+    EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
+}
+
 TEST_F(GstPlayerPrivateTest, shouldCreateClearGstBuffer)
 {
     GstBuffer buffer{};
@@ -491,6 +582,32 @@ TEST_F(GstPlayerPrivateTest, shouldAttachVideoData)
     m_sut->attachVideoData();
 }
 
+TEST_F(GstPlayerPrivateTest, shouldAttachVideoDataAsBufferList)
+{
+    GstBuffer firstBuffer{};
+    GstBuffer secondBuffer{};
+    GstAppSrc videoSrc{};
+    int bufferListStorage{0};
+    GstBufferList *bufferList{reinterpret_cast<GstBufferList *>(&bufferListStorage)};
+    modifyContext(
+        [&](PlayerContext &context)
+        {
+            context.videoBuffers.emplace_back(&firstBuffer);
+            context.videoBuffers.emplace_back(&secondBuffer);
+            context.videoNeedData = true;
+            context.streamInfo[firebolt::rialto::MediaSourceType::VIDEO] = GST_ELEMENT(&videoSrc);
+        });
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_gstWrapperMock, gstBufferListNewSized(2)).WillOnce(Return(bufferList));
+        EXPECT_CALL(*m_gstWrapperMock, gstBufferListAdd(bufferList, &firstBuffer));
+        EXPECT_CALL(*m_gstWrapperMock, gstBufferListAdd(bufferList, &secondBuffer));
+        EXPECT_CALL(*m_gstWrapperMock, gstAppSrcPushBufferList(GST_APP_SRC(&videoSrc), bufferList));
+    }
+    m_sut->attachVideoData();
+    modifyContext([&](PlayerContext &context) { EXPECT_TRUE(context.videoBuffers.empty()); });
+}
+
 TEST_F(GstPlayerPrivateTest, shouldCancelVideoUnderflow)
 {
     GstBuffer buffer{};
@@ -641,20 +758,35 @@ TEST_F(GstPlayerPrivateTest, shouldUpdateAudioCapsNumOfChannelsOnly)
 }
 
 TEST_F(GstPlayerPrivateTest, shouldNotUpdateAudioCapsWhenValuesAreInvalid)
+{
+    GstAppSrc audioSrc{};
+    modifyContext([&](PlayerContext &context)
+                  { context.streamInfo[firebolt::rialto::MediaSourceType::AUDIO] = GST_ELEMENT(&audioSrc); });
+
+    m_sut->updateAudioCaps(kInvalidSampleRate, kInvalidNumberOfChannels);
+}
+
+TEST_F(GstPlayerPrivateTest, shouldNotUpdateAudioCapsWhenValuesAreUnchanged)
 {
     GstAppSrc audioSrc{};
     GstCaps dummyCaps1;
     GstCaps dummyCaps2;
-    std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
     modifyContext([&](PlayerContext &context)
                   { context.streamInfo[firebolt::rialto::MediaSourceType::AUDIO] = GST_ELEMENT(&audioSrc); });
 
     EXPECT_CALL(*m_gstWrapperMock, gstAppSrcGetCaps(GST_APP_SRC(&audioSrc))).WillOnce(Return(&dummyCaps1));
     EXPECT_CALL(*m_gstWrapperMock, gstCapsCopy(&dummyCaps1)).WillOnce(Return(&dummyCaps2));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsSetSimpleIntStub(&dummyCaps2, CharStrMatcher("rate"), G_TYPE_INT, kSampleRate));
+    EXPECT_CALL(*m_gstWrapperMock,
+                gstCapsSetSimpleIntStub(&dummyCaps2, CharStrMatcher("channels"), G_TYPE_INT, kNumberOfChannels));
+    EXPECT_CALL(*m_gstWrapperMock, gstAppSrcSetCaps(GST_APP_SRC(&audioSrc), &dummyCaps2));
     EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps1));
     EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps2));
 
-    m_sut->updateAudioCaps(kInvalidSampleRate, kInvalidNumberOfChannels);
+    m_sut->updateAudioCaps(kSampleRate, kNumberOfChannels);
+    m_sut->updateAudioCaps(kSampleRate, kNumberOfChannels);
+    m_sut->updateAudioCaps(kInvalidSampleRate, kNumberOfChannels);
+    modifyContext([&](PlayerContext &context) { EXPECT_EQ(context.audioCapsUpdates, 1u); });
 }
 
 TEST_F(GstPlayerPrivateTest, shouldNotUpdateAudioCapsWhenNoSrc)
@@ -682,6 +814,90 @@ TEST_F(GstPlayerPrivateTest, shouldUpdateVideoCaps)
     m_sut->updateVideoCaps(kWidth, kHeight);
 }
 
+TEST_F(GstPlayerPrivateTest, shouldNotUpdateVideoCapsWhenValuesAreUnchanged)
+{
+    GstAppSrc videoSrc{};
+    GstCaps dummyCaps1;
+    GstCaps dummyCaps2;
+    modifyContext([&](PlayerContext &context)
+                  { context.streamInfo[firebolt::rialto::MediaSourceType::VIDEO] = GST_ELEMENT(&videoSrc); });
+
+    EXPECT_CALL(*m_gstWrapperMock, gstAppSrcGetCaps(GST_APP_SRC(&videoSrc))).WillOnce(Return(&dummyCaps1));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsCopy(&dummyCaps1)).WillOnce(Return(&dummyCaps2));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsSetSimpleIntStub(&dummyCaps2, CharStrMatcher("width"), G_TYPE_INT, kWidth));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsSetSimpleIntStub(&dummyCaps2, CharStrMatcher("height"), G_TYPE_INT, kHeight));
+    EXPECT_CALL(*m_gstWrapperMock, gstAppSrcSetCaps(GST_APP_SRC(&videoSrc), &dummyCaps2));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps1));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps2));
+
+    m_sut->updateVideoCaps(kWidth, kHeight);
+    m_sut->updateVideoCaps(kWidth, kHeight);
+    modifyContext([&](PlayerContext &context) { EXPECT_EQ(context.videoCapsUpdates, 1u); });
+}
+
+TEST_F(GstPlayerPrivateTest, shouldPushPendingVideoBuffersBeforeVideoCapsChange)
+{
+    GstBuffer buffer{};
+    GstAppSrc videoSrc{};
+    GstCaps dummyCaps1;
+    GstCaps dummyCaps2;
+    modifyContext(
+        [&](PlayerContext &context)
+        {
+            context.videoBuffers.emplace_back(&buffer);
+            context.videoNeedData = false;
+            context.streamInfo[firebolt::rialto::MediaSourceType::VIDEO] = GST_ELEMENT(&videoSrc);
+        });
+
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_gstWrapperMock, gstAppSrcPushBuffer(GST_APP_SRC(&videoSrc), &buffer));
+        EXPECT_CALL(*m_gstWrapperMock, gstAppSrcGetCaps(GST_APP_SRC(&videoSrc))).WillOnce(Return(&dummyCaps1));
+        EXPECT_CALL(*m_gstWrapperMock, gstCapsCopy(&dummyCaps1)).WillOnce(Return(&dummyCaps2));
+        EXPECT_CALL(*m_gstWrapperMock,
+                    gstCapsSetSimpleIntStub(&dummyCaps2, CharStrMatcher("width"), G_TYPE_INT, kWidth));
+        EXPECT_CALL(*m_gstWrapperMock,
+                    gstCapsSetSimpleIntStub(&dummyCaps2, CharStrMatcher("height"), G_TYPE_INT, kHeight));
+        EXPECT_CALL(*m_gstWrapperMock, gstAppSrcSetCaps(GST_APP_SRC(&videoSrc), &dummyCaps2));
+    }
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps1));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps2));
+
+    m_sut->updateVideoCaps(kWidth, kHeight);
+    modifyContext([&](PlayerContext &context) { EXPECT_TRUE(context.videoBuffers.empty()); });
+}
+
+TEST_F(GstPlayerPrivateTest, shouldPushPendingAudioBuffersBeforeAudioCapsChange)
+{
+    GstBuffer buffer{};
+    GstAppSrc audioSrc{};
+    GstCaps dummyCaps1;
+    GstCaps dummyCaps2;
+    modifyContext(
+        [&](PlayerContext &context)
+        {
+            context.audioBuffers.emplace_back(&buffer);
+            context.audioNeedData = false;
+            context.audioCapsNumberOfChannels = kNumberOfChannels;
+            context.streamInfo[firebolt::rialto::MediaSourceType::AUDIO] = GST_ELEMENT(&audioSrc);
+        });
+
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_gstWrapperMock, gstAppSrcPushBuffer(GST_APP_SRC(&audioSrc), &buffer));
+        EXPECT_CALL(*m_gstWrapperMock, gstAppSrcGetCaps(GST_APP_SRC(&audioSrc))).WillOnce(Return(&dummyCaps1));
+        EXPECT_CALL(*m_gstWrapperMock, gstCapsCopy(&dummyCaps1)).WillOnce(Return(&dummyCaps2));
+        EXPECT_CALL(*m_gstWrapperMock,
+                    gstCapsSetSimpleIntStub(&dummyCaps2, CharStrMatcher("rate"), G_TYPE_INT, kSampleRate));
+        EXPECT_CALL(*m_gstWrapperMock, gstAppSrcSetCaps(GST_APP_SRC(&audioSrc), &dummyCaps2));
+    }
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps1));
+    EXPECT_CALL(*m_gstWrapperMock, gstCapsUnref(&dummyCaps2));
+
+    m_sut->updateAudioCaps(kSampleRate, kNumberOfChannels);
+    modifyContext([&](PlayerContext &context) { EXPECT_TRUE(context.audioBuffers.empty()); });
+}
+
 TEST_F(GstPlayerPrivateTest, shouldNotUpdateAudioVideoCapsWhenNoSrc)
 {
     m_sut->updateVideoCaps(kWidth, kHeight);
@@ -782,3 +998,180 @@ TEST_F(GstPlayerPrivateTest, shouldStopWorkerThread)
     EXPECT_CALL(m_workerThreadMock, stop());
     m_sut->stopWorkerThread();
 }
+
+class GstPlayerPrivateZeroCopyTest : public GstPlayerTestCommon
+{
+protected:
+    std::unique_ptr<IGstPlayerPrivate> m_sut;
+    const std::vector<uint8_t> m_data{1, 2, 3, 4};
+
+    GstPlayerPrivateZeroCopyTest()
+    {
+        setenv("RIALTO_SHM_ZERO_COPY", "1", 1);
+        gstPlayerWillBeCreated();
+        m_sut = std::make_unique<GstPlayer>(&m_gstPlayerClient, m_decryptionServiceMock, MediaType::MSE, m_videoReq,
+                                            m_gstWrapperMock, m_glibWrapperMock, m_gstSrcFactoryMock,
+                                            m_timerFactoryMock, std::move(taskFactory), std::move(workerThreadFactory),
+                                            std::move(gstDispatcherThreadFactory));
+    }
+
+    ~GstPlayerPrivateZeroCopyTest() override
+    {
+        if (m_sut)
+        {
+            gstPlayerWillBeDestroyed();
+            m_sut.reset();
+        }
+        unsetenv("RIALTO_SHM_ZERO_COPY");
+    }
+};
+
+TEST_F(GstPlayerPrivateZeroCopyTest, shouldWrapShmDataAndNotifyWhenReleased)
+{
+    GstBuffer buffer{};
+    gpointer userData{nullptr};
+    GDestroyNotify notify{nullptr};
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<StrictMock<DataReaderMock>>()};
+    std::weak_ptr<IDataReader> dataReaderObserver{dataReader};
+    IMediaPipeline::MediaSegmentAudio mediaSegment{kSourceId, kTimeStamp, kDuration, kSampleRate, kNumberOfChannels};
+    mediaSegment.setData(m_data.size(), m_data.data());
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrappedFull(GST_MEMORY_FLAG_READONLY, _, m_data.size(), 0, m_data.size(),
+                                                           _, _))
+        .WillOnce(Invoke(
+            [&](GstMemoryFlags, gpointer data, gsize, gsize, gsize, gpointer user_data, GDestroyNotify destroyNotify)
+            {
+                EXPECT_EQ(data, m_data.data());
+                userData = user_data;
+                notify = destroyNotify;
+                return &buffer;
+            }));
+    EXPECT_EQ(m_sut->createShmBuffer(mediaSegment, dataReader), &buffer);
+    EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
+    EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
+
+    // Wrapped buffer keeps the shared memory slot in use
+    dataReader.reset();
+    EXPECT_FALSE(dataReaderObserver.expired());
+
+    ASSERT_TRUE(notify);
+    notify(userData);
+    EXPECT_TRUE(dataReaderObserver.expired());
+}
+
+TEST_F(GstPlayerPrivateZeroCopyTest, shouldWaitForShmBuffersReleaseWhenDestroyed)
+{
+    GstBuffer buffer{};
+    gpointer userData{nullptr};
+    GDestroyNotify notify{nullptr};
+    std::atomic<bool> isReleased{false};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight};
+    mediaSegment.setData(m_data.size(), m_data.data());
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrappedFull(_, _, _, _, _, _, _))
+        .WillOnce(Invoke(
+            [&](GstMemoryFlags, gpointer, gsize, gsize, gsize, gpointer user_data, GDestroyNotify destroyNotify)
+            {
+                userData = user_data;
+                notify = destroyNotify;
+                return &buffer;
+            }));
+    EXPECT_EQ(m_sut->createShmBuffer(mediaSegment, std::make_shared<StrictMock<DataReaderMock>>()), &buffer);
+    ASSERT_TRUE(notify);
+
+    // Buffer is released by a gstreamer thread after the pipeline is stopped
+    std::thread gstThread{[&]()
+                          {
+                              std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                              isReleased = true;
+                              notify(userData);
+                          }};
+    gstPlayerWillBeDestroyed();
+    m_sut.reset();
+    EXPECT_TRUE(isReleased);
+    gstThread.join();
+}
+
+TEST_F(GstPlayerPrivateZeroCopyTest, shouldNotWaitForeverForShmBuffersWhenDestroyed)
+{
+    GstBuffer buffer{};
+    gpointer userData{nullptr};
+    GDestroyNotify notify{nullptr};
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<StrictMock<DataReaderMock>>()};
+    std::weak_ptr<IDataReader> dataReaderObserver{dataReader};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight};
+    mediaSegment.setData(m_data.size(), m_data.data());
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrappedFull(_, _, _, _, _, _, _))
+        .WillOnce(Invoke(
+            [&](GstMemoryFlags, gpointer, gsize, gsize, gsize, gpointer user_data, GDestroyNotify destroyNotify)
+            {
+                userData = user_data;
+                notify = destroyNotify;
+                return &buffer;
+            }));
+    EXPECT_EQ(m_sut->createShmBuffer(mediaSegment, dataReader), &buffer);
+    dataReader.reset();
+    ASSERT_TRUE(notify);
+
+    // Buffer leaked by an element is never released before the player is destroyed
+    gstPlayerWillBeDestroyed();
+    m_sut.reset();
+    EXPECT_FALSE(dataReaderObserver.expired());
+
+    // Late release must not touch the destroyed player
+    notify(userData);
+    EXPECT_TRUE(dataReaderObserver.expired());
+}
+
+TEST_F(GstPlayerPrivateZeroCopyTest, shouldCopyEncryptedShmData)
+{
+    GstBuffer buffer{}, initVectorBuffer{}, keyIdBuffer{}, subSamplesBuffer{};
+    GstStructure structure{};
+    guint8 subSamplesData{0};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight};
+    mediaSegment.setData(m_data.size(), m_data.data());
+    mediaSegment.setEncrypted(true);
+    mediaSegment.setMediaKeySessionId(kMediaKeySessionId);
+    mediaSegment.setKeyId(kKeyId);
+    mediaSegment.setInitVector(kInitVector);
+    mediaSegment.setInitWithLast15(kInitWithLast15);
+
+    // Sample, key id and init vector have the same size, so their allocations are told apart by order
+    Sequence allocations;
+
+    // Decryption is done in place, so encrypted samples must never be wrapped
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrappedFull(_, _, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, m_data.size(), nullptr))
+        .InSequence(allocations)
+        .WillOnce(Return(&buffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&buffer, 0, m_data.data(), m_data.size()));
+    EXPECT_CALL(m_decryptionServiceMock, isNetflixKeySystem(kMediaKeySessionId)).WillOnce(Return(false));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, kKeyId.size(), nullptr))
+        .InSequence(allocations)
+        .WillOnce(Return(&keyIdBuffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&keyIdBuffer, 0, _, kKeyId.size()));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, kInitVector.size(), nullptr))
+        .InSequence(allocations)
+        .WillOnce(Return(&initVectorBuffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&initVectorBuffer, 0, _, kInitVector.size()));
+    EXPECT_CALL(*m_glibWrapperMock, gMalloc(0)).WillOnce(Return(&subSamplesData));
+    EXPECT_CALL(*m_gstWrapperMock, gstByteWriterInitWithData(_, &subSamplesData, 0, FALSE));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrapped(&subSamplesData, 0)).WillOnce(Return(&subSamplesBuffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstStructureNewBufferStub(_, _, _, _)).Times(3).WillRepeatedly(Return(&structure));
+    EXPECT_CALL(*m_gstWrapperMock, gstStructureNewUintStub(_, _, _, _)).Times(4).WillRepeatedly(Return(&structure));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferAddProtectionMeta(&buffer, &structure));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferUnref(&subSamplesBuffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferUnref(&initVectorBuffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferUnref(&keyIdBuffer));
+
+    EXPECT_EQ(m_sut->createShmBuffer(mediaSegment, std::make_shared<StrictMock<DataReaderMock>>()), &buffer);
+}
+
+TEST_F(GstPlayerPrivateZeroCopyTest, shouldCopyShmDataWhenWrappingFails)
+{
+    GstBuffer buffer{};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight};
+    mediaSegment.setData(m_data.size(), m_data.data());
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrappedFull(_, _, _, _, _, _, _)).WillOnce(Return(nullptr));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, m_data.size(), nullptr)).WillOnce(Return(&buffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&buffer, 0, m_data.data(), m_data.size()));
+    EXPECT_EQ(m_sut->createShmBuffer(mediaSegment, nullptr), &buffer);
+}
@@ -27,6 +27,8 @@
 using testing::_;
 using testing::ByMove;
 using testing::Invoke;
+using testing::Pointee;
+using testing::Ref;
 using testing::Return;
 
 class GstPlayerTest : public GstPlayerTestCommon
@@ -104,8 +106,12 @@ TEST_F(GstPlayerTest, shouldAttachSamplesFromShm)
     std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
     std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
     EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
-    EXPECT_CALL(m_taskFactoryMock, createReadShmDataAndAttachSamples(_, _, dataReader))
+    std::unique_ptr<IPlayerTask> releasedTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
+    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*releasedTask), execute());
+    EXPECT_CALL(m_taskFactoryMock, createReadShmDataAndAttachSamples(_, _, Pointee(Ref(*dataReader))))
         .WillOnce(Return(ByMove(std::move(task))));
+    // Task mock does not keep the player data reader, so it is dropped when attachSamples returns
+    EXPECT_CALL(m_taskFactoryMock, createShmBuffersReleased(_)).WillOnce(Return(ByMove(std::move(releasedTask))));
 
     m_sut->attachSamples(dataReader);
 }
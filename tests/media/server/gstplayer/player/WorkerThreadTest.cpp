@@ -22,6 +22,7 @@
 #include <condition_variable>
 #include <gtest/gtest.h>
 #include <mutex>
+#include <vector>
 
 using firebolt::rialto::server::PlayerTaskMock;
 using testing::Invoke;
@@ -55,3 +56,103 @@ TEST(WorkerThreadTest, shouldEnqueueTaskAndExit)
 
     // sut.reset();
 }
+
+TEST(WorkerThreadTest, shouldExecuteTasksOfEachWorkerInOrder)
+{
+    constexpr int kNumOfWorkers{4};
+    constexpr int kNumOfTasks{100};
+    auto pool = std::make_shared<firebolt::rialto::server::WorkerThreadPool>(kNumOfWorkers);
+    std::vector<std::unique_ptr<firebolt::rialto::server::WorkerThread>> workers;
+    std::vector<std::vector<int>> executedTasks(kNumOfWorkers);
+    for (int i = 0; i < kNumOfWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<firebolt::rialto::server::WorkerThread>(pool));
+    }
+
+    for (int taskIdx = 0; taskIdx < kNumOfTasks; ++taskIdx)
+    {
+        for (int i = 0; i < kNumOfWorkers; ++i)
+        {
+            std::unique_ptr<firebolt::rialto::server::IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
+            EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute())
+                .WillOnce(Invoke([&executedTasks, i, taskIdx]() { executedTasks[i].push_back(taskIdx); }));
+            workers[i]->enqueueTask(std::move(task));
+        }
+    }
+
+    for (int i = 0; i < kNumOfWorkers; ++i)
+    {
+        std::unique_ptr<firebolt::rialto::server::IPlayerTask> shutdownTask{
+            std::make_unique<StrictMock<PlayerTaskMock>>()};
+        auto &worker = *workers[i];
+        EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*shutdownTask), execute())
+            .WillOnce(Invoke([&worker]() { worker.stop(); }));
+        worker.enqueueTask(std::move(shutdownTask));
+        worker.join();
+
+        ASSERT_EQ(executedTasks[i].size(), static_cast<size_t>(kNumOfTasks));
+        for (int taskIdx = 0; taskIdx < kNumOfTasks; ++taskIdx)
+        {
+            EXPECT_EQ(executedTasks[i][taskIdx], taskIdx);
+        }
+    }
+}
+
+TEST(WorkerThreadTest, shouldRunTasksWhileAllPoolThreadsAreBlocked)
+{
+    constexpr int kNumOfBlockedWorkers{3};
+    auto pool = std::make_shared<firebolt::rialto::server::WorkerThreadPool>(1);
+    std::mutex mutex;
+    std::condition_variable cv;
+    int numOfBlockedTasks{0};
+    bool isReleased{false};
+    std::vector<std::unique_ptr<firebolt::rialto::server::WorkerThread>> workers;
+    for (int i = 0; i <= kNumOfBlockedWorkers; ++i)
+    {
+        workers.push_back(std::make_unique<firebolt::rialto::server::WorkerThread>(pool));
+    }
+
+    for (int i = 0; i < kNumOfBlockedWorkers; ++i)
+    {
+        std::unique_ptr<firebolt::rialto::server::IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
+        EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute())
+            .WillOnce(Invoke(
+                [&]()
+                {
+                    std::unique_lock<std::mutex> lock{mutex};
+                    ++numOfBlockedTasks;
+                    cv.notify_all();
+                    cv.wait(lock, [&]() { return isReleased; });
+                }));
+        workers[i]->enqueueTask(std::move(task));
+    }
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        EXPECT_TRUE(
+            cv.wait_for(lock, std::chrono::seconds(1), [&]() { return numOfBlockedTasks == kNumOfBlockedWorkers; }));
+    }
+
+    // The last worker's task releases the others, so it must not wait for a blocked pool thread
+    std::unique_ptr<firebolt::rialto::server::IPlayerTask> releaseTask{std::make_unique<StrictMock<PlayerTaskMock>>()};
+    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*releaseTask), execute())
+        .WillOnce(Invoke(
+            [&]()
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                isReleased = true;
+                cv.notify_all();
+            }));
+    workers[kNumOfBlockedWorkers]->enqueueTask(std::move(releaseTask));
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(1), [&]() { return isReleased; }));
+        isReleased = true;
+        cv.notify_all();
+    }
+    EXPECT_GE(pool->getNumOfThreads(), static_cast<size_t>(kNumOfBlockedWorkers + 1));
+
+    for (auto &worker : workers)
+    {
+        worker->join();
+    }
+}
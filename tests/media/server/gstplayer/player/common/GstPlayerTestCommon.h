@@ -84,7 +84,6 @@ private:
     GstElement m_pipeline{};
     GFlagsClass m_flagsClass{};
     GstElement m_playsink{};
-    GstBus m_bus{};
     GType m_gstPlayFlagsType = static_cast<GType>(123);
     GFlagsValue m_audioFlag{1, "audio", "audio"};
     GFlagsValue m_videoFlag{2, "video", "video"};
@@ -25,6 +25,8 @@
 #include <gtest/gtest.h>
 
 using testing::_;
+using testing::InSequence;
+using testing::Invoke;
 using testing::Return;
 using testing::StrictMock;
 
@@ -39,6 +41,8 @@ constexpr int32_t sampleRate{13};
 constexpr int32_t numberOfChannels{4};
 constexpr int32_t width{1024};
 constexpr int32_t height{768};
+constexpr int32_t otherWidth{1920};
+constexpr int32_t otherHeight{1080};
 
 firebolt::rialto::IMediaPipeline::MediaSegmentVector buildAudioSamples()
 {
@@ -71,6 +75,28 @@ public:
     firebolt::rialto::server::PlayerContext m_context;
     StrictMock<firebolt::rialto::server::GstPlayerPrivateMock> m_gstPlayer;
     GstBuffer m_gstBuffer{};
+
+    void expectAudioCapsUpdate(int32_t rate, int32_t channels)
+    {
+        EXPECT_CALL(m_gstPlayer, updateAudioCaps(rate, channels))
+            .WillOnce(Invoke(
+                [this](int32_t newRate, int32_t newChannels)
+                {
+                    m_context.audioCapsSampleRate = newRate;
+                    m_context.audioCapsNumberOfChannels = newChannels;
+                }));
+    }
+
+    void expectVideoCapsUpdate(int32_t newWidth, int32_t newHeight)
+    {
+        EXPECT_CALL(m_gstPlayer, updateVideoCaps(newWidth, newHeight))
+            .WillOnce(Invoke(
+                [this](int32_t appliedWidth, int32_t appliedHeight)
+                {
+                    m_context.videoCapsWidth = appliedWidth;
+                    m_context.videoCapsHeight = appliedHeight;
+                }));
+    }
 };
 
 TEST_F(AttachSamplesTest, shouldAttachAllAudioSamples)
@@ -78,8 +104,8 @@ TEST_F(AttachSamplesTest, shouldAttachAllAudioSamples)
     auto samples = buildAudioSamples();
     EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
     firebolt::rialto::server::AttachSamples task{m_context, m_gstPlayer, samples};
-    EXPECT_CALL(m_gstPlayer, updateAudioCaps(sampleRate, numberOfChannels)).Times(2);
-    EXPECT_CALL(m_gstPlayer, attachAudioData()).Times(2);
+    expectAudioCapsUpdate(sampleRate, numberOfChannels);
+    EXPECT_CALL(m_gstPlayer, attachAudioData());
     EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(true, false));
     task.execute();
     EXPECT_EQ(m_context.audioBuffers.size(), 2);
@@ -90,9 +116,41 @@ TEST_F(AttachSamplesTest, shouldAttachAllVideoSamples)
     auto samples = buildVideoSamples();
     EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
     firebolt::rialto::server::AttachSamples task{m_context, m_gstPlayer, samples};
-    EXPECT_CALL(m_gstPlayer, updateVideoCaps(width, height)).Times(2);
-    EXPECT_CALL(m_gstPlayer, attachVideoData()).Times(2);
+    expectVideoCapsUpdate(width, height);
+    EXPECT_CALL(m_gstPlayer, attachVideoData());
+    EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(false, true));
+    task.execute();
+    EXPECT_EQ(m_context.videoBuffers.size(), 2);
+}
+
+TEST_F(AttachSamplesTest, shouldNotUpdateVideoCapsAlreadyApplied)
+{
+    auto samples = buildVideoSamples();
+    m_context.videoCapsWidth = width;
+    m_context.videoCapsHeight = height;
+    EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
+    firebolt::rialto::server::AttachSamples task{m_context, m_gstPlayer, samples};
+    EXPECT_CALL(m_gstPlayer, attachVideoData());
     EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(false, true));
     task.execute();
     EXPECT_EQ(m_context.videoBuffers.size(), 2);
 }
+
+TEST_F(AttachSamplesTest, shouldUpdateVideoCapsWhenChangedWithinBatch)
+{
+    auto samples = buildVideoSamples();
+    samples.emplace_back(std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegmentVideo>(videoSourceId,
+                                                                                               itWillHappenInTheFuture,
+                                                                                               duration, otherWidth,
+                                                                                               otherHeight));
+    EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(3).WillRepeatedly(Return(&m_gstBuffer));
+    firebolt::rialto::server::AttachSamples task{m_context, m_gstPlayer, samples};
+    {
+        InSequence seq;
+        expectVideoCapsUpdate(width, height);
+        expectVideoCapsUpdate(otherWidth, otherHeight);
+        EXPECT_CALL(m_gstPlayer, attachVideoData());
+        EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(false, true));
+    }
+    task.execute();
+}
@@ -206,6 +206,8 @@ TEST_F(AttachSourceTest, shouldUpdateEmptyCapsInVideoSource)
 TEST_F(AttachSourceTest, shouldUpdateExistingCapsInVideoSource)
 {
     m_context.streamInfo.emplace(firebolt::rialto::MediaSourceType::VIDEO, &m_appSrc);
+    m_context.videoCapsWidth = 1920;
+    m_context.videoCapsHeight = 1080;
     firebolt::rialto::IMediaPipeline::MediaSource source(-1, firebolt::rialto::MediaSourceType::VIDEO, "video/h264");
     firebolt::rialto::server::AttachSource task{m_context, m_gstWrapper, m_glibWrapper, source};
     EXPECT_CALL(*m_gstWrapper, gstCapsNewEmptySimple(StrEq("video/x-h264"))).WillOnce(Return(&m_gstCaps2));
@@ -219,6 +221,8 @@ TEST_F(AttachSourceTest, shouldUpdateExistingCapsInVideoSource)
     task.execute();
     EXPECT_EQ(1, m_context.streamInfo.size());
     EXPECT_NE(m_context.streamInfo.end(), m_context.streamInfo.find(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_EQ(m_context.videoCapsWidth, 0);
+    EXPECT_EQ(m_context.videoCapsHeight, 0);
 }
 
 TEST_F(AttachSourceTest, shouldNotUpdateAudioSource)
@@ -18,19 +18,18 @@
  */
 
 #include "tasks/NeedData.h"
-#include "GstPlayerClientMock.h"
+#include "GstPlayerPrivateMock.h"
 #include "PlayerContext.h"
 #include <gst/gst.h>
 #include <gtest/gtest.h>
 
-using testing::Return;
 using testing::StrictMock;
 
 class NeedDataTest : public testing::Test
 {
 protected:
     firebolt::rialto::server::PlayerContext m_context{};
-    StrictMock<firebolt::rialto::server::GstPlayerClientMock> m_gstPlayerClient;
+    StrictMock<firebolt::rialto::server::GstPlayerPrivateMock> m_gstPlayer;
     GstAppSrc m_audioSrc{};
     GstAppSrc m_videoSrc{};
 
@@ -43,13 +42,13 @@ protected:
 
 TEST_F(NeedDataTest, shouldDoNothingWhenAudioAppSourceIsNotPresent)
 {
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_audioSrc};
+    firebolt::rialto::server::NeedData task{m_context, m_gstPlayer, &m_audioSrc};
     task.execute();
 }
 
 TEST_F(NeedDataTest, shouldDoNothingWhenVideoAppSourceIsNotPresent)
 {
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
+    firebolt::rialto::server::NeedData task{m_context, m_gstPlayer, &m_videoSrc};
     task.execute();
 }
 
@@ -57,78 +56,26 @@ TEST_F(NeedDataTest, shouldDoNothingForUnknownAppSource)
 {
     GstAppSrc unknownSrc{};
     setupAppSource();
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &unknownSrc};
+    firebolt::rialto::server::NeedData task{m_context, m_gstPlayer, &unknownSrc};
     task.execute();
 }
 
-TEST_F(NeedDataTest, shouldNotifyNeedAudioData)
+TEST_F(NeedDataTest, shouldRequestAudioData)
 {
     setupAppSource();
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::AUDIO)).WillOnce(Return(true));
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_audioSrc};
+    EXPECT_CALL(m_gstPlayer, requestMediaData(firebolt::rialto::MediaSourceType::AUDIO));
+    firebolt::rialto::server::NeedData task{m_context, m_gstPlayer, &m_audioSrc};
     task.execute();
     EXPECT_TRUE(m_context.audioNeedData);
-    EXPECT_TRUE(m_context.audioNeedDataPending);
     EXPECT_FALSE(m_context.videoNeedData);
-    EXPECT_FALSE(m_context.videoNeedDataPending);
 }
 
-TEST_F(NeedDataTest, shouldFailToNotifyNeedAudioData)
+TEST_F(NeedDataTest, shouldRequestVideoData)
 {
     setupAppSource();
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::AUDIO)).WillOnce(Return(false));
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_audioSrc};
-    task.execute();
-    EXPECT_TRUE(m_context.audioNeedData);
-    EXPECT_FALSE(m_context.audioNeedDataPending);
-    EXPECT_FALSE(m_context.videoNeedData);
-    EXPECT_FALSE(m_context.videoNeedDataPending);
-}
-
-TEST_F(NeedDataTest, shouldSkipToNotifyNeedAudioData)
-{
-    setupAppSource();
-    m_context.audioNeedDataPending = true;
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_audioSrc};
-    task.execute();
-    EXPECT_TRUE(m_context.audioNeedData);
-    EXPECT_TRUE(m_context.audioNeedDataPending);
-    EXPECT_FALSE(m_context.videoNeedData);
-    EXPECT_FALSE(m_context.videoNeedDataPending);
-}
-
-TEST_F(NeedDataTest, shouldNotifyNeedVideoData)
-{
-    setupAppSource();
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO)).WillOnce(Return(true));
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
-    task.execute();
-    EXPECT_FALSE(m_context.audioNeedData);
-    EXPECT_FALSE(m_context.audioNeedDataPending);
-    EXPECT_TRUE(m_context.videoNeedData);
-    EXPECT_TRUE(m_context.videoNeedDataPending);
-}
-
-TEST_F(NeedDataTest, shouldFailToNotifyNeedVideoData)
-{
-    setupAppSource();
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO)).WillOnce(Return(false));
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
-    task.execute();
-    EXPECT_FALSE(m_context.audioNeedData);
-    EXPECT_FALSE(m_context.audioNeedDataPending);
-    EXPECT_TRUE(m_context.videoNeedData);
-    EXPECT_FALSE(m_context.videoNeedDataPending);
-}
-
-TEST_F(NeedDataTest, shouldSkipToNotifyNeedVideoData)
-{
-    setupAppSource();
-    m_context.videoNeedDataPending = true;
-    firebolt::rialto::server::NeedData task{m_context, &m_gstPlayerClient, &m_videoSrc};
+    EXPECT_CALL(m_gstPlayer, requestMediaData(firebolt::rialto::MediaSourceType::VIDEO));
+    firebolt::rialto::server::NeedData task{m_context, m_gstPlayer, &m_videoSrc};
     task.execute();
     EXPECT_FALSE(m_context.audioNeedData);
-    EXPECT_FALSE(m_context.audioNeedDataPending);
     EXPECT_TRUE(m_context.videoNeedData);
-    EXPECT_TRUE(m_context.videoNeedDataPending);
 }
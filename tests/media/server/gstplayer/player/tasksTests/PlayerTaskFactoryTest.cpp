@@ -41,6 +41,7 @@
 #include "tasks/SetVideoGeometry.h"
 #include "tasks/SetupElement.h"
 #include "tasks/SetupSource.h"
+#include "tasks/ShmBuffersReleased.h"
 #include "tasks/Shutdown.h"
 #include "tasks/Stop.h"
 #include "tasks/Underflow.h"
@@ -111,7 +112,7 @@ TEST_F(PlayerTaskFactoryTest, ShouldCreateHandleBusMessage)
 
 TEST_F(PlayerTaskFactoryTest, ShouldCreateNeedData)
 {
-    auto task = m_sut.createNeedData(m_context, nullptr);
+    auto task = m_sut.createNeedData(m_context, m_gstPlayer, nullptr);
     EXPECT_NE(task, nullptr);
     EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::NeedData &>(*task));
 }
@@ -179,6 +180,13 @@ TEST_F(PlayerTaskFactoryTest, ShouldCreateSetVideoGeometry)
     EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::SetVideoGeometry &>(*task));
 }
 
+TEST_F(PlayerTaskFactoryTest, ShouldCreateShmBuffersReleased)
+{
+    auto task = m_sut.createShmBuffersReleased(m_gstPlayer);
+    EXPECT_NE(task, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::ShmBuffersReleased &>(*task));
+}
+
 TEST_F(PlayerTaskFactoryTest, ShouldCreateShutdown)
 {
     auto task = m_sut.createShutdown(m_gstPlayer);
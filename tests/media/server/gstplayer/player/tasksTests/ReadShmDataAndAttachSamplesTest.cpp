@@ -27,6 +27,9 @@
 
 using testing::_;
 using testing::ByMove;
+using testing::Eq;
+using testing::InSequence;
+using testing::Invoke;
 using testing::Return;
 using testing::StrictMock;
 
@@ -39,6 +42,7 @@ constexpr gint64 itWillHappenInTheFuture = 3823530248;
 constexpr int64_t duration{9000000000};
 constexpr int32_t sampleRate{13};
 constexpr int32_t numberOfChannels{4};
+constexpr int32_t otherNumberOfChannels{2};
 constexpr int32_t width{1024};
 constexpr int32_t height{768};
 
@@ -75,15 +79,37 @@ protected:
     std::shared_ptr<StrictMock<firebolt::rialto::server::DataReaderMock>> m_dataReader{
         std::make_shared<StrictMock<firebolt::rialto::server::DataReaderMock>>()};
     GstBuffer m_gstBuffer{};
+
+    void expectAudioCapsUpdate(int32_t rate, int32_t channels)
+    {
+        EXPECT_CALL(m_gstPlayer, updateAudioCaps(rate, channels))
+            .WillOnce(Invoke(
+                [this](int32_t newRate, int32_t newChannels)
+                {
+                    m_context.audioCapsSampleRate = newRate;
+                    m_context.audioCapsNumberOfChannels = newChannels;
+                }));
+    }
+
+    void expectVideoCapsUpdate(int32_t newWidth, int32_t newHeight)
+    {
+        EXPECT_CALL(m_gstPlayer, updateVideoCaps(newWidth, newHeight))
+            .WillOnce(Invoke(
+                [this](int32_t appliedWidth, int32_t appliedHeight)
+                {
+                    m_context.videoCapsWidth = appliedWidth;
+                    m_context.videoCapsHeight = appliedHeight;
+                }));
+    }
 };
 
 TEST_F(ReadShmDataAndAttachSamplesTest, shouldAttachAllAudioSamples)
 {
     firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec = buildAudioSamples();
     EXPECT_CALL(*m_dataReader, readData()).WillOnce(Return(ByMove(std::move(dataVec))));
-    EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
-    EXPECT_CALL(m_gstPlayer, updateAudioCaps(sampleRate, numberOfChannels)).Times(2);
-    EXPECT_CALL(m_gstPlayer, attachAudioData()).Times(2);
+    EXPECT_CALL(m_gstPlayer, createShmBuffer(_, Eq(m_dataReader))).Times(2).WillRepeatedly(Return(&m_gstBuffer));
+    expectAudioCapsUpdate(sampleRate, numberOfChannels);
+    EXPECT_CALL(m_gstPlayer, attachAudioData());
     EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(true, false));
     firebolt::rialto::server::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
     task.execute();
@@ -94,11 +120,45 @@ TEST_F(ReadShmDataAndAttachSamplesTest, shouldAttachAllVideoSamples)
 {
     firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec = buildVideoSamples();
     EXPECT_CALL(*m_dataReader, readData()).WillOnce(Return(ByMove(std::move(dataVec))));
-    EXPECT_CALL(m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&m_gstBuffer));
-    EXPECT_CALL(m_gstPlayer, updateVideoCaps(width, height)).Times(2);
-    EXPECT_CALL(m_gstPlayer, attachVideoData()).Times(2);
+    EXPECT_CALL(m_gstPlayer, createShmBuffer(_, Eq(m_dataReader))).Times(2).WillRepeatedly(Return(&m_gstBuffer));
+    expectVideoCapsUpdate(width, height);
+    EXPECT_CALL(m_gstPlayer, attachVideoData());
     EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(false, true));
     firebolt::rialto::server::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
     task.execute();
     EXPECT_EQ(m_context.videoBuffers.size(), 2);
 }
+
+TEST_F(ReadShmDataAndAttachSamplesTest, shouldNotUpdateAudioCapsAlreadyApplied)
+{
+    firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec = buildAudioSamples();
+    m_context.audioCapsSampleRate = sampleRate;
+    m_context.audioCapsNumberOfChannels = numberOfChannels;
+    EXPECT_CALL(*m_dataReader, readData()).WillOnce(Return(ByMove(std::move(dataVec))));
+    EXPECT_CALL(m_gstPlayer, createShmBuffer(_, Eq(m_dataReader))).Times(2).WillRepeatedly(Return(&m_gstBuffer));
+    EXPECT_CALL(m_gstPlayer, attachAudioData());
+    EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(true, false));
+    firebolt::rialto::server::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
+    task.execute();
+    EXPECT_EQ(m_context.audioBuffers.size(), 2);
+}
+
+TEST_F(ReadShmDataAndAttachSamplesTest, shouldUpdateAudioCapsWhenChangedWithinBatch)
+{
+    firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec = buildAudioSamples();
+    dataVec.emplace_back(
+        std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegmentAudio>(audioSourceId, itWillHappenInTheFuture,
+                                                                              duration, sampleRate,
+                                                                              otherNumberOfChannels));
+    EXPECT_CALL(*m_dataReader, readData()).WillOnce(Return(ByMove(std::move(dataVec))));
+    EXPECT_CALL(m_gstPlayer, createShmBuffer(_, Eq(m_dataReader))).Times(3).WillRepeatedly(Return(&m_gstBuffer));
+    {
+        InSequence seq;
+        expectAudioCapsUpdate(sampleRate, numberOfChannels);
+        expectAudioCapsUpdate(sampleRate, otherNumberOfChannels);
+        EXPECT_CALL(m_gstPlayer, attachAudioData());
+        EXPECT_CALL(m_gstPlayer, notifyNeedMediaData(true, false));
+    }
+    firebolt::rialto::server::ReadShmDataAndAttachSamples task{m_context, m_gstPlayer, m_dataReader};
+    task.execute();
+}
@@ -21,10 +21,12 @@
 #include "GstPlayerClientMock.h"
 #include "GstPlayerPrivateMock.h"
 #include "GstWrapperMock.h"
+#include "ISharedMemoryBuffer.h"
 #include "PlayerContext.h"
 #include <gst/gst.h>
 #include <gtest/gtest.h>
 
+using firebolt::rialto::server::kShmSlotsPerSource;
 using testing::Return;
 using testing::StrictMock;
 
@@ -52,8 +54,8 @@ protected:
         m_context.pipeline = &m_pipeline;
         m_context.audioNeedData = true;
         m_context.videoNeedData = true;
-        m_context.audioNeedDataPending = true;
-        m_context.videoNeedDataPending = true;
+        m_context.audioNeedDataPending = kShmSlotsPerSource;
+        m_context.videoNeedDataPending = kShmSlotsPerSource;
         m_context.audioBuffers.emplace_back(&m_audioBuffer);
         m_context.videoBuffers.emplace_back(&m_videoBuffer);
         m_context.streamInfo.emplace(firebolt::rialto::MediaSourceType::AUDIO, GST_ELEMENT(&m_audioSrc));
@@ -124,13 +126,13 @@ TEST_F(SetPositionTest, shouldSetPosition)
                                GST_SEEK_TYPE_SET, position, GST_SEEK_TYPE_NONE, GST_CLOCK_TIME_NONE))
         .WillOnce(Return(true));
     EXPECT_CALL(m_gstPlayerClient, notifyPlaybackState(firebolt::rialto::PlaybackState::FLUSHED));
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::AUDIO)).WillOnce(Return(true));
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO)).WillOnce(Return(true));
+    EXPECT_CALL(m_gstPlayer, requestMediaData(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(m_gstPlayer, requestMediaData(firebolt::rialto::MediaSourceType::VIDEO));
     task.execute();
     EXPECT_TRUE(m_context.audioNeedData);
     EXPECT_TRUE(m_context.videoNeedData);
-    EXPECT_TRUE(m_context.audioNeedDataPending);
-    EXPECT_TRUE(m_context.videoNeedDataPending);
+    EXPECT_FALSE(m_context.audioNeedDataPending);
+    EXPECT_FALSE(m_context.videoNeedDataPending);
     EXPECT_TRUE(m_context.audioBuffers.empty());
     EXPECT_TRUE(m_context.videoBuffers.empty());
 }
@@ -149,13 +151,13 @@ TEST_F(SetPositionTest, shouldSetPositionWithChangedPlaybackRate)
                                GST_SEEK_TYPE_SET, position, GST_SEEK_TYPE_NONE, GST_CLOCK_TIME_NONE))
         .WillOnce(Return(true));
     EXPECT_CALL(m_gstPlayerClient, notifyPlaybackState(firebolt::rialto::PlaybackState::FLUSHED));
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::AUDIO)).WillOnce(Return(true));
-    EXPECT_CALL(m_gstPlayerClient, notifyNeedMediaData(firebolt::rialto::MediaSourceType::VIDEO)).WillOnce(Return(true));
+    EXPECT_CALL(m_gstPlayer, requestMediaData(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(m_gstPlayer, requestMediaData(firebolt::rialto::MediaSourceType::VIDEO));
     task.execute();
     EXPECT_TRUE(m_context.audioNeedData);
     EXPECT_TRUE(m_context.videoNeedData);
-    EXPECT_TRUE(m_context.audioNeedDataPending);
-    EXPECT_TRUE(m_context.videoNeedDataPending);
+    EXPECT_FALSE(m_context.audioNeedDataPending);
+    EXPECT_FALSE(m_context.videoNeedDataPending);
     EXPECT_TRUE(m_context.audioBuffers.empty());
     EXPECT_TRUE(m_context.videoBuffers.empty());
 }
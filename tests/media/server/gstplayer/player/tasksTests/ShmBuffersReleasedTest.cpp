@@ -0,0 +1,36 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "tasks/ShmBuffersReleased.h"
+#include "GstPlayerPrivateMock.h"
+#include <gtest/gtest.h>
+
+using testing::StrictMock;
+
+class ShmBuffersReleasedTest : public testing::Test
+{
+protected:
+    StrictMock<firebolt::rialto::server::GstPlayerPrivateMock> m_gstPlayer;
+};
+
+TEST_F(ShmBuffersReleasedTest, shouldNotifyShmBuffersReleased)
+{
+    firebolt::rialto::server::ShmBuffersReleased task{m_gstPlayer};
+    EXPECT_CALL(m_gstPlayer, notifyShmBuffersReleased());
+    task.execute();
+}
@@ -0,0 +1,178 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "GlibWrapperMock.h"
+#include "GstPlayerClientMock.h"
+#include "GstPlayerPrivateMock.h"
+#include "GstWrapperMock.h"
+#include "PlayerContext.h"
+#include "WorkerThread.h"
+#include "WorkerThreadPool.h"
+#include "tasks/IPlayerTask.h"
+#include "tasks/PlayerTaskFactory.h"
+#include "tasks/PlayerTaskPool.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <thread>
+
+using firebolt::rialto::server::GlibWrapperMock;
+using firebolt::rialto::server::GstPlayerClientMock;
+using firebolt::rialto::server::GstPlayerPrivateMock;
+using firebolt::rialto::server::GstWrapperMock;
+using firebolt::rialto::server::IPlayerTask;
+using firebolt::rialto::server::PlayerContext;
+using firebolt::rialto::server::PlayerTaskFactory;
+using firebolt::rialto::server::PlayerTaskPool;
+using firebolt::rialto::server::WorkerThread;
+using firebolt::rialto::server::WorkerThreadPool;
+using testing::StrictMock;
+
+namespace
+{
+/**
+ * @brief Number of heap allocations made by the test binary.
+ *
+ * The global operator new is replaced for the whole binary, which is why these tests have an executable of their own.
+ */
+std::atomic<std::size_t> gNumOfHeapAllocations{0};
+
+class CountingTask : public IPlayerTask
+{
+public:
+    explicit CountingTask(std::atomic<int> &counter) : m_counter{counter} {}
+    void execute() const override { ++m_counter; }
+
+private:
+    std::atomic<int> &m_counter;
+};
+
+class BigTask : public IPlayerTask
+{
+public:
+    void execute() const override {}
+
+    std::array<char, PlayerTaskPool::kBlockSize> payload{};
+};
+
+void waitForCounter(const std::atomic<int> &counter, int expectedValue)
+{
+    while (counter != expectedValue)
+    {
+        std::this_thread::yield();
+    }
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    ++gNumOfHeapAllocations;
+    void *ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(PlayerTaskPoolTest, shouldReuseTaskMemory)
+{
+    std::atomic<int> counter{0};
+    std::unique_ptr<IPlayerTask> task{std::make_unique<CountingTask>(counter)};
+    const IPlayerTask *kFirstTask{task.get()};
+    task.reset();
+
+    const std::size_t kNumOfHeapAllocations{gNumOfHeapAllocations};
+    task = std::make_unique<CountingTask>(counter);
+    EXPECT_EQ(task.get(), kFirstTask);
+    EXPECT_EQ(gNumOfHeapAllocations, kNumOfHeapAllocations);
+}
+
+TEST(PlayerTaskPoolTest, shouldAllocateTasksBiggerThanBlockOnHeap)
+{
+    const std::size_t kNumOfHeapAllocations{gNumOfHeapAllocations};
+    const std::size_t kNumOfBlocks{PlayerTaskPool::getNumOfBlocks()};
+    std::unique_ptr<IPlayerTask> task{std::make_unique<BigTask>()};
+    EXPECT_EQ(gNumOfHeapAllocations, kNumOfHeapAllocations + 1);
+    EXPECT_EQ(PlayerTaskPool::getNumOfBlocks(), kNumOfBlocks);
+}
+
+TEST(PlayerTaskPoolTest, shouldCreateFactoryTasksWithoutHeapAllocation)
+{
+    PlayerContext context;
+    StrictMock<GstPlayerPrivateMock> gstPlayer;
+    StrictMock<GstPlayerClientMock> gstPlayerClient;
+    PlayerTaskFactory factory{&gstPlayerClient, std::make_shared<StrictMock<GstWrapperMock>>(),
+                              std::make_shared<StrictMock<GlibWrapperMock>>()};
+    factory.createNeedData(context, gstPlayer, nullptr).reset();
+
+    const std::size_t kNumOfHeapAllocations{gNumOfHeapAllocations};
+    std::unique_ptr<IPlayerTask> needData{factory.createNeedData(context, gstPlayer, nullptr)};
+    std::unique_ptr<IPlayerTask> reportPosition{factory.createReportPosition(context)};
+    EXPECT_EQ(gNumOfHeapAllocations, kNumOfHeapAllocations);
+}
+
+TEST(PlayerTaskPoolTest, shouldNotAllocateInSteadyState)
+{
+    constexpr int kTasksPerBurst{50};
+    constexpr int kNumOfBursts{100};
+    std::atomic<int> counter{0};
+    PlayerContext context;
+    StrictMock<GstPlayerPrivateMock> gstPlayer;
+    StrictMock<GstPlayerClientMock> gstPlayerClient;
+    PlayerTaskFactory factory{&gstPlayerClient, std::make_shared<StrictMock<GstWrapperMock>>(),
+                              std::make_shared<StrictMock<GlibWrapperMock>>()};
+    WorkerThread worker{std::make_shared<WorkerThreadPool>(2)};
+    auto runBurst = [&]()
+    {
+        const int kExpectedValue{counter + kTasksPerBurst};
+        for (int i = 0; i < kTasksPerBurst; ++i)
+        {
+            // A real task, as created for the appsrc need-data callback. Its source is not attached, so it has
+            // nothing to do when executed.
+            worker.enqueueTask(factory.createNeedData(context, gstPlayer, nullptr));
+            worker.enqueueTask(std::make_unique<CountingTask>(counter));
+        }
+        waitForCounter(counter, kExpectedValue);
+    };
+
+    // Let the pools and queues grow to their working size
+    runBurst();
+
+    const std::size_t kNumOfHeapAllocations{gNumOfHeapAllocations};
+    for (int i = 0; i < kNumOfBursts; ++i)
+    {
+        runBurst();
+    }
+    EXPECT_EQ(gNumOfHeapAllocations, kNumOfHeapAllocations);
+
+    worker.stop();
+}
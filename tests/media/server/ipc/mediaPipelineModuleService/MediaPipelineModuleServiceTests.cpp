@@ -105,6 +105,27 @@ TEST_F(MediaPipelineModuleServiceTests, shouldFailToPlay)
     sendPlayRequestAndReceiveResponse();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldReplyToPlayWhenPlaybackServiceCompletesIt)
+{
+    playbackServiceWillPlayLater();
+    sendPlayRequestAndReceiveResponse();
+    playbackServiceCompletesPlay(true);
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldFailPlayWhenPlaybackServiceCompletesItWithError)
+{
+    playbackServiceWillPlayLater();
+    sendPlayRequestAndReceiveResponse();
+    playbackServiceCompletesPlay(false);
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldFailPlayWhenPlaybackServiceDropsIt)
+{
+    playbackServiceWillPlayLater();
+    sendPlayRequestAndReceiveResponse();
+    playbackServiceDropsPlay();
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldPause)
 {
     playbackServiceWillPause();
@@ -153,6 +174,35 @@ TEST_F(MediaPipelineModuleServiceTests, shouldFailWhenHaveDataIsReceived)
     sendHaveDataRequestAndReceiveResponse();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldReturnNeedMediaDataInHaveDataResponse)
+{
+    playbackServiceWillCreateSession();
+    int sessionId = sendCreateSessionRequestAndReceiveResponse();
+    playbackServiceWillHaveDataAndRequestMoreData(sessionId);
+    sendHaveDataRequestAndReceiveNeedMediaDataInResponse(sessionId);
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldSendNeedMediaDataEventWhenHaveDataFails)
+{
+    playbackServiceWillCreateSession();
+    int sessionId = sendCreateSessionRequestAndReceiveResponse();
+    playbackServiceWillFailToHaveDataAndRequestMoreData(sessionId);
+    mediaClientWillSendNeedMediaDataEvent(sessionId);
+    sendHaveDataRequestAndReceiveNoNeedMediaDataInResponse(sessionId);
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldHaveDataMultiSource)
+{
+    playbackServiceWillHaveDataMultiSource();
+    sendHaveDataMultiSourceRequestAndReceiveResponse();
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldFailWhenHaveDataMultiSourceFailsForOneSource)
+{
+    playbackServiceWillFailToHaveDataMultiSource();
+    sendHaveDataMultiSourceRequestAndReceiveResponse();
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldSetPlaybackRate)
 {
     playbackServiceWillSetPlaybackRate();
@@ -28,6 +28,7 @@
 using testing::_;
 using testing::DoAll;
 using testing::Invoke;
+using testing::InvokeArgument;
 using testing::Return;
 using testing::SaveArg;
 using testing::SetArgReferee;
@@ -369,25 +370,30 @@ void MediaPipelineModuleServiceTests::playbackServiceWillFailToAttachSource()
 void MediaPipelineModuleServiceTests::playbackServiceWillPlay()
 {
     expectRequestSuccess();
-    EXPECT_CALL(m_playbackServiceMock, play(hardcodedSessionId)).WillOnce(Return(true));
+    EXPECT_CALL(m_playbackServiceMock, play(hardcodedSessionId, _)).WillOnce(InvokeArgument<1>(true));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillFailToPlay()
 {
     expectRequestFailure();
-    EXPECT_CALL(m_playbackServiceMock, play(hardcodedSessionId)).WillOnce(Return(false));
+    EXPECT_CALL(m_playbackServiceMock, play(hardcodedSessionId, _)).WillOnce(InvokeArgument<1>(false));
+}
+
+void MediaPipelineModuleServiceTests::playbackServiceWillPlayLater()
+{
+    EXPECT_CALL(m_playbackServiceMock, play(hardcodedSessionId, _)).WillOnce(SaveArg<1>(&m_playbackResultCallback));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillPause()
 {
     expectRequestSuccess();
-    EXPECT_CALL(m_playbackServiceMock, pause(hardcodedSessionId)).WillOnce(Return(true));
+    EXPECT_CALL(m_playbackServiceMock, pause(hardcodedSessionId, _)).WillOnce(InvokeArgument<1>(true));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillFailToPause()
 {
     expectRequestFailure();
-    EXPECT_CALL(m_playbackServiceMock, pause(hardcodedSessionId)).WillOnce(Return(false));
+    EXPECT_CALL(m_playbackServiceMock, pause(hardcodedSessionId, _)).WillOnce(InvokeArgument<1>(false));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillStop()
@@ -405,13 +411,13 @@ void MediaPipelineModuleServiceTests::playbackServiceWillFailToStop()
 void MediaPipelineModuleServiceTests::playbackServiceWillSetPosition()
 {
     expectRequestSuccess();
-    EXPECT_CALL(m_playbackServiceMock, setPosition(hardcodedSessionId, position)).WillOnce(Return(true));
+    EXPECT_CALL(m_playbackServiceMock, setPosition(hardcodedSessionId, position, _)).WillOnce(InvokeArgument<2>(true));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillFailToSetPosition()
 {
     expectRequestFailure();
-    EXPECT_CALL(m_playbackServiceMock, setPosition(hardcodedSessionId, position)).WillOnce(Return(false));
+    EXPECT_CALL(m_playbackServiceMock, setPosition(hardcodedSessionId, position, _)).WillOnce(InvokeArgument<2>(false));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillSetVideoWindow()
@@ -429,15 +435,73 @@ void MediaPipelineModuleServiceTests::playbackServiceWillFailToSetVideoWindow()
 void MediaPipelineModuleServiceTests::playbackServiceWillHaveData()
 {
     expectRequestSuccess();
-    EXPECT_CALL(m_playbackServiceMock, haveData(hardcodedSessionId, mediaSourceStatus, numFrames, requestId))
-        .WillOnce(Return(true));
+    EXPECT_CALL(m_playbackServiceMock, haveData(hardcodedSessionId, mediaSourceStatus, numFrames, requestId, _))
+        .WillOnce(InvokeArgument<4>(true));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillFailToHaveData()
 {
     expectRequestFailure();
-    EXPECT_CALL(m_playbackServiceMock, haveData(hardcodedSessionId, mediaSourceStatus, numFrames, requestId))
-        .WillOnce(Return(false));
+    EXPECT_CALL(m_playbackServiceMock, haveData(hardcodedSessionId, mediaSourceStatus, numFrames, requestId, _))
+        .WillOnce(InvokeArgument<4>(false));
+}
+
+void MediaPipelineModuleServiceTests::playbackServiceWillHaveDataAndRequestMoreData(int sessionId)
+{
+    expectRequestSuccess();
+    EXPECT_CALL(m_playbackServiceMock, haveData(sessionId, mediaSourceStatus, numFrames, requestId, _))
+        .WillOnce(Invoke(
+            [&](int, firebolt::rialto::MediaSourceStatus, std::uint32_t, std::uint32_t,
+                const firebolt::rialto::server::service::IPlaybackService::ResultCallback &callback)
+            {
+                m_mediaPipelineClient->notifyNeedMediaData(sourceId, frameCount, needDataRequestId,
+                                                           std::make_shared<firebolt::rialto::ShmInfo>(shmInfo));
+                callback(true);
+            }));
+}
+
+void MediaPipelineModuleServiceTests::playbackServiceWillFailToHaveDataAndRequestMoreData(int sessionId)
+{
+    expectRequestFailure();
+    EXPECT_CALL(m_playbackServiceMock, haveData(sessionId, mediaSourceStatus, numFrames, requestId, _))
+        .WillOnce(Invoke(
+            [&](int, firebolt::rialto::MediaSourceStatus, std::uint32_t, std::uint32_t,
+                const firebolt::rialto::server::service::IPlaybackService::ResultCallback &callback)
+            {
+                m_mediaPipelineClient->notifyNeedMediaData(sourceId, frameCount, needDataRequestId,
+                                                           std::make_shared<firebolt::rialto::ShmInfo>(shmInfo));
+                callback(false);
+            }));
+}
+
+void MediaPipelineModuleServiceTests::playbackServiceWillHaveDataMultiSource()
+{
+    expectRequestSuccess();
+    playbackServiceWillHaveDataOfBothSources(true);
+}
+
+void MediaPipelineModuleServiceTests::playbackServiceWillFailToHaveDataMultiSource()
+{
+    expectRequestFailure();
+    playbackServiceWillHaveDataOfBothSources(false);
+}
+
+void MediaPipelineModuleServiceTests::playbackServiceWillHaveDataOfBothSources(bool result)
+{
+    EXPECT_CALL(m_playbackServiceMock, haveData(hardcodedSessionId, _, _))
+        .WillOnce(Invoke(
+            [result](int, const std::vector<firebolt::rialto::server::HaveDataShmInfo> &sources,
+                     const firebolt::rialto::server::service::IPlaybackService::ResultCallback &callback)
+            {
+                ASSERT_EQ(sources.size(), 2U);
+                for (std::uint32_t i = 0; i < sources.size(); ++i)
+                {
+                    EXPECT_EQ(sources[i].status, mediaSourceStatus);
+                    EXPECT_EQ(sources[i].numFrames, numFrames);
+                    EXPECT_EQ(sources[i].needDataRequestId, requestId + i);
+                }
+                callback(result);
+            }));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillSetPlaybackRate()
@@ -455,19 +519,13 @@ void MediaPipelineModuleServiceTests::playbackServiceWillFailToSetPlaybackRate()
 void MediaPipelineModuleServiceTests::playbackServiceWillGetPosition()
 {
     expectRequestSuccess();
-    EXPECT_CALL(m_playbackServiceMock, getPosition(hardcodedSessionId, _))
-        .WillOnce(Invoke(
-            [&](int, std::int64_t &pos)
-            {
-                pos = position;
-                return true;
-            }));
+    EXPECT_CALL(m_playbackServiceMock, getPosition(hardcodedSessionId, _)).WillOnce(InvokeArgument<1>(true, position));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillFailToGetPosition()
 {
     expectRequestFailure();
-    EXPECT_CALL(m_playbackServiceMock, getPosition(hardcodedSessionId, _)).WillOnce(Return(false));
+    EXPECT_CALL(m_playbackServiceMock, getPosition(hardcodedSessionId, _)).WillOnce(InvokeArgument<1>(false, 0));
 }
 
 void MediaPipelineModuleServiceTests::playbackServiceWillRenderFrame()
@@ -482,6 +540,26 @@ void MediaPipelineModuleServiceTests::playbackServiceWillFailToRenderFrame()
     EXPECT_CALL(m_playbackServiceMock, renderFrame(hardcodedSessionId)).WillOnce(Return(false));
 }
 
+void MediaPipelineModuleServiceTests::playbackServiceCompletesPlay(bool result)
+{
+    if (result)
+    {
+        expectRequestSuccess();
+    }
+    else
+    {
+        expectRequestFailure();
+    }
+    m_playbackResultCallback(result);
+    m_playbackResultCallback = nullptr;
+}
+
+void MediaPipelineModuleServiceTests::playbackServiceDropsPlay()
+{
+    expectRequestFailure();
+    m_playbackResultCallback = nullptr;
+}
+
 void MediaPipelineModuleServiceTests::mediaClientWillSendPlaybackStateChangedEvent()
 {
     EXPECT_CALL(*m_clientMock, sendEvent(PlaybackStateChangeEventMatcher(convertPlaybackState(playbackState))));
@@ -502,12 +580,12 @@ void MediaPipelineModuleServiceTests::mediaClientWillSendNeedMediaDataEvent(int
 
 void MediaPipelineModuleServiceTests::mediaClientWillSendPostionChangeEvent()
 {
-    EXPECT_CALL(*m_clientMock, sendEvent(PositionChangeEventMatcher(position)));
+    EXPECT_CALL(*m_clientMock, sendCoalescedEvent(PositionChangeEventMatcher(position), _));
 }
 
 void MediaPipelineModuleServiceTests::mediaClientWillSendQosEvent()
 {
-    EXPECT_CALL(*m_clientMock, sendEvent(QosEventMatcher(sourceId, qosInfo.processed, qosInfo.dropped)));
+    EXPECT_CALL(*m_clientMock, sendCoalescedEvent(QosEventMatcher(sourceId, qosInfo.processed, qosInfo.dropped), _));
 }
 
 void MediaPipelineModuleServiceTests::sendClientConnected()
@@ -676,6 +754,60 @@ void MediaPipelineModuleServiceTests::sendHaveDataRequestAndReceiveResponse()
     m_service->haveData(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
 
+void MediaPipelineModuleServiceTests::sendHaveDataRequestAndReceiveNeedMediaDataInResponse(int sessionId)
+{
+    firebolt::rialto::HaveDataRequest request;
+    firebolt::rialto::HaveDataResponse response;
+
+    request.set_session_id(sessionId);
+    request.set_status(convertHaveDataRequestMediaSourceStatus(mediaSourceStatus));
+    request.set_num_frames(numFrames);
+    request.set_request_id(requestId);
+    request.set_accept_need_media_data(true);
+
+    m_service->haveData(m_controllerMock.get(), &request, &response, m_closureMock.get());
+
+    ASSERT_EQ(response.need_media_data_size(), 1);
+    EXPECT_EQ(response.need_media_data(0).session_id(), sessionId);
+    EXPECT_EQ(response.need_media_data(0).source_id(), sourceId);
+    EXPECT_EQ(response.need_media_data(0).request_id(), needDataRequestId);
+    EXPECT_EQ(response.need_media_data(0).frame_count(), frameCount);
+    EXPECT_EQ(response.need_media_data(0).shm_info().max_media_bytes(), shmInfo.maxMediaBytes);
+}
+
+void MediaPipelineModuleServiceTests::sendHaveDataRequestAndReceiveNoNeedMediaDataInResponse(int sessionId)
+{
+    firebolt::rialto::HaveDataRequest request;
+    firebolt::rialto::HaveDataResponse response;
+
+    request.set_session_id(sessionId);
+    request.set_status(convertHaveDataRequestMediaSourceStatus(mediaSourceStatus));
+    request.set_num_frames(numFrames);
+    request.set_request_id(requestId);
+    request.set_accept_need_media_data(true);
+
+    m_service->haveData(m_controllerMock.get(), &request, &response, m_closureMock.get());
+
+    EXPECT_EQ(response.need_media_data_size(), 0);
+}
+
+void MediaPipelineModuleServiceTests::sendHaveDataMultiSourceRequestAndReceiveResponse()
+{
+    firebolt::rialto::HaveDataMultiSourceRequest request;
+    firebolt::rialto::HaveDataMultiSourceResponse response;
+
+    request.set_session_id(hardcodedSessionId);
+    for (std::uint32_t id : {requestId, requestId + 1})
+    {
+        auto source = request.add_sources();
+        source->set_status(convertHaveDataRequestMediaSourceStatus(mediaSourceStatus));
+        source->set_num_frames(numFrames);
+        source->set_request_id(id);
+    }
+
+    m_service->haveDataMultiSource(m_controllerMock.get(), &request, &response, m_closureMock.get());
+}
+
 void MediaPipelineModuleServiceTests::sendSetPlaybackRateRequestAndReceiveResponse()
 {
     firebolt::rialto::SetPlaybackRateRequest request;
@@ -50,6 +50,7 @@ public:
     void playbackServiceWillFailToAttachSource();
     void playbackServiceWillPlay();
     void playbackServiceWillFailToPlay();
+    void playbackServiceWillPlayLater();
     void playbackServiceWillPause();
     void playbackServiceWillFailToPause();
     void playbackServiceWillStop();
@@ -60,12 +61,19 @@ public:
     void playbackServiceWillFailToSetVideoWindow();
     void playbackServiceWillHaveData();
     void playbackServiceWillFailToHaveData();
+    void playbackServiceWillHaveDataAndRequestMoreData(int sessionId);
+    void playbackServiceWillFailToHaveDataAndRequestMoreData(int sessionId);
+    void playbackServiceWillHaveDataMultiSource();
+    void playbackServiceWillFailToHaveDataMultiSource();
+    void playbackServiceWillHaveDataOfBothSources(bool result);
     void playbackServiceWillSetPlaybackRate();
     void playbackServiceWillFailToSetPlaybackRate();
     void playbackServiceWillGetPosition();
     void playbackServiceWillFailToGetPosition();
     void playbackServiceWillRenderFrame();
     void playbackServiceWillFailToRenderFrame();
+    void playbackServiceCompletesPlay(bool result);
+    void playbackServiceDropsPlay();
     void mediaClientWillSendPlaybackStateChangedEvent();
     void mediaClientWillSendNetworkStateChangedEvent();
     void mediaClientWillSendNeedMediaDataEvent(int sessionId);
@@ -87,6 +95,9 @@ public:
     void sendGetPositionRequestAndReceiveResponse();
     void sendGetPositionRequestAndReceiveResponseWithoutPositionMatch();
     void sendHaveDataRequestAndReceiveResponse();
+    void sendHaveDataRequestAndReceiveNeedMediaDataInResponse(int sessionId);
+    void sendHaveDataRequestAndReceiveNoNeedMediaDataInResponse(int sessionId);
+    void sendHaveDataMultiSourceRequestAndReceiveResponse();
     void sendSetPlaybackRateRequestAndReceiveResponse();
     void sendSetVideoWindowRequestAndReceiveResponse();
     void sendPlaybackStateChangedEvent();
@@ -103,6 +114,7 @@ private:
     std::shared_ptr<StrictMock<firebolt::rialto::ipc::ControllerMock>> m_controllerMock;
     StrictMock<firebolt::rialto::server::service::PlaybackServiceMock> m_playbackServiceMock;
     std::shared_ptr<firebolt::rialto::IMediaPipelineClient> m_mediaPipelineClient;
+    firebolt::rialto::server::service::IPlaybackService::ResultCallback m_playbackResultCallback;
     std::shared_ptr<firebolt::rialto::server::ipc::IMediaPipelineModuleService> m_service;
 
     void expectRequestSuccess();
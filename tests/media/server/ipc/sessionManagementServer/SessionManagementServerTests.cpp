@@ -41,6 +41,14 @@ TEST_F(SessionManagementServerTests, shouldStartServer)
     sendServerStart();
 }
 
+TEST_F(SessionManagementServerTests, shouldStopServerWaitingForEvents)
+{
+    serverWillStartAndWaitForEvents();
+    sendServerStart();
+    serverWillStop();
+    sendServerStop();
+}
+
 TEST_F(SessionManagementServerTests, shouldEstablishConnection)
 {
     serverWillInitialize();
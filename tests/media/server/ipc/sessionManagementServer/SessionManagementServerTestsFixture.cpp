@@ -32,6 +32,7 @@
 #include <vector>
 
 using testing::_;
+using testing::AtMost;
 using testing::Invoke;
 using testing::Return;
 using testing::SetArgReferee;
@@ -123,6 +124,27 @@ void SessionManagementServerTests::serverWillFailToInitialize()
 void SessionManagementServerTests::serverWillStart()
 {
     EXPECT_CALL(*m_serverMock, process()).WillOnce(Return(false));
+    // The event loop has already finished, but the server is still marked as running until stopped
+    EXPECT_CALL(*m_serverMock, wakeEventLoop());
+}
+
+void SessionManagementServerTests::serverWillStartAndWaitForEvents()
+{
+    std::shared_future<void> wakeUpFuture{m_wakeUpPromise.get_future()};
+    EXPECT_CALL(*m_serverMock, process()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_serverMock, wait(-1))
+        .Times(AtMost(1))
+        .WillRepeatedly(Invoke(
+            [wakeUpFuture](int)
+            {
+                wakeUpFuture.wait();
+                return true;
+            }));
+}
+
+void SessionManagementServerTests::serverWillStop()
+{
+    EXPECT_CALL(*m_serverMock, wakeEventLoop()).WillOnce(Invoke([this]() { m_wakeUpPromise.set_value(); }));
 }
 
 void SessionManagementServerTests::clientWillConnect()
@@ -174,6 +196,11 @@ void SessionManagementServerTests::sendServerStart()
     m_sut->start();
 }
 
+void SessionManagementServerTests::sendServerStop()
+{
+    m_sut->stop();
+}
+
 void SessionManagementServerTests::sendConnectClient()
 {
     m_clientConnectedCb(m_clientMock);
@@ -30,6 +30,7 @@
 #include "MediaPipelineModuleServiceMock.h"
 #include "PlaybackServiceMock.h"
 #include "RialtoControlModuleServiceMock.h"
+#include <future>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -44,6 +45,8 @@ public:
     void serverWillInitialize();
     void serverWillFailToInitialize();
     void serverWillStart();
+    void serverWillStartAndWaitForEvents();
+    void serverWillStop();
     void clientWillConnect();
     void clientWillDisconnect();
     void serverWillSetLogLevels();
@@ -51,6 +54,7 @@ public:
     void sendServerInitialize();
     void sendServerInitializeAndExpectFailure();
     void sendServerStart();
+    void sendServerStop();
     void sendConnectClient();
     void sendDisconnectClient();
     void sendSetLogLevels();
@@ -71,6 +75,7 @@ private:
 
     std::function<void(const std::shared_ptr<firebolt::rialto::ipc::IClient> &)> m_clientConnectedCb;
     std::function<void(const std::shared_ptr<firebolt::rialto::ipc::IClient> &)> m_clientDisconnectedCb;
+    std::promise<void> m_wakeUpPromise;
 };
 
 #endif // SESSION_MANAGEMENT_SERVER_TESTS_FIXTURE_H_
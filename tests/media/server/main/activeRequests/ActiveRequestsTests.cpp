@@ -45,7 +45,7 @@ TEST_F(ActiveRequestsTests, addSegmentShouldReturnErrorForInvalidData)
 {
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegment>();
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(m_sut.addSegment(0, segment), firebolt::rialto::AddSegmentStatus::ERROR);
 }
 
@@ -60,7 +60,7 @@ TEST_F(ActiveRequestsTests, addSegmentShouldReturnErrorForInvalidId)
 
 TEST_F(ActiveRequestsTests, addSegmentsOverLimitShouldReturnNoSpace)
 {
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, 5));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, 5, 0));
     std::vector<uint8_t> data{'T', 'E', 'S', 'T'};
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegment>();
@@ -76,23 +76,36 @@ TEST_F(ActiveRequestsTests, addSegmentsOverLimitShouldReturnNoSpace)
 TEST_F(ActiveRequestsTests, shouldGenerateGetAndEraseIds)
 {
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::AUDIO, m_sut.getType(0));
     m_sut.erase(0);
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
 
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(1));
-    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::VIDEO, m_sut.getType(1));
     m_sut.erase(1);
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(1));
 }
 
+TEST_F(ActiveRequestsTests, getShmSlotShouldThrowForInvalidId)
+{
+    EXPECT_THROW(m_sut.getShmSlot(123), std::runtime_error);
+}
+
+TEST_F(ActiveRequestsTests, shouldGetShmSlot)
+{
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 1));
+    EXPECT_EQ(1, m_sut.getShmSlot(0));
+    m_sut.erase(0);
+    EXPECT_THROW(m_sut.getShmSlot(0), std::runtime_error);
+}
+
 TEST_F(ActiveRequestsTests, shouldClearIds)
 {
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(0));
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
-    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
+    EXPECT_EQ(1, m_sut.insert(firebolt::rialto::MediaSourceType::VIDEO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::AUDIO, m_sut.getType(0));
     EXPECT_EQ(firebolt::rialto::MediaSourceType::VIDEO, m_sut.getType(1));
     m_sut.clear();
@@ -106,7 +119,7 @@ TEST_F(ActiveRequestsTests, shouldAddAndGetSegments)
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegmentAudio>();
     segment->setData(data.size(), data.data());
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(m_sut.addSegment(0, segment), firebolt::rialto::AddSegmentStatus::OK);
     const firebolt::rialto::IMediaPipeline::MediaSegmentVector &segments = m_sut.getSegments(0);
     ASSERT_EQ(1, segments.size());
@@ -119,7 +132,7 @@ TEST_F(ActiveRequestsTests, shouldAddAndRemoveSegments)
     std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment =
         std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegment>();
     segment->setData(data.size(), data.data());
-    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max()));
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, std::numeric_limits<std::uint32_t>::max(), 0));
     EXPECT_EQ(m_sut.addSegment(0, segment), firebolt::rialto::AddSegmentStatus::OK);
     m_sut.clear();
     EXPECT_THROW(m_sut.getSegments(0), std::runtime_error);
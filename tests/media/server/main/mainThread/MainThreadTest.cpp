@@ -18,8 +18,11 @@
  */
 
 #include "MainThread.h"
+#include <chrono>
+#include <future>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace firebolt::rialto::server;
 
@@ -134,3 +137,125 @@ TEST_F(MainThreadTests, IgnoreUnregisteredClients)
 
     unregisterClient(clientId2);
 }
+
+/**
+ * Test that a MainThread serves the clients round-robin, so a busy client cannot starve the others.
+ */
+TEST_F(MainThreadTests, ClientsAreServedRoundRobin)
+{
+    m_mainThread = std::make_shared<MainThread>();
+
+    uint32_t clientId1 = m_mainThread->registerClient();
+    uint32_t clientId2 = m_mainThread->registerClient();
+    uint32_t clientId3 = m_mainThread->registerClient();
+
+    // Block the main thread until all the tasks are queued
+    std::promise<void> unblockPromise;
+    std::shared_future<void> unblockFuture{unblockPromise.get_future()};
+    m_mainThread->enqueueTask(clientId3, [unblockFuture]() { unblockFuture.wait(); });
+
+    InSequence s;
+
+    std::shared_ptr<DummyMock> dummyMock1 = std::make_shared<DummyMock>();
+    std::shared_ptr<DummyMock> dummyMock2 = std::make_shared<DummyMock>();
+    EXPECT_CALL(*dummyMock1, mockMethod());
+    EXPECT_CALL(*dummyMock2, mockMethod());
+    EXPECT_CALL(*dummyMock1, mockMethod());
+    EXPECT_CALL(*dummyMock2, mockMethod());
+    EXPECT_CALL(*dummyMock1, mockMethod());
+
+    enqueueTaskOnDummyMock(clientId1, dummyMock1);
+    enqueueTaskOnDummyMock(clientId1, dummyMock1);
+    enqueueTaskOnDummyMock(clientId1, dummyMock1);
+    enqueueTaskOnDummyMock(clientId2, dummyMock2);
+    enqueueTaskOnDummyMock(clientId2, dummyMock2);
+    unblockPromise.set_value();
+
+    // Wait for the queued tasks of both clients
+    m_mainThread->enqueueTaskAndWait(clientId1, []() {});
+
+    unregisterClient(clientId1);
+    unregisterClient(clientId2);
+    unregisterClient(clientId3);
+}
+
+/**
+ * Test that a MainThread handles more queued tasks than the preallocated task slots.
+ */
+TEST_F(MainThreadTests, ManyQueuedTasks)
+{
+    constexpr int kNumTasks{100};
+    m_mainThread = std::make_shared<MainThread>();
+
+    uint32_t clientId = m_mainThread->registerClient();
+
+    std::shared_ptr<DummyMock> dummyMock = std::make_shared<DummyMock>();
+    EXPECT_CALL(*dummyMock, mockMethod()).Times(kNumTasks + 1);
+
+    for (int i = 0; i < kNumTasks; ++i)
+    {
+        enqueueTaskOnDummyMock(clientId, dummyMock);
+    }
+    enqueueTaskAndWaitOnDummyMock(clientId, dummyMock);
+
+    unregisterClient(clientId);
+}
+
+/**
+ * Test that a MainThread executes all the queued tasks before it is destroyed.
+ */
+TEST_F(MainThreadTests, QueuedTasksAreExecutedOnDestruction)
+{
+    constexpr int kNumTasks{5};
+    m_mainThread = std::make_shared<MainThread>();
+
+    uint32_t clientId = m_mainThread->registerClient();
+
+    // Block the main thread until the destruction starts
+    std::promise<void> unblockPromise;
+    std::shared_future<void> unblockFuture{unblockPromise.get_future()};
+    m_mainThread->enqueueTask(clientId, [unblockFuture]() { unblockFuture.wait(); });
+
+    std::shared_ptr<DummyMock> dummyMock = std::make_shared<DummyMock>();
+    EXPECT_CALL(*dummyMock, mockMethod()).Times(kNumTasks);
+    for (int i = 0; i < kNumTasks; ++i)
+    {
+        enqueueTaskOnDummyMock(clientId, dummyMock);
+    }
+
+    std::thread unblockThread{[&unblockPromise]()
+                              {
+                                  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                                  unblockPromise.set_value();
+                              }};
+    m_mainThread.reset();
+    unblockThread.join();
+}
+
+/**
+ * Test that unregistering a client releases the callers waiting for its queued tasks.
+ */
+TEST_F(MainThreadTests, UnregisterClientReleasesWaitingCallers)
+{
+    m_mainThread = std::make_shared<MainThread>();
+
+    uint32_t clientId1 = m_mainThread->registerClient();
+    uint32_t clientId2 = m_mainThread->registerClient();
+
+    // Block the main thread, so that the task of the first client stays queued
+    std::promise<void> unblockPromise;
+    std::shared_future<void> unblockFuture{unblockPromise.get_future()};
+    m_mainThread->enqueueTask(clientId2, [unblockFuture]() { unblockFuture.wait(); });
+
+    std::shared_ptr<DummyMock> dummyMock = std::make_shared<DummyMock>();
+    EXPECT_CALL(*dummyMock, mockMethod()).Times(0);
+    std::future<void> waitingCaller{
+        std::async(std::launch::async, [&]() { enqueueTaskAndWaitOnDummyMock(clientId1, dummyMock); })};
+
+    // Tasks of the main thread client are handled first
+    m_mainThread->enqueueTask(m_mainThreadClientId, [this, clientId1]() { m_mainThread->unregisterClient(clientId1); });
+    unblockPromise.set_value();
+
+    EXPECT_EQ(waitingCaller.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    unregisterClient(clientId2);
+}
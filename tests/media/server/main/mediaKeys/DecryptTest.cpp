@@ -18,6 +18,9 @@
  */
 
 #include "MediaKeysTestBase.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 class RialtoServerMediaKeysDecryptTest : public MediaKeysTestBase
 {
@@ -42,7 +45,6 @@ protected:
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, Success)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock,
                 decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
         .WillOnce(Return(MediaKeyErrorStatus::OK));
@@ -56,7 +58,6 @@ TEST_F(RialtoServerMediaKeysDecryptTest, Success)
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, SessionDoesNotExistFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_EQ(MediaKeyErrorStatus::BAD_SESSION_ID,
               m_mediaKeys->decrypt(m_kKeySessionId + 1, &m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId,
                                    m_initWithLast15));
@@ -67,7 +68,6 @@ TEST_F(RialtoServerMediaKeysDecryptTest, SessionDoesNotExistFailure)
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, DecryptFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock,
                 decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
         .WillOnce(Return(MediaKeyErrorStatus::INVALID_STATE));
@@ -76,3 +76,49 @@ TEST_F(RialtoServerMediaKeysDecryptTest, DecryptFailure)
               m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId,
                                    m_initWithLast15));
 }
+
+/**
+ * Test that closing the key session waits for the decryption in progress, so that the session is not destroyed on
+ * the decrypting thread.
+ */
+TEST_F(RialtoServerMediaKeysDecryptTest, SessionClosedDuringDecryption)
+{
+    std::thread closeThread;
+    std::atomic<bool> isClosed{false};
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_mediaKeySessionMock, closeKeySession()).WillOnce(Return(MediaKeyErrorStatus::OK));
+    EXPECT_CALL(*m_mediaKeySessionMock,
+                decrypt(&m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15))
+        .WillOnce(Invoke(
+            [&](GstBuffer *, GstBuffer *, const uint32_t, GstBuffer *, GstBuffer *, uint32_t)
+            {
+                closeThread = std::thread(
+                    [&]()
+                    {
+                        EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
+                        isClosed = true;
+                    });
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                EXPECT_FALSE(isClosed);
+                return MediaKeyErrorStatus::OK;
+            }));
+
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample,
+                                                            m_subSampleCount, &m_IV, &m_keyId, m_initWithLast15));
+    closeThread.join();
+    EXPECT_TRUE(isClosed);
+}
+
+/**
+ * Test that Decrypt fails after the key session has been closed.
+ */
+TEST_F(RialtoServerMediaKeysDecryptTest, ClosedSessionFailure)
+{
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_mediaKeySessionMock, closeKeySession()).WillOnce(Return(MediaKeyErrorStatus::OK));
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->closeKeySession(m_kKeySessionId));
+
+    EXPECT_EQ(MediaKeyErrorStatus::BAD_SESSION_ID,
+              m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_subSample, m_subSampleCount, &m_IV, &m_keyId,
+                                   m_initWithLast15));
+}
@@ -35,7 +35,6 @@ protected:
  */
 TEST_F(RialtoServerMediaKeysIsNetflixKeySystemTest, ReturnTrue)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock, isNetflixKeySystem()).WillOnce(Return(true));
 
     EXPECT_TRUE(m_mediaKeys->isNetflixKeySystem(m_kKeySessionId));
@@ -46,7 +45,6 @@ TEST_F(RialtoServerMediaKeysIsNetflixKeySystemTest, ReturnTrue)
  */
 TEST_F(RialtoServerMediaKeysIsNetflixKeySystemTest, ReturnFalseWhenSessionDoesNotExist)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_FALSE(m_mediaKeys->isNetflixKeySystem(m_kKeySessionId + 1));
 }
 
@@ -55,7 +53,6 @@ TEST_F(RialtoServerMediaKeysIsNetflixKeySystemTest, ReturnFalseWhenSessionDoesNo
  */
 TEST_F(RialtoServerMediaKeysIsNetflixKeySystemTest, ReturnFalse)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock, isNetflixKeySystem()).WillOnce(Return(false));
 
     EXPECT_FALSE(m_mediaKeys->isNetflixKeySystem(m_kKeySessionId));
@@ -37,7 +37,6 @@ protected:
  */
 TEST_F(RialtoServerMediaKeysSelectKeyIdTest, Success)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock, selectKeyId(m_kKeyId)).WillOnce(Return(MediaKeyErrorStatus::OK));
 
     EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->selectKeyId(m_kKeySessionId, m_kKeyId));
@@ -48,7 +47,6 @@ TEST_F(RialtoServerMediaKeysSelectKeyIdTest, Success)
  */
 TEST_F(RialtoServerMediaKeysSelectKeyIdTest, SessionDoesNotExistFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_EQ(MediaKeyErrorStatus::BAD_SESSION_ID, m_mediaKeys->selectKeyId(m_kKeySessionId + 1, m_kKeyId));
 }
 
@@ -57,7 +55,6 @@ TEST_F(RialtoServerMediaKeysSelectKeyIdTest, SessionDoesNotExistFailure)
  */
 TEST_F(RialtoServerMediaKeysSelectKeyIdTest, SelectKeyIdFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock, selectKeyId(m_kKeyId)).WillOnce(Return(MediaKeyErrorStatus::INVALID_STATE));
 
     EXPECT_EQ(MediaKeyErrorStatus::INVALID_STATE, m_mediaKeys->selectKeyId(m_kKeySessionId, m_kKeyId));
@@ -106,16 +106,50 @@ TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaData)
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_sharedMemoryBufferMock);
     ASSERT_TRUE(m_activeRequestsMock);
-    EXPECT_CALL(*m_sharedMemoryBufferMock, clearData(m_kSessionId, mediaSourceType)).WillOnce(Return(true));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxDataLen(m_kSessionId, mediaSourceType)).WillOnce(Return(7 * 1024 * 1024));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, mediaSourceType)).WillOnce(Return(0));
-    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, mediaSourceType))
+        .WillOnce(Return(7 * 1024 * 1024 / 2));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, mediaSourceType, 0)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, 0)).WillOnce(Return(0));
     EXPECT_CALL(*m_mediaPipelineClientMock,
                 notifyNeedMediaData(sourceId, numFrames, 0, _)); // params tested in NeedMediaDataTests
 
     m_gstPlayerCallback->notifyNeedMediaData(mediaSourceType);
 }
 
+/**
+ * Test a notification of the need media data is not forwarded when all shared memory slots are in use.
+ */
+TEST_F(RialtoServerMediaPipelineCallbackTest, notifyNeedMediaDataFailsWhenAllShmSlotsAreInUse)
+{
+    auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    int sourceId{static_cast<int>(firebolt::rialto::MediaSourceType::VIDEO)};
+    int numFrames{24};
+    ASSERT_TRUE(m_sharedMemoryBufferMock);
+    ASSERT_TRUE(m_activeRequestsMock);
+    for (std::uint32_t slot = 0; slot < firebolt::rialto::server::kShmSlotsPerSource; ++slot)
+    {
+        mainThreadWillEnqueueTaskAndWait();
+        EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, mediaSourceType, slot))
+            .WillOnce(Return(slot * 7 * 1024 * 1024 / 2));
+    }
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, mediaSourceType))
+        .Times(firebolt::rialto::server::kShmSlotsPerSource)
+        .WillRepeatedly(Return(7 * 1024 * 1024 / 2));
+    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, _))
+        .Times(firebolt::rialto::server::kShmSlotsPerSource)
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyNeedMediaData(sourceId, numFrames, 0, _))
+        .Times(firebolt::rialto::server::kShmSlotsPerSource);
+
+    for (std::uint32_t slot = 0; slot < firebolt::rialto::server::kShmSlotsPerSource; ++slot)
+    {
+        EXPECT_TRUE(m_gstPlayerCallback->notifyNeedMediaData(mediaSourceType));
+    }
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_FALSE(m_gstPlayerCallback->notifyNeedMediaData(mediaSourceType));
+}
+
 /**
  * Test a notification of qos is forwarded to the registered client.
  */
@@ -29,6 +29,7 @@ class RialtoServerMediaPipelineHaveDataTest : public MediaPipelineTestBase
 {
 protected:
     const uint32_t m_kNumFrames{24};
+    const uint32_t m_kSlotDataLen{4096};
     const uint32_t m_kNeedDataRequestId{0};
 
     RialtoServerMediaPipelineHaveDataTest() { createMediaPipeline(); }
@@ -63,13 +64,14 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataSuccessWithNeedMedia
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     ASSERT_TRUE(m_sharedMemoryBufferMock);
     ASSERT_TRUE(m_activeRequestsMock);
-    EXPECT_CALL(*m_sharedMemoryBufferMock, clearData(m_kSessionId, mediaSourceType)).WillOnce(Return(true));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxDataLen(m_kSessionId, mediaSourceType)).WillOnce(Return(7 * 1024 * 1024));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, mediaSourceType)).WillOnce(Return(0));
-    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, mediaSourceType))
+        .WillOnce(Return(7 * 1024 * 1024 / 2));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, mediaSourceType, 0)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, 0)).WillOnce(Return(0));
     EXPECT_CALL(*m_mediaPipelineClientMock,
                 notifyNeedMediaData(sourceId, m_kNumFrames, 0, _)); // params tested in NeedMediaDataTests
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNeedDataRequestId));
@@ -84,6 +86,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataGettingSamplesThrows
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, getSegments(m_kNeedDataRequestId))
         .WillOnce(Throw(std::runtime_error("runtime_error")));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
@@ -99,6 +102,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataSuccess)
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, getSegments(m_kNeedDataRequestId)).WillOnce(ReturnRef(dataVec));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(A<const IMediaPipeline::MediaSegmentVector &>()));
@@ -114,6 +118,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataSuccessEos)
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, getSegments(m_kNeedDataRequestId)).WillOnce(ReturnRef(dataVec));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(A<const IMediaPipeline::MediaSegmentVector &>()));
@@ -121,6 +126,36 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataSuccessEos)
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNeedDataRequestId));
 }
 
+TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataMultiSourceSuccess)
+{
+    const uint32_t kAudioNeedDataRequestId{m_kNeedDataRequestId + 1};
+    IMediaPipeline::MediaSegmentVector dataVec;
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    mainThreadWillEnqueueTaskAndWait();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getType(kAudioNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(kAudioNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, getSegments(m_kNeedDataRequestId)).WillOnce(ReturnRef(dataVec));
+    EXPECT_CALL(*m_activeRequestsMock, getSegments(kAudioNeedDataRequestId)).WillOnce(ReturnRef(dataVec));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_activeRequestsMock, erase(kAudioNeedDataRequestId));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(A<const IMediaPipeline::MediaSegmentVector &>())).Times(2);
+    EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_TRUE(m_mediaPipeline->haveData({{firebolt::rialto::MediaSourceStatus::OK, m_kNeedDataRequestId},
+                                           {firebolt::rialto::MediaSourceStatus::EOS, kAudioNeedDataRequestId}}));
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataMultiSourceFailureDueToUninitializedPlayer)
+{
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_FALSE(m_mediaPipeline->haveData({{firebolt::rialto::MediaSourceStatus::OK, m_kNeedDataRequestId}}));
+}
+
 TEST_F(RialtoServerMediaPipelineHaveDataTest, AddSegmentReturnsError)
 {
     std::unique_ptr<IMediaPipeline::MediaSegment> segment = std::make_unique<IMediaPipeline::MediaSegment>();
@@ -178,13 +213,14 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithN
     mainThreadWillEnqueueTaskAndWait();
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     ASSERT_TRUE(m_sharedMemoryBufferMock);
     ASSERT_TRUE(m_activeRequestsMock);
-    EXPECT_CALL(*m_sharedMemoryBufferMock, clearData(m_kSessionId, mediaSourceType)).WillOnce(Return(true));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxDataLen(m_kSessionId, mediaSourceType)).WillOnce(Return(7 * 1024 * 1024));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, mediaSourceType)).WillOnce(Return(0));
-    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, mediaSourceType))
+        .WillOnce(Return(7 * 1024 * 1024 / 2));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, mediaSourceType, 0)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, insert(mediaSourceType, _, 0)).WillOnce(Return(0));
     EXPECT_CALL(*m_mediaPipelineClientMock,
                 notifyNeedMediaData(sourceId, m_kNumFrames, 0, _)); // params tested in NeedMediaDataTests
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -199,6 +235,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFailureDueTo
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(nullptr));
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
@@ -215,9 +252,10 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFailureDueTo
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Throw(std::runtime_error("runtime_error")));
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
     EXPECT_FALSE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -235,12 +273,15 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFailureDueTo
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kSlotDataLen, m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
     EXPECT_FALSE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -257,12 +298,15 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccess)
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kSlotDataLen, m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -279,12 +323,15 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataAudioSuccess
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::AUDIO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::AUDIO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, firebolt::rialto::MediaSourceType::AUDIO))
+        .WillOnce(Return(m_kSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::AUDIO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::AUDIO, &data, offset, m_kSlotDataLen, m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -301,12 +348,15 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithE
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kSlotDataLen));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kSlotDataLen, m_kNumFrames))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
     EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::VIDEO));
@@ -324,10 +374,59 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessEosWi
     ASSERT_TRUE(m_activeRequestsMock);
     EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
         .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
     EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
     EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
-    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO, 0))
         .WillOnce(Return(offset));
     EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::VIDEO));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, 0, m_kNeedDataRequestId));
 }
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataOfSeveralSourcesSuccess)
+{
+    const uint32_t kAudioNeedDataRequestId{m_kNeedDataRequestId + 1};
+    std::uint8_t data{123};
+    int offset = 0;
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    loadGstPlayer();
+    mainThreadWillEnqueueTask();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getType(kAudioNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(m_kNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, getShmSlot(kAudioNeedDataRequestId)).WillOnce(Return(0));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_activeRequestsMock, erase(kAudioNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillRepeatedly(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO, 0))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getSlotDataOffset(m_kSessionId, firebolt::rialto::MediaSourceType::AUDIO, 0))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxSlotDataLen(m_kSessionId, firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(m_kSlotDataLen));
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kSlotDataLen, m_kNumFrames))
+        .WillOnce(Return(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::AUDIO));
+
+    bool result{false};
+    m_mediaPipeline->haveDataAsync({{firebolt::rialto::MediaSourceStatus::OK, m_kNumFrames, m_kNeedDataRequestId},
+                                    {firebolt::rialto::MediaSourceStatus::EOS, 0, kAudioNeedDataRequestId}},
+                                   [&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataOfSeveralSourcesFailureDueToUninitializedPlayer)
+{
+    mainThreadWillEnqueueTask();
+
+    bool result{true};
+    m_mediaPipeline->haveDataAsync({{firebolt::rialto::MediaSourceStatus::OK, m_kNumFrames, m_kNeedDataRequestId},
+                                    {firebolt::rialto::MediaSourceStatus::OK, m_kNumFrames, m_kNeedDataRequestId + 1}},
+                                   [&](bool callResult) { result = callResult; });
+    EXPECT_FALSE(result);
+}
@@ -216,6 +216,85 @@ TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, GetPositionSuccess)
     EXPECT_EQ(targetPosition, m_kPosition);
 }
 
+/**
+ * Test that the asynchronous Play reports success from the main thread if the gstreamer player API succeeds.
+ */
+TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, PlayAsyncSuccess)
+{
+    loadGstPlayer();
+    mainThreadWillEnqueueTask();
+
+    bool result{false};
+    EXPECT_CALL(*m_gstPlayerMock, play());
+    m_mediaPipeline->playAsync([&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
+}
+
+/**
+ * Test that the asynchronous Pause reports failure if the gstreamer player is not initialized.
+ */
+TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, PauseAsyncFailureDueToUninitializedPlayer)
+{
+    mainThreadWillEnqueueTask();
+
+    bool result{true};
+    m_mediaPipeline->pauseAsync([&](bool callResult) { result = callResult; });
+    EXPECT_FALSE(result);
+}
+
+/**
+ * Test that the asynchronous SetPosition reports success if the gstreamer player API succeeds.
+ */
+TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, SetPositionAsyncSuccess)
+{
+    loadGstPlayer();
+    mainThreadWillEnqueueTask();
+
+    bool result{false};
+    EXPECT_CALL(*m_gstPlayerMock, setPosition(m_kPosition));
+    m_mediaPipeline->setPositionAsync(m_kPosition, [&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
+}
+
+/**
+ * Test that the asynchronous GetPosition reports the position if the gstreamer API succeeds.
+ */
+TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, GetPositionAsyncSuccess)
+{
+    loadGstPlayer();
+    mainThreadWillEnqueueTask();
+
+    bool result{false};
+    int64_t targetPosition{};
+    EXPECT_CALL(*m_gstPlayerMock, getPosition(_))
+        .WillOnce(Invoke(
+            [&](int64_t &pos)
+            {
+                pos = m_kPosition;
+                return true;
+            }));
+    m_mediaPipeline->getPositionAsync(
+        [&](bool callResult, int64_t position)
+        {
+            result = callResult;
+            targetPosition = position;
+        });
+    EXPECT_TRUE(result);
+    EXPECT_EQ(targetPosition, m_kPosition);
+}
+
+/**
+ * Test that a task dropped by the main thread never reports a result.
+ */
+TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, PlayAsyncNotCompletedWhenTaskIsDropped)
+{
+    EXPECT_CALL(*m_mainThreadMock, enqueueTask(m_kMainThreadClientId, _));
+
+    bool isCalled{false};
+    m_mediaPipeline->playAsync([&](bool) { isCalled = true; });
+    EXPECT_FALSE(isCalled);
+}
+
 TEST_F(RialtoServerMediaPipelineMiscellaneousFunctionsTest, RenderFrameSuccess)
 {
     loadGstPlayer();
@@ -29,6 +29,7 @@ constexpr firebolt::rialto::MediaSourceType validMediaSourceType{firebolt::rialt
 constexpr int sourceId = static_cast<int>(validMediaSourceType);
 constexpr std::uint32_t bufferLen{7 * 1024 * 1024};
 constexpr std::uint32_t metadataOffset{1024};
+constexpr std::uint32_t shmSlot{1};
 constexpr int requestId{0};
 constexpr int maxFrames{24};
 constexpr int maxMetadataBytes{2500};
@@ -56,17 +57,19 @@ NeedMediaDataTests::NeedMediaDataTests()
 
 void NeedMediaDataTests::initialize()
 {
-    EXPECT_CALL(shmBufferMock, getMaxDataLen(sessionId, validMediaSourceType)).WillOnce(Return(bufferLen));
-    EXPECT_CALL(shmBufferMock, getDataOffset(sessionId, validMediaSourceType)).WillOnce(Return(metadataOffset));
+    EXPECT_CALL(shmBufferMock, getMaxSlotDataLen(sessionId, validMediaSourceType)).WillOnce(Return(bufferLen));
+    EXPECT_CALL(shmBufferMock, getSlotDataOffset(sessionId, validMediaSourceType, shmSlot))
+        .WillOnce(Return(metadataOffset));
     m_sut = std::make_unique<firebolt::rialto::server::NeedMediaData>(m_clientMock, activeRequestsMock, shmBufferMock,
-                                                                      sessionId, validMediaSourceType);
+                                                                      sessionId, validMediaSourceType, shmSlot);
 }
 
 void NeedMediaDataTests::initializeWithWrongType()
 {
     m_sut = std::make_unique<firebolt::rialto::server::NeedMediaData>(m_clientMock, activeRequestsMock, shmBufferMock,
                                                                       sessionId,
-                                                                      firebolt::rialto::MediaSourceType::UNKNOWN);
+                                                                      firebolt::rialto::MediaSourceType::UNKNOWN,
+                                                                      shmSlot);
 }
 
 void NeedMediaDataTests::needMediaDataWillBeSent()
@@ -76,7 +79,7 @@ void NeedMediaDataTests::needMediaDataWillBeSent()
     expectedShmInfo->metadataOffset = metadataOffset;
     expectedShmInfo->mediaDataOffset = metadataOffset + maxMetadataBytes;
     ASSERT_TRUE(m_sut);
-    EXPECT_CALL(activeRequestsMock, insert(validMediaSourceType, _)).WillOnce(Return(requestId));
+    EXPECT_CALL(activeRequestsMock, insert(validMediaSourceType, _, shmSlot)).WillOnce(Return(requestId));
     EXPECT_CALL(*m_clientMock, notifyNeedMediaData(sourceId, maxFrames, requestId, expectedShmInfo));
     EXPECT_TRUE(m_sut->send());
 }
@@ -19,6 +19,12 @@
 
 #include "SharedMemoryBufferTestsFixture.h"
 
+namespace
+{
+constexpr int kAudioRegionLen{1 * 1024 * 1024 * firebolt::rialto::server::kShmSlotsPerSource};
+constexpr int kVideoRegionLen{7 * 1024 * 1024 * firebolt::rialto::server::kShmSlotsPerSource};
+} // namespace
+
 TEST_F(SharedMemoryBufferTests, shouldMapSession)
 {
     constexpr int session1{0};
@@ -98,34 +104,33 @@ TEST_F(SharedMemoryBufferTests, shouldNotReturnMaxVideoDataLenForNotMappedSessio
     shouldFailToReturnMaxVideoDataLen(session1);
 }
 
-TEST_F(SharedMemoryBufferTests, shouldClearAudioData)
+TEST_F(SharedMemoryBufferTests, shouldReturnMaxVideoSlotDataLen)
 {
     constexpr int session1{0};
     initialize();
     mapPartitionShouldSucceed(session1);
-    shouldClearAudioData(session1);
+    shouldReturnMaxVideoSlotDataLen(session1);
 }
 
-TEST_F(SharedMemoryBufferTests, shouldNotClearAudioDataForNotMappedSession)
-{
-    constexpr int session1{0};
-    initialize();
-    shouldFailToClearAudioData(session1);
-}
-
-TEST_F(SharedMemoryBufferTests, shouldClearVideoData)
+TEST_F(SharedMemoryBufferTests, shouldReturnVideoSlotDataOffsets)
 {
     constexpr int session1{0};
+    // Video region of first mapped session is split into 7MB slots
+    constexpr std::uint32_t slotLen{7 * 1024 * 1024};
     initialize();
     mapPartitionShouldSucceed(session1);
-    shouldClearVideoData(session1);
+    for (std::uint32_t slot = 0; slot < firebolt::rialto::server::kShmSlotsPerSource; ++slot)
+    {
+        shouldReturnVideoSlotDataOffset(session1, slot, slot * slotLen);
+    }
 }
 
-TEST_F(SharedMemoryBufferTests, shouldNotClearVideoDataForNotMappedSession)
+TEST_F(SharedMemoryBufferTests, shouldFailToReturnVideoSlotDataOffsetForInvalidSlot)
 {
     constexpr int session1{0};
     initialize();
-    shouldFailToClearVideoData(session1);
+    mapPartitionShouldSucceed(session1);
+    shouldFailToReturnVideoSlotDataOffset(session1, firebolt::rialto::server::kShmSlotsPerSource);
 }
 
 TEST_F(SharedMemoryBufferTests, shouldFailToReturnVideoDataOffset)
@@ -155,8 +160,8 @@ TEST_F(SharedMemoryBufferTests, shouldReturnVideoDataOffsetForOneSession)
 TEST_F(SharedMemoryBufferTests, shouldReturnAudioDataOffsetForOneSession)
 {
     constexpr int session1{0};
-    // Audio buffer for first mapped session is after video buffer - 7MB
-    constexpr std::uint32_t expectedOffset{7 * 1024 * 1024};
+    // Audio buffer for first mapped session is after video buffer
+    constexpr std::uint32_t expectedOffset{kVideoRegionLen};
     initialize();
     mapPartitionShouldSucceed(session1);
     shouldReturnAudioDataOffset(session1, expectedOffset);
@@ -166,8 +171,8 @@ TEST_F(SharedMemoryBufferTests, shouldReturnVideoDataOffsetForTwoSessions)
 {
     constexpr int maxPlaybacks{2};
     constexpr int session1{0}, session2{1};
-    // Video buffer for second mapped session is after video and audio buffer of 1st session - 7MB + 1MB = 8MB
-    constexpr std::uint32_t expectedOffset{8 * 1024 * 1024};
+    // Video buffer for second mapped session is after video and audio buffer of 1st session
+    constexpr std::uint32_t expectedOffset{kVideoRegionLen + kAudioRegionLen};
     initialize(maxPlaybacks);
     mapPartitionShouldSucceed(session1);
     mapPartitionShouldSucceed(session2);
@@ -179,8 +184,8 @@ TEST_F(SharedMemoryBufferTests, shouldReturnAudioDataOffsetForTwoSessions)
     constexpr int maxPlaybacks{2};
     constexpr int session1{0}, session2{1};
     // Video buffer for second mapped session is after video and audio buffer of 1st session
-    // and video buffer of 2nd session - 7MB + 1MB + 7MB = 15MB
-    constexpr std::uint32_t expectedOffset{15 * 1024 * 1024};
+    // and video buffer of 2nd session
+    constexpr std::uint32_t expectedOffset{kVideoRegionLen + kAudioRegionLen + kVideoRegionLen};
     initialize(maxPlaybacks);
     mapPartitionShouldSucceed(session1);
     mapPartitionShouldSucceed(session2);
@@ -218,14 +223,10 @@ TEST_F(SharedMemoryBufferTests, shouldGetDataPtr)
     EXPECT_NE(nullptr, session1Audio);
     EXPECT_NE(nullptr, session2Video);
     EXPECT_NE(nullptr, session2Audio);
-    EXPECT_EQ((session1Audio - session1Video),
-              (7 * 1024 * 1024)); // Difference between S1 audio & S1 video should be 7 MB
-    EXPECT_EQ((session2Video - session1Audio),
-              (1 * 1024 * 1024)); // Difference between S2 video & S1 audio should be 1 MB
-    EXPECT_EQ((session2Video - session1Video),
-              (8 * 1024 * 1024)); // Difference between S2 video & S1 video should be 8 MB
-    EXPECT_EQ((session2Audio - session2Video),
-              (7 * 1024 * 1024)); // Difference between S2 video & S2 audio should be 7 MB
+    EXPECT_EQ((session1Audio - session1Video), kVideoRegionLen);
+    EXPECT_EQ((session2Video - session1Audio), kAudioRegionLen);
+    EXPECT_EQ((session2Video - session1Video), kVideoRegionLen + kAudioRegionLen);
+    EXPECT_EQ((session2Audio - session2Video), kVideoRegionLen);
 }
 
 TEST_F(SharedMemoryBufferTests, shouldGetFd)
@@ -21,8 +21,10 @@
 
 namespace
 {
-constexpr std::uint32_t audioBufferLen{1 * 1024 * 1024}; // 1MB
-constexpr std::uint32_t videoBufferLen{7 * 1024 * 1024}; // 7MB
+constexpr std::uint32_t audioSlotLen{1 * 1024 * 1024}; // 1MB
+constexpr std::uint32_t videoSlotLen{7 * 1024 * 1024}; // 7MB
+constexpr std::uint32_t audioBufferLen{audioSlotLen * firebolt::rialto::server::kShmSlotsPerSource};
+constexpr std::uint32_t videoBufferLen{videoSlotLen * firebolt::rialto::server::kShmSlotsPerSource};
 } // namespace
 
 void SharedMemoryBufferTests::initialize(int maxPlaybacks)
@@ -102,28 +104,24 @@ void SharedMemoryBufferTests::shouldFailToReturnAudioDataOffset(int sessionId)
     EXPECT_THROW(m_sut->getDataOffset(sessionId, firebolt::rialto::MediaSourceType::AUDIO), std::runtime_error);
 }
 
-void SharedMemoryBufferTests::shouldClearAudioData(int sessionId)
+void SharedMemoryBufferTests::shouldReturnMaxVideoSlotDataLen(int sessionId)
 {
     ASSERT_TRUE(m_sut);
-    EXPECT_TRUE(m_sut->clearData(sessionId, firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_EQ(m_sut->getMaxSlotDataLen(sessionId, firebolt::rialto::MediaSourceType::VIDEO), videoSlotLen);
 }
 
-void SharedMemoryBufferTests::shouldFailToClearAudioData(int sessionId)
+void SharedMemoryBufferTests::shouldReturnVideoSlotDataOffset(int sessionId, std::uint32_t slot,
+                                                              std::uint32_t expectedOffset)
 {
     ASSERT_TRUE(m_sut);
-    EXPECT_FALSE(m_sut->clearData(sessionId, firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_EQ(m_sut->getSlotDataOffset(sessionId, firebolt::rialto::MediaSourceType::VIDEO, slot), expectedOffset);
 }
 
-void SharedMemoryBufferTests::shouldClearVideoData(int sessionId)
+void SharedMemoryBufferTests::shouldFailToReturnVideoSlotDataOffset(int sessionId, std::uint32_t slot)
 {
     ASSERT_TRUE(m_sut);
-    EXPECT_TRUE(m_sut->clearData(sessionId, firebolt::rialto::MediaSourceType::VIDEO));
-}
-
-void SharedMemoryBufferTests::shouldFailToClearVideoData(int sessionId)
-{
-    ASSERT_TRUE(m_sut);
-    EXPECT_FALSE(m_sut->clearData(sessionId, firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_THROW(m_sut->getSlotDataOffset(sessionId, firebolt::rialto::MediaSourceType::VIDEO, slot),
+                 std::runtime_error);
 }
 
 uint8_t *SharedMemoryBufferTests::shouldGetDataPtr(int sessionId, const firebolt::rialto::MediaSourceType &mediaSourceType)
@@ -148,7 +146,7 @@ void SharedMemoryBufferTests::shouldGetFd()
 void SharedMemoryBufferTests::shouldGetSize()
 {
     ASSERT_TRUE(m_sut);
-    EXPECT_EQ(8 * 1024 * 1024, m_sut->getSize()); // Size for one session should be 8 MB
+    EXPECT_EQ(audioBufferLen + videoBufferLen, m_sut->getSize()); // Size for one session
 }
 
 void SharedMemoryBufferTests::shouldGetBuffer()
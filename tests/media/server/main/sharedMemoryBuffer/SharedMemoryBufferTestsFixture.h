@@ -44,10 +44,9 @@ public:
     void shouldFailToReturnVideoDataOffset(int sessionId);
     void shouldReturnAudioDataOffset(int sessionId, std::uint32_t expectedOffset);
     void shouldFailToReturnAudioDataOffset(int sessionId);
-    void shouldClearAudioData(int sessionId);
-    void shouldFailToClearAudioData(int sessionId);
-    void shouldClearVideoData(int sessionId);
-    void shouldFailToClearVideoData(int sessionId);
+    void shouldReturnMaxVideoSlotDataLen(int sessionId);
+    void shouldReturnVideoSlotDataOffset(int sessionId, std::uint32_t slot, std::uint32_t expectedOffset);
+    void shouldFailToReturnVideoSlotDataOffset(int sessionId, std::uint32_t slot);
     uint8_t *shouldGetDataPtr(int sessionId, const firebolt::rialto::MediaSourceType &mediaSourceType);
     void shouldFailToGetDataPtr(int sessionId, const firebolt::rialto::MediaSourceType &mediaSourceType);
     void shouldGetFd();
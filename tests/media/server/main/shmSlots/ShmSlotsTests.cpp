@@ -0,0 +1,89 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmSlots.h"
+#include <gtest/gtest.h>
+
+using firebolt::rialto::server::kShmSlotsPerSource;
+using firebolt::rialto::server::ShmSlots;
+
+class ShmSlotsTests : public testing::Test
+{
+protected:
+    ShmSlots m_sut;
+};
+
+TEST_F(ShmSlotsTests, shouldAcquireAllSlots)
+{
+    std::uint32_t slot{kShmSlotsPerSource};
+    for (std::uint32_t i = 0; i < kShmSlotsPerSource; ++i)
+    {
+        EXPECT_TRUE(m_sut.acquire(slot));
+        EXPECT_EQ(i, slot);
+    }
+}
+
+TEST_F(ShmSlotsTests, shouldFailToAcquireWhenAllSlotsAreInUse)
+{
+    std::uint32_t slot{0};
+    for (std::uint32_t i = 0; i < kShmSlotsPerSource; ++i)
+    {
+        EXPECT_TRUE(m_sut.acquire(slot));
+    }
+    EXPECT_FALSE(m_sut.acquire(slot));
+}
+
+TEST_F(ShmSlotsTests, shouldAcquireReleasedSlot)
+{
+    std::uint32_t slot{0};
+    for (std::uint32_t i = 0; i < kShmSlotsPerSource; ++i)
+    {
+        EXPECT_TRUE(m_sut.acquire(slot));
+    }
+    m_sut.release(0);
+    EXPECT_TRUE(m_sut.acquire(slot));
+    EXPECT_EQ(0, slot);
+}
+
+TEST_F(ShmSlotsTests, shouldReleaseRequestedSlotsOnly)
+{
+    std::uint32_t readSlot{0};
+    std::uint32_t slot{0};
+    EXPECT_TRUE(m_sut.acquire(readSlot));
+    m_sut.startReading(readSlot);
+    for (std::uint32_t i = 1; i < kShmSlotsPerSource; ++i)
+    {
+        EXPECT_TRUE(m_sut.acquire(slot));
+    }
+    m_sut.releaseRequested();
+    for (std::uint32_t i = 1; i < kShmSlotsPerSource; ++i)
+    {
+        EXPECT_TRUE(m_sut.acquire(slot));
+        EXPECT_NE(readSlot, slot);
+    }
+    EXPECT_FALSE(m_sut.acquire(slot));
+}
+
+TEST_F(ShmSlotsTests, shouldIgnoreInvalidSlot)
+{
+    std::uint32_t slot{0};
+    m_sut.startReading(kShmSlotsPerSource);
+    m_sut.release(kShmSlotsPerSource);
+    EXPECT_TRUE(m_sut.acquire(slot));
+}
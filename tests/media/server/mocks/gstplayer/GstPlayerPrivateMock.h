@@ -36,7 +36,12 @@ public:
     MOCK_METHOD(bool, setWesterossinkRectangle, (), (override));
     MOCK_METHOD(bool, setWesterossinkSecondaryVideo, (), (override));
     MOCK_METHOD(void, notifyNeedMediaData, (bool audioNotificationNeeded, bool videoNotificationNeeded), (override));
+    MOCK_METHOD(void, requestMediaData, (const MediaSourceType &mediaSourceType), (override));
     MOCK_METHOD(GstBuffer *, createBuffer, (const IMediaPipeline::MediaSegment &mediaSegment), (const, override));
+    MOCK_METHOD(GstBuffer *, createShmBuffer,
+                (const IMediaPipeline::MediaSegment &mediaSegment, const std::shared_ptr<IDataReader> &dataReader),
+                (override));
+    MOCK_METHOD(void, notifyShmBuffersReleased, (), (override));
     MOCK_METHOD(void, attachAudioData, (), (override));
     MOCK_METHOD(void, attachVideoData, (), (override));
     MOCK_METHOD(void, updateAudioCaps, (int32_t rate, int32_t channels), (override));
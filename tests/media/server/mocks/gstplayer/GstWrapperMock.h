@@ -81,11 +81,15 @@ public:
     MOCK_METHOD(GstFlowReturn, gstAppSrcEndOfStream, (GstAppSrc *), (override));
     MOCK_METHOD(gboolean, gstElementQueryPosition, (GstElement *, GstFormat, gint64 *), (override));
     MOCK_METHOD(GstFlowReturn, gstAppSrcPushBuffer, (GstAppSrc *, GstBuffer *), (override));
+    MOCK_METHOD(GstFlowReturn, gstAppSrcPushBufferList, (GstAppSrc *, GstBufferList *), (override));
+    MOCK_METHOD(GstBufferList *, gstBufferListNewSized, (guint), (override));
+    MOCK_METHOD(void, gstBufferListAdd, (GstBufferList *, GstBuffer *), (override));
     MOCK_METHOD(GstBuffer *, gstBufferNew, (), (override));
     MOCK_METHOD(GstBuffer *, gstBufferNewAllocate, (GstAllocator *, gsize, GstAllocationParams *), (override));
     MOCK_METHOD(gsize, gstBufferFill, (GstBuffer *, gsize, gconstpointer, gsize), (override));
     MOCK_METHOD(void, gstBufferUnref, (GstBuffer *), (override));
     MOCK_METHOD(void, gstMessageUnref, (GstMessage *), (override));
+    MOCK_METHOD(GstMessage *, gstMessageRef, (GstMessage *), (override));
     MOCK_METHOD(GstMessage *, gstBusTimedPopFiltered, (GstBus * bus, GstClockTime timeout, GstMessageType types),
                 (override));
     MOCK_METHOD(void, gstDebugBinToDotFileWithTs, (GstBin * bin, GstDebugGraphDetails details, const gchar *file_name),
@@ -127,6 +131,10 @@ public:
     MOCK_METHOD(gboolean, gstByteWriterPutUint16Be, (GstByteWriter * writer, guint16 val), (const, override));
     MOCK_METHOD(gboolean, gstByteWriterPutUint32Be, (GstByteWriter * writer, guint32 val), (const, override));
     MOCK_METHOD(GstBuffer *, gstBufferNewWrapped, (gpointer data, gsize size), (const, override));
+    MOCK_METHOD(GstBuffer *, gstBufferNewWrappedFull,
+                (GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset, gsize size, gpointer user_data,
+                 GDestroyNotify notify),
+                (const, override));
     MOCK_METHOD(GstCaps *, gstCodecUtilsOpusCreateCapsFromHeader, (gconstpointer data, guint size), (const, override));
     MOCK_METHOD(gboolean, gstCapsIsSubset, (const GstCaps *subset, const GstCaps *superset), (const));
     MOCK_METHOD(gboolean, gstCapsIsStrictlyEqual, (const GstCaps *caps1, const GstCaps *caps2), (const));
@@ -43,8 +43,8 @@ public:
                 (PlayerContext & context, IGstPlayerPrivate &player), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createHandleBusMessage,
                 (PlayerContext & context, IGstPlayerPrivate &player, GstMessage *message), (const, override));
-    MOCK_METHOD(std::unique_ptr<IPlayerTask>, createNeedData, (PlayerContext & context, GstAppSrc *src),
-                (const, override));
+    MOCK_METHOD(std::unique_ptr<IPlayerTask>, createNeedData,
+                (PlayerContext & context, IGstPlayerPrivate &player, GstAppSrc *src), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createPause, (IGstPlayerPrivate & player), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createPlay, (IGstPlayerPrivate & player), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createReadShmDataAndAttachSamples,
@@ -63,6 +63,8 @@ public:
                 (PlayerContext & context, IGstPlayerPrivate &player, GstElement *source), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createSetVideoGeometry,
                 (PlayerContext & context, IGstPlayerPrivate &player, const Rectangle &rectangle), (const, override));
+    MOCK_METHOD(std::unique_ptr<IPlayerTask>, createShmBuffersReleased, (IGstPlayerPrivate & player),
+                (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createShutdown, (IGstPlayerPrivate & player), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createStop, (PlayerContext & context, IGstPlayerPrivate &player),
                 (const, override));
@@ -79,6 +79,11 @@ public:
                 (::google::protobuf::RpcController * controller, const ::firebolt::rialto::HaveDataRequest *request,
                  ::firebolt::rialto::HaveDataResponse *response, ::google::protobuf::Closure *done),
                 (override));
+    MOCK_METHOD(void, haveDataMultiSource,
+                (::google::protobuf::RpcController * controller,
+                 const ::firebolt::rialto::HaveDataMultiSourceRequest *request,
+                 ::firebolt::rialto::HaveDataMultiSourceResponse *response, ::google::protobuf::Closure *done),
+                (override));
 };
 } // namespace firebolt::rialto::server::ipc
 
@@ -29,8 +29,11 @@ namespace firebolt::rialto::server
 class ActiveRequestsMock : public IActiveRequests
 {
 public:
-    MOCK_METHOD(std::uint32_t, insert, (const MediaSourceType &mediaSourceType, std::uint32_t maxMediaBytes), (override));
+    MOCK_METHOD(std::uint32_t, insert,
+                (const MediaSourceType &mediaSourceType, std::uint32_t maxMediaBytes, std::uint32_t shmSlot),
+                (override));
     MOCK_METHOD(MediaSourceType, getType, (std::uint32_t requestId), (const, override));
+    MOCK_METHOD(std::uint32_t, getShmSlot, (std::uint32_t requestId), (const, override));
     MOCK_METHOD(void, erase, (std::uint32_t requestId), (override));
     MOCK_METHOD(void, clear, (), (override));
     MOCK_METHOD(AddSegmentStatus, addSegment,
@@ -44,6 +44,15 @@ public:
     MOCK_METHOD(bool, setVideoWindow, (uint32_t x, uint32_t y, uint32_t width, uint32_t height), (override));
     MOCK_METHOD(bool, haveData, (MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId), (override));
     MOCK_METHOD(bool, haveData, (MediaSourceStatus status, uint32_t needDataRequestId), (override));
+    MOCK_METHOD(void, haveDataAsync,
+                (MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId, ResultCallback callback),
+                (override));
+    MOCK_METHOD(void, haveDataAsync, (const std::vector<HaveDataShmInfo> &sources, ResultCallback callback),
+                (override));
+    MOCK_METHOD(void, playAsync, (ResultCallback callback), (override));
+    MOCK_METHOD(void, pauseAsync, (ResultCallback callback), (override));
+    MOCK_METHOD(void, setPositionAsync, (int64_t position, ResultCallback callback), (override));
+    MOCK_METHOD(void, getPositionAsync, (PositionCallback callback), (override));
     MOCK_METHOD(bool, renderFrame, (), (override));
     MOCK_METHOD(AddSegmentStatus, addSegment,
                 (uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment), (override));
@@ -30,9 +30,12 @@ class SharedMemoryBufferMock : public ISharedMemoryBuffer
 public:
     MOCK_METHOD(bool, mapPartition, (int sessionId), (override));
     MOCK_METHOD(bool, unmapPartition, (int sessionId), (override));
-    MOCK_METHOD(bool, clearData, (int sessionId, const MediaSourceType &mediaSourceType), (const, override));
     MOCK_METHOD(std::uint32_t, getDataOffset, (int sessionId, const MediaSourceType &mediaSourceType), (const, override));
     MOCK_METHOD(std::uint32_t, getMaxDataLen, (int sessionId, const MediaSourceType &mediaSourceType), (const, override));
+    MOCK_METHOD(std::uint32_t, getSlotDataOffset,
+                (int sessionId, const MediaSourceType &mediaSourceType, std::uint32_t slot), (const, override));
+    MOCK_METHOD(std::uint32_t, getMaxSlotDataLen, (int sessionId, const MediaSourceType &mediaSourceType),
+                (const, override));
     MOCK_METHOD(std::uint8_t *, getDataPtr, (int sessionId, const MediaSourceType &mediaSourceType), (const, override));
     MOCK_METHOD(int, getFd, (), (const, override));
     MOCK_METHOD(std::uint32_t, getSize, (), (const, override));
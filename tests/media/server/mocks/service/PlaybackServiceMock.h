@@ -40,14 +40,15 @@ public:
     MOCK_METHOD(bool, load, (int, MediaType, const std::string &, const std::string &), (override));
     MOCK_METHOD(bool, attachSource, (int, IMediaPipeline::MediaSource &), (override));
     MOCK_METHOD(bool, removeSource, (int, std::int32_t), (override));
-    MOCK_METHOD(bool, play, (int), (override));
-    MOCK_METHOD(bool, pause, (int), (override));
+    MOCK_METHOD(void, play, (int, ResultCallback), (override));
+    MOCK_METHOD(void, pause, (int, ResultCallback), (override));
     MOCK_METHOD(bool, stop, (int), (override));
     MOCK_METHOD(bool, setPlaybackRate, (int, double), (override));
-    MOCK_METHOD(bool, setPosition, (int, int64_t), (override));
-    MOCK_METHOD(bool, getPosition, (int sessionId, int64_t &position), (override));
+    MOCK_METHOD(void, setPosition, (int, int64_t, ResultCallback), (override));
+    MOCK_METHOD(void, getPosition, (int sessionId, PositionCallback callback), (override));
     MOCK_METHOD(bool, setVideoWindow, (int, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t), (override));
-    MOCK_METHOD(bool, haveData, (int, MediaSourceStatus, std::uint32_t, std::uint32_t), (override));
+    MOCK_METHOD(void, haveData, (int, MediaSourceStatus, std::uint32_t, std::uint32_t, ResultCallback), (override));
+    MOCK_METHOD(void, haveData, (int, const std::vector<HaveDataShmInfo> &, ResultCallback), (override));
     MOCK_METHOD(bool, renderFrame, (int), (override));
     MOCK_METHOD(bool, getSharedMemory, (int32_t & fd, uint32_t &size), (override));
     MOCK_METHOD(std::vector<std::string>, getSupportedMimeTypes, (MediaSourceType type), (override));
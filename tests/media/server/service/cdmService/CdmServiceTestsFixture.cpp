@@ -18,6 +18,7 @@
  */
 
 #include "CdmServiceTestsFixture.h"
+#include <chrono>
 #include <string>
 #include <utility>
 
@@ -199,25 +200,35 @@ void CdmServiceTests::mediaKeysWillGetDrmTimeWithStatus(firebolt::rialto::MediaK
 
 void CdmServiceTests::mediaKeysWillDecryptWithStatus(firebolt::rialto::MediaKeyErrorStatus status)
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
     EXPECT_CALL(m_mediaKeysMock, decrypt(keySessionId, _, _, subSampleCount, _, _, initWithLast15)).WillOnce(Return(status));
 }
 
 void CdmServiceTests::mediaKeysWillSelectKeyIdWithStatus(firebolt::rialto::MediaKeyErrorStatus status)
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
     EXPECT_CALL(m_mediaKeysMock, selectKeyId(keySessionId, keyId)).WillOnce(Return(status));
 }
 
-void CdmServiceTests::mediaKeysWillNotFindMediaKeySession()
+void CdmServiceTests::mediaKeysWillCheckIfKeySystemIsNetflix(bool result)
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(false));
+    EXPECT_CALL(m_mediaKeysMock, isNetflixKeySystem(keySessionId)).WillOnce(Return(result));
 }
 
-void CdmServiceTests::mediaKeysWillCheckIfKeySystemIsNetflix(bool result)
+void CdmServiceTests::mediaKeysWillBeDestroyedDuringDecryption()
 {
-    EXPECT_CALL(m_mediaKeysMock, hasSession(keySessionId)).WillOnce(Return(true));
-    EXPECT_CALL(m_mediaKeysMock, isNetflixKeySystem(keySessionId)).WillOnce(Return(result));
+    EXPECT_CALL(m_mediaKeysMock, decrypt(keySessionId, _, _, subSampleCount, _, _, initWithLast15))
+        .WillOnce(Invoke(
+            [this](int32_t, GstBuffer *, GstBuffer *, const uint32_t, GstBuffer *, GstBuffer *, uint32_t)
+            {
+                m_destroyThread = std::thread(
+                    [this]()
+                    {
+                        EXPECT_TRUE(m_sut.destroyMediaKeys(mediaKeysHandle));
+                        m_isDestroyed = true;
+                    });
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                EXPECT_FALSE(m_isDestroyed);
+                return firebolt::rialto::MediaKeyErrorStatus::OK;
+            }));
 }
 
 void CdmServiceTests::createMediaKeysShouldSucceed()
@@ -240,6 +251,13 @@ void CdmServiceTests::destroyMediaKeysShouldFail()
     EXPECT_FALSE(m_sut.destroyMediaKeys(mediaKeysHandle));
 }
 
+void CdmServiceTests::destroyMediaKeysShouldCompleteAfterDecryption()
+{
+    ASSERT_TRUE(m_destroyThread.joinable());
+    m_destroyThread.join();
+    EXPECT_TRUE(m_isDestroyed);
+}
+
 void CdmServiceTests::createKeySessionShouldSucceed()
 {
     int32_t returnKeySessionId = -1;
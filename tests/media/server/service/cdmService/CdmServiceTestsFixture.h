@@ -28,8 +28,10 @@
 #include "MediaKeysServerInternalMock.h"
 #include "SharedMemoryBufferFactoryMock.h"
 #include "SharedMemoryBufferMock.h"
+#include <atomic>
 #include <gtest/gtest.h>
 #include <memory>
+#include <thread>
 #include <vector>
 
 using testing::StrictMock;
@@ -60,8 +62,8 @@ public:
     void mediaKeysWillGetDrmTimeWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void mediaKeysWillDecryptWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void mediaKeysWillSelectKeyIdWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
-    void mediaKeysWillNotFindMediaKeySession();
     void mediaKeysWillCheckIfKeySystemIsNetflix(bool result);
+    void mediaKeysWillBeDestroyedDuringDecryption();
 
     void mediaKeysCapabilitiesFactoryWillCreateMediaKeysCapabilities();
     void mediaKeysCapabilitiesFactoryWillReturnNullptr();
@@ -77,6 +79,7 @@ public:
     void createMediaKeysShouldFail();
     void destroyMediaKeysShouldSucceed();
     void destroyMediaKeysShouldFail();
+    void destroyMediaKeysShouldCompleteAfterDecryption();
     void createKeySessionShouldSucceed();
     void createKeySessionShouldFailWithReturnStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void generateRequestShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus status);
@@ -114,6 +117,8 @@ private:
     StrictMock<firebolt::rialto::MediaKeysCapabilitiesMock> &m_mediaKeysCapabilitiesMock;
     std::shared_ptr<StrictMock<firebolt::rialto::MediaKeysClientMock>> m_mediaKeysClientMock;
     firebolt::rialto::server::service::CdmService m_sut;
+    std::thread m_destroyThread;
+    std::atomic<bool> m_isDestroyed{false};
 };
 
 #endif // CDM_SERVICE_TESTS_FIXTURE_H_
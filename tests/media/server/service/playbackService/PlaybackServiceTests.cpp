@@ -454,6 +454,27 @@ TEST_F(PlaybackServiceTests, shouldHaveData)
     haveDataShouldSucceed();
 }
 
+TEST_F(PlaybackServiceTests, shouldFailToHaveDataOfSeveralSourcesForNotExistingSession)
+{
+    mediaPipelineCapabilitiesFactoryWillCreateMediaPipelineCapabilities();
+    triggerSetMaxPlaybacks();
+    sharedMemoryBufferWillBeInitialized();
+    triggerSwitchToActive();
+    haveDataOfSeveralSourcesShouldFail();
+}
+
+TEST_F(PlaybackServiceTests, shouldHaveDataOfSeveralSources)
+{
+    mediaPipelineCapabilitiesFactoryWillCreateMediaPipelineCapabilities();
+    triggerSetMaxPlaybacks();
+    sharedMemoryBufferWillBeInitialized();
+    triggerSwitchToActive();
+    mediaPipelineFactoryWillCreateMediaPipeline();
+    createSessionShouldSucceed();
+    mediaPipelineWillHaveDataOfSeveralSources();
+    haveDataOfSeveralSourcesShouldSucceed();
+}
+
 TEST_F(PlaybackServiceTests, shouldFailToGetSharedMemoryInInactiveState)
 {
     mediaPipelineCapabilitiesFactoryWillCreateMediaPipelineCapabilities();
@@ -26,6 +26,7 @@
 using testing::_;
 using testing::ByMove;
 using testing::Invoke;
+using testing::InvokeArgument;
 using testing::Return;
 using testing::Throw;
 
@@ -47,6 +48,8 @@ constexpr std::uint32_t y{7};
 constexpr firebolt::rialto::MediaSourceStatus status{firebolt::rialto::MediaSourceStatus::CODEC_CHANGED};
 constexpr std::uint32_t needDataRequestId{17};
 constexpr std::uint32_t numFrames{1};
+const std::vector<firebolt::rialto::server::HaveDataShmInfo> severalSources{{status, numFrames, needDataRequestId},
+                                                                            {status, numFrames, needDataRequestId + 1}};
 constexpr std::int32_t shmFd{234};
 constexpr std::uint32_t shmSize{2048};
 } // namespace
@@ -128,22 +131,22 @@ void PlaybackServiceTests::mediaPipelineWillFailToRemoveSource()
 
 void PlaybackServiceTests::mediaPipelineWillPlay()
 {
-    EXPECT_CALL(m_mediaPipelineMock, play()).WillOnce(Return(true));
+    EXPECT_CALL(m_mediaPipelineMock, playAsync(_)).WillOnce(InvokeArgument<0>(true));
 }
 
 void PlaybackServiceTests::mediaPipelineWillFailToPlay()
 {
-    EXPECT_CALL(m_mediaPipelineMock, play()).WillOnce(Return(false));
+    EXPECT_CALL(m_mediaPipelineMock, playAsync(_)).WillOnce(InvokeArgument<0>(false));
 }
 
 void PlaybackServiceTests::mediaPipelineWillPause()
 {
-    EXPECT_CALL(m_mediaPipelineMock, pause()).WillOnce(Return(true));
+    EXPECT_CALL(m_mediaPipelineMock, pauseAsync(_)).WillOnce(InvokeArgument<0>(true));
 }
 
 void PlaybackServiceTests::mediaPipelineWillFailToPause()
 {
-    EXPECT_CALL(m_mediaPipelineMock, pause()).WillOnce(Return(false));
+    EXPECT_CALL(m_mediaPipelineMock, pauseAsync(_)).WillOnce(InvokeArgument<0>(false));
 }
 
 void PlaybackServiceTests::mediaPipelineWillStop()
@@ -168,12 +171,12 @@ void PlaybackServiceTests::mediaPipelineWillFailToSetPlaybackRate()
 
 void PlaybackServiceTests::mediaPipelineWillSetPosition()
 {
-    EXPECT_CALL(m_mediaPipelineMock, setPosition(position)).WillOnce(Return(true));
+    EXPECT_CALL(m_mediaPipelineMock, setPositionAsync(position, _)).WillOnce(InvokeArgument<1>(true));
 }
 
 void PlaybackServiceTests::mediaPipelineWillFailToSetPosition()
 {
-    EXPECT_CALL(m_mediaPipelineMock, setPosition(position)).WillOnce(Return(false));
+    EXPECT_CALL(m_mediaPipelineMock, setPositionAsync(position, _)).WillOnce(InvokeArgument<1>(false));
 }
 
 void PlaybackServiceTests::mediaPipelineWillSetVideoWindow()
@@ -188,28 +191,42 @@ void PlaybackServiceTests::mediaPipelineWillFailToSetVideoWindow()
 
 void PlaybackServiceTests::mediaPipelineWillHaveData()
 {
-    EXPECT_CALL(m_mediaPipelineMock, haveData(status, numFrames, needDataRequestId)).WillOnce(Return(true));
+    EXPECT_CALL(m_mediaPipelineMock, haveDataAsync(status, numFrames, needDataRequestId, _))
+        .WillOnce(InvokeArgument<3>(true));
 }
 
 void PlaybackServiceTests::mediaPipelineWillFailToHaveData()
 {
-    EXPECT_CALL(m_mediaPipelineMock, haveData(status, numFrames, needDataRequestId)).WillOnce(Return(false));
+    EXPECT_CALL(m_mediaPipelineMock, haveDataAsync(status, numFrames, needDataRequestId, _))
+        .WillOnce(InvokeArgument<3>(false));
 }
 
-void PlaybackServiceTests::mediaPipelineWillGetPosition()
+void PlaybackServiceTests::mediaPipelineWillHaveDataOfSeveralSources()
 {
-    EXPECT_CALL(m_mediaPipelineMock, getPosition(_))
+    EXPECT_CALL(m_mediaPipelineMock, haveDataAsync(_, _))
         .WillOnce(Invoke(
-            [&](int64_t &pos)
+            [](const std::vector<firebolt::rialto::server::HaveDataShmInfo> &sources,
+                firebolt::rialto::server::IMediaPipelineServerInternal::ResultCallback callback)
             {
-                pos = position;
-                return true;
+                ASSERT_EQ(sources.size(), severalSources.size());
+                for (size_t i = 0; i < sources.size(); ++i)
+                {
+                    EXPECT_EQ(sources[i].status, severalSources[i].status);
+                    EXPECT_EQ(sources[i].numFrames, severalSources[i].numFrames);
+                    EXPECT_EQ(sources[i].needDataRequestId, severalSources[i].needDataRequestId);
+                }
+                callback(true);
             }));
 }
 
+void PlaybackServiceTests::mediaPipelineWillGetPosition()
+{
+    EXPECT_CALL(m_mediaPipelineMock, getPositionAsync(_)).WillOnce(InvokeArgument<0>(true, position));
+}
+
 void PlaybackServiceTests::mediaPipelineWillFailToGetPosition()
 {
-    EXPECT_CALL(m_mediaPipelineMock, getPosition(_)).WillOnce(Return(false));
+    EXPECT_CALL(m_mediaPipelineMock, getPositionAsync(_)).WillOnce(InvokeArgument<0>(false, 0));
 }
 
 void PlaybackServiceTests::mediaPipelineFactoryWillCreateMediaPipeline()
@@ -315,22 +332,30 @@ void PlaybackServiceTests::removeSourceShouldFail()
 
 void PlaybackServiceTests::playShouldSucceed()
 {
-    EXPECT_TRUE(m_sut->play(sessionId));
+    bool result{false};
+    m_sut->play(sessionId, [&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
 }
 
 void PlaybackServiceTests::playShouldFail()
 {
-    EXPECT_FALSE(m_sut->play(sessionId));
+    bool result{true};
+    m_sut->play(sessionId, [&](bool callResult) { result = callResult; });
+    EXPECT_FALSE(result);
 }
 
 void PlaybackServiceTests::pauseShouldSucceed()
 {
-    EXPECT_TRUE(m_sut->pause(sessionId));
+    bool result{false};
+    m_sut->pause(sessionId, [&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
 }
 
 void PlaybackServiceTests::pauseShouldFail()
 {
-    EXPECT_FALSE(m_sut->pause(sessionId));
+    bool result{true};
+    m_sut->pause(sessionId, [&](bool callResult) { result = callResult; });
+    EXPECT_FALSE(result);
 }
 
 void PlaybackServiceTests::stopShouldSucceed()
@@ -355,12 +380,16 @@ void PlaybackServiceTests::setPlaybackRateShouldFail()
 
 void PlaybackServiceTests::setPositionShouldSucceed()
 {
-    EXPECT_TRUE(m_sut->setPosition(sessionId, position));
+    bool result{false};
+    m_sut->setPosition(sessionId, position, [&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
 }
 
 void PlaybackServiceTests::setPositionShouldFail()
 {
-    EXPECT_FALSE(m_sut->setPosition(sessionId, position));
+    bool result{true};
+    m_sut->setPosition(sessionId, position, [&](bool callResult) { result = callResult; });
+    EXPECT_FALSE(result);
 }
 
 void PlaybackServiceTests::setVideoWindowShouldSucceed()
@@ -375,12 +404,30 @@ void PlaybackServiceTests::setVideoWindowShouldFail()
 
 void PlaybackServiceTests::haveDataShouldSucceed()
 {
-    EXPECT_TRUE(m_sut->haveData(sessionId, status, numFrames, needDataRequestId));
+    bool result{false};
+    m_sut->haveData(sessionId, status, numFrames, needDataRequestId, [&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
 }
 
 void PlaybackServiceTests::haveDataShouldFail()
 {
-    EXPECT_FALSE(m_sut->haveData(sessionId, status, numFrames, needDataRequestId));
+    bool result{true};
+    m_sut->haveData(sessionId, status, numFrames, needDataRequestId, [&](bool callResult) { result = callResult; });
+    EXPECT_FALSE(result);
+}
+
+void PlaybackServiceTests::haveDataOfSeveralSourcesShouldSucceed()
+{
+    bool result{false};
+    m_sut->haveData(sessionId, severalSources, [&](bool callResult) { result = callResult; });
+    EXPECT_TRUE(result);
+}
+
+void PlaybackServiceTests::haveDataOfSeveralSourcesShouldFail()
+{
+    bool result{true};
+    m_sut->haveData(sessionId, severalSources, [&](bool callResult) { result = callResult; });
+    EXPECT_FALSE(result);
 }
 
 void PlaybackServiceTests::getSharedMemoryShouldSucceed()
@@ -403,15 +450,23 @@ void PlaybackServiceTests::getSharedMemoryShouldFail()
 
 void PlaybackServiceTests::getPositionShouldSucceed()
 {
+    bool result{false};
     std::int64_t targetPosition{};
-    EXPECT_TRUE(m_sut->getPosition(sessionId, targetPosition));
+    m_sut->getPosition(sessionId,
+                       [&](bool callResult, std::int64_t callPosition)
+                       {
+                           result = callResult;
+                           targetPosition = callPosition;
+                       });
+    EXPECT_TRUE(result);
     EXPECT_EQ(targetPosition, position);
 }
 
 void PlaybackServiceTests::getPositionShouldFail()
 {
-    std::int64_t targetPosition{};
-    EXPECT_FALSE(m_sut->getPosition(sessionId, targetPosition));
+    bool result{true};
+    m_sut->getPosition(sessionId, [&](bool callResult, std::int64_t) { result = callResult; });
+    EXPECT_FALSE(result);
 }
 
 void PlaybackServiceTests::getSupportedMimeTypesSucceed()
@@ -63,6 +63,7 @@ public:
     void mediaPipelineWillFailToSetVideoWindow();
     void mediaPipelineWillHaveData();
     void mediaPipelineWillFailToHaveData();
+    void mediaPipelineWillHaveDataOfSeveralSources();
     void mediaPipelineWillGetPosition();
     void mediaPipelineWillFailToGetPosition();
 
@@ -100,6 +101,8 @@ public:
     void setVideoWindowShouldFail();
     void haveDataShouldSucceed();
     void haveDataShouldFail();
+    void haveDataOfSeveralSourcesShouldSucceed();
+    void haveDataOfSeveralSourcesShouldFail();
     void getSharedMemoryShouldSucceed();
     void getSharedMemoryShouldFail();
     void getPositionShouldSucceed();